@@ -458,6 +458,7 @@ set(BASE_CMN_SRC
     src/common/textbuf.cpp
     src/common/textfile.cpp
     src/common/threadinfo.cpp
+    src/common/threadpool.cpp
     src/common/time.cpp
     src/common/timercmn.cpp
     src/common/timerimpl.cpp
@@ -579,6 +580,7 @@ set(BASE_CMN_HDR
     wx/platinfo.h
     wx/power.h
     wx/process.h
+    wx/progsrc.h
     wx/ptr_scpd.h
     wx/ptr_shrd.h
     wx/recguard.h
@@ -608,6 +610,7 @@ set(BASE_CMN_HDR
     wx/textbuf.h
     wx/textfile.h
     wx/thread.h
+    wx/threadpool.h
     wx/thrimpl.cpp
     wx/time.h
     wx/timer.h
@@ -495,6 +495,14 @@ protected:
 
     void DoFrameLayout();
 
+    // Calls DoFrameLayout() and refreshes only the UI parts and the panes
+    // whose rectangles have changed.
+    void DoFrameLayoutAndRefresh();
+
+    // Lays out the frame after only the dock sizes or the pane proportions
+    // changed, reusing the existing sizers and UI parts.
+    void UpdateSizes();
+
     void LayoutAddPane(wxSizer* container,
                        wxAuiDockInfo& dock,
                        wxAuiPaneInfo& pane,
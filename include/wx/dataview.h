@@ -22,6 +22,7 @@
 #include "wx/dynarray.h"
 #include "wx/icon.h"
 #include "wx/itemid.h"
+#include "wx/longlong.h"
 #include "wx/weakref.h"
 #include "wx/vector.h"
 #include "wx/dataobj.h"
@@ -185,6 +186,52 @@ private:
 };
 
 
+// ----------------------------------------------------------------------------
+// wxDataViewSortKey: a value used for sorting the items
+// ----------------------------------------------------------------------------
+
+// The key is a simplified representation of an item value which can be
+// compared more efficiently than the value itself and is used for sorting the
+// items if wxDataViewModel::HasSortKeys() returns true.
+
+class WXDLLIMPEXP_CORE wxDataViewSortKey
+{
+public:
+    wxDataViewSortKey()
+    {
+        m_kind = Kind_None;
+        m_double = 0.;
+    }
+
+    void Clear() { m_kind = Kind_None; }
+
+    void SetInteger(wxLongLong value) { m_kind = Kind_Integer; m_integer = value; }
+    void SetDouble(double value) { m_kind = Kind_Double; m_double = value; }
+    void SetString(const wxString& value) { m_kind = Kind_String; m_string = value; }
+
+    bool IsEmpty() const { return m_kind == Kind_None; }
+
+    // Return negative, zero or positive value depending on whether this key
+    // is less than, equal to or greater than the other one. Keys of different
+    // kinds are ordered by kind, with the empty keys coming first.
+    int Compare(const wxDataViewSortKey& other) const;
+
+private:
+    enum Kind
+    {
+        Kind_None,
+        Kind_Integer,
+        Kind_Double,
+        Kind_String
+    };
+
+    Kind m_kind;
+
+    wxLongLong m_integer;
+    double m_double;
+    wxString m_string;
+};
+
 // ---------------------------------------------------------
 // wxDataViewModel
 // ---------------------------------------------------------
@@ -277,6 +324,19 @@ public:
                          unsigned int column, bool ascending ) const;
     virtual bool HasDefaultCompare() const { return false; }
 
+    // override to return true if the items can be sorted by the given column
+    // by comparing the keys returned by GetSortKey() instead of calling
+    // Compare() for each pair of them, which is much faster
+    virtual bool HasSortKeys(unsigned int WXUNUSED(column)) const
+        { return false; }
+
+    // get the key used for sorting the item by the given column: by default
+    // it is the item value itself for the types supported by the default
+    // Compare() implementation
+    virtual void GetSortKey(wxDataViewSortKey& key,
+                            const wxDataViewItem& item,
+                            unsigned int column) const;
+
     // internal
     virtual bool IsListModel() const { return false; }
     virtual bool IsVirtualListModel() const { return false; }
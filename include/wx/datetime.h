@@ -1517,6 +1517,58 @@ private:
         m_days;
 };
 
+// ----------------------------------------------------------------------------
+// wxDateTimeFormatter: a format string compiled for repeated use
+// ----------------------------------------------------------------------------
+
+// This class does the same thing as wxDateTime::Format() and ParseFormat() but
+// interprets the format string only once, when it is set, and also retrieves
+// the localized names used by it only once, which makes it much faster when
+// the same format is used for many dates.
+//
+// Its const methods can be used concurrently from several threads.
+class wxDateTimeFormatterData;
+
+class WXDLLIMPEXP_BASE wxDateTimeFormatter
+{
+public:
+    // default ctor uses wxDefaultDateTimeFormat
+    wxDateTimeFormatter();
+    explicit wxDateTimeFormatter(const wxString& format);
+    wxDateTimeFormatter(const wxDateTimeFormatter& other);
+    wxDateTimeFormatter& operator=(const wxDateTimeFormatter& other);
+    ~wxDateTimeFormatter();
+
+    // (re)compile the formatter for the given format, this must also be
+    // called if the locale changes as the month and week day names are
+    // cached
+    bool SetFormat(const wxString& format);
+    const wxString& GetFormat() const;
+
+    // return the same string as dt.Format(GetFormat(), tz)
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    // write the formatted date to the provided buffer, which is always NUL
+    // terminated (unless size is 0), and return the length of the full
+    // result, so that the output was truncated if the return value is greater
+    // than or equal to size, as with snprintf()
+    size_t FormatTo(wxChar* buf,
+                    size_t size,
+                    const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    // parse the date in the same way as dt->ParseFormat(date, GetFormat(),
+    // dateDef, end), if end is NULL the entire string must be matched
+    bool Parse(const wxString& date,
+               wxDateTime* dt,
+               const wxDateTime& dateDef = wxDefaultDateTime,
+               wxString::const_iterator* end = NULL) const;
+
+private:
+    wxDateTimeFormatterData* m_data;
+};
+
 // ----------------------------------------------------------------------------
 // wxDateTimeArray: array of dates.
 // ----------------------------------------------------------------------------
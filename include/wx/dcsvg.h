@@ -16,6 +16,7 @@
 #include "wx/string.h"
 #include "wx/filename.h"
 #include "wx/dc.h"
+#include "wx/hashmap.h"
 #include "wx/scopedptr.h"
 
 #define wxSVGVersion wxT("v0101")
@@ -31,6 +32,7 @@ enum wxSVGShapeRenderingMode
 };
 
 class WXDLLIMPEXP_FWD_BASE wxFileOutputStream;
+class WXDLLIMPEXP_FWD_BASE wxBufferedOutputStream;
 
 class WXDLLIMPEXP_FWD_CORE wxSVGFileDC;
 
@@ -279,12 +281,23 @@ private:
     // their current values in wxDC.
     void DoStartNewGraphics();
 
+    // Add the polyline with the given points, closing it if requested, to the
+    // path being accumulated, starting a new path if the current one uses
+    // different attributes or if the lines can't be merged at all.
+    void AddToPath(int n, const wxPoint points[],
+                   wxCoord xoffset, wxCoord yoffset,
+                   bool close = false);
+
+    // Write out the accumulated path, if any.
+    void FlushPath();
+
     wxString            m_filename;
     bool                m_OK;
     bool                m_graphics_changed;  // set by Set{Brush,Pen}()
     int                 m_width, m_height;
     double              m_dpi;
     wxScopedPtr<wxFileOutputStream> m_outfile;
+    wxScopedPtr<wxBufferedOutputStream> m_outstream; // buffers m_outfile
     wxScopedPtr<wxSVGBitmapHandler> m_bmp_handler; // class to handle bitmaps
     wxSVGShapeRenderingMode m_renderingMode;
 
@@ -299,6 +312,17 @@ private:
     // Unique ID for every gradient.
     size_t m_gradientUniqueId;
 
+    // The data and the attributes of the path being accumulated by
+    // AddToPath(), the data is empty if there is no such path.
+    wxString m_pathData;
+    wxString m_pathAttrs;
+
+    // The IDs of the bitmaps already written to the file, indexed by the key
+    // identifying their contents: each distinct bitmap is only written once
+    // and is referenced by all the subsequent DrawBitmap() calls.
+    WX_DECLARE_STRING_HASH_MAP(wxString, BitmapIds);
+    BitmapIds m_bitmapIds;
+
     wxDECLARE_ABSTRACT_CLASS(wxSVGFileDCImpl);
     wxDECLARE_NO_COPY_CLASS(wxSVGFileDCImpl);
 };
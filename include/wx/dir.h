@@ -82,6 +82,36 @@ public:
     virtual wxDirTraverseResult OnOpenError(const wxString& dirname);
 };
 
+// ----------------------------------------------------------------------------
+// wxDirBatchTraverser: helper class for wxDir::TraverseParallel()
+// ----------------------------------------------------------------------------
+
+// Unlike wxDirTraverser, this class gets all the files of a directory at once.
+// All its methods are called from the thread which called TraverseParallel()
+// only, so they don't need to be thread-safe.
+class WXDLLIMPEXP_BASE wxDirBatchTraverser
+{
+public:
+    virtual ~wxDirBatchTraverser() { }
+
+    // called with the names of all the files found in the given directory,
+    // dirname includes the trailing path separator, so that the full path of
+    // each of the files is just dirname + filenames[n]
+    //
+    // return wxDIR_STOP or wxDIR_CONTINUE from here
+    virtual wxDirTraverseResult OnFiles(const wxString& dirname,
+                                        const wxArrayString& filenames) = 0;
+
+    // called for each directory found, always before OnFiles() and OnDir()
+    // calls for its contents
+    //
+    // the base class version always returns wxDIR_CONTINUE
+    virtual wxDirTraverseResult OnDir(const wxString& dirname);
+
+    // the same as wxDirTraverser::OnOpenError()
+    virtual wxDirTraverseResult OnOpenError(const wxString& dirname);
+};
+
 // ----------------------------------------------------------------------------
 // wxDir: portable equivalent of {open/read/close}dir functions
 // ----------------------------------------------------------------------------
@@ -146,6 +176,14 @@ public:
                     const wxString& filespec = wxEmptyString,
                     int flags = wxDIR_DEFAULT) const;
 
+    // enumerate all files in this directory and its subdirectories reading
+    // the directories in parallel, if possible
+    //
+    // return the number of files found
+    size_t TraverseParallel(wxDirBatchTraverser& sink,
+                            const wxString& filespec = wxEmptyString,
+                            int flags = wxDIR_DEFAULT) const;
+
     // simplest version of Traverse(): get the names of all files under this
     // directory into filenames array, return the number of files
     static size_t GetAllFiles(const wxString& dirname,
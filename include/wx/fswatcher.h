@@ -20,6 +20,7 @@
 #include "wx/filename.h"
 #include "wx/dir.h"
 #include "wx/hashmap.h"
+#include "wx/vector.h"
 
 #define wxTRACE_FSWATCHER "fswatcher"
 
@@ -217,6 +218,78 @@ typedef void (wxEvtHandler::*wxFileSystemWatcherEventFunction)
 #define EVT_FSWATCHER(winid, func) \
     wx__DECLARE_EVT1(wxEVT_FSWATCHER, winid, wxFileSystemWatcherEventHandler(func))
 
+/**
+ * Event containing all the file system changes detected at once.
+ *
+ * If this event is not handled, the events it contains are sent individually
+ * as wxEVT_FSWATCHER events.
+ */
+class WXDLLIMPEXP_FWD_BASE wxFileSystemWatcherBatchEvent;
+wxDECLARE_EXPORTED_EVENT(WXDLLIMPEXP_BASE, wxEVT_FSWATCHER_BATCH,
+                         wxFileSystemWatcherBatchEvent);
+
+class WXDLLIMPEXP_BASE wxFileSystemWatcherBatchEvent : public wxEvent
+{
+public:
+    wxFileSystemWatcherBatchEvent(int watchid = wxID_ANY) :
+        wxEvent(watchid, wxEVT_FSWATCHER_BATCH)
+    {
+    }
+
+    wxFileSystemWatcherBatchEvent(const wxFileSystemWatcherBatchEvent& event);
+
+    virtual ~wxFileSystemWatcherBatchEvent();
+
+    /**
+     * Returns the number of the events in this batch.
+     */
+    size_t GetEventCount() const
+    {
+        return m_events.size();
+    }
+
+    /**
+     * Returns the event with the given index.
+     */
+    const wxFileSystemWatcherEvent& GetEvent(size_t n) const
+    {
+        return *m_events[n];
+    }
+
+    /**
+     * Appends the event to this batch, takes ownership of the pointer.
+     */
+    void AddEvent(wxFileSystemWatcherEvent* event)
+    {
+        m_events.push_back(event);
+    }
+
+    virtual wxEvent* Clone() const wxOVERRIDE
+    {
+        return new wxFileSystemWatcherBatchEvent(*this);
+    }
+
+    virtual wxEventCategory GetEventCategory() const wxOVERRIDE
+    {
+        return wxEVT_CATEGORY_UNKNOWN;
+    }
+
+private:
+    wxVector<wxFileSystemWatcherEvent*> m_events;
+
+    wxDECLARE_DYNAMIC_CLASS_NO_ASSIGN(wxFileSystemWatcherBatchEvent);
+};
+
+typedef void (wxEvtHandler::*wxFileSystemWatcherBatchEventFunction)
+                                            (wxFileSystemWatcherBatchEvent&);
+
+#define wxFileSystemWatcherBatchEventHandler(func) \
+    wxEVENT_HANDLER_CAST(wxFileSystemWatcherBatchEventFunction, func)
+
+#define EVT_FSWATCHER_BATCH(winid, func) \
+    wx__DECLARE_EVT1(wxEVT_FSWATCHER_BATCH, winid, \
+                     wxFileSystemWatcherBatchEventHandler(func))
+
 // ----------------------------------------------------------------------------
 // wxFileSystemWatcherBase: interface for wxFileSystemWatcher
 // ----------------------------------------------------------------------------
@@ -315,6 +388,29 @@ public:
     virtual bool AddTree(const wxFileName& path, int events = wxFSW_EVENT_ALL,
                          const wxString& filespec = wxEmptyString);
 
+    /**
+     * Like AddTree(), but may return before the whole tree is watched, the
+     * directories are found in the background and watched as soon as they
+     * are. IsAddingTrees() returns true until all of them are.
+     *
+     * The base class version simply calls AddTree().
+     */
+    virtual bool AddTreeAsync(const wxFileName& path,
+                              int events = wxFSW_EVENT_ALL,
+                              const wxString& filespec = wxEmptyString)
+    {
+        return AddTree(path, events, filespec);
+    }
+
+    /**
+     * Returns true if any trees added by AddTreeAsync() are still being
+     * scanned.
+     */
+    virtual bool IsAddingTrees() const
+    {
+        return false;
+    }
+
     /**
      * Removes path from the list of watched paths.
      */
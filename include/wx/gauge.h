@@ -43,6 +43,12 @@
 extern WXDLLIMPEXP_DATA_CORE(const char) wxGaugeNameStr[];
 
 class WXDLLIMPEXP_FWD_CORE wxAppProgressIndicator;
+class wxProgressSource;
+
+#if wxUSE_TIMER
+class WXDLLIMPEXP_FWD_BASE wxTimer;
+class WXDLLIMPEXP_FWD_BASE wxTimerEvent;
+#endif // wxUSE_TIMER
 
 // ----------------------------------------------------------------------------
 // wxGauge: a progress bar
@@ -55,6 +61,10 @@ public:
 #if wxGAUGE_EMULATE_INDETERMINATE_MODE
         m_nDirection(wxRIGHT),
 #endif
+#if wxUSE_TIMER
+        m_progressSource(NULL),
+        m_progressTimer(NULL),
+#endif // wxUSE_TIMER
         m_appProgressIndicator(NULL) { }
 
     virtual ~wxGaugeBase();
@@ -80,6 +90,13 @@ public:
     // indeterminate mode API
     virtual void Pulse();
 
+#if wxUSE_TIMER
+    // update the value from the given source, which may be changed by another
+    // thread, every interval milliseconds; pass NULL to stop doing it
+    void SetProgressSource(wxProgressSource *source, int interval = 50);
+    wxProgressSource *GetProgressSource() const { return m_progressSource; }
+#endif // wxUSE_TIMER
+
     // simple accessors
     bool IsVertical() const { return HasFlag(wxGA_VERTICAL); }
 
@@ -119,8 +136,19 @@ protected:
     int m_nDirection;       // can be wxRIGHT or wxLEFT
 #endif
 
+#if wxUSE_TIMER
+    // the source of the progress value and the timer used for sampling it
+    wxProgressSource *m_progressSource;
+    wxTimer *m_progressTimer;
+#endif // wxUSE_TIMER
+
     wxAppProgressIndicator *m_appProgressIndicator;
 
+private:
+#if wxUSE_TIMER
+    void OnProgressTimer(wxTimerEvent& event);
+#endif // wxUSE_TIMER
+
     wxDECLARE_NO_COPY_CLASS(wxGaugeBase);
 };
 
@@ -19,6 +19,7 @@
 #include "wx/dialog.h"
 #include "wx/module.h"
 #include "wx/cmndata.h"
+#include "wx/hashmap.h"
 #include "wx/strvararg.h"
 
 //-----------------------------------------------------------------------------
@@ -34,6 +35,11 @@ public:
     // Recommended constructor
     wxPostScriptDC(const wxPrintData& printData);
 
+    // Set the PostScript language level, from 1 to 3, used by the output,
+    // this must be done before calling StartDoc()
+    void SetLanguageLevel(int level);
+    int GetLanguageLevel() const;
+
 private:
     wxDECLARE_DYNAMIC_CLASS(wxPostScriptDC);
 };
@@ -78,6 +84,15 @@ public:
 
     virtual void ComputeScaleAndOrigin() wxOVERRIDE;
 
+    void SetLanguageLevel(int level)
+    {
+        wxCHECK_RET( level >= 1 && level <= 3, "invalid language level" );
+
+        m_languageLevel = level;
+    }
+
+    int GetLanguageLevel() const { return m_languageLevel; }
+
     void SetBackgroundMode(int WXUNUSED(mode)) wxOVERRIDE { }
 #if wxUSE_PALETTE
     void SetPalette(const wxPalette& WXUNUSED(palette)) wxOVERRIDE { }
@@ -145,6 +160,15 @@ protected:
     void SetPSFont();
     // Set PostScript color
     void SetPSColour(const wxColour& col);
+    // Output raw data, without any conversion
+    void PsWrite(const char* data, size_t len);
+    // Output the image data encoded as required by the image procedures
+    void PsWriteImageData(const wxImage& image);
+    // Return the name of the filter used for decoding the image data
+    const char* GetImageDataFilter() const;
+    // Draw the image using only PostScript Level 1 operators
+    void DoDrawImageLevel1(const wxImage& image,
+                           double xx, double yy, double ww, double hh);
 
     FILE*             m_pstream;    // PostScript output stream
     unsigned char     m_currentRed;
@@ -159,6 +183,16 @@ protected:
     wxArrayString     m_definedPSFonts;
     bool              m_isFontChanged;
 
+    // The images already drawn, indexed by the key identifying their contents.
+    // The value is the index of the reusable PostScript stream defined for the
+    // image data or -1 if it was drawn only once and so it wasn't defined yet.
+    WX_DECLARE_STRING_HASH_MAP(int, ImageIndices);
+    ImageIndices      m_drawnImages;
+    int               m_numDefinedImages;
+
+    // The PostScript language level which can be used by the output.
+    int               m_languageLevel;
+
 private:
     wxDECLARE_DYNAMIC_CLASS(wxPostScriptDCImpl);
 };
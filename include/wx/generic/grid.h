@@ -18,6 +18,7 @@
 #include "wx/hashmap.h"
 
 #include "wx/scrolwin.h"
+#include "wx/vector.h"
 
 #if wxUSE_STD_CONTAINERS_COMPATIBLY
     #include <iterator>
@@ -115,6 +116,7 @@ class WXDLLIMPEXP_FWD_CORE wxDatePickerCtrl;
 #endif
 
 class wxGridFixedIndicesSet;
+class wxGridTextExtentCache;
 
 class wxGridOperations;
 class wxGridRowOperations;
@@ -1430,6 +1432,15 @@ public:
                          const wxArrayString& lines,
                          long *width, long *height ) const;
 
+    // Return the extent of a single line of text drawn with the current font
+    // of the given DC, using the text extent cache if it's enabled.
+    wxSize GetCellTextExtent( const wxDC& dc, const wxString& text ) const;
+
+    // Enable or disable caching the extents of the text drawn in the cells.
+    void EnableTextExtentCache(bool enable = true);
+    bool IsTextExtentCacheEnabled() const { return m_textExtentCache != NULL; }
+    void ClearTextExtentCache();
+
     // If bottomRight is invalid, i.e. == wxGridNoCellCoords, it defaults to
     // topLeft. If topLeft itself is invalid, the function simply returns.
     void RefreshBlock(const wxGridCellCoords& topLeft,
@@ -1459,6 +1470,19 @@ public:
     //
     void     ForceRefresh();
 
+    // Mark the given cells as changed: all the cells marked as changed are
+    // repainted together during the next idle time, which is much cheaper
+    // than refreshing them one by one if many cells change frequently.
+    void MarkCellChanged(int row, int col)
+        { m_changedCells.push_back(wxGridCellCoords(row, col)); }
+    void MarkCellChanged(const wxGridCellCoords& coords)
+        { m_changedCells.push_back(coords); }
+    void MarkCellsChanged(const wxGridCellCoordsArray& cells);
+
+    // Refresh all the cells marked as changed immediately, this only needs to
+    // be called if the changes must be shown before the next idle time.
+    void RefreshChangedCells();
+
 
     // ------ edit control functions
     //
@@ -2468,6 +2492,12 @@ protected:
     bool m_inOnKeyDown;
     int  m_batchCount;
 
+    // the cells marked as changed since the last RefreshChangedCells() call
+    wxVector<wxGridCellCoords> m_changedCells;
+
+    // the cache of the text extents, NULL if disabled
+    wxGridTextExtentCache *m_textExtentCache;
+
 
     wxGridTypeRegistry*    m_typeRegistry;
 
@@ -2590,6 +2620,7 @@ protected:
     void OnKeyUp( wxKeyEvent& );
     void OnChar( wxKeyEvent& );
     void OnHideEditor( wxCommandEvent& );
+    void OnIdle( wxIdleEvent& );
 
 
     bool SetCurrentCell( const wxGridCellCoords& coords );
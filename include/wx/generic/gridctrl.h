@@ -51,6 +51,12 @@ protected:
     wxSize DoGetBestSize(const wxGridCellAttr& attr,
                          wxDC& dc,
                          const wxString& text);
+
+    // same as above, but uses the grid text extents cache if enabled
+    wxSize DoGetBestSize(const wxGrid& grid,
+                         const wxGridCellAttr& attr,
+                         wxDC& dc,
+                         const wxString& text);
 };
 
 // the default renderer for the cells containing numeric (long) data
@@ -289,7 +295,8 @@ private:
     // Break a single logical line of text into several physical lines, all of
     // which are added to the lines array. The lines are broken at maxWidth and
     // the dc is used for measuring text extent only.
-    void BreakLine(wxDC& dc,
+    void BreakLine(const wxGrid& grid,
+                   wxDC& dc,
                    const wxString& logicalLine,
                    wxCoord maxWidth,
                    wxArrayString& lines);
@@ -299,7 +306,8 @@ private:
     // is returned in line output parameter.
     //
     // Returns the width of the last line.
-    wxCoord BreakWord(wxDC& dc,
+    wxCoord BreakWord(const wxGrid& grid,
+                      wxDC& dc,
                       const wxString& word,
                       wxCoord maxWidth,
                       wxArrayString& lines,
@@ -13,6 +13,7 @@
 #include "wx/containr.h"
 #include "wx/scrolwin.h"
 #include "wx/textctrl.h"
+#include "wx/vector.h"
 
 #if wxUSE_DRAG_AND_DROP
 class WXDLLIMPEXP_FWD_CORE wxDropTarget;
@@ -25,6 +26,35 @@ class WXDLLIMPEXP_FWD_CORE wxDropTarget;
 class WXDLLIMPEXP_FWD_CORE wxListHeaderWindow;
 class WXDLLIMPEXP_FWD_CORE wxListMainWindow;
 
+//-----------------------------------------------------------------------------
+// wxListSortKey: column and flags used by SortItemsByColumns()
+//-----------------------------------------------------------------------------
+
+// flags for wxListSortKey
+enum
+{
+    wxLIST_SORT_DESCENDING = 0x0001,    // sort in descending order
+    wxLIST_SORT_NOCASE     = 0x0002,    // ignore case when comparing
+    wxLIST_SORT_NATURAL    = 0x0004,    // compare embedded numbers as numbers
+    wxLIST_SORT_NUMERIC    = 0x0008     // compare the whole text as a number
+};
+
+class wxListSortKey
+{
+public:
+    wxListSortKey(int column = 0, int flags = 0)
+        : m_column(column), m_flags(flags)
+    {
+    }
+
+    int GetColumn() const { return m_column; }
+    int GetFlags() const { return m_flags; }
+
+private:
+    int m_column;
+    int m_flags;
+};
+
 //-----------------------------------------------------------------------------
 // wxListCtrl
 //-----------------------------------------------------------------------------
@@ -146,6 +176,11 @@ public:
     bool ScrollList( int dx, int dy );
     bool SortItems( wxListCtrlCompare fn, wxIntPtr data );
 
+    // sort the items using their text in the given column(s), this preserves
+    // the selection and the current item
+    bool SortItemsByColumn( int col, int flags = 0 );
+    bool SortItemsByColumns( const wxVector<wxListSortKey>& keys );
+
     // do we have a header window?
     bool HasHeader() const
         { return InReportView() && !HasFlag(wxLC_NO_HEADER); }
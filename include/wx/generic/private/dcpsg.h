@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/generic/private/dcpsg.h
+// Purpose:     Helpers for encoding the data output by wxPostScriptDC
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_GENERIC_PRIVATE_DCPSG_H_
+#define _WX_GENERIC_PRIVATE_DCPSG_H_
+
+#include "wx/buffer.h"
+#include "wx/utils.h"
+
+// The encoded data is split in lines of this length when it's written out.
+#define wxPOSTSCRIPT_DATA_LINE_LENGTH 76
+
+// Encode the data in the format used by RunLengthDecode filter, including the
+// EOD marker.
+//
+// Each run is either a literal sequence of up to 128 bytes, preceded by its
+// length minus 1, or a single byte repeated up to 128 times, preceded by 257
+// minus the number of repetitions.
+inline void
+wxPostScriptEncodeRunLength(const unsigned char* data, size_t len,
+                            wxMemoryBuffer& out)
+{
+    const unsigned char* const end = data + len;
+    while ( data != end )
+    {
+        size_t run = 1;
+        while ( data + run != end && run < 128 && data[run] == *data )
+            run++;
+
+        if ( run > 1 )
+        {
+            out.AppendByte(static_cast<char>(257 - run));
+            out.AppendByte(static_cast<char>(*data));
+            data += run;
+            continue;
+        }
+
+        // Look for the end of the literal sequence: it ends where a run of at
+        // least 2 identical bytes starts.
+        size_t count = 1;
+        while ( data + count != end && count < 128 &&
+                    !(data + count + 1 != end && data[count] == data[count + 1]) )
+            count++;
+
+        out.AppendByte(static_cast<char>(count - 1));
+        out.AppendData(data, count);
+        data += count;
+    }
+
+    out.AppendByte(static_cast<char>(128)); // EOD
+}
+
+// Encode the data using ASCII85 encoding, including the "~>" EOD marker.
+inline void
+wxPostScriptEncodeASCII85(const unsigned char* data, size_t len,
+                          wxMemoryBuffer& out)
+{
+    size_t lineLen = 0;
+    for ( size_t n = 0; n < len; n += 4 )
+    {
+        const size_t count = wxMin(len - n, size_t(4));
+
+        wxUint32 value = 0;
+        for ( size_t i = 0; i < 4; i++ )
+            value = (value << 8) | (i < count ? data[n + i] : 0);
+
+        if ( !value && count == 4 )
+        {
+            out.AppendByte('z');
+            lineLen++;
+        }
+        else
+        {
+            char chars[5];
+            for ( int i = 4; i >= 0; i-- )
+            {
+                chars[i] = static_cast<char>('!' + value % 85);
+                value /= 85;
+            }
+
+            // Partial group of N bytes is written as N + 1 characters.
+            out.AppendData(chars, count + 1);
+            lineLen += count + 1;
+        }
+
+        if ( lineLen >= wxPOSTSCRIPT_DATA_LINE_LENGTH )
+        {
+            out.AppendByte('\n');
+            lineLen = 0;
+        }
+    }
+
+    out.AppendData("~>\n", 3);
+}
+
+#endif // _WX_GENERIC_PRIVATE_DCPSG_H_
@@ -1031,6 +1031,74 @@ private:
     wxGridDataTypeInfoArray m_typeinfo;
 };
 
+// ----------------------------------------------------------------------------
+// wxGridTextExtentCache: cache of the text extents used by wxGrid
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_ADV wxGridTextExtentCache
+{
+public:
+    wxGridTextExtentCache();
+
+    // This ctor allows to use a different maximal number of the cached
+    // entries than the default one and is only used for testing.
+    explicit wxGridTextExtentCache(size_t maxEntries);
+
+    ~wxGridTextExtentCache() { Clear(); }
+
+    // Return the extent of the text using the current font of the DC, either
+    // from the cache or by measuring it and adding it to the cache.
+    wxSize GetTextExtent(const wxDC& dc, const wxString& text);
+
+    void Clear();
+
+    // Return the total number of the cached extents, only used for testing.
+    size_t GetNumEntries() const { return m_numEntries; }
+
+private:
+    WX_DECLARE_STRING_HASH_MAP(wxSize, TextExtents);
+
+    // the extents of the strings using the given font
+    struct FontExtents
+    {
+        explicit FontExtents(const wxFont& font_) : font(font_) { }
+
+        const wxFont font;
+        TextExtents extents;
+    };
+
+    wxVector<FontExtents*> m_fonts;
+
+    // index of the font used by the last lookup in m_fonts, checked first
+    size_t m_lastFont;
+
+    // the resolution of the DC used for measuring the cached extents
+    wxSize m_ppi;
+
+    // the total number of the entries in all m_fonts elements and the number
+    // of them at which the cache is cleared
+    size_t m_numEntries;
+    const size_t m_maxEntries;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridTextExtentCache);
+};
+
+// ----------------------------------------------------------------------------
+// helpers for wxGrid::RefreshChangedCells()
+// ----------------------------------------------------------------------------
+
+// Combine the given changed cells of the grid into rectangular blocks: the
+// adjacent cells in each row are combined into runs and the identical runs in
+// consecutive rows into blocks. The cells may be given in any order and may
+// contain duplicates, while the cells outside of the grid are ignored.
+//
+// Notice that the columns of the returned blocks are column positions and not
+// indices, as the cells of a block are adjacent on screen and not necessarily
+// in the grid itself if its columns are reordered.
+WXDLLIMPEXP_ADV wxVector<wxGridBlockCoords>
+wxGridCombineChangedCells(const wxGrid& grid,
+                          const wxVector<wxGridCellCoords>& cells);
+
 // Returns the rectangle for showing something of the given size in a cell with
 // the given alignment.
 //
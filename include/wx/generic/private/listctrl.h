@@ -702,6 +702,7 @@ public:
     long InsertColumn( long col, const wxListItem &item );
     int GetItemWidthWithImage(wxListItem * item);
     void SortItems( wxListCtrlCompare fn, wxIntPtr data );
+    bool SortItemsByColumns( const wxVector<wxListSortKey>& keys );
 
     size_t GetItemCount() const;
     bool IsEmpty() const { return GetItemCount() == 0; }
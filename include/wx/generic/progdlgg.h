@@ -19,6 +19,12 @@ class WXDLLIMPEXP_FWD_CORE wxEventLoop;
 class WXDLLIMPEXP_FWD_CORE wxGauge;
 class WXDLLIMPEXP_FWD_CORE wxStaticText;
 class WXDLLIMPEXP_FWD_CORE wxWindowDisabler;
+class wxProgressSource;
+
+#if wxUSE_TIMER
+class WXDLLIMPEXP_FWD_BASE wxTimer;
+class WXDLLIMPEXP_FWD_BASE wxTimerEvent;
+#endif // wxUSE_TIMER
 
 /*
     Progress dialog which shows a moving progress bar.
@@ -57,6 +63,14 @@ public:
     virtual bool WasCancelled() const;
     virtual bool WasSkipped() const;
 
+#if wxUSE_TIMER
+    // Periodically update the dialog using the value and message of the given
+    // source, which can be changed by another thread, instead of requiring
+    // Update() calls. Pass NULL to stop doing it.
+    void SetProgressSource(wxProgressSource *source, int interval = 50);
+    wxProgressSource *GetProgressSource() const { return m_progressSource; }
+#endif // wxUSE_TIMER
+
     // Must provide overload to avoid hiding it (and warnings about it)
     virtual void Update() wxOVERRIDE { wxDialog::Update(); }
 
@@ -151,6 +165,14 @@ protected:
     // time between the moment the dialog was closed/cancelled and resume
     unsigned long m_break;
 
+#if wxUSE_TIMER
+    // The source set by SetProgressSource(), the timer used for sampling it
+    // and the last value taken from it.
+    wxProgressSource *m_progressSource;
+    wxTimer *m_progressTimer;
+    int m_progressSourceValue;
+#endif // wxUSE_TIMER
+
 private:
     // update the label to show the given time (in seconds)
     static void SetTimeLabel(unsigned long val, wxStaticText *label);
@@ -171,6 +193,11 @@ private:
     // common part of Update() and Pulse()
     void DoAfterUpdate();
 
+#if wxUSE_TIMER
+    // samples m_progressSource
+    void OnProgressTimer(wxTimerEvent& event);
+#endif // wxUSE_TIMER
+
     // shortcuts for enabling buttons
     void EnableClose();
     void EnableSkip(bool enable = true);
@@ -224,7 +251,6 @@ private:
     // currently active loop when it is created.
     wxEventLoop *m_tempEventLoop;
 
-
     wxDECLARE_EVENT_TABLE();
     wxDECLARE_NO_COPY_CLASS(wxGenericProgressDialog);
 };
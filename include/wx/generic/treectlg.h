@@ -15,6 +15,7 @@
 
 #include "wx/scrolwin.h"
 #include "wx/pen.h"
+#include "wx/vector.h"
 
 // -----------------------------------------------------------------------------
 // forward declaration
@@ -277,6 +278,10 @@ protected:
 
     bool                 m_dropEffectAboveItem;
 
+    // the biggest width of the items shown so far, only used in virtual mode
+    // as the width of all items is unknown in it
+    int                  m_virtualWidth;
+
     // the common part of all ctors
     void Init();
 
@@ -350,6 +355,41 @@ protected:
 
     virtual wxSize DoGetBestSize() const wxOVERRIDE;
 
+    // these functions must be overridden in the derived class to provide the
+    // items of a control with wxTR_VIRTUAL style: the number of children of
+    // the given item and the text, image and data of the n-th child of the
+    // given parent
+    virtual size_t OnGetChildrenCount(const wxTreeItemId& item) const;
+    virtual wxString OnGetItemText(const wxTreeItemId& parent, size_t n) const;
+    virtual int OnGetItemImage(const wxTreeItemId& parent, size_t n) const;
+    virtual wxTreeItemData *OnGetItemData(const wxTreeItemId& parent,
+                                          size_t n) const;
+
+    // virtual mode helpers
+    bool IsVirtual() const { return HasFlag(wxTR_VIRTUAL); }
+
+    // create the placeholders for the children of the given item if it
+    // doesn't have any yet
+    void LoadVirtualChildren(wxGenericTreeItem *item);
+
+    // return the n-th child of the given item, creating it if necessary
+    wxGenericTreeItem *DoGetChild(wxGenericTreeItem *parent, size_t n) const;
+
+    // return the row of the item, the root is always at row 0, even if hidden
+    unsigned int GetVirtualRow(wxGenericTreeItem *item) const;
+
+    // return the item at the given row or NULL, also return the indices of
+    // all its ancestors in their parents in the path if it's non-NULL
+    wxGenericTreeItem *GetVirtualItemAtRow(unsigned int row,
+                                           wxVector<size_t> *path = NULL) const;
+
+    // set the position and size of the item, this only needs to be done in
+    // virtual mode as CalculatePositions() does it for all items otherwise
+    void CalculateItemPosition(wxGenericTreeItem *item) const;
+
+    void PaintVirtualRows(wxDC& dc);
+    void PaintRow(wxGenericTreeItem *item, wxDC& dc, int x, int y_top);
+
 private:
     // Reset the state of the last find (i.e. keyboard incremental search)
     // operation.
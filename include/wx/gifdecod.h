@@ -52,7 +52,9 @@ public:
     wxGIFDecoder();
     ~wxGIFDecoder();
 
-    // get data of current frame
+    // get data of current frame, decoding it if necessary: notice that only a
+    // few frames are kept decoded at any moment, so the returned pointer is
+    // only valid until the data of another frame is retrieved
     unsigned char* GetData(unsigned int frame) const;
     unsigned char* GetPalette(unsigned int frame) const;
     unsigned int GetNcolours(unsigned int frame) const;
@@ -91,20 +93,19 @@ protected:
         // modifies current stream position (see wxAnimationDecoder::CanRead)
 
 private:
-    int getcode(wxInputStream& stream, int bits, int abfin);
-    wxGIFErrorCode dgif(wxInputStream& stream,
-                        GIFImage *img, int interl, int bits);
+    // decode the frame data if it's not decoded yet
+    wxGIFErrorCode DecodeFrame(unsigned int frame) const;
+
+    // decode the compressed data of the image into its bitmap
+    static wxGIFErrorCode dgif(GIFImage *img);
 
 
     // array of all frames
     wxArrayPtrVoid m_frames;
 
-    // decoder state vars
-    int           m_restbits;       // remaining valid bits
-    unsigned int  m_restbyte;       // remaining bytes in this block
-    unsigned int  m_lastbyte;       // last byte read
-    unsigned char m_buffer[256];    // buffer for reading
-    unsigned char *m_bufp;          // pointer to next byte in buffer
+    // indices of the frames whose data is currently decoded, the most
+    // recently used one is the last
+    mutable wxArrayInt m_decodedFrames;
 
     wxDECLARE_NO_COPY_CLASS(wxGIFDecoder);
 };
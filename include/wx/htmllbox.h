@@ -73,6 +73,11 @@ public:
     virtual void RefreshAll() wxOVERRIDE;
     virtual void SetItemCount(size_t count) wxOVERRIDE;
 
+    // set the maximal number of items whose parsed representation is cached
+    // and the maximal amount of memory which may be used by them (0 meaning
+    // that it is unlimited)
+    void SetCacheSize(size_t maxItems, size_t maxBytes = 0);
+
 #if wxUSE_FILESYSTEM
     // retrieve the file system used by the wxHtmlWinParser: if you use
     // relative paths in your HTML, you should use its ChangePathTo() method
@@ -129,6 +134,9 @@ protected:
     // ensure that the given item is cached
     void CacheItem(size_t n) const;
 
+    // cache one of the items around the visible ones, if not done yet
+    void PrefetchItems();
+
 private:
     // wxHtmlWindowInterface methods:
     virtual void SetHTMLWindowTitle(const wxString& title) wxOVERRIDE;
@@ -151,6 +159,9 @@ private:
     // Create the cell for the given item, caller is responsible for freeing it.
     wxHtmlCell* CreateCellForItem(size_t n) const;
 
+    // return the width used for laying out the cells
+    int GetCellsWidth() const;
+
     // return physical coordinates of root wxHtmlCell of n-th item
     wxPoint GetRootCellCoords(size_t n) const;
 
@@ -169,6 +180,9 @@ private:
     // this class caches the pre-parsed HTML to speed up display
     wxHtmlListBoxCache *m_cache;
 
+    // the width of the cells in the cache
+    int m_cacheWidth;
+
     // HTML parser we use
     wxHtmlWinParser *m_htmlParser;
 
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/image.h
+// Purpose:     wxImageDownscaler helper used by the image handlers
+// Author:      wxWidgets Team
+// Created:     2020-03-09
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_IMAGE_H_
+#define _WX_PRIVATE_IMAGE_H_
+
+#include "wx/image.h"
+#include "wx/vector.h"
+
+#if wxUSE_IMAGE
+
+// ----------------------------------------------------------------------------
+// wxImageDownscaler: scales down the image while it's being decoded.
+// ----------------------------------------------------------------------------
+
+// This class allows the image handlers to support wxIMAGE_OPTION_MAX_WIDTH and
+// wxIMAGE_OPTION_MAX_HEIGHT options without having to decode the entire image
+// at full size first. The handler fills the source rows, in any monotonic
+// order, into the buffers provided by this class and calls AddRow() for each
+// of them. The rows are then averaged in exactly the same way as done by
+// wxImage::Rescale() with wxIMAGE_QUALITY_BOX_AVERAGE, so the result is the
+// same as if the entire image were loaded and then scaled down.
+class wxImageDownscaler
+{
+public:
+    // Return the size that the image of the given size should be scaled to, in
+    // order to satisfy the max size options, using the same algorithm as
+    // wxImage::LoadFile() itself. Returns the size unchanged if no scaling is
+    // needed.
+    static wxSize GetScaledSize(int width, int height,
+                                unsigned maxWidth, unsigned maxHeight);
+
+    // Create the object scaling the image of the given size into the image,
+    // which must be already created with the smaller destination size and
+    // have alpha if hasAlpha is true.
+    wxImageDownscaler(wxImage* image, int width, int height, bool hasAlpha);
+
+    // Must be called before adding any rows by the handlers which discard the
+    // alpha channel after loading the image if it contains only zeroes, as
+    // the BMP one does. The colours are not weighted by alpha then until the
+    // first non-zero alpha value is found, so that they are still correct if
+    // the alpha channel is discarded.
+    void IgnoreZeroAlpha();
+
+    // Buffers for the RGB data and alpha of the source row to add. The alpha
+    // buffer is only non-NULL if hasAlpha was true in the ctor.
+    unsigned char* GetRowData() { return &m_rowData[0]; }
+    unsigned char* GetRowAlpha() { return m_hasAlpha ? &m_rowAlpha[0] : NULL; }
+
+    // Add the data of the source row with the given index from the buffers.
+    void AddRow(int y);
+
+    // Must be called after adding all the rows to write the last of them.
+    void Finish();
+
+    // Helper setting the original size options of the image after loading
+    // it, if it has been scaled.
+    static void SetOriginalSize(wxImage* image, int width, int height);
+
+private:
+    struct Box
+    {
+        int start;
+        int end;
+    };
+
+    // The accumulated values for one of the destination rows.
+    struct Row
+    {
+        int y;                      // the index of this row or -1
+        wxVector<double> sums;      // 3 or 4 values per destination pixel
+    };
+
+    void FlushRow(Row& row);
+
+    // Called when the first non-zero alpha value is found after calling
+    // IgnoreZeroAlpha() to switch to weighting the colours by alpha.
+    void StartWeightingByAlpha();
+
+
+    wxImage* const m_image;
+
+    const int m_srcWidth;
+    const bool m_hasAlpha;
+
+    // True if the colours are weighted by alpha, which is always the case if
+    // we have it unless IgnoreZeroAlpha() was called and all alpha values
+    // seen so far were zero.
+    bool m_weightByAlpha;
+
+    // Number of accumulated values per destination pixel.
+    const int m_numSums;
+
+    wxVector<Box> m_hBoxes,
+                  m_vBoxes;
+
+    wxVector<unsigned char> m_rowData,
+                            m_rowAlpha;
+
+    // The source rows can contribute to two adjacent destination rows, so we
+    // need to accumulate the values for both of them.
+    Row m_rows[2];
+
+    wxDECLARE_NO_COPY_CLASS(wxImageDownscaler);
+};
+
+#endif // wxUSE_IMAGE
+
+#endif // _WX_PRIVATE_IMAGE_H_
@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/private/parallelsort.h
+// Purpose:     wxParallelSort() helper sorting using wxThreadPool
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PRIVATE_PARALLELSORT_H_
+#define _WX_PRIVATE_PARALLELSORT_H_
+
+#include "wx/utils.h"
+
+#if wxUSE_THREADS
+    #include "wx/threadpool.h"
+#endif // wxUSE_THREADS
+
+#include <algorithm>
+
+// Don't bother sorting in parallel if there are fewer elements than this.
+#define wxPARALLEL_SORT_MIN_COUNT 50000
+
+#if wxUSE_THREADS
+
+namespace wxPrivate
+{
+
+// Functors executed by the thread pool for sorting in parallel.
+template <typename RandomIt, typename Compare>
+class ParallelSortTask
+{
+public:
+    ParallelSortTask(RandomIt first, RandomIt last, const Compare& cmp)
+        : m_first(first), m_last(last), m_cmp(cmp)
+    {
+    }
+
+    void operator()() const { std::sort(m_first, m_last, m_cmp); }
+
+private:
+    RandomIt m_first,
+             m_last;
+    Compare m_cmp;
+};
+
+template <typename RandomIt, typename Compare>
+class ParallelMergeTask
+{
+public:
+    ParallelMergeTask(RandomIt first, RandomIt middle, RandomIt last,
+                      const Compare& cmp)
+        : m_first(first), m_middle(middle), m_last(last), m_cmp(cmp)
+    {
+    }
+
+    void operator()() const
+        { std::inplace_merge(m_first, m_middle, m_last, m_cmp); }
+
+private:
+    RandomIt m_first,
+             m_middle,
+             m_last;
+    Compare m_cmp;
+};
+
+} // namespace wxPrivate
+
+#endif // wxUSE_THREADS
+
+// Sort the elements in the given range, in the same way as std::sort() does
+// it, but using all the threads of wxThreadPool if there are many of them.
+//
+// The range is split into chunks, one per thread, which are sorted in parallel
+// and then merged, also in parallel, pairwise. Notice that the comparator is
+// called from the other threads, so it must not use any GUI functions nor any
+// other non thread-safe objects.
+template <typename RandomIt, typename Compare>
+void wxParallelSort(RandomIt first, RandomIt last, const Compare& cmp)
+{
+#if wxUSE_THREADS
+    const size_t count = last - first;
+
+    size_t numChunks = wxThreadPool::Get().GetThreadCount();
+    if ( count >= wxPARALLEL_SORT_MIN_COUNT && numChunks > 1 )
+    {
+        const size_t chunkSize = (count + numChunks - 1) / numChunks;
+        numChunks = (count + chunkSize - 1) / chunkSize;
+
+        {
+            wxTaskGroup group;
+            for ( size_t n = 0; n < numChunks; n++ )
+            {
+                const size_t start = n*chunkSize;
+                group.Run(wxPrivate::ParallelSortTask<RandomIt, Compare>
+                          (
+                            first + start,
+                            first + wxMin(start + chunkSize, count),
+                            cmp
+                          ));
+            }
+        }
+
+        for ( size_t width = chunkSize; width < count; width *= 2 )
+        {
+            wxTaskGroup group;
+            for ( size_t start = 0; start + width < count; start += 2*width )
+            {
+                group.Run(wxPrivate::ParallelMergeTask<RandomIt, Compare>
+                          (
+                            first + start,
+                            first + start + width,
+                            first + wxMin(start + 2*width, count),
+                            cmp
+                          ));
+            }
+        }
+
+        return;
+    }
+#endif // wxUSE_THREADS
+
+    std::sort(first, last, cmp);
+}
+
+#endif // _WX_PRIVATE_PARALLELSORT_H_
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/progsrc.h
+// Purpose:     wxProgressSource class for reporting progress from any thread
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PROGSRC_H_
+#define _WX_PROGSRC_H_
+
+#include "wx/atomic.h"
+#include "wx/string.h"
+#include "wx/thread.h"
+
+// ----------------------------------------------------------------------------
+// wxProgressSource: progress value updated by a worker and sampled by the GUI
+// ----------------------------------------------------------------------------
+
+// Unlike wxProgressDialog::Update() or wxGauge::SetValue(), which can only be
+// called from the main thread and update the display every time, the methods
+// of this class changing the progress can be called from any thread and just
+// store the new value, without any locking when atomic operations are
+// available. The value is periodically read by the main thread, see
+// wxProgressDialog::SetProgressSource() and wxGauge::SetProgressSource(), so
+// any number of updates done in between results in at most one redraw.
+class wxProgressSource
+{
+public:
+    wxProgressSource()
+        : m_value(0),
+          m_cancelled(0),
+          m_messageChanged(false)
+    {
+    }
+
+    // Methods which can be called from any thread.
+
+    // Set the current progress value.
+    void SetValue(int value) { Store(m_value, value); }
+
+    // Increment the current progress value by one.
+    void Advance() { wxAtomicInc(m_value); }
+
+    // Change the message shown by the progress dialog. This is more expensive
+    // than changing the value and so shouldn't be done too often.
+    void SetMessage(const wxString& message)
+    {
+        wxCriticalSectionLocker lock(m_csMessage);
+
+        // Make a deep copy, the string is going to be used by another thread.
+        m_message = message.Clone();
+        m_messageChanged = true;
+    }
+
+    // Return true if the operation was cancelled: the worker should check
+    // this from time to time and stop as soon as possible if it returns true.
+    bool IsCancelled() const { return Load(m_cancelled) != 0; }
+
+    // Request cancelling the operation.
+    void Cancel() { Store(m_cancelled, 1); }
+
+
+    // Methods used by the main thread for sampling the progress.
+
+    // Return the last value set.
+    int GetValue() const { return Load(m_value); }
+
+    // Return true and fill the provided string with the new message if it was
+    // changed since the last call to this function.
+    bool GetNewMessage(wxString& message)
+    {
+        wxCriticalSectionLocker lock(m_csMessage);
+
+        if ( !m_messageChanged )
+            return false;
+
+        message = m_message.Clone();
+        m_messageChanged = false;
+
+        return true;
+    }
+
+    // Reset the progress state to allow reusing the object.
+    void Reset()
+    {
+        Store(m_value, 0);
+        Store(m_cancelled, 0);
+
+        wxCriticalSectionLocker lock(m_csMessage);
+        m_message.clear();
+        m_messageChanged = false;
+    }
+
+private:
+    // Read or write a value shared between threads. With the native atomic
+    // operations wxAtomicInt is just a plain integer, so access it as volatile
+    // to ensure the compiler neither caches the values read in a register nor
+    // omits the stores. The generic wxAtomicInt already uses volatile.
+    static int Load(const wxAtomicInt& value)
+    {
+#ifdef wxHAS_ATOMIC_OPS
+        return *static_cast<const volatile wxAtomicInt*>(&value);
+#else
+        return value;
+#endif
+    }
+
+    static void Store(wxAtomicInt& value, int newValue)
+    {
+#ifdef wxHAS_ATOMIC_OPS
+        *static_cast<volatile wxAtomicInt*>(&value) = newValue;
+#else
+        value = newValue;
+#endif
+    }
+
+    wxAtomicInt m_value;
+    wxAtomicInt m_cancelled;
+
+    // The message is rarely changed, so just protect it with a lock.
+    wxCriticalSection m_csMessage;
+    wxString m_message;
+    bool m_messageChanged;
+
+    wxDECLARE_NO_COPY_CLASS(wxProgressSource);
+};
+
+#endif // _WX_PROGSRC_H_
@@ -1703,10 +1703,7 @@ public:
     // then it is forced to integer.
     void SetChoiceSelection( int newValue );
 
-    void SetExpanded( bool expanded )
-    {
-        ChangeFlag(wxPG_PROP_COLLAPSED, !expanded);
-    }
+    void SetExpanded( bool expanded );
 
     // Sets or clears given property flag. Mainly for internal use.
     // Setting a property flag never has any side-effect, and is
@@ -2029,6 +2026,9 @@ protected:
     // moved to it.
     void SubPropsChanged( int oldSelInd = -1 );
 
+    // Called when the children were added, removed or reordered.
+    void ChildrenChanged();
+
     int GetY2( int lh ) const;
 
     wxString                    m_label;
@@ -2065,6 +2065,10 @@ protected:
     // Index in parent's property array.
     unsigned int                m_arrIndex;
 
+    // Row in which this property was shown when the visible rows of its page
+    // were last calculated, see wxPropertyGridPageState::GetRowOfProperty().
+    unsigned int                m_rowIndex;
+
     // If not -1, then overrides m_value
     int                         m_commonValue;
 
@@ -351,6 +351,25 @@ public:
 
     wxPGProperty* DoGetItemAtY( int y ) const;
 
+    // Returns the number of visible rows, i.e. of the properties which are
+    // not hidden and whose parents are all expanded.
+    unsigned int GetVisibleRowCount() const
+    {
+        EnsureVisibleRows();
+        return (unsigned int) m_visibleRows.size();
+    }
+
+    // Returns the property shown in the given row or NULL if there is none.
+    wxPGProperty* GetPropertyAtRow( unsigned int row ) const
+    {
+        EnsureVisibleRows();
+        return row < m_visibleRows.size() ? m_visibleRows[row] : NULL;
+    }
+
+    // Returns the row in which the given property is shown or -1 if it is
+    // hidden or one of its parents is collapsed.
+    int GetRowOfProperty( const wxPGProperty* p ) const;
+
     // Override this member function to add custom behaviour on property
     // insertion.
     virtual wxPGProperty* DoInsert( wxPGProperty* parent,
@@ -529,10 +548,13 @@ public:
 
     bool PrepareAfterItemsAdded();
 
-    // Called after virtual height needs to be recalculated.
+    // Called after virtual height needs to be recalculated. This is also
+    // the case whenever the order or the visibility of the properties
+    // changes, so the visible rows index is invalidated too.
     void VirtualHeightChanged()
     {
         m_vhCalcPending = true;
+        m_visibleRowsPending = true;
     }
 
     // Base append.
@@ -592,6 +614,18 @@ protected:
     bool IsChildCategory(wxPGProperty* p,
                          wxPropertyCategory* cat, bool recursive);
 
+    // Rebuild m_visibleRows if it is out of date.
+    void EnsureVisibleRows() const
+    {
+        if ( m_visibleRowsPending )
+            RecalculateVisibleRows();
+    }
+
+    void RecalculateVisibleRows() const;
+
+    // Append visible children of the given property to m_visibleRows.
+    void DoAddVisibleRows( const wxPGProperty* parent ) const;
+
     // If visible, then this is pointer to wxPropertyGrid.
     // This shall *never* be NULL to indicate that this state is not visible.
     wxPropertyGrid*             m_pPropGrid;
@@ -659,6 +693,13 @@ protected:
     // Used to (temporarily) disable splitter centering.
     bool                        m_dontCenterSplitter;
 
+    // All visible properties in display order, allowing to find the property
+    // at the given y coordinate and vice versa without walking the tree.
+    mutable wxVector<wxPGProperty*> m_visibleRows;
+
+    // True if m_visibleRows needs to be rebuilt.
+    mutable bool                m_visibleRowsPending;
+
 private:
     // Only inits arrays, doesn't migrate things or such.
     void InitNonCatMode();
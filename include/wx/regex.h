@@ -16,6 +16,7 @@
 #if wxUSE_REGEX
 
 #include "wx/string.h"
+#include "wx/arrstr.h"
 
 // ----------------------------------------------------------------------------
 // constants
@@ -142,8 +143,30 @@ public:
     int ReplaceAll(wxString *text, const wxString& replacement) const
         { return Replace(text, replacement, 0); }
 
+    // check all the given strings against the expression, return the number
+    // of matching ones and, if indices is not NULL, fill it with their indices
+    //
+    // this is much faster than calling Matches() for each of the strings as
+    // it doesn't need to compute the positions of the matches, but notice
+    // that GetMatch() can't be used after calling it
+    //
+    // flags may be combination of wxRE_NOTBOL and wxRE_NOTEOL
+    size_t Filter(const wxArrayString& strings,
+                  wxArrayInt *indices = NULL,
+                  int flags = 0) const;
+    size_t Filter(const wxString *strings,
+                  size_t count,
+                  wxArrayInt *indices = NULL,
+                  int flags = 0) const;
+
     static wxString QuoteMeta(const wxString& str);
 
+    // the compiled expressions are cached and reused by all wxRegEx objects
+    // using the same pattern and flags, this sets the maximal number of them
+    // kept in the cache (0 disables caching)
+    static void SetCacheSize(size_t size);
+    static size_t GetCacheSize();
+
     // dtor not virtual, don't derive from this class
     ~wxRegEx();
 
@@ -12,9 +12,11 @@
 #define _WX_SELSTORE_H_
 
 #include "wx/dynarray.h"
+#include "wx/vector.h"
 
 // ----------------------------------------------------------------------------
-// wxSelectedIndices is just a sorted array of indices
+// wxSelectedIndices is just a sorted array of indices, it is not used by
+// wxSelectionStore any more but is still defined for compatibility
 // ----------------------------------------------------------------------------
 
 inline int CMPFUNC_CONV wxUIntCmp(unsigned n1, unsigned n2)
@@ -29,23 +31,23 @@ WX_DEFINE_SORTED_EXPORTED_ARRAY_CMP_INT(unsigned, wxUIntCmp, wxSelectedIndices);
 // controls, i.e. it is well suited for storing even when the control contains
 // a huge (practically infinite) number of items.
 //
-// Of course, internally it still has to store the selected items somehow (as
-// an array currently) but the advantage is that it can handle the selection
-// of all items (common operation) efficiently and that it could be made even
-// smarter in the future (e.g. store the selections as an array of ranges +
-// individual items) without changing its API.
+// Internally the items whose state differs from the default one are stored as
+// a sorted array of ranges, so that selecting a range of items, even a huge
+// one, only takes a single entry and checking whether an item is selected is
+// done using a binary search. The default state is used to handle the
+// selection of all items efficiently.
 // ----------------------------------------------------------------------------
 
 class WXDLLIMPEXP_CORE wxSelectionStore
 {
 public:
-    wxSelectionStore() : m_itemsSel(wxUIntCmp) { Init(); }
+    wxSelectionStore() { Init(); }
 
     // set the total number of items we handle
     void SetItemCount(unsigned count);
 
     // special case of SetItemCount(0)
-    void Clear() { m_itemsSel.Clear(); m_count = 0; m_defaultState = false; }
+    void Clear() { m_ranges.clear(); Init(); }
 
     // must be called when new items are inserted/added
     void OnItemsInserted(unsigned item, unsigned numItems);
@@ -78,15 +80,15 @@ public:
     // return true if no items are currently selected
     bool IsEmpty() const
     {
-        return m_defaultState ? m_itemsSel.size() == m_count
-                              : m_itemsSel.empty();
+        return m_defaultState ? m_numItemsSel == m_count
+                              : m_numItemsSel == 0;
     }
 
     // return the total number of selected items
     unsigned GetSelectedCount() const
     {
-        return m_defaultState ? m_count - m_itemsSel.GetCount()
-                              : m_itemsSel.GetCount();
+        return m_defaultState ? m_count - m_numItemsSel
+                              : m_numItemsSel;
     }
 
     // type of a "cookie" used to preserve the iteration state, this is an
@@ -103,8 +105,27 @@ public:
     unsigned GetNextSelectedItem(IterationState& cookie) const;
 
 private:
+    // half-open range [from, to) of items
+    struct Range
+    {
+        Range(unsigned from_ = 0, unsigned to_ = 0) : from(from_), to(to_) { }
+
+        unsigned from,
+                 to;
+    };
+
     // (re)init
-    void Init() { m_count = 0; m_defaultState = false; }
+    void Init() { m_count = 0; m_defaultState = false; m_numItemsSel = 0; }
+
+    // return the index of the first range ending at or after the given item,
+    // i.e. such that item <= to, or m_ranges.size() if there is none
+    size_t FindRangeEndingAfter(unsigned item) const;
+
+    // add the given range to, or remove it from, m_ranges, return the number
+    // of items which were added or removed and append (some of) them to
+    // itemsChanged if it's non-NULL
+    unsigned AddRange(unsigned from, unsigned to, wxArrayInt *itemsChanged);
+    unsigned RemoveRange(unsigned from, unsigned to, wxArrayInt *itemsChanged);
 
     // the total number of items we handle
     unsigned m_count;
@@ -114,11 +135,14 @@ private:
     // handle selection of all items efficiently
     bool m_defaultState;
 
-    // the array of items whose selection state is different from default
-    wxSelectedIndices m_itemsSel;
+    // the sorted ranges of items whose selection state is different from
+    // default, they never overlap nor are adjacent to each other
+    wxVector<Range> m_ranges;
+
+    // the total number of items in m_ranges
+    unsigned m_numItemsSel;
 
     wxDECLARE_NO_COPY_CLASS(wxSelectionStore);
 };
 
 #endif // _WX_SELSTORE_H_
-
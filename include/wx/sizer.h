@@ -338,6 +338,7 @@ public:
         if ( IsWindow() )
             m_window->SetMinSize(size);
         m_minSize = size;
+        InvalidateContainingSizer();
     }
     void SetMinSize( int x, int y )
         { SetMinSize(wxSize(x, y)); }
@@ -347,11 +348,11 @@ public:
     // if either of dimensions is zero, ratio is assumed to be 1
     // to avoid "divide by zero" errors
     void SetRatio(int width, int height)
-        { m_ratio = (width && height) ? ((float) width / (float) height) : 1; }
+        { SetRatio((width && height) ? ((float) width / (float) height) : 1); }
     void SetRatio(const wxSize& size)
         { SetRatio(size.x, size.y); }
     void SetRatio(float ratio)
-        { m_ratio = ratio; }
+        { m_ratio = ratio; InvalidateContainingSizer(); }
     float GetRatio() const
         { return m_ratio; }
 
@@ -367,15 +368,15 @@ public:
     bool IsSpacer() const { return m_kind == Item_Spacer; }
 
     void SetProportion( int proportion )
-        { m_proportion = proportion; }
+        { m_proportion = proportion; InvalidateContainingSizer(); }
     int GetProportion() const
         { return m_proportion; }
     void SetFlag( int flag )
-        { m_flag = flag; }
+        { m_flag = flag; InvalidateContainingSizer(); }
     int GetFlag() const
         { return m_flag; }
     void SetBorder( int border )
-        { m_border = border; }
+        { m_border = border; InvalidateContainingSizer(); }
     int GetBorder() const
         { return m_border; }
 
@@ -412,22 +413,30 @@ public:
     {
         Free();
         DoSetWindow(window);
+        InvalidateContainingSizer();
     }
 
     void AssignSizer(wxSizer *sizer)
     {
         Free();
         DoSetSizer(sizer);
+        InvalidateContainingSizer();
     }
 
     void AssignSpacer(const wxSize& size)
     {
         Free();
         DoSetSpacer(size);
+        InvalidateContainingSizer();
     }
 
     void AssignSpacer(int w, int h) { AssignSpacer(wxSize(w, h)); }
 
+    // set or get the sizer containing this item, this is done automatically
+    // when the item is added to a sizer
+    void SetContainingSizer(wxSizer *sizer);
+    wxSizer *GetContainingSizer() const { return m_containingSizer; }
+
 #if WXWIN_COMPATIBILITY_2_8
     // these functions do not free the old sizer/spacer and so can easily
     // provoke the memory leaks and so shouldn't be used, use Assign() instead
@@ -439,11 +448,15 @@ public:
 
 protected:
     // common part of several ctors
-    void Init() { m_userData = NULL; m_kind = Item_None; }
+    void Init() { m_userData = NULL; m_containingSizer = NULL; m_kind = Item_None; }
 
     // common part of ctors taking wxSizerFlags
     void Init(const wxSizerFlags& flags);
 
+    // invalidate the cached minimal size of the sizer containing this item,
+    // should be called whenever anything affecting the layout changes
+    void InvalidateContainingSizer();
+
     // free current contents
     void Free();
 
@@ -489,6 +502,9 @@ protected:
 
     wxObject    *m_userData;
 
+    // the sizer this item is in, may be NULL
+    wxSizer     *m_containingSizer;
+
 private:
     wxDECLARE_CLASS(wxSizerItem);
     wxDECLARE_NO_COPY_CLASS(wxSizerItem);
@@ -504,7 +520,13 @@ WX_DECLARE_EXPORTED_LIST( wxSizerItem, wxSizerItemList );
 class WXDLLIMPEXP_CORE wxSizer: public wxObject, public wxClientDataContainer
 {
 public:
-    wxSizer() { m_containingWindow = NULL; }
+    wxSizer()
+    {
+        m_containingWindow = NULL;
+        m_containingSizer = NULL;
+        m_minSizeCache = wxDefaultSize;
+        m_cacheMinSize = true;
+    }
     virtual ~wxSizer();
 
     // methods for adding elements to the sizer: there are Add/Insert/Prepend
@@ -600,6 +622,19 @@ public:
     void SetContainingWindow(wxWindow *window);
     wxWindow *GetContainingWindow() const { return m_containingWindow; }
 
+    // set (or unset if sizer is NULL) or get the sizer containing this one,
+    // this is done automatically when it is added to another sizer
+    void SetContainingSizer(wxSizer *sizer) { m_containingSizer = sizer; }
+    wxSizer *GetContainingSizer() const { return m_containingSizer; }
+
+    // Invalidate the cached minimal size of this sizer and of all sizers
+    // containing it, as well as the best size of the window using the
+    // outermost one. This is done automatically when the sizer items change
+    // or the best size or visibility of the windows in it changes, but must
+    // be called by the derived classes when anything else affecting their
+    // minimal size or layout is modified.
+    void InvalidateMinSize();
+
     virtual bool Remove( wxSizer *sizer );
     virtual bool Remove( int index );
 
@@ -650,7 +685,8 @@ public:
     wxPoint GetPosition() const
         { return m_position; }
 
-    // Calculate the minimal size or return m_minSize if bigger.
+    // Calculate the minimal size or return m_minSize if bigger. The result is
+    // cached until InvalidateMinSize() is called.
     wxSize GetMinSize();
 
     // These virtual functions are used by the layout algorithm: first
@@ -694,16 +730,7 @@ public:
     const wxSizerItemList& GetChildren() const
         { return m_children; }
 
-    void SetDimension(const wxPoint& pos, const wxSize& size)
-    {
-        m_position = pos;
-        m_size = size;
-        Layout();
-
-        // This call is required for wxWrapSizer to be able to calculate its
-        // minimal size correctly.
-        InformFirstDirection(wxHORIZONTAL, size.x, size.y);
-    }
+    void SetDimension(const wxPoint& pos, const wxSize& size);
     void SetDimension(int x, int y, int width, int height)
         { SetDimension(wxPoint(x, y), wxSize(width, height)); }
 
@@ -750,6 +777,18 @@ protected:
     // the window this sizer is used in, can be NULL
     wxWindow *m_containingWindow;
 
+    // the sizer containing this one, NULL for the top level sizer
+    wxSizer *m_containingSizer;
+
+    // the cached value returned by GetMinSize() or wxDefaultSize if it needs
+    // to be recalculated
+    wxSize m_minSizeCache;
+
+    // false if the minimal size of this sizer depends on its current size or
+    // on the previous layouts and so can't be cached, this also prevents the
+    // sizers containing it from caching their minimal sizes
+    bool m_cacheMinSize;
+
     wxSize GetMaxClientSize( wxWindow *window ) const;
     wxSize GetMinClientSize( wxWindow *window );
     wxSize VirtualFitSize( wxWindow *window );
@@ -764,6 +803,12 @@ protected:
     virtual wxSizerItem* DoInsert(size_t index, wxSizerItem *item);
 
 private:
+    // Same as InvalidateMinSize() but doesn't invalidate the window best size,
+    // used by wxWindow which does it itself.
+    void DoInvalidateMinSize();
+
+    friend class WXDLLIMPEXP_FWD_CORE wxWindowBase;
+
     wxDECLARE_CLASS(wxSizer);
 };
 
@@ -790,16 +835,18 @@ public:
     {
         wxASSERT_MSG( cols >= 0, "Number of columns must be non-negative");
         m_cols = cols;
+        InvalidateMinSize();
     }
 
     void SetRows( int rows )
     {
         wxASSERT_MSG( rows >= 0, "Number of rows must be non-negative");
         m_rows = rows;
+        InvalidateMinSize();
     }
 
-    void SetVGap( int gap )     { m_vgap = gap; }
-    void SetHGap( int gap )     { m_hgap = gap; }
+    void SetVGap( int gap )     { m_vgap = gap; InvalidateMinSize(); }
+    void SetHGap( int gap )     { m_hgap = gap; InvalidateMinSize(); }
     int GetCols() const         { return m_cols; }
     int GetRows() const         { return m_rows; }
     int GetVGap() const         { return m_vgap; }
@@ -901,12 +948,14 @@ public:
     // grow in one direction but not the other
 
     // the direction may be wxVERTICAL, wxHORIZONTAL or wxBOTH (default)
-    void SetFlexibleDirection(int direction) { m_flexDirection = direction; }
+    void SetFlexibleDirection(int direction)
+        { m_flexDirection = direction; InvalidateMinSize(); }
     int GetFlexibleDirection() const { return m_flexDirection; }
 
     // note that the grow mode only applies to the direction which is not
     // flexible
-    void SetNonFlexibleGrowMode(wxFlexSizerGrowMode mode) { m_growMode = mode; }
+    void SetNonFlexibleGrowMode(wxFlexSizerGrowMode mode)
+        { m_growMode = mode; InvalidateMinSize(); }
     wxFlexSizerGrowMode GetNonFlexibleGrowMode() const { return m_growMode; }
 
     // Read-only access to the row heights and col widths arrays
@@ -966,7 +1015,7 @@ public:
 
     bool IsVertical() const { return m_orient == wxVERTICAL; }
 
-    void SetOrientation(int orient) { m_orient = orient; }
+    void SetOrientation(int orient) { m_orient = orient; InvalidateMinSize(); }
 
     // implementation of our resizing logic
     virtual wxSize CalcMin() wxOVERRIDE;
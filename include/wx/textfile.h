@@ -20,6 +20,8 @@
 #if wxUSE_TEXTFILE
 
 #include "wx/file.h"
+#include "wx/buffer.h"
+#include "wx/vector.h"
 
 // ----------------------------------------------------------------------------
 // wxTextFile
@@ -48,6 +50,80 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxTextFile);
 };
 
+// ----------------------------------------------------------------------------
+// wxIndexedTextFile: read-only access to the lines of a (big) text file
+// ----------------------------------------------------------------------------
+
+// Unlike wxTextFile, this class doesn't load the file contents in memory but
+// only builds a table of the line offsets when it's opened, the lines
+// themselves are read and converted only when they are accessed.
+class WXDLLIMPEXP_BASE wxIndexedTextFile
+{
+public:
+    // constructors
+    wxIndexedTextFile() { Init(); }
+    wxIndexedTextFile(const wxString& strFileName,
+                      const wxMBConv& conv = wxConvAuto());
+
+    ~wxIndexedTextFile();
+
+    // index the file, the conversion is only used for decoding the lines
+    bool Open(const wxString& strFileName, const wxMBConv& conv = wxConvAuto());
+
+    // close the file and free the index
+    bool Close();
+
+    bool IsOpened() const { return m_file.IsOpened(); }
+
+    const wxString& GetName() const { return m_strFileName; }
+
+    // accessors
+    // ---------
+
+    size_t GetLineCount() const { return m_aTypes.size(); }
+
+    // read the given line from the file, n must be less than GetLineCount()
+    wxString GetLine(size_t n) const;
+    wxString operator[](size_t n) const { return GetLine(n); }
+
+    wxTextFileType GetLineType(size_t n) const
+        { return static_cast<wxTextFileType>(m_aTypes[n]); }
+
+    // get the offset of the start of the line in the file
+    wxFileOffset GetLineOffset(size_t n) const { return m_aOffsets[n]; }
+
+private:
+    void Init();
+
+    // build m_aOffsets and m_aTypes for the currently opened file
+    bool BuildIndex();
+
+    // return the pointer to len bytes at the given offset in the file
+    const char *ReadBytes(wxFileOffset ofs, size_t len) const;
+
+
+    wxString m_strFileName;
+
+    // mutable because GetLine() needs to read from it
+    mutable wxFile m_file;
+
+    // the conversion used for the lines contents, owned by this object
+    wxMBConv *m_conv;
+
+    // offsets of the lines starts, this array has one more element than the
+    // number of lines and the last element is the file length
+    wxVector<wxFileOffset> m_aOffsets;
+
+    // types of the lines stored as bytes as there may be a lot of them
+    wxVector<unsigned char> m_aTypes;
+
+    // the buffer containing the last read part of the file and its offset
+    mutable wxMemoryBuffer m_buf;
+    mutable wxFileOffset m_bufStart;
+
+    wxDECLARE_NO_COPY_CLASS(wxIndexedTextFile);
+};
+
 #else // !wxUSE_TEXTFILE
 
 // old code relies on the static methods of wxTextFile being always available
@@ -0,0 +1,404 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     wxThreadPool, wxThreadPoolTask and wxTaskGroup classes
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_THREADPOOL_H_
+#define _WX_THREADPOOL_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_THREADS
+
+#include "wx/atomic.h"
+#include "wx/event.h"
+#include "wx/object.h"
+#include "wx/thread.h"
+#include "wx/vector.h"
+
+class WXDLLIMPEXP_FWD_BASE wxThreadPool;
+class WXDLLIMPEXP_FWD_BASE wxTaskGroup;
+class wxThreadPoolWorker;
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolTask: a unit of work executed by wxThreadPool
+// ----------------------------------------------------------------------------
+
+// Tasks are reference-counted and are usually referenced using
+// wxThreadPoolTaskPtr, the pool keeps its own reference to the task until it
+// is completed, so it is safe to drop all the other ones after queuing it.
+class WXDLLIMPEXP_BASE wxThreadPoolTask
+{
+public:
+    wxThreadPoolTask();
+
+    // Perform the task, this is called in one of the pool threads or, if
+    // another thread waits for the task completion, possibly in that thread.
+    virtual void Run() = 0;
+
+    // Called in the main thread after Run() if a handler was specified when
+    // queuing the task.
+    virtual void OnCompleted() { }
+
+    // Return true once Run() has returned.
+    bool IsDone() const { return m_pending == 0; }
+
+    // Wait until the task is done, executing the other pending tasks of the
+    // pool in the meanwhile. Can only be called after queuing the task.
+    void Wait();
+
+    // Reference counting, the task is deleted when the last reference to it
+    // is released.
+    void IncRef() { wxAtomicInc(m_refCount); }
+    void DecRef() { if ( !wxAtomicDec(m_refCount) ) delete this; }
+
+protected:
+    virtual ~wxThreadPoolTask();
+
+private:
+    wxAtomicInt m_refCount;
+
+    // 1 until the task is done, 0 after it.
+    wxAtomicInt m_pending;
+
+    // These fields are only set when the task is queued.
+    wxThreadPool* m_pool;
+    wxTaskGroup* m_group;
+    wxEvtHandler* m_handler;
+
+    friend class wxThreadPool;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolTask);
+};
+
+typedef wxObjectDataPtr<wxThreadPoolTask> wxThreadPoolTaskPtr;
+
+// ----------------------------------------------------------------------------
+// Private helpers for the tasks created from functors.
+// ----------------------------------------------------------------------------
+
+namespace wxPrivate
+{
+
+// Task calling a functor without arguments.
+template <typename F>
+class ThreadPoolFunctorTask : public wxThreadPoolTask
+{
+public:
+    explicit ThreadPoolFunctorTask(const F& fn) : m_fn(fn) { }
+
+    virtual void Run() wxOVERRIDE { m_fn(); }
+
+private:
+    F m_fn;
+};
+
+// Same as above but calling another functor in the main thread on completion.
+template <typename F, typename G>
+class ThreadPoolFunctorTaskWithCallback : public ThreadPoolFunctorTask<F>
+{
+public:
+    ThreadPoolFunctorTaskWithCallback(const F& fn, const G& onDone)
+        : ThreadPoolFunctorTask<F>(fn),
+          m_onDone(onDone)
+    {
+    }
+
+    virtual void OnCompleted() wxOVERRIDE { m_onDone(); }
+
+private:
+    G m_onDone;
+};
+
+// Base class for the tasks computing a value, used by wxThreadPoolFuture.
+template <typename T>
+class ThreadPoolResultTask : public wxThreadPoolTask
+{
+public:
+    const T& GetResult() const { return m_result; }
+
+protected:
+    T m_result;
+};
+
+template <typename T, typename F>
+class ThreadPoolFunctorResultTask : public ThreadPoolResultTask<T>
+{
+public:
+    explicit ThreadPoolFunctorResultTask(const F& fn) : m_fn(fn) { }
+
+    virtual void Run() wxOVERRIDE { this->m_result = m_fn(); }
+
+private:
+    F m_fn;
+};
+
+// Calls the completion functor with the result of the task.
+template <typename T, typename F, typename G>
+class ThreadPoolFunctorResultTaskWithCallback
+    : public ThreadPoolFunctorResultTask<T, F>
+{
+public:
+    ThreadPoolFunctorResultTaskWithCallback(const F& fn, const G& onDone)
+        : ThreadPoolFunctorResultTask<T, F>(fn),
+          m_onDone(onDone)
+    {
+    }
+
+    virtual void OnCompleted() wxOVERRIDE { m_onDone(this->m_result); }
+
+private:
+    G m_onDone;
+};
+
+} // namespace wxPrivate
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolFuture: result of a task computing a value
+// ----------------------------------------------------------------------------
+
+template <typename T>
+class wxThreadPoolFuture
+{
+public:
+    // Default ctor creates an invalid object, use wxThreadPool::Async() to
+    // create the valid ones.
+    wxThreadPoolFuture() { }
+
+    bool IsValid() const { return m_task.get() != NULL; }
+
+    // Return true if the value has been already computed.
+    bool IsReady() const { return m_task->IsDone(); }
+
+    // Wait until the value is computed.
+    void Wait() const { m_task->Wait(); }
+
+    // Return the value, waiting for it if necessary.
+    const T& Get() const
+    {
+        m_task->Wait();
+        return m_task->GetResult();
+    }
+
+    // Return the task computing the value.
+    wxThreadPoolTaskPtr GetTask() const
+    {
+        if ( m_task )
+            m_task->IncRef();
+        return wxThreadPoolTaskPtr(m_task.get());
+    }
+
+private:
+    explicit wxThreadPoolFuture(wxPrivate::ThreadPoolResultTask<T>* task)
+        : m_task(task)
+    {
+    }
+
+    wxObjectDataPtr< wxPrivate::ThreadPoolResultTask<T> > m_task;
+
+    friend class wxThreadPool;
+    friend class wxTaskGroup;
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPool: a fixed set of threads executing the queued tasks
+// ----------------------------------------------------------------------------
+
+// Each pool thread has its own queue of tasks. The tasks queued from inside
+// a pool thread are added to its own queue and executed in LIFO order, while
+// the idle threads steal the oldest tasks from the queues of the other ones,
+// so that the work spreads over all threads without contention on a single
+// queue. The tasks queued from the other threads are distributed among the
+// pool threads in round-robin order.
+class WXDLLIMPEXP_BASE wxThreadPool
+{
+public:
+    // Create the pool with the given number of threads or, by default, with
+    // as many threads as there are CPUs.
+    explicit wxThreadPool(int numThreads = -1);
+
+    // Waits until all the tasks already queued are executed.
+    ~wxThreadPool();
+
+    // Return the global pool shared by the entire application, which is
+    // created on first use with the default number of threads.
+    static wxThreadPool& Get();
+
+    int GetThreadCount() const { return static_cast<int>(m_workers.size()); }
+
+    // Queue the task for execution, the task must have been allocated on the
+    // heap and the returned pointer takes ownership of the reference to it.
+    //
+    // If the handler is specified, the task OnCompleted() is called in the
+    // main thread using wxEvtHandler::CallAfter() on it once the task is done.
+    wxThreadPoolTaskPtr Queue(wxThreadPoolTask* task,
+                              wxEvtHandler* handler = NULL)
+    {
+        DoQueue(task, handler, NULL);
+        return wxThreadPoolTaskPtr(task);
+    }
+
+    // Execute the given functor, taking no arguments, in the pool.
+    template <typename F>
+    wxThreadPoolTaskPtr Run(const F& fn)
+    {
+        return Queue(new wxPrivate::ThreadPoolFunctorTask<F>(fn));
+    }
+
+    // Same as above but call onDone(), also without arguments, in the main
+    // thread once the functor execution completes.
+    template <typename F, typename G>
+    wxThreadPoolTaskPtr Run(const F& fn, wxEvtHandler* handler, const G& onDone)
+    {
+        return Queue
+               (
+                new wxPrivate::ThreadPoolFunctorTaskWithCallback<F, G>(fn, onDone),
+                handler
+               );
+    }
+
+    // Compute the value returned by the given functor in the pool, the type of
+    // the value must be explicitly specified, e.g. Async<int>(fn).
+    template <typename T, typename F>
+    wxThreadPoolFuture<T> Async(const F& fn)
+    {
+        wxPrivate::ThreadPoolResultTask<T>* const
+            task = new wxPrivate::ThreadPoolFunctorResultTask<T, F>(fn);
+        DoQueue(task, NULL, NULL);
+        return wxThreadPoolFuture<T>(task);
+    }
+
+    // Same as above but call onDone() with the computed value in the main
+    // thread once it becomes available.
+    template <typename T, typename F, typename G>
+    wxThreadPoolFuture<T> Async(const F& fn, wxEvtHandler* handler, const G& onDone)
+    {
+        wxPrivate::ThreadPoolResultTask<T>* const
+            task = new wxPrivate::ThreadPoolFunctorResultTaskWithCallback<T, F, G>
+                       (fn, onDone);
+        DoQueue(task, handler, NULL);
+        return wxThreadPoolFuture<T>(task);
+    }
+
+private:
+    // Add the task to one of the queues, taking a reference to it.
+    void DoQueue(wxThreadPoolTask* task, wxEvtHandler* handler, wxTaskGroup* group);
+
+    // Take a task from the queue of the given worker or steal one from the
+    // other workers, worker may be NULL if called from another thread.
+    wxThreadPoolTask* TakeTask(wxThreadPoolWorker* worker);
+
+    // Run the task and release the reference to it.
+    void ExecuteTask(wxThreadPoolTask* task);
+
+    // Wait until the counter becomes 0, executing the queued tasks meanwhile.
+    void WaitFor(wxAtomicInt& pending);
+
+    // Return the worker corresponding to the current thread, if any.
+    wxThreadPoolWorker* GetCurrentWorker() const;
+
+
+    wxVector<wxThreadPoolWorker*> m_workers;
+
+    // The number of tasks in all the queues.
+    wxAtomicInt m_numQueued;
+
+    // The number of workers waiting for m_condWork and of the threads waiting
+    // for m_condDone, used to avoid locking the mutex if nobody waits.
+    wxAtomicInt m_numSleeping;
+    wxAtomicInt m_numWaiting;
+
+    // Used to choose the queue for the tasks queued by the other threads.
+    wxAtomicInt m_nextWorker;
+
+    wxMutex m_mutex;
+    wxCondition m_condWork,
+                m_condDone;
+
+    // Set to true in the dtor, protected by m_mutex.
+    bool m_exiting;
+
+    friend class wxThreadPoolTask;
+    friend class wxThreadPoolWorker;
+    friend class wxTaskGroup;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPool);
+};
+
+// ----------------------------------------------------------------------------
+// wxTaskGroup: allows to wait for completion of a group of tasks
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxTaskGroup
+{
+public:
+    explicit wxTaskGroup(wxThreadPool& pool = wxThreadPool::Get())
+        : m_pool(pool),
+          m_pending(0)
+    {
+    }
+
+    // Waits for all the tasks of the group to complete.
+    ~wxTaskGroup() { Wait(); }
+
+    // These functions are the same as wxThreadPool ones but the tasks are
+    // added to this group.
+    wxThreadPoolTaskPtr Queue(wxThreadPoolTask* task,
+                              wxEvtHandler* handler = NULL)
+    {
+        m_pool.DoQueue(task, handler, this);
+        return wxThreadPoolTaskPtr(task);
+    }
+
+    template <typename F>
+    wxThreadPoolTaskPtr Run(const F& fn)
+    {
+        return Queue(new wxPrivate::ThreadPoolFunctorTask<F>(fn));
+    }
+
+    template <typename F, typename G>
+    wxThreadPoolTaskPtr Run(const F& fn, wxEvtHandler* handler, const G& onDone)
+    {
+        return Queue
+               (
+                new wxPrivate::ThreadPoolFunctorTaskWithCallback<F, G>(fn, onDone),
+                handler
+               );
+    }
+
+    template <typename T, typename F>
+    wxThreadPoolFuture<T> Async(const F& fn)
+    {
+        wxPrivate::ThreadPoolResultTask<T>* const
+            task = new wxPrivate::ThreadPoolFunctorResultTask<T, F>(fn);
+        m_pool.DoQueue(task, NULL, this);
+        return wxThreadPoolFuture<T>(task);
+    }
+
+    // Return true if all the tasks of this group are done.
+    bool IsDone() const { return m_pending == 0; }
+
+    // Wait until all the tasks are done, executing the pending tasks of the
+    // pool in the meanwhile.
+    void Wait() { m_pool.WaitFor(m_pending); }
+
+    wxThreadPool& GetPool() const { return m_pool; }
+
+private:
+    wxThreadPool& m_pool;
+
+    // The number of the tasks of this group which are not done yet.
+    wxAtomicInt m_pending;
+
+    friend class wxThreadPool;
+
+    wxDECLARE_NO_COPY_CLASS(wxTaskGroup);
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_THREADPOOL_H_
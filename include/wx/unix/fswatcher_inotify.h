@@ -14,6 +14,12 @@
 
 #if wxUSE_FSWATCHER
 
+#if wxUSE_THREADS && defined(wxHAS_CALL_AFTER)
+    #define wxHAS_INOTIFY_ASYNC_TREE
+
+    class wxInotifyTreeScan;
+#endif
+
 class WXDLLIMPEXP_BASE wxInotifyFileSystemWatcher :
         public wxFileSystemWatcherBase
 {
@@ -25,10 +31,36 @@ public:
 
     virtual ~wxInotifyFileSystemWatcher();
 
+    virtual bool RemoveTree(const wxFileName& path) wxOVERRIDE;
+
+#ifdef wxHAS_INOTIFY_ASYNC_TREE
+    virtual bool AddTreeAsync(const wxFileName& path,
+                              int events = wxFSW_EVENT_ALL,
+                              const wxString& filespec = wxEmptyString) wxOVERRIDE;
+
+    virtual bool IsAddingTrees() const wxOVERRIDE;
+
+    virtual bool RemoveAll() wxOVERRIDE;
+#endif // wxHAS_INOTIFY_ASYNC_TREE
+
     void OnDirDeleted(const wxString& path);
 
 protected:
     bool Init();
+
+#ifdef wxHAS_INOTIFY_ASYNC_TREE
+private:
+    // Watch the directories found by the scans, called from the event loop.
+    void OnTreeScanProgress();
+
+    // Stop and delete the scan with the given index.
+    void CancelTreeScan(size_t n);
+
+    // The scans started by AddTreeAsync() and not finished yet.
+    wxVector<wxInotifyTreeScan*> m_treeScans;
+
+    friend class wxInotifyTreeScan;
+#endif // wxHAS_INOTIFY_ASYNC_TREE
 };
 
 #endif
@@ -23,10 +23,19 @@ class wxFSWatchEntry : public wxFSWatchInfo
 {
 public:
     wxFSWatchEntry(const wxFSWatchInfo& winfo) :
-        wxFSWatchInfo(winfo)
+        wxFSWatchInfo(winfo),
+        m_fileName(winfo.GetPath()),
+        m_wd(-1)
     {
     }
 
+    // Returns the watched path, parsed only once to avoid doing it for every
+    // event.
+    const wxFileName& GetFileName() const
+    {
+        return m_fileName;
+    }
+
     int GetWatchDescriptor() const
     {
         return m_wd;
@@ -38,6 +47,7 @@ public:
     }
 
 private:
+    wxFileName m_fileName;
     int m_wd;
 
     wxDECLARE_NO_COPY_CLASS(wxFSWatchEntry);
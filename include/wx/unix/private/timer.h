@@ -13,6 +13,9 @@
 #if wxUSE_TIMER
 
 #include "wx/private/timer.h"
+#include "wx/vector.h"
+
+#include <limits.h>
 
 // the type used for milliseconds is large enough for microseconds too but
 // introduce a synonym for it to avoid confusion
@@ -43,8 +46,14 @@ public:
         m_isRunning = false;
     }
 
+    // for wxTimerScheduler only: the position of this timer in its heap
+    size_t GetScheduleIndex() const { return m_scheduleIndex; }
+    void SetScheduleIndex(size_t index) { m_scheduleIndex = index; }
+
 private:
     bool m_isRunning;
+
+    size_t m_scheduleIndex;
 };
 
 // ----------------------------------------------------------------------------
@@ -53,21 +62,36 @@ private:
 
 struct wxTimerSchedule
 {
-    wxTimerSchedule(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+    wxTimerSchedule(wxUnixTimerImpl *timer,
+                    wxUsecClock_t expiration,
+                    unsigned long order)
         : m_timer(timer),
-          m_expiration(expiration)
+          m_expiration(expiration),
+          m_order(order)
     {
     }
 
+    // return true if this timer must be notified before the other one
+    bool IsBefore(const wxTimerSchedule& other) const
+    {
+        if ( m_expiration != other.m_expiration )
+            return m_expiration < other.m_expiration;
+
+        // notify the timers expiring at the same time in the order in which
+        // they were added
+        return m_order - other.m_order > ULONG_MAX / 2;
+    }
+
     // the timer itself (we don't own this pointer)
     wxUnixTimerImpl *m_timer;
 
     // the time of its next expiration, in usec
     wxUsecClock_t m_expiration;
-};
 
-// the linked list of all active timers, we keep it sorted by expiration time
-WX_DECLARE_LIST(wxTimerSchedule, wxTimerList);
+    // the sequential number of this schedule, only used to order the timers
+    // expiring at the same time (and it's fine if it wraps around)
+    unsigned long m_order;
+};
 
 // ----------------------------------------------------------------------------
 // wxTimerScheduler: class responsible for updating all timers
@@ -118,17 +142,32 @@ public:
 private:
     // ctor and dtor are private, this is a singleton class only created by
     // Get() and destroyed by Shutdown()
-    wxTimerScheduler() { }
-    ~wxTimerScheduler();
+    wxTimerScheduler() : m_nextOrder(0) { }
+
+    // add the given timer schedule to the heap
+    void DoAddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration);
+
+    // remove the timer at the given position in the heap
+    void DoRemoveTimer(size_t n);
+
+    // put the schedule at the given position in the heap and update the timer
+    // index
+    void SetAt(size_t n, const wxTimerSchedule& s);
+
+    // move the schedule at the given position up or down the heap until the
+    // heap property is restored
+    void SiftUp(size_t n);
+    void SiftDown(size_t n);
 
-    // add the given timer schedule to the list in the right place
-    //
-    // we take ownership of the pointer "s" which must be heap-allocated
-    void DoAddTimer(wxTimerSchedule *s);
 
+    // all currently active timers organized as a binary min-heap ordered by
+    // expiration, so that the first element is always the next one to expire
+    // and each timer knows its position in it, which allows to add and remove
+    // timers in logarithmic time
+    wxVector<wxTimerSchedule> m_timers;
 
-    // the list of all currently active timers sorted by expiration
-    wxTimerList m_timers;
+    // the order of the next added timer schedule
+    unsigned long m_nextOrder;
 
     static wxTimerScheduler *ms_instance;
 };
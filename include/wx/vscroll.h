@@ -16,6 +16,7 @@
 #include "wx/scrolwin.h"
 
 class WXDLLIMPEXP_FWD_CORE wxVarScrollHelperEvtHandler;
+class wxVarScrollUnitSizeIndex;
 
 
 // Using the same techniques as the wxScrolledWindow class      |
@@ -82,6 +83,14 @@ public:
     void EnablePhysicalScrolling(bool scrolling = true)
         { m_physicalScrolling = scrolling; }
 
+    // with the unit size cache on, the sizes of all units are retrieved once
+    // and kept in an index allowing to find the offset of any unit, or the
+    // unit at any offset, in logarithmic time: this is useful for windows
+    // with a huge number of units, but means that RefreshUnit[s]() or
+    // RefreshAll() must be called whenever the size of a unit changes
+    void EnableUnitSizeCache(bool enable = true);
+    bool IsUnitSizeCacheEnabled() const { return m_sizeIndex != NULL; }
+
     // wxNOT_FOUND if none, i.e. if it is below the last item
     int VirtualHitTest(wxCoord coord) const;
 
@@ -258,6 +267,10 @@ protected:
     void IncOrient(wxCoord& x, wxCoord& y, wxCoord inc);
 
 private:
+    // return the unit size index, (re)building it if necessary, or NULL if
+    // the unit size cache is not enabled
+    wxVarScrollUnitSizeIndex *GetUnitSizeIndex() const;
+
     // the total number of (logical) units
     size_t m_unitMax;
 
@@ -281,6 +294,12 @@ private:
 
     // handler injected into target window to forward some useful events to us
     wxVarScrollHelperEvtHandler *m_handler;
+
+    // the index of unit sizes, only non-NULL if EnableUnitSizeCache() was
+    // called (it is empty until it is needed for the first time)
+    wxVarScrollUnitSizeIndex *m_sizeIndex;
+
+    friend class wxVarScrollUnitSizeIndex;
 };
 
 
@@ -478,6 +497,12 @@ public:
         wxVarHScrollHelper::EnablePhysicalScrolling(hscrolling);
     }
 
+    void EnableUnitSizeCache(bool vcache = true, bool hcache = true)
+    {
+        wxVarVScrollHelper::EnableUnitSizeCache(vcache);
+        wxVarHScrollHelper::EnableUnitSizeCache(hcache);
+    }
+
     // scroll to the specified row/column: it will become the first visible
     // cell in the window
     //
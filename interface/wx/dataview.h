@@ -6,6 +6,63 @@
 /////////////////////////////////////////////////////////////////////////////
 
 
+/**
+    @class wxDataViewSortKey
+
+    wxDataViewSortKey is a simple value used for sorting the items of
+    wxDataViewCtrl, see wxDataViewModel::GetSortKey().
+
+    The key can hold an integer, a floating point number or a string, or be
+    empty. The keys of different kinds are ordered by kind, with the empty keys
+    coming first, and the strings are compared in the same way as
+    wxDataViewModel::Compare() does it by default.
+
+    @library{wxcore}
+    @category{dvc}
+
+    @since 3.1.4
+*/
+class wxDataViewSortKey
+{
+public:
+    /**
+        Creates an empty key.
+    */
+    wxDataViewSortKey();
+
+    /**
+        Makes the key empty.
+    */
+    void Clear();
+
+    /**
+        Sets the key to the given integer value.
+    */
+    void SetInteger(wxLongLong value);
+
+    /**
+        Sets the key to the given floating point value.
+    */
+    void SetDouble(double value);
+
+    /**
+        Sets the key to the given string.
+    */
+    void SetString(const wxString& value);
+
+    /**
+        Returns @true if the key doesn't have any value.
+    */
+    bool IsEmpty() const;
+
+    /**
+        Returns a negative value, 0 or a positive value if this key is less
+        than, equal to or greater than the @a other one.
+    */
+    int Compare(const wxDataViewSortKey& other) const;
+};
+
+
 /**
     @class wxDataViewModel
 
@@ -299,6 +356,42 @@ public:
     */
     virtual bool HasDefaultCompare() const;
 
+    /**
+        Override this to indicate that the items can be sorted by the given
+        column by comparing their keys returned by GetSortKey().
+
+        When this method returns @true, the generic implementation of
+        wxDataViewCtrl retrieves the key of each item only once before sorting
+        and then compares the keys instead of calling Compare() for each pair
+        of items, which is significantly faster for big models. Compare() is
+        still used for the columns for which this method returns @false and
+        when sorting by the default order.
+
+        The keys must order the items in the same way as Compare() would do.
+
+        The default implementation returns @false.
+
+        @see GetSortKey()
+
+        @since 3.1.4
+    */
+    virtual bool HasSortKeys(unsigned int column) const;
+
+    /**
+        Retrieve the key used for sorting the given item by the given column.
+
+        This function is only called if HasSortKeys() returns @true for this
+        column. The default implementation uses the value returned by
+        GetValue() and handles the same types as the default implementation of
+        Compare(), leaving @a key empty for the other ones. Override it to
+        provide the key more efficiently or for the custom types.
+
+        @since 3.1.4
+    */
+    virtual void GetSortKey(wxDataViewSortKey& key,
+                            const wxDataViewItem& item,
+                            unsigned int column) const;
+
     /**
         Return true if there is a value in the given column of this item.
 
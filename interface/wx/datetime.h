@@ -1597,6 +1597,125 @@ const wxDateTime wxDefaultDateTime;
 #define wxInvalidDateTime wxDefaultDateTime
 
 
+/**
+    @class wxDateTimeFormatter
+
+    Object formatting and parsing dates using the same format string many
+    times.
+
+    This class produces the same results as wxDateTime::Format() and
+    wxDateTime::ParseFormat() but interprets the format string only once,
+    when it is set, and also retrieves the localized month and week day names
+    only once. This makes it significantly faster when formatting or parsing
+    many dates, e.g. when filling a list control or reading a log file:
+    @code
+    wxDateTimeFormatter formatter("%Y-%m-%d %H:%M:%S");
+    for ( size_t n = 0; n < dates.size(); n++ )
+        list->SetItem(n, 0, formatter.Format(dates[n]));
+    @endcode
+
+    The commonly used numeric fields, the month and week day names, AM/PM
+    strings and the time zone offset are handled by this class itself, while
+    the rest of the format specifiers, as well as the fields with the
+    explicitly specified width, are still formatted by wxDateTime. Similarly,
+    parsing falls back to wxDateTime::ParseFormat() if the format contains any
+    of the less common specifiers such as @c "%c" or @c "%x".
+
+    Notice that as the localized names are cached, the format must be set
+    again if the current locale changes.
+
+    The const methods of this class can be called concurrently from multiple
+    threads.
+
+    @library{wxbase}
+    @category{data}
+
+    @see wxDateTime::Format(), wxDateTime::ParseFormat()
+
+    @since 3.1.4
+*/
+class wxDateTimeFormatter
+{
+public:
+    /**
+        Default constructor uses ::wxDefaultDateTimeFormat.
+    */
+    wxDateTimeFormatter();
+
+    /**
+        Constructor compiling the given format.
+
+        The format can't be empty and uses the same syntax as the format
+        passed to wxDateTime::Format(). If it is empty anyhow, an assertion
+        failure is reported and ::wxDefaultDateTimeFormat is used instead.
+    */
+    explicit wxDateTimeFormatter(const wxString& format);
+
+    /**
+        Set the format to use.
+
+        Returns @false if the format is invalid, i.e. empty.
+    */
+    bool SetFormat(const wxString& format);
+
+    /**
+        Return the format used.
+    */
+    const wxString& GetFormat() const;
+
+    /**
+        Return the date formatted using this format.
+
+        The result is the same as that of
+        @code
+        dt.Format(formatter.GetFormat(), tz)
+        @endcode
+    */
+    wxString Format(const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    /**
+        Format the date into the provided buffer.
+
+        This function avoids allocating memory for the result, which can be
+        useful when formatting big numbers of dates.
+
+        @param buf The buffer receiving the output, which is always
+            NUL-terminated unless @a size is 0.
+        @param size The size of the buffer, in characters.
+        @param dt The date to format.
+        @param tz The time zone to use.
+        @return The length of the full result, not counting the trailing NUL.
+            If it is greater than or equal to @a size, the output was
+            truncated, just as with @c snprintf().
+    */
+    size_t FormatTo(wxChar* buf,
+                    size_t size,
+                    const wxDateTime& dt,
+                    const wxDateTime::TimeZone& tz = wxDateTime::Local) const;
+
+    /**
+        Parse the date using this format.
+
+        This function works like wxDateTime::ParseFormat() except that @a dt
+        is not modified if parsing fails.
+
+        @param date The string to parse.
+        @param dt The date receiving the result, must be non-@NULL.
+        @param dateDef The date used for the fields not specified in the
+            format, see wxDateTime::ParseFormat() for more details.
+        @param end If non-@NULL, receives the position of the first character
+            which was not parsed. If it is @NULL, the entire string must be
+            matched by the format.
+        @return @true if the date was parsed successfully.
+    */
+    bool Parse(const wxString& date,
+               wxDateTime* dt,
+               const wxDateTime& dateDef = wxDefaultDateTime,
+               wxString::const_iterator* end = NULL) const;
+};
+
+
 /**
     @class wxDateTimeWorkDays
 
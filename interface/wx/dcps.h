@@ -19,6 +19,16 @@
     However, some functions, like SetFont(), may be legitimately called even
     before StartDoc().
 
+    @section images Images
+
+    By default, the bitmaps are written uncompressed, using only the
+    operators available in PostScript Level 1, for compatibility with all
+    printers. Since wxWidgets 3.1.4, SetLanguageLevel() can be used to allow
+    writing them in a more compact form: with Level 2 they are run-length
+    encoded and with Level 3 they are compressed using zlib, if available,
+    and the images drawn more than once in the same document are stored
+    only once.
+
     @library{wxbase}
     @category{dc}
 */
@@ -32,5 +42,23 @@ public:
     */
     wxPostScriptDC(const wxPrintData& printData);
 
+    /**
+        Set the PostScript language level which can be used in the output.
+
+        The @a level must be 1, which is the default, 2 or 3 and must be set
+        before calling StartDoc(). The output is compatible with all printers
+        supporting at least the given language level, which is also indicated
+        in the document header if it is greater than 1.
+
+        @since 3.1.4
+    */
+    void SetLanguageLevel(int level);
+
+    /**
+        Returns the PostScript language level set by SetLanguageLevel().
+
+        @since 3.1.4
+    */
+    int GetLanguageLevel() const;
 };
 
@@ -44,6 +44,9 @@ enum wxSVGShapeRenderingMode
     are supported and these are saved as separate files in the same folder
     as the SVG file, however it is possible to change this behaviour by
     replacing the built in bitmap handler using wxSVGFileDC::SetBitmapHandler().
+    Since wxWidgets 3.1.4, each distinct bitmap is processed by the handler
+    only once, even if it is drawn several times, and is referenced from the
+    SVG file for all the subsequent drawing operations.
 
     More substantial SVG libraries (for reading and writing) are available at
     <a href="http://wxart2d.sourceforge.net/" target="_blank">wxArt2D</a> and
@@ -169,6 +172,11 @@ public:
         inline with the XML generated by the main wxSVGFileDC class so it is
         important that the XML is properly formed.
 
+        Notice that, since wxWidgets 3.1.4, this function is called only once
+        for each distinct bitmap, with the output placed inside a @c defs
+        element, and @a x and @a y are always 0 in this case. The bitmap is
+        then positioned at the actual location with a @c use element.
+
         @param bitmap A valid bitmap to add to SVG.
         @param x Horizontal position of the bitmap.
         @param y Vertical position of the bitmap.
@@ -1,6 +1,6 @@
 /////////////////////////////////////////////////////////////////////////////
 // Name:        dir.h
-// Purpose:     interface of wxDir and wxDirTraverser
+// Purpose:     interface of wxDir, wxDirTraverser and wxDirBatchTraverser
 // Author:      wxWidgets team
 // Licence:     wxWindows licence
 /////////////////////////////////////////////////////////////////////////////
@@ -96,6 +96,91 @@ public:
 };
 
 
+/**
+    @class wxDirBatchTraverser
+
+    wxDirBatchTraverser is an abstract interface which must be implemented by
+    objects passed to wxDir::TraverseParallel() function.
+
+    Unlike wxDirTraverser, this class is notified about all the files of a
+    directory at once, which is more efficient when traversing big directory
+    trees.
+
+    All the methods of this class are called from the thread calling
+    wxDir::TraverseParallel(), even though the directories themselves are read
+    by the other threads, so they don't need to be thread-safe. The order of
+    the calls is only guaranteed to respect the following rules:
+        - OnDir() is called for the subdirectories of a directory in the order
+          in which they are enumerated by wxDir::GetFirst() and GetNext().
+        - OnDir() is called for a directory before OnDir() and OnFiles() are
+          called for any of its subdirectories and files.
+        - OnFiles() is called at most once for each directory and after all
+          OnDir() calls for its subdirectories.
+    The calls for different subdirectories may be interleaved in arbitrary
+    order, which is not necessarily the same for different traversals of the
+    same directory tree.
+
+    Example of counting all the files under the given directory:
+    @code
+    class CountingTraverser : public wxDirBatchTraverser
+    {
+    public:
+        CountingTraverser() : m_count(0) { }
+
+        virtual wxDirTraverseResult OnFiles(const wxString& dirname,
+                                            const wxArrayString& filenames)
+        {
+            m_count += filenames.size();
+            return wxDIR_CONTINUE;
+        }
+
+        size_t m_count;
+    };
+    @endcode
+
+    @library{wxbase}
+    @category{file}
+
+    @since 3.1.4
+*/
+class wxDirBatchTraverser
+{
+public:
+    /**
+        This function is called for each directory, see
+        wxDirTraverser::OnDir() for the meaning of its return value.
+
+        The base class version always returns ::wxDIR_CONTINUE.
+    */
+    virtual wxDirTraverseResult OnDir(const wxString& dirname);
+
+    /**
+        This function is called with the names of all the files found in the
+        given directory, if there are any.
+
+        @a dirname includes the trailing path separator, so that the full path
+        of each of the files is @c dirname+filenames[n].
+
+        It may return ::wxDIR_STOP to abort traversing or ::wxDIR_CONTINUE to
+        proceed.
+
+        This is a pure virtual function and must be implemented in the derived
+        class.
+    */
+    virtual wxDirTraverseResult OnFiles(const wxString& dirname,
+                                        const wxArrayString& filenames) = 0;
+
+    /**
+        This function is called for each directory which we failed to open for
+        enumerating, see wxDirTraverser::OnOpenError() for the meaning of its
+        return value.
+
+        The base class version always returns ::wxDIR_IGNORE.
+    */
+    virtual wxDirTraverseResult OnOpenError(const wxString& dirname);
+};
+
+
 
 /**
     These flags affect the behaviour of GetFirst/GetNext() and Traverse(),
@@ -234,6 +319,10 @@ public:
         subdirectories (both flags are included in the value by default).
         See ::wxDirFlags for the list of the possible flags.
 
+        The directories are read in parallel using TraverseParallel(), but the
+        files are still returned in the same order as Traverse() would return
+        them.
+
         @return Returns the total number of files found while traversing
                 the directory @a dirname (i.e. the number of entries appended
                 to the @a files array).
@@ -373,5 +462,31 @@ public:
     size_t Traverse(wxDirTraverser& sink,
                     const wxString& filespec = wxEmptyString,
                     int flags = wxDIR_DEFAULT) const;
+
+    /**
+        Enumerate all files and directories under the given directory reading
+        the directories in parallel.
+
+        This function is similar to Traverse() and uses the same @a filespec
+        and @a flags, but reads the subdirectories using the threads of the
+        global wxThreadPool, if threads are available, which is much faster
+        for the big directory trees, especially on network or solid state
+        drives. The thread calling this function reads the directories too,
+        so it's safe to call it from inside a wxThreadPool task.
+
+        For each directory found, @ref wxDirBatchTraverser::OnDir()
+        "sink.OnDir()" is called and @ref wxDirBatchTraverser::OnFiles()
+        "sink.OnFiles()" is called once for all the files in it, see
+        wxDirBatchTraverser for the guarantees about the order of these calls.
+        All of them are done from the calling thread.
+
+        The function returns the total number of files found or @c "(size_t)-1"
+        on error.
+
+        @since 3.1.4
+    */
+    size_t TraverseParallel(wxDirBatchTraverser& sink,
+                            const wxString& filespec = wxEmptyString,
+                            int flags = wxDIR_DEFAULT) const;
 };
 
@@ -40,6 +40,12 @@
     these events in any other object. See the fswatcher sample for an example
     of the latter approach.
 
+    Under Linux, all the changes detected at once are also sent together in a
+    single wxFileSystemWatcherBatchEvent before being sent individually, which
+    can be handled instead of wxFileSystemWatcherEvent to process many changes
+    more efficiently. Repeated modification or access events for the same
+    file are also merged into one, as they don't carry any useful information.
+
     @library{wxbase}
     @category{file}
 
@@ -98,6 +104,39 @@ public:
     virtual bool AddTree(const wxFileName& path, int events = wxFSW_EVENT_ALL,
                          const wxString& filter = wxEmptyString);
 
+    /**
+        This is the same as AddTree(), but returns without waiting until all
+        the subdirectories of @a path are watched.
+
+        Under Linux, this function starts watching @a path itself immediately
+        and then finds its subdirectories in the background, using
+        wxThreadPool, and watches them as they are found, without blocking the
+        event loop for too long even for the trees with hundreds of thousands
+        of subdirectories. Unlike AddTree(), the subdirectories which are
+        already watched, e.g. because they were created after this function
+        was called, are not watched again.
+
+        On the other platforms, this function simply calls AddTree().
+
+        @see IsAddingTrees()
+
+        @since 3.1.4
+     */
+    virtual bool AddTreeAsync(const wxFileName& path,
+                              int events = wxFSW_EVENT_ALL,
+                              const wxString& filter = wxEmptyString);
+
+    /**
+        Returns @true if the trees passed to AddTreeAsync() are still being
+        added.
+
+        Calling RemoveTree() or RemoveAll() stops adding the corresponding
+        trees.
+
+        @since 3.1.4
+     */
+    virtual bool IsAddingTrees() const;
+
     /**
         Removes @a path from the list of watched paths.
 
@@ -229,6 +268,61 @@ public:
 
 wxEventType wxEVT_FSWATCHER;
 
+
+/**
+    @class wxFileSystemWatcherBatchEvent
+
+    Event containing all the file system changes detected at once.
+
+    This event is currently only sent under Linux, where it contains all the
+    changes reported by a single read of the inotify descriptor. If it is not
+    handled, or if the handler calls wxEvent::Skip(), all the events contained
+    in it are sent individually as @c wxEVT_FSWATCHER events, so there is no
+    need to handle it unless processing many changes at once is more
+    efficient for the application.
+
+    @beginEventTable{wxFileSystemWatcherBatchEvent}
+    @event{EVT_FSWATCHER_BATCH(id, func)}
+        Process a @c wxEVT_FSWATCHER_BATCH event.
+    @endEventTable
+
+    @library{wxbase}
+    @category{events}
+
+    @see wxFileSystemWatcher, wxFileSystemWatcherEvent
+
+    @since 3.1.4
+*/
+class wxFileSystemWatcherBatchEvent : public wxEvent
+{
+public:
+    /**
+        Creates an empty batch.
+     */
+    wxFileSystemWatcherBatchEvent(int watchid = wxID_ANY);
+
+    /**
+        Returns the number of the events in this batch.
+     */
+    size_t GetEventCount() const;
+
+    /**
+        Returns the event with the given index, which must be less than
+        GetEventCount().
+     */
+    const wxFileSystemWatcherEvent& GetEvent(size_t n) const;
+
+    /**
+        Appends an event to the batch.
+
+        The batch takes ownership of the event, which must be allocated on
+        the heap.
+     */
+    void AddEvent(wxFileSystemWatcherEvent* event);
+};
+
+wxEventType wxEVT_FSWATCHER_BATCH;
+
 /**
     These are the possible types of file system change events.
 
@@ -152,6 +152,34 @@ public:
     */
     virtual void Pulse();
 
+    /**
+        Update the gauge value periodically using the given progress source.
+
+        This allows showing the progress of the work done by another thread
+        without sending events to the main thread: the worker just changes
+        the value of @a source, which is sampled every @a interval
+        milliseconds, and the gauge is updated only if it changed. The values
+        greater than GetRange() are limited to it.
+
+        @param source
+            The source to sample or @NULL to stop sampling. It must remain
+            valid as long as it is used by the gauge.
+        @param interval
+            The sampling interval in milliseconds.
+
+        @see wxProgressDialog::SetProgressSource()
+
+        @since 3.1.4
+    */
+    void SetProgressSource(wxProgressSource* source, int interval = 50);
+
+    /**
+        Returns the source set by SetProgressSource() or @NULL.
+
+        @since 3.1.4
+    */
+    wxProgressSource* GetProgressSource() const;
+
     /**
         Sets the range (maximum value) of the gauge. This function makes the
         gauge switch to determinate mode, if it's not already.
@@ -11,6 +11,11 @@
    @class wxGIFDecoder
 
    An animation decoder supporting animated GIF files.
+
+   Only the compressed data of the frames is kept in memory after loading the
+   file and the frames are decoded on demand, when they are converted to
+   wxImage. A small number of the most recently used frames is kept decoded to
+   avoid decoding them again when they are accessed repeatedly.
 */
 class  wxGIFDecoder : public wxAnimationDecoder
 {
@@ -3844,6 +3844,63 @@ public:
     */
     void AutoSizeRows(bool setAsMin = true);
 
+    /**
+        Enables or disables caching of the text extents.
+
+        When the cache is enabled, the grid remembers the extents of all the
+        strings it measures, for each font used, and doesn't measure the same
+        string again. This makes drawing the cells faster and may make
+        auto-sizing the rows and columns (see AutoSizeColumns() and
+        AutoSizeRows()) much faster if the cells contain many identical
+        values. It is especially useful with wxGridCellAutoWrapStringRenderer,
+        which measures the same words many times when wrapping the text.
+
+        The cache is limited in size and is cleared automatically when it
+        becomes full or the resolution changes. It is not used when drawing on
+        a scaled DC, e.g. by Render().
+
+        The cache is disabled by default.
+
+        @see ClearTextExtentCache(), GetCellTextExtent()
+
+        @since 3.1.4
+    */
+    void EnableTextExtentCache(bool enable = true);
+
+    /**
+        Returns @true if the text extent cache is enabled.
+
+        @see EnableTextExtentCache()
+
+        @since 3.1.4
+    */
+    bool IsTextExtentCacheEnabled() const;
+
+    /**
+        Clears the text extent cache.
+
+        This function doesn't need to be called normally, as the cache takes
+        into account the font used for drawing the text, but can be used to
+        free the memory used by it.
+
+        @since 3.1.4
+    */
+    void ClearTextExtentCache();
+
+    /**
+        Returns the extent of a single line of text drawn using the current
+        font of the given DC.
+
+        This function uses the text extent cache, if enabled, and so should
+        be used instead of wxDC::GetTextExtent() by the custom cell renderers
+        measuring their text.
+
+        @see EnableTextExtentCache()
+
+        @since 3.1.4
+    */
+    wxSize GetCellTextExtent(const wxDC& dc, const wxString& text) const;
+
     /**
         Returns the cell fitting mode.
 
@@ -5307,6 +5364,52 @@ public:
     */
     void ForceRefresh();
 
+    /**
+        Marks the given cell as changed.
+
+        All the cells marked as changed are repainted together during the next
+        idle time, which is much more efficient than refreshing each of them
+        individually if many cells change frequently, e.g. when the grid
+        shows some continuously updated values. The adjacent changed cells
+        are combined into rectangular blocks and only these blocks are
+        repainted.
+
+        Notice that only the changed cells themselves are repainted, so if
+        their contents can overflow into the neighbouring cells, either the
+        overflow should be disabled for them or these cells should be marked
+        as changed too.
+
+        @see MarkCellsChanged(), RefreshChangedCells()
+
+        @since 3.1.4
+    */
+    void MarkCellChanged(int row, int col);
+
+    /// @overload
+    void MarkCellChanged(const wxGridCellCoords& coords);
+
+    /**
+        Marks all the given cells as changed.
+
+        @see MarkCellChanged()
+
+        @since 3.1.4
+    */
+    void MarkCellsChanged(const wxGridCellCoordsArray& cells);
+
+    /**
+        Immediately refreshes all the cells marked as changed.
+
+        This function is called automatically during idle time, so it only
+        needs to be called if the changes must be shown before it, e.g. before
+        calling wxWindow::Update().
+
+        @see MarkCellChanged()
+
+        @since 3.1.4
+    */
+    void RefreshChangedCells();
+
     /**
         Returns the number of times that BeginBatch() has been called without
         (yet) matching calls to EndBatch(). While the grid's batch count is
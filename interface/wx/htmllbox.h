@@ -77,6 +77,37 @@ public:
     const wxFileSystem& GetFileSystem() const;
     //@}
 
+    /**
+        Sets the limits on the number of items whose parsed representation is
+        cached by the control.
+
+        wxHtmlListBox keeps the parsed HTML of the most recently shown items
+        to avoid parsing it again when they're redrawn and discards the least
+        recently used items when either the number of the cached items or the
+        estimated amount of memory used by them exceeds the specified limits.
+        The items around the visible ones are also parsed in advance, when the
+        program is idle, if the cache is big enough to hold them. By default,
+        up to 200 items using up to 4MiB of memory are cached, which should be
+        enough for most uses, but it may be useful to increase these limits
+        for the controls with many visible items or, conversely, reduce them
+        if the items are very big.
+
+        Notice that the heights of the items are remembered independently of
+        this cache, so that the items don't need to be parsed again just to
+        determine their height. As with the cached items themselves, this
+        means that RefreshRow(), RefreshRows() or RefreshAll() must be called
+        when the contents of the items changes.
+
+        @param maxItems
+            The maximal number of cached items, must be strictly positive.
+        @param maxBytes
+            The maximal amount of memory used by the cached items, 0 means
+            that it is not limited.
+
+        @since 3.1.4
+    */
+    void SetCacheSize(size_t maxItems, size_t maxBytes = 0);
+
 protected:
 
     /**
@@ -1207,12 +1207,15 @@ public:
             max width given if it is not 0 @em and its height is less than the
             max height given if it is not 0. This is typically used for loading
             thumbnails and the advantage of using these options compared to
-            calling Rescale() after loading is that some handlers (only JPEG
-            one right now) support rescaling the image during loading which is
-            vastly more efficient than loading the entire huge image and
-            rescaling it later (if these options are not supported by the
-            handler, this is still what happens however). These options must be
-            set before calling LoadFile() to have any effect.
+            calling Rescale() after loading is that some handlers (JPEG, PNG,
+            BMP and TIFF ones right now) support rescaling the image during
+            loading which is vastly more efficient than loading the entire huge
+            image and rescaling it later (if these options are not supported by
+            the handler, this is still what happens however). PNG handler
+            doesn't support this for the interlaced images and BMP one for
+            RLE-compressed bitmaps, while TIFF handler uses the reduced
+            resolution version of the image stored in the file, if any. These
+            options must be set before calling LoadFile() to have any effect.
 
         @li @c wxIMAGE_OPTION_ORIGINAL_WIDTH and @c wxIMAGE_OPTION_ORIGINAL_HEIGHT:
             These options will return the original size of the image if either
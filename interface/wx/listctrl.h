@@ -113,6 +113,66 @@ enum
     wxLIST_FIND_RIGHT
 };
 
+/**
+    Flags for wxListSortKey.
+
+    @since 3.1.4
+*/
+enum
+{
+    /// Sort the items in descending instead of ascending order.
+    wxLIST_SORT_DESCENDING = 0x0001,
+
+    /// Ignore the case of the items text when comparing it.
+    wxLIST_SORT_NOCASE     = 0x0002,
+
+    /**
+        Compare the runs of digits in the items text as numbers, so that
+        "item9" comes before "item10".
+     */
+    wxLIST_SORT_NATURAL    = 0x0004,
+
+    /**
+        Compare the items text as floating point numbers.
+
+        The items whose text is not a number come before all the others and
+        are compared as strings.
+     */
+    wxLIST_SORT_NUMERIC    = 0x0008
+};
+
+/**
+    @class wxListSortKey
+
+    Column and flags used for sorting wxListCtrl items by their text.
+
+    @see wxListCtrl::SortItemsByColumns()
+
+    @library{wxcore}
+    @category{ctrl}
+
+    @since 3.1.4
+*/
+class wxListSortKey
+{
+public:
+    /**
+        Constructor.
+
+        @param column
+            Index of the column containing the text to use for sorting.
+        @param flags
+            Combination of @c wxLIST_SORT_XXX flags.
+     */
+    wxListSortKey(int column = 0, int flags = 0);
+
+    /// Returns the column index.
+    int GetColumn() const;
+
+    /// Returns the flags.
+    int GetFlags() const;
+};
+
 
 
 
@@ -1283,6 +1343,40 @@ public:
     */
     bool SortItems(wxListCtrlCompare fnSortCallBack, wxIntPtr data);
 
+    /**
+        Sort the items using their text in the given column.
+
+        This is the same as calling SortItemsByColumns() with a single key.
+
+        @since 3.1.4
+    */
+    bool SortItemsByColumn(int col, int flags = 0);
+
+    /**
+        Sort the items using their text in the given columns.
+
+        The items are ordered using the first key and the items which are
+        equal according to it are ordered using the second one and so on.
+        The sort is stable, i.e. the items which are equal according to all
+        the keys keep their relative order.
+
+        Unlike SortItems(), this function doesn't require the items to have
+        any client data and doesn't call any user code. The text of each item
+        is retrieved only once, which makes this function much faster for big
+        controls, and the items may be sorted using several threads if there
+        are many of them. The selected items and the current item are
+        preserved.
+
+        This function can't be used with virtual list controls and is only
+        available in the generic version of wxListCtrl, i.e. not in wxMSW.
+
+        @return @true if the items were sorted, @false on error, e.g. if a
+            column index is invalid.
+
+        @since 3.1.4
+    */
+    bool SortItemsByColumns(const wxVector<wxListSortKey>& keys);
+
     /**
         Returns true if checkboxes are enabled for list items.
 
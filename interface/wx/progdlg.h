@@ -199,6 +199,39 @@ public:
      */
     bool WasSkipped() const;
 
+    /**
+        Update the dialog periodically using the given progress source.
+
+        This is an alternative to calling Update() from the main thread, which
+        is convenient when the work is done by another thread: the worker
+        thread only needs to change the value, and possibly the message, of
+        @a source, which is cheap and doesn't require any synchronization with
+        the main thread, while the dialog samples them every @a interval
+        milliseconds and is only updated if they changed. Notice that the
+        value of @a source is limited to the range of the dialog.
+
+        If the user cancels the dialog, wxProgressSource::Cancel() is called,
+        so the worker should check wxProgressSource::IsCancelled() regularly.
+        The dialog stops sampling the source when it is cancelled or when the
+        value reaches the maximum, which is handled as described in Update().
+
+        @param source
+            The source to sample, it must remain valid until this function
+            is called with @NULL or the dialog is destroyed.
+        @param interval
+            The sampling interval in milliseconds.
+
+        @since 3.1.4
+    */
+    void SetProgressSource(wxProgressSource* source, int interval = 50);
+
+    /**
+        Returns the source set by SetProgressSource() or @NULL.
+
+        @since 3.1.4
+    */
+    wxProgressSource* GetProgressSource() const;
+
 
     /**
         Updates the dialog, setting the progress bar to the new value and
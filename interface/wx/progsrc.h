@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        interface/wx/progsrc.h
+// Purpose:     interface of wxProgressSource
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxProgressSource
+
+    Progress of an operation, which can be updated from any thread.
+
+    This class allows showing the progress of the work done by a worker thread
+    in wxProgressDialog or wxGauge without sending an event to the main thread
+    for every step of the work. Instead, the worker just updates the progress
+    value stored in this object, which is done using atomic operations and
+    doesn't require any locking if they are available (see wxAtomicInc()), and
+    the dialog or the gauge periodically samples it on the main thread, see
+    wxProgressDialog::SetProgressSource() and wxGauge::SetProgressSource().
+    This means that the display is refreshed at a fixed rate, independently
+    of how often the progress changes.
+
+    Example of using it:
+    @code
+    class MyWorker : public wxThread
+    {
+    public:
+        MyWorker(wxProgressSource& progress)
+            : wxThread(wxTHREAD_JOINABLE), m_progress(progress) { }
+
+    protected:
+        virtual ExitCode Entry()
+        {
+            for ( int n = 0; n < 1000000; n++ )
+            {
+                if ( m_progress.IsCancelled() )
+                    break;
+
+                ... do something ...
+
+                m_progress.Advance();
+            }
+
+            return 0;
+        }
+
+    private:
+        wxProgressSource& m_progress;
+    };
+
+    void MyFrame::OnStart(wxCommandEvent&)
+    {
+        // m_progress is a wxProgressSource member of this frame.
+        m_progress.Reset();
+
+        m_dialog = new wxProgressDialog("Working", "Please wait...", 1000000,
+                                        this, wxPD_CAN_ABORT | wxPD_AUTO_HIDE);
+        m_dialog->SetProgressSource(&m_progress);
+
+        m_worker = new MyWorker(m_progress);
+        m_worker->Run();
+    }
+    @endcode
+
+    @library{wxbase}
+    @category{threading}
+
+    @since 3.1.4
+*/
+class wxProgressSource
+{
+public:
+    /**
+        Default constructor initializes the progress to 0.
+    */
+    wxProgressSource();
+
+    /**
+        Set the current progress value.
+
+        This function can be called from any thread.
+    */
+    void SetValue(int value);
+
+    /**
+        Increment the current progress value by one.
+
+        This function can be called from any thread, including from several
+        threads at once.
+    */
+    void Advance();
+
+    /**
+        Change the message associated with the progress.
+
+        This function can be called from any thread, but, unlike SetValue(),
+        it uses a critical section internally and so should be used rather
+        rarely.
+
+        Only the last message set before the progress is sampled is shown.
+    */
+    void SetMessage(const wxString& message);
+
+    /**
+        Returns @true if Cancel() was called.
+
+        The worker thread should call this function regularly and stop as soon
+        as possible if it returns @true.
+    */
+    bool IsCancelled() const;
+
+    /**
+        Request cancelling the operation.
+
+        This function is called by wxProgressDialog when the user cancels it,
+        but can also be called directly.
+    */
+    void Cancel();
+
+    /**
+        Returns the current progress value.
+
+        This function is used for sampling the progress.
+    */
+    int GetValue() const;
+
+    /**
+        Retrieves the new message, if it was changed.
+
+        Returns @true and fills @a message with the last message passed to
+        SetMessage() if it was called since the last call to this function or
+        just returns @false otherwise.
+    */
+    bool GetNewMessage(wxString& message);
+
+    /**
+        Reset the object to its initial state.
+
+        This function can be called to reuse the object for another operation,
+        but only when no worker threads use it.
+    */
+    void Reset();
+};
@@ -336,6 +336,32 @@ public:
 
     wxPGProperty* DoGetItemAtY( int y ) const;
 
+    /**
+        Returns the number of visible rows, i.e. of the properties which are
+        not hidden and whose parents are all expanded.
+
+        @since 3.1.4
+    */
+    unsigned int GetVisibleRowCount() const;
+
+    /**
+        Returns the property shown in the given row or @NULL if there is none.
+
+        The visible rows are indexed when they are needed for the first time
+        after a change, so this function takes constant time.
+
+        @since 3.1.4
+    */
+    wxPGProperty* GetPropertyAtRow( unsigned int row ) const;
+
+    /**
+        Returns the row in which the given property is shown or -1 if it is
+        hidden or one of its parents is collapsed.
+
+        @since 3.1.4
+    */
+    int GetRowOfProperty( const wxPGProperty* p ) const;
+
     /**
         Override this member function to add custom behaviour on property
         insertion.
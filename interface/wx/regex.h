@@ -221,6 +221,36 @@ public:
     */
     bool Matches(const wxString& text, int flags = 0) const;
 
+    //@{
+    /**
+        Checks all the given strings against the expression.
+
+        This function returns the number of strings matching the expression
+        and, if @a indices is non-@NULL, appends the indices of all of them to
+        it.
+
+        It is equivalent to calling Matches() for each of the strings, but is
+        significantly faster, as it doesn't need to compute the positions of
+        the matched subexpressions, which allows the regex engine to use a
+        simpler matching algorithm. Notice that, for the same reason,
+        GetMatch() can't be used after calling this function.
+
+        @e Flags may be combination of @c wxRE_NOTBOL and @c wxRE_NOTEOL, see
+        @ref wxRE_NOT_FLAGS, and are used for all strings.
+
+        May only be called after successful call to Compile().
+
+        @since 3.1.4
+    */
+    size_t Filter(const wxArrayString& strings,
+                  wxArrayInt* indices = NULL,
+                  int flags = 0) const;
+    size_t Filter(const wxString* strings,
+                  size_t count,
+                  wxArrayInt* indices = NULL,
+                  int flags = 0) const;
+    //@}
+
     /**
         Replaces the current regular expression in the string pointed to by
         @a text, with the text in @a replacement and return number of matches
@@ -276,5 +306,32 @@ public:
         @since 3.1.3
     */
     static wxString QuoteMeta(const wxString& str);
+
+    /**
+        Sets the maximal number of the compiled expressions kept in the cache.
+
+        Compiling a regular expression is relatively expensive, so wxRegEx
+        keeps the recently compiled expressions in a cache shared by the
+        entire program and reuses them when an expression with the same
+        pattern and flags is compiled again. The least recently used
+        expressions are removed from the cache when its size exceeds the
+        value set by this function, which is 64 by default.
+
+        @param size
+            The maximal number of cached expressions, 0 disables caching.
+
+        @since 3.1.4
+    */
+    static void SetCacheSize(size_t size);
+
+    /**
+        Returns the maximal number of the compiled expressions kept in the
+        cache.
+
+        @see SetCacheSize()
+
+        @since 3.1.4
+    */
+    static size_t GetCacheSize();
 };
 
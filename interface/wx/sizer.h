@@ -461,6 +461,42 @@ public:
     */
     void SetContainingWindow(wxWindow *window);
 
+    /**
+        Returns the sizer containing this one or @NULL if none.
+
+        @since 3.1.4
+    */
+    wxSizer* GetContainingSizer() const;
+
+    /**
+        Set the sizer containing this one.
+
+        This is done automatically when this sizer is added to another one and
+        normally doesn't need to be called by the application.
+
+        @since 3.1.4
+    */
+    void SetContainingSizer(wxSizer* sizer);
+
+    /**
+        Invalidates the cached minimal size of this sizer.
+
+        The minimal size computed by GetMinSize() is cached and only
+        recomputed when something affecting it changes. This function marks
+        the cached size of this sizer and of all the sizers containing it as
+        invalid and also invalidates the best size of the window using the
+        outermost sizer, see wxWindow::InvalidateBestSize().
+
+        It is called automatically when the items are added to or removed
+        from the sizer, their properties are modified and also when the best
+        size of any window in the sizer changes or it is shown or hidden.
+        However it must be called by the custom sizer classes when any of
+        their own parameters affecting their minimal size or layout change.
+
+        @since 3.1.4
+    */
+    void InvalidateMinSize();
+
     /**
        Returns the number of items in the sizer.
 
@@ -509,6 +545,11 @@ public:
         In particular, if you use the value to set toplevel window's minimal or
         actual size, use wxWindow::SetMinClientSize() or wxWindow::SetClientSize(),
         not wxWindow::SetMinSize() or wxWindow::SetSize().
+
+        Since wxWidgets 3.1.4 the returned value is cached until
+        InvalidateMinSize() is called, except for the sizers whose minimal
+        size depends on their current size, such as wxWrapSizer, and the
+        sizers containing them.
     */
     wxSize GetMinSize();
 
@@ -1115,6 +1156,24 @@ public:
     void AssignSpacer(int w, int h);
     //@}
 
+    /**
+        Returns the sizer containing this item or @NULL if it wasn't added to
+        any sizer yet.
+
+        @since 3.1.4
+    */
+    wxSizer* GetContainingSizer() const;
+
+    /**
+        Set the sizer containing this item.
+
+        This is done automatically when the item is added to a sizer and
+        normally doesn't need to be called by the application.
+
+        @since 3.1.4
+    */
+    void SetContainingSizer(wxSizer* sizer);
+
     /**
         Calculates the minimum desired size for the item, including any space
         needed by borders.
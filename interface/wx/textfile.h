@@ -298,3 +298,116 @@ public:
     wxString& operator[](size_t n) const;
 };
 
+
+
+/**
+    @class wxIndexedTextFile
+
+    wxIndexedTextFile provides read-only access to the lines of a text file
+    without loading the entire file in memory.
+
+    When the file is opened, it is scanned once to build a table of the line
+    offsets, but the lines themselves are only read from the file and
+    converted to wxString when they are accessed using GetLine(). This makes
+    it possible to work with the files which are too big for wxTextFile, e.g.
+    log files of several gigabytes, while still providing constant time access
+    to any line by its index.
+
+    Lines are recognized in the same way as by wxTextFile, i.e. DOS, Unix and
+    Mac line terminators are all understood and can be mixed in the same file.
+    However, as the file is indexed before decoding it, only the encodings in
+    which CR and LF characters are always represented by single bytes, such as
+    UTF-8 or any 8 bit encoding, are supported. Files starting with UTF-16 or
+    UTF-32 BOM can't be opened by this class.
+
+    Notice that this class is not thread-safe, even its const methods modify
+    the internal read buffer and the current position in the file.
+
+    @library{wxbase}
+    @category{file}
+
+    @see wxTextFile
+
+    @since 3.1.4
+*/
+class wxIndexedTextFile
+{
+public:
+    /**
+        Default constructor, use Open() to initialize the object.
+    */
+    wxIndexedTextFile();
+
+    /**
+        Constructor opening the given file.
+
+        Use IsOpened() to check whether it was successful.
+    */
+    wxIndexedTextFile(const wxString& strFile,
+                      const wxMBConv& conv = wxConvAuto());
+
+    /**
+        Destructor closes the file.
+    */
+    ~wxIndexedTextFile();
+
+    /**
+        Opens the file with the given name and builds its lines index.
+
+        The @a conv argument is used to convert the lines contents to wxString
+        when they are retrieved. If a line can't be converted using it, it is
+        interpreted as being in ISO-8859-1 encoding.
+
+        @return
+            @true if the file was successfully opened and indexed.
+    */
+    bool Open(const wxString& strFile, const wxMBConv& conv = wxConvAuto());
+
+    /**
+        Closes the file and frees the lines index.
+    */
+    bool Close();
+
+    /**
+        Returns @true if the file is currently opened.
+    */
+    bool IsOpened() const;
+
+    /**
+        Returns the name of the file.
+    */
+    const wxString& GetName() const;
+
+    /**
+        Returns the number of lines in the file.
+    */
+    size_t GetLineCount() const;
+
+    /**
+        Reads the line number @a n from the file.
+
+        The first line has index 0 and @a n must be less than GetLineCount().
+        The returned string doesn't contain the line terminator.
+
+        Accessing the lines sequentially is more efficient than accessing them
+        in random order, as the file data are read in bigger chunks then.
+    */
+    wxString GetLine(size_t n) const;
+
+    /**
+        Returns the type of the line terminator of the line @a n.
+
+        This function doesn't need to access the file.
+    */
+    wxTextFileType GetLineType(size_t n) const;
+
+    /**
+        Returns the offset of the start of the line @a n in the file.
+    */
+    wxFileOffset GetLineOffset(size_t n) const;
+
+    /**
+        The same as GetLine().
+    */
+    wxString operator[](size_t n) const;
+};
@@ -0,0 +1,383 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        interface/wx/threadpool.h
+// Purpose:     interface of wxThreadPool, wxThreadPoolTask and wxTaskGroup
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+    @class wxThreadPoolTask
+
+    Base class for the tasks executed by wxThreadPool.
+
+    Derive from this class and override its Run() method to perform the work
+    in one of the pool threads, then pass the object, which must be allocated
+    on the heap, to wxThreadPool::Queue() or wxTaskGroup::Queue(). For simple
+    cases, it is often more convenient to use wxThreadPool::Run() or
+    wxThreadPool::Async() taking a functor instead.
+
+    The tasks are reference-counted and are normally referenced by
+    wxThreadPoolTaskPtr smart pointer. The pool keeps its own reference to the
+    task until it is done, so the pointer returned by wxThreadPool::Queue()
+    may be simply ignored if the caller doesn't need to wait for the task.
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool, wxTaskGroup
+
+    @since 3.1.4
+*/
+class wxThreadPoolTask
+{
+public:
+    /**
+        Default constructor.
+
+        The task is created with the reference count of 1.
+    */
+    wxThreadPoolTask();
+
+    /**
+        Perform the task.
+
+        This function is called in one of the pool threads or, if another
+        thread is waiting for the task completion using Wait(), possibly in
+        that thread. In either case, it must not use any GUI functions.
+    */
+    virtual void Run() = 0;
+
+    /**
+        Called in the main thread when the task is done.
+
+        This function is only called if a non-@NULL handler was passed to
+        wxThreadPool::Queue(), using wxEvtHandler::CallAfter() on this
+        handler. Notice that the handler must remain alive until then.
+
+        Default implementation does nothing.
+    */
+    virtual void OnCompleted();
+
+    /**
+        Return @true if Run() has already returned.
+    */
+    bool IsDone() const;
+
+    /**
+        Wait until the task is done.
+
+        While waiting, the calling thread executes the other tasks queued in
+        the same pool, so it is safe to call this function from inside another
+        task, even if the pool has a single thread.
+
+        This function can only be called after queuing the task.
+    */
+    void Wait();
+
+    /**
+        Increment the reference count of the task.
+    */
+    void IncRef();
+
+    /**
+        Decrement the reference count and delete the task when it reaches 0.
+    */
+    void DecRef();
+
+protected:
+    /**
+        Destructor is protected, use DecRef() instead of deleting the task.
+    */
+    virtual ~wxThreadPoolTask();
+};
+
+/**
+    Smart pointer to wxThreadPoolTask.
+
+    @since 3.1.4
+*/
+typedef wxObjectDataPtr<wxThreadPoolTask> wxThreadPoolTaskPtr;
+
+
+/**
+    @class wxThreadPoolFuture
+
+    The value computed by a task executed by wxThreadPool.
+
+    Objects of this class are returned by wxThreadPool::Async() and
+    wxTaskGroup::Async() and can be used to retrieve the value returned by the
+    functor once it is computed. They are cheap to copy, all the copies refer
+    to the same task.
+
+    @tparam T Type of the value, must be default constructible and
+        assignable.
+
+    @library{wxbase}
+    @category{threading}
+
+    @since 3.1.4
+*/
+template <typename T>
+class wxThreadPoolFuture
+{
+public:
+    /**
+        Default constructor creates an invalid object.
+    */
+    wxThreadPoolFuture();
+
+    /**
+        Return @true if the object was returned by Async().
+    */
+    bool IsValid() const;
+
+    /**
+        Return @true if the value has been already computed.
+    */
+    bool IsReady() const;
+
+    /**
+        Wait until the value is computed.
+
+        @see wxThreadPoolTask::Wait()
+    */
+    void Wait() const;
+
+    /**
+        Return the value, waiting until it's computed if necessary.
+    */
+    const T& Get() const;
+
+    /**
+        Return the task computing the value.
+    */
+    wxThreadPoolTaskPtr GetTask() const;
+};
+
+
+/**
+    @class wxThreadPool
+
+    A fixed set of threads executing the tasks queued to it.
+
+    This class allows the different parts of the application to share the
+    same, bounded, number of threads for performing work in parallel, instead
+    of each of them creating its own threads and oversubscribing the CPUs. In
+    most cases, the global pool returned by Get() should be used, but it is
+    possible to create separate pools too.
+
+    Each pool thread has its own queue of tasks. The tasks queued from inside
+    a task executed by the pool are added to the queue of the current thread
+    and are executed in LIFO order, which is good for cache locality, while
+    the idle threads steal the oldest tasks from the queues of the other ones.
+    This allows the pool to efficiently handle both big numbers of small
+    tasks and the tasks recursively creating and waiting for sub-tasks.
+
+    Example of computing values in parallel and showing them in the GUI:
+    @code
+    struct ComputeChecksum
+    {
+        explicit ComputeChecksum(const wxString& path) : m_path(path) { }
+
+        wxUint32 operator()() const { ... read the file ... }
+
+        wxString m_path;
+    };
+
+    void MyFrame::StartChecksum(const wxString& path)
+    {
+        wxThreadPool::Get().Async<wxUint32>
+        (
+            ComputeChecksum(path),
+            this,
+            [this](wxUint32 crc) { m_text->SetValue(wxString::Format("%08x", crc)); }
+        );
+    }
+    @endcode
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxTaskGroup, wxThread
+
+    @since 3.1.4
+*/
+class wxThreadPool
+{
+public:
+    /**
+        Create the pool with the given number of threads.
+
+        By default, i.e. if @a numThreads is -1 or 0, the number of threads is
+        wxThread::GetCPUCount().
+    */
+    explicit wxThreadPool(int numThreads = -1);
+
+    /**
+        Destructor waits until all the tasks already queued are executed and
+        terminates the pool threads.
+    */
+    ~wxThreadPool();
+
+    /**
+        Return the global pool.
+
+        The global pool is created with the default number of threads when
+        this function is called for the first time and is destroyed when the
+        library is cleaned up.
+    */
+    static wxThreadPool& Get();
+
+    /**
+        Return the number of threads in the pool.
+    */
+    int GetThreadCount() const;
+
+    /**
+        Queue the task for execution.
+
+        The task must be allocated on the heap and the returned pointer takes
+        ownership of the reference to it which it has initially. Each task
+        may only be queued once.
+
+        @param task The task to execute.
+        @param handler If non-@NULL, wxThreadPoolTask::OnCompleted() is
+            called in the main thread using wxEvtHandler::CallAfter() on this
+            handler once the task is done.
+    */
+    wxThreadPoolTaskPtr Queue(wxThreadPoolTask* task,
+                              wxEvtHandler* handler = NULL);
+
+    /**
+        Execute the given functor, which takes no arguments, in the pool.
+    */
+    template <typename F>
+    wxThreadPoolTaskPtr Run(const F& fn);
+
+    /**
+        Execute the given functor in the pool and call @a onDone, which also
+        takes no arguments, in the main thread after the functor returns.
+
+        @a onDone is called using wxEvtHandler::CallAfter() on @a handler.
+    */
+    template <typename F, typename G>
+    wxThreadPoolTaskPtr Run(const F& fn, wxEvtHandler* handler, const G& onDone);
+
+    /**
+        Compute the value returned by the given functor in the pool.
+
+        The type of the value must be specified explicitly, e.g.
+        @code
+        wxThreadPoolFuture<int> f = wxThreadPool::Get().Async<int>(fn);
+        ...
+        int value = f.Get();
+        @endcode
+    */
+    template <typename T, typename F>
+    wxThreadPoolFuture<T> Async(const F& fn);
+
+    /**
+        Compute the value returned by the given functor in the pool and pass
+        it to @a onDone in the main thread.
+
+        @a onDone is called using wxEvtHandler::CallAfter() on @a handler and
+        must take a single argument of type @c T or <tt>const T&</tt>.
+    */
+    template <typename T, typename F, typename G>
+    wxThreadPoolFuture<T> Async(const F& fn, wxEvtHandler* handler, const G& onDone);
+};
+
+
+/**
+    @class wxTaskGroup
+
+    Group of tasks which can be waited for together.
+
+    This class has the same functions for queuing the tasks as wxThreadPool
+    itself, with the difference that the tasks are added to this group and
+    can be waited for using Wait(). The destructor also waits for all the
+    tasks of the group, so the usual way to use this class is:
+    @code
+    {
+        wxTaskGroup group;
+        for ( size_t n = 0; n < images.size(); n++ )
+            group.Run(ProcessImage(images[n]));
+    } // All images are processed here.
+    @endcode
+
+    Task groups can be used from inside the tasks, e.g. to recursively split
+    the work into smaller pieces.
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool
+
+    @since 3.1.4
+*/
+class wxTaskGroup
+{
+public:
+    /**
+        Create the group using the given pool, which must outlive it.
+    */
+    explicit wxTaskGroup(wxThreadPool& pool = wxThreadPool::Get());
+
+    /**
+        Destructor waits until all the tasks of the group are done.
+    */
+    ~wxTaskGroup();
+
+    /**
+        Queue the task as part of this group.
+
+        @see wxThreadPool::Queue()
+    */
+    wxThreadPoolTaskPtr Queue(wxThreadPoolTask* task,
+                              wxEvtHandler* handler = NULL);
+
+    /**
+        Execute the functor as part of this group.
+
+        @see wxThreadPool::Run()
+    */
+    template <typename F>
+    wxThreadPoolTaskPtr Run(const F& fn);
+
+    /**
+        Execute the functor as part of this group and call @a onDone in the
+        main thread once it is done.
+
+        @see wxThreadPool::Run()
+    */
+    template <typename F, typename G>
+    wxThreadPoolTaskPtr Run(const F& fn, wxEvtHandler* handler, const G& onDone);
+
+    /**
+        Compute the value returned by the functor as part of this group.
+
+        @see wxThreadPool::Async()
+    */
+    template <typename T, typename F>
+    wxThreadPoolFuture<T> Async(const F& fn);
+
+    /**
+        Return @true if all the tasks of the group are done.
+    */
+    bool IsDone() const;
+
+    /**
+        Wait until all the tasks of the group are done.
+
+        As with wxThreadPoolTask::Wait(), the calling thread executes the
+        queued tasks while waiting.
+    */
+    void Wait();
+
+    /**
+        Return the pool used by this group.
+    */
+    wxThreadPool& GetPool() const;
+};
@@ -149,6 +149,7 @@ static const int wxTREE_ITEMSTATE_PREV  = -3;   // cycle to the previous state
 #define wxTR_HIDE_ROOT               0x0800     // don't display root node
 
 #define wxTR_FULL_ROW_HIGHLIGHT      0x2000     // highlight full horz space
+#define wxTR_VIRTUAL                 0x4000     // items provided by callbacks
 
 // make the default control appearance look more native-like depending on the
 // platform
@@ -63,6 +63,21 @@
     @style{wxTR_MULTIPLE}
         Use this style to allow a range of items to be selected. If a second
         range is selected, the current range, if any, is deselected.
+    @style{wxTR_VIRTUAL}
+        The application provides the items on demand by overriding
+        OnGetChildrenCount(), OnGetItemText() and, optionally,
+        OnGetItemImage() and OnGetItemData(). Only the root item is added
+        explicitly, using AddRoot(), and the other items are only created when
+        they become visible or are accessed using the navigation functions,
+        allowing to show trees with millions of items. Items can't be inserted,
+        deleted individually or sorted in this mode, use DeleteChildren() to
+        update the children of an item after they change. All rows have the
+        same height and only the parts of the lines connecting the items which
+        cross the visible rows are drawn. Finding the position of an item or
+        the item at the given position takes time logarithmic in the number of
+        children at each level of the tree, while expanding or collapsing an
+        item takes time linear in the number of its children. Generic only,
+        this style is available since wxWidgets 3.1.4.
     @style{wxTR_DEFAULT_STYLE}
         The set of flags that are closest to the defaults for the native control
         for a particular toolkit.
@@ -790,6 +805,65 @@ public:
     virtual int OnCompareItems(const wxTreeItemId& item1,
                                const wxTreeItemId& item2);
 
+    /**
+        This function @b must be overridden in the derived class for a control
+        with @c wxTR_VIRTUAL style. It should return the number of children of
+        the given item.
+
+        It is called for the root item when it is added and for every other
+        item when it is created, to determine whether it has any children, and
+        then again when the item is expanded.
+
+        This function is only available in the generic version.
+
+        @see OnGetItemText()
+
+        @since 3.1.4
+    */
+    virtual size_t OnGetChildrenCount(const wxTreeItemId& item) const;
+
+    /**
+        This function may be overridden in the derived class for a control
+        with @c wxTR_VIRTUAL style to associate data with the @a n-th child of
+        the given @a parent item when it is created. The tree control takes
+        ownership of the returned object.
+
+        The base class version always returns @NULL.
+
+        This function is only available in the generic version.
+
+        @since 3.1.4
+    */
+    virtual wxTreeItemData *OnGetItemData(const wxTreeItemId& parent,
+                                          size_t n) const;
+
+    /**
+        This function must be overridden in the derived class for a control
+        with @c wxTR_VIRTUAL style having an image list (see SetImageList()).
+        It should return the index of the image of the @a n-th child of the
+        given @a parent item in the image list or -1 for no image.
+
+        The base class version always returns -1.
+
+        This function is only available in the generic version.
+
+        @since 3.1.4
+    */
+    virtual int OnGetItemImage(const wxTreeItemId& parent, size_t n) const;
+
+    /**
+        This function @b must be overridden in the derived class for a control
+        with @c wxTR_VIRTUAL style. It should return the text of the @a n-th
+        child of the given @a parent item.
+
+        This function is only available in the generic version.
+
+        @see OnGetChildrenCount(), OnGetItemImage(), OnGetItemData()
+
+        @since 3.1.4
+    */
+    virtual wxString OnGetItemText(const wxTreeItemId& parent, size_t n) const;
+
     /**
         Appends an item as the first child of @a parent, return a new item id.
 
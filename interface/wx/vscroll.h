@@ -73,6 +73,36 @@ public:
     */
     void EnablePhysicalScrolling(bool scrolling = true);
 
+    /**
+        Enables or disables caching the sizes of all units.
+
+        By default, the sizes of the units are retrieved by calling
+        OnGetUnitSize() whenever they are needed, which means that computing
+        the scroll offset of the window or finding the unit at the given
+        position takes time proportional to the number of units. When the
+        cache is enabled, the sizes of all units are retrieved once, when they
+        are needed for the first time after SetUnitCount() call, and stored
+        in an index allowing to perform these operations in logarithmic time
+        instead, which is worth doing for windows with a very large number of
+        units of variable size.
+
+        Notice that when using the cache, RefreshUnit(), RefreshUnits() or
+        RefreshAll() must be called whenever the size of any unit changes to
+        update it.
+
+        @since 3.1.4
+    */
+    void EnableUnitSizeCache(bool enable = true);
+
+    /**
+        Returns @true if the unit sizes cache is enabled.
+
+        @see EnableUnitSizeCache()
+
+        @since 3.1.4
+    */
+    bool IsUnitSizeCacheEnabled() const;
+
     /**
         This function needs to be overridden in the in the derived class to
         return the window size with respect to the opposing orientation. If
@@ -520,6 +550,20 @@ public:
     void EnablePhysicalScrolling(bool vscrolling = true,
                                  bool hscrolling = true);
 
+    /**
+        Enables or disables caching the sizes of rows and/or columns.
+
+        @param vcache
+            Specifies if the row heights should be cached.
+        @param hcache
+            Specifies if the column widths should be cached.
+
+        @see wxVarScrollHelperBase::EnableUnitSizeCache()
+
+        @since 3.1.4
+    */
+    void EnableUnitSizeCache(bool vcache = true, bool hcache = true);
+
     /**
         Returns the number of columns and rows the target window contains.
 
@@ -2136,6 +2136,7 @@ bool wxAuiToolBar::RealizeHelper(wxClientDC& dc, bool horizontal)
     wxSize size = m_sizer->GetMinSize();
     m_minWidth = size.x;
     m_minHeight = size.y;
+    InvalidateBestSize();
 
     if ((m_windowStyle & wxAUI_TB_NO_AUTORESIZE) == 0)
     {
@@ -2736,6 +2736,100 @@ void wxAuiManager::DoFrameLayout()
     }
 }
 
+// DoFrameLayoutAndRefresh() is used instead of DoFrameLayout() followed by
+// Repaint() when the UI parts are not recreated: it only refreshes the parts
+// which were moved or resized, which is much faster than repainting all of
+// them when there are many panes
+
+void wxAuiManager::DoFrameLayoutAndRefresh()
+{
+    int i, part_count = m_uiParts.GetCount();
+
+    wxAuiRectArray old_part_rects;
+    for (i = 0; i < part_count; ++i)
+        old_part_rects.Add(m_uiParts.Item(i).rect);
+
+    DoFrameLayout();
+
+    // the parts are drawn with the client area origin offset, see Repaint()
+    const wxPoint origin = m_frame->GetClientAreaOrigin();
+
+    for (i = 0; i < part_count; ++i)
+    {
+        wxAuiDockUIPart& part = m_uiParts.Item(i);
+        wxRect old_rect = old_part_rects[i];
+        if (part.rect == old_rect)
+            continue;
+
+        wxRect new_rect = part.rect;
+        old_rect.Offset(origin);
+        new_rect.Offset(origin);
+        m_frame->RefreshRect(old_rect, false);
+        m_frame->RefreshRect(new_rect, false);
+
+        if (part.type == wxAuiDockUIPart::typePane &&
+                part.pane->window && part.pane->window->IsShown())
+        {
+            part.pane->window->Refresh();
+        }
+    }
+}
+
+// UpdateSizes() is a lightweight version of Update() which can only be used
+// if nothing but the dock sizes and pane proportions changed since the last
+// call to Update(), as is the case when a sash is dragged.  Instead of
+// recreating all the sizers and the UI parts, it just updates the sizer items
+// of the docks and panes and lays them out again.
+
+void wxAuiManager::UpdateSizes()
+{
+    int i, part_count;
+    for (i = 0, part_count = m_uiParts.GetCount(); i < part_count; ++i)
+    {
+        wxAuiDockUIPart& part = m_uiParts.Item(i);
+
+        if (part.type == wxAuiDockUIPart::typeDock)
+        {
+            // see LayoutAll() and LayoutAddDock()
+            wxAuiDockInfo& dock = *part.dock;
+            if (dock.size < dock.min_size)
+                dock.size = dock.min_size;
+
+            // the minimal size of an item containing a sizer is always taken
+            // from the sizer itself, so it must be set there and not just on
+            // the item, which would be overwritten during the next layout
+            wxSizer* const dock_sizer = part.sizer_item->GetSizer();
+            wxCHECK_RET( dock_sizer, "dock part must contain the dock sizer" );
+
+            if (dock.IsHorizontal())
+                part.cont_sizer->SetItemMinSize(dock_sizer, 0, dock.size);
+            else
+                part.cont_sizer->SetItemMinSize(dock_sizer, dock.size, 0);
+        }
+        else if (part.type == wxAuiDockUIPart::typePane)
+        {
+            // the pane window is in the vertical pane sizer, which is in the
+            // horizontal one added to the dock sizer, see LayoutAddPane()
+            wxSizer* const horz_pane_sizer = part.cont_sizer->GetContainingSizer();
+            wxCHECK_RET( horz_pane_sizer, "pane sizer must be in a sizer" );
+
+            wxSizer* const dock_sizer = horz_pane_sizer->GetContainingSizer();
+            wxCHECK_RET( dock_sizer, "pane sizer must be in a dock sizer" );
+
+            wxSizerItem* const sizer_item = dock_sizer->GetItem(horz_pane_sizer);
+            wxCHECK_RET( sizer_item, "pane sizer item not found" );
+
+            const wxAuiPaneInfo& pane = *part.pane;
+            if (pane.IsFixed() && pane.min_size == wxDefaultSize)
+                sizer_item->SetProportion(0);
+            else
+                sizer_item->SetProportion(pane.dock_proportion);
+        }
+    }
+
+    DoFrameLayoutAndRefresh();
+}
+
 // GetPanePart() looks up the pane the pane border UI part (or the regular
 // pane part if there is no border). This allows the caller to get the exact
 // rectangle of the pane in question, including decorations like
@@ -3951,8 +4045,7 @@ void wxAuiManager::OnSize(wxSizeEvent& event)
 {
     if (m_frame)
     {
-        DoFrameLayout();
-        Repaint();
+        DoFrameLayoutAndRefresh();
 
 #if wxUSE_MDI
         if (wxDynamicCast(m_frame, wxMDIParentFrame))
@@ -4249,8 +4342,10 @@ bool wxAuiManager::DoEndResizeAction(wxMouseEvent& event)
             break;
         }
 
-        Update();
-        Repaint(NULL);
+        // only the size of the dock has changed, so there is no need to
+        // recreate the layout, and repaint immediately for live resizing
+        UpdateSizes();
+        m_frame->Update();
     }
     else if (m_actionPart &&
         m_actionPart->type == wxAuiDockUIPart::typePaneSizer)
@@ -4419,9 +4514,9 @@ bool wxAuiManager::DoEndResizeAction(wxMouseEvent& event)
         pane.dock_proportion = new_proportion;
 
 
-        // repaint
-        Update();
-        Repaint(NULL);
+        // only the proportions have changed, so just update the layout
+        UpdateSizes();
+        m_frame->Update();
     }
 
     return true;
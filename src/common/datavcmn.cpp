@@ -94,6 +94,40 @@ wxFont wxDataViewItemAttr::GetEffectiveFont(const wxFont& font) const
     return f;
 }
 
+// ----------------------------------------------------------------------------
+// wxDataViewSortKey
+// ----------------------------------------------------------------------------
+
+int wxDataViewSortKey::Compare(const wxDataViewSortKey& other) const
+{
+    if ( m_kind != other.m_kind )
+        return m_kind < other.m_kind ? -1 : 1;
+
+    switch ( m_kind )
+    {
+        case Kind_None:
+            break;
+
+        case Kind_Integer:
+            if ( m_integer < other.m_integer )
+                return -1;
+            if ( m_integer > other.m_integer )
+                return 1;
+            break;
+
+        case Kind_Double:
+            if ( m_double < other.m_double )
+                return -1;
+            if ( m_double > other.m_double )
+                return 1;
+            break;
+
+        case Kind_String:
+            return m_string.Cmp(other.m_string);
+    }
+
+    return 0;
+}
 
 // ---------------------------------------------------------
 // wxDataViewModelNotifier
@@ -420,6 +454,52 @@ int wxDataViewModel::Compare( const wxDataViewItem &item1, const wxDataViewItem
     return ascending ? id1 - id2 : id2 - id1;
 }
 
+void wxDataViewModel::GetSortKey(wxDataViewSortKey& key,
+                                 const wxDataViewItem& item,
+                                 unsigned int column) const
+{
+    key.Clear();
+
+    // Don't call GetValue() for the cells without values, as Compare() does.
+    if ( !HasValue(item, column) )
+        return;
+
+    wxVariant value;
+    GetValue(value, item, column);
+
+    const wxString type = value.GetType();
+    if ( type == wxT("string") )
+    {
+        key.SetString(value.GetString());
+    }
+    else if ( type == wxT("long") )
+    {
+        key.SetInteger(value.GetLong());
+    }
+    else if ( type == wxT("double") )
+    {
+        key.SetDouble(value.GetDouble());
+    }
+#if wxUSE_DATETIME
+    else if ( type == wxT("datetime") )
+    {
+        key.SetInteger(value.GetDateTime().GetValue());
+    }
+#endif // wxUSE_DATETIME
+    else if ( type == wxT("bool") )
+    {
+        key.SetInteger(value.GetBool());
+    }
+    else if ( type == wxT("wxDataViewIconText") )
+    {
+        wxDataViewIconText iconText;
+        iconText << value;
+
+        key.SetString(iconText.GetText());
+    }
+    //else: leave the key empty, the values of other types can't be compared
+}
+
 // ---------------------------------------------------------
 // wxDataViewIndexListModel
 // ---------------------------------------------------------
@@ -47,6 +47,7 @@
 #include "wx/thread.h"
 
 #include <ctype.h>
+#include <limits.h>
 
 #ifdef __WINDOWS__
     #include <winnls.h>
@@ -55,6 +56,8 @@
 
 #include "wx/datetime.h"
 #include "wx/time.h"
+#include "wx/scopedarray.h"
+#include "wx/vector.h"
 
 // ============================================================================
 // implementation of wxDateTime
@@ -99,22 +102,43 @@ bool GetNumericToken(size_t len,
                      unsigned long *number,
                      size_t *numScannedDigits = NULL)
 {
-    size_t n = 1;
-    wxString s;
+    // Accumulate the value directly instead of collecting the digits into a
+    // temporary string and converting it as this function is called for each
+    // numeric field of every parsed date.
+    size_t n = 0;
+    unsigned long value = 0;
+    bool ok = true;
     while ( p != end && wxIsdigit(*p) )
     {
-        s += *p++;
+        const wxUniChar ch = *p++;
+        if ( ch < wxS('0') || ch > wxS('9') )
+        {
+            // Some non-ASCII digit, we can't handle it.
+            ok = false;
+        }
+        else
+        {
+            const unsigned long digit = ch - wxS('0');
+            if ( value > (ULONG_MAX - digit) / 10 )
+                ok = false; // overflow
+            else
+                value = 10*value + digit;
+        }
 
-        if ( len && ++n > len )
+        if ( ++n == len )
             break;
     }
 
     if (numScannedDigits)
     {
-        *numScannedDigits = n - 1;
+        *numScannedDigits = n;
     }
 
-    return !s.empty() && s.ToULong(number);
+    if ( !n || !ok )
+        return false;
+
+    *number = value;
+    return true;
 }
 
 // scans all alphabetic characters and returns the resulting string
@@ -309,6 +333,371 @@ ParseFormatAt(wxString::const_iterator& p,
     return dt;
 }
 
+// Parses the time zone offset in ISO 8601 format, i.e. either "Z" or
+// [+-]HH[[:]MM], and returns it in seconds in timeZone.
+bool ParseTimeZoneOffset(wxString::const_iterator& input,
+                         const wxString::const_iterator& end,
+                         bool* haveTimeZone,
+                         long* timeZone)
+{
+    // check that we have something here at all
+    if ( input == end )
+        return false;
+
+    if ( *input == wxS('Z') )
+    {
+        // Time is in UTC.
+        ++input;
+        *haveTimeZone = true;
+        return true;
+    }
+
+    // Check if there's either a plus, hyphen-minus, or minus sign.
+    bool minusFound;
+    if ( *input == wxS('+') )
+        minusFound = false;
+    else if
+    (
+        *input == wxS('-')
+#if wxUSE_UNICODE
+        || *input == wxString::FromUTF8("\xe2\x88\x92")
+#endif
+    )
+        minusFound = true;
+    else
+        return false;   // no match
+
+    ++input;
+
+    // Here should follow exactly 2 digits for hours (HH).
+    const size_t numRequiredDigits = 2;
+    size_t numScannedDigits;
+
+    unsigned long hours;
+    if ( !GetNumericToken(numRequiredDigits, input, end,
+                          &hours, &numScannedDigits)
+         || numScannedDigits != numRequiredDigits)
+    {
+        return false; // No match.
+    }
+
+    // Optionally followed by a colon separator.
+    bool mustHaveMinutes = false;
+    if ( input != end && *input == wxS(':') )
+    {
+        mustHaveMinutes = true;
+        ++input;
+    }
+
+    // Optionally followed by exactly 2 digits for minutes (MM).
+    unsigned long minutes = 0;
+    if ( !GetNumericToken(numRequiredDigits, input, end,
+                          &minutes, &numScannedDigits)
+         || numScannedDigits != numRequiredDigits)
+    {
+        if (mustHaveMinutes || numScannedDigits)
+        {
+            // No match if we must have minutes, or digits
+            // for minutes were specified but not exactly 2.
+            return false;
+        }
+    }
+
+    /*
+    Contemporary offset limits are -12:00 and +14:00.
+    However historically offsets of over +/- 15 hours
+    existed so be a bit more flexible. Info retrieved
+    from Time Zone Database at
+    https://www.iana.org/time-zones.
+    */
+    if ( hours > 15 || minutes > 59 )
+        return false;   // bad format
+
+    *timeZone = 3600*hours + 60*minutes;
+    if ( minusFound )
+        *timeZone = -*timeZone;
+
+    *haveTimeZone = true;
+
+    return true;
+}
+
+// The fields found while parsing a date using a format string, used by both
+// wxDateTime::ParseFormat() and wxDateTimeFormatter::Parse().
+struct ParsedDateFields
+{
+    ParsedDateFields()
+    {
+        haveWDay =
+        haveYDay =
+        haveDay =
+        haveMon =
+        haveYear =
+        haveHour =
+        haveMin =
+        haveSec =
+        haveMsec = false;
+
+        hourIsIn12hFormat =
+        isPM = false;
+
+        haveTimeZone = false;
+
+        msec =
+        sec =
+        min =
+        hour = 0;
+        wday = wxDateTime::Inv_WeekDay;
+        yday =
+        mday = 0;
+        mon = wxDateTime::Inv_Month;
+        year = 0;
+        timeZone = 0;
+    }
+
+    // Parse the numeric field corresponding to the given format specifier,
+    // which must be one of "deHIjlmMSwyY", and store it. Returns false if
+    // there is no valid number for this field in the input.
+    bool ParseNumber(wxUniChar spec,
+                     size_t width,
+                     wxString::const_iterator& input,
+                     const wxString::const_iterator& end);
+
+    // Construct the date from the fields found, taking the missing ones from
+    // dateDef if it's valid, dt itself if it is or today otherwise. Returns
+    // false if the fields are inconsistent.
+    bool ApplyTo(wxDateTime& dt, const wxDateTime& dateDef) const;
+
+    // what fields have we found?
+    bool haveWDay,
+         haveYDay,
+         haveDay,
+         haveMon,
+         haveYear,
+         haveHour,
+         haveMin,
+         haveSec,
+         haveMsec;
+
+    bool hourIsIn12hFormat, // or in 24h one?
+         isPM;              // AM by default
+
+    bool haveTimeZone;
+
+    // and the value of the items we have
+    wxDateTime::wxDateTime_t msec,
+                             sec,
+                             min,
+                             hour;
+    wxDateTime::WeekDay wday;
+    wxDateTime::wxDateTime_t yday,
+                             mday;
+    wxDateTime::Month mon;
+    int year;
+    long timeZone;  // time zone in seconds as expected in Tm structure
+};
+
+bool ParsedDateFields::ParseNumber(wxUniChar spec,
+                                   size_t width,
+                                   wxString::const_iterator& input,
+                                   const wxString::const_iterator& end)
+{
+    unsigned long num;
+    if ( !GetNumericToken(width, input, end, &num) )
+        return false;
+
+    switch ( spec.GetValue() )
+    {
+        case wxT('d'):       // day of a month (01-31)
+        case 'e':           // day of a month (1-31) (GNU extension)
+            if ( (num > 31) || (num < 1) )
+                return false;
+
+            // we can't check whether the day range is correct yet, will
+            // do it later - assume ok for now
+            haveDay = true;
+            mday = (wxDateTime::wxDateTime_t)num;
+            break;
+
+        case wxT('H'):       // hour in 24h format (00-23)
+            if ( num > 23 )
+                return false;
+
+            haveHour = true;
+            hour = (wxDateTime::wxDateTime_t)num;
+            break;
+
+        case wxT('I'):       // hour in 12h format (01-12)
+            if ( !num || (num > 12) )
+                return false;
+
+            haveHour = true;
+            hourIsIn12hFormat = true;
+            hour = (wxDateTime::wxDateTime_t)(num % 12);        // 12 should be 0
+            break;
+
+        case wxT('j'):       // day of the year
+            if ( !num || (num > 366) )
+                return false;
+
+            haveYDay = true;
+            yday = (wxDateTime::wxDateTime_t)num;
+            break;
+
+        case wxT('l'):       // milliseconds (0-999)
+            haveMsec = true;
+            msec = (wxDateTime::wxDateTime_t)num;
+            break;
+
+        case wxT('m'):       // month as a number (01-12)
+            if ( !num || (num > 12) )
+                return false;
+
+            haveMon = true;
+            mon = (wxDateTime::Month)(num - 1);
+            break;
+
+        case wxT('M'):       // minute as a decimal number (00-59)
+            if ( num > 59 )
+                return false;
+
+            haveMin = true;
+            min = (wxDateTime::wxDateTime_t)num;
+            break;
+
+        case wxT('S'):       // second as a decimal number (00-61)
+            if ( num > 61 )
+                return false;
+
+            haveSec = true;
+            sec = (wxDateTime::wxDateTime_t)num;
+            break;
+
+        case wxT('w'):       // weekday as a number (0-6), Sunday = 0
+            if ( num > 6 )
+                return false;
+
+            haveWDay = true;
+            wday = (wxDateTime::WeekDay)num;
+            break;
+
+        case wxT('y'):       // year without century (00-99)
+            if ( num > 99 )
+                return false;
+
+            haveYear = true;
+
+            // TODO should have an option for roll over date instead of
+            //      hard coding it here
+            year = (num > 30 ? 1900 : 2000) + (wxDateTime::wxDateTime_t)num;
+            break;
+
+        case wxT('Y'):       // year with century
+            haveYear = true;
+            year = (wxDateTime::wxDateTime_t)num;
+            break;
+
+        default:
+            wxFAIL_MSG( "not a numeric format specifier" );
+            return false;
+    }
+
+    return true;
+}
+
+bool ParsedDateFields::ApplyTo(wxDateTime& dt, const wxDateTime& dateDef) const
+{
+    wxDateTime::Tm tmDef;
+    if ( dateDef.IsValid() )
+    {
+        // take this date as default
+        tmDef = dateDef.GetTm();
+    }
+    else if ( dt.IsValid() )
+    {
+        // if this date is valid, don't change it
+        tmDef = dt.GetTm();
+    }
+    else
+    {
+        // no default and this date is invalid - fall back to Today()
+        tmDef = wxDateTime::Today().GetTm();
+    }
+
+    wxDateTime::Tm tm = tmDef;
+
+    // set the date
+    if ( haveMon )
+    {
+        tm.mon = mon;
+    }
+
+    if ( haveYear )
+    {
+        tm.year = year;
+    }
+
+    // TODO we don't check here that the values are consistent, if both year
+    //      day and month/day were found, we just ignore the year day and we
+    //      also always ignore the week day
+    if ( haveDay )
+    {
+        if ( mday > wxDateTime::GetNumberOfDays(tm.mon, tm.year) )
+            return false;
+
+        tm.mday = mday;
+    }
+    else if ( haveYDay )
+    {
+        if ( yday > wxDateTime::GetNumberOfDays(tm.year) )
+            return false;
+
+        wxDateTime::Tm tm2 = wxDateTime(1, wxDateTime::Jan, tm.year).
+                                SetToYearDay(yday).GetTm();
+
+        tm.mon = tm2.mon;
+        tm.mday = tm2.mday;
+    }
+
+    // set the time
+    if ( haveHour )
+    {
+        tm.hour = hour;
+
+        // deal with AM/PM
+        if ( hourIsIn12hFormat && isPM )
+        {
+            // translate to 24hour format
+            tm.hour += 12;
+        }
+        //else: either already in 24h format or no translation needed
+    }
+
+    if ( haveMin )
+    {
+        tm.min = min;
+    }
+
+    if ( haveSec )
+    {
+        tm.sec = sec;
+    }
+
+    if ( haveMsec )
+        tm.msec = msec;
+
+    dt.Set(tm);
+
+    if ( haveTimeZone )
+        dt.MakeFromTimezone(timeZone);
+
+    // finally check that the week day is consistent -- if we had it
+    if ( haveWDay && dt.GetWeekDay() != wday )
+        return false;
+
+    return true;
+}
+
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
@@ -990,36 +1379,7 @@ wxDateTime::ParseFormat(const wxString& date,
     wxCHECK_MSG( !format.empty(), false, "format can't be empty" );
     wxCHECK_MSG( endParse, false, "end iterator pointer must be specified" );
 
-    wxString str;
-    unsigned long num;
-
-    // what fields have we found?
-    bool haveWDay = false,
-         haveYDay = false,
-         haveDay = false,
-         haveMon = false,
-         haveYear = false,
-         haveHour = false,
-         haveMin = false,
-         haveSec = false,
-         haveMsec = false;
-
-    bool hourIsIn12hFormat = false, // or in 24h one?
-         isPM = false;              // AM by default
-
-    bool haveTimeZone = false;
-
-    // and the value of the items we have (init them to get rid of warnings)
-    wxDateTime_t msec = 0,
-                 sec = 0,
-                 min = 0,
-                 hour = 0;
-    WeekDay wday = Inv_WeekDay;
-    wxDateTime_t yday = 0,
-                 mday = 0;
-    wxDateTime::Month mon = Inv_Month;
-    int year = 0;
-    long timeZone = 0;  // time zone in seconds as expected in Tm structure
+    ParsedDateFields fields;
 
     wxString::const_iterator input = date.begin();
     const wxString::const_iterator end = date.end();
@@ -1091,37 +1451,37 @@ wxDateTime::ParseFormat(const wxString& date,
             case wxT('a'):       // a weekday name
             case wxT('A'):
                 {
-                    wday = GetWeekDayFromName
+                    fields.wday = GetWeekDayFromName
                            (
                             input, end,
                             *fmt == 'a' ? Name_Abbr : Name_Full,
                             DateLang_Local
                            );
-                    if ( wday == Inv_WeekDay )
+                    if ( fields.wday == Inv_WeekDay )
                     {
                         // no match
                         return false;
                     }
                 }
-                haveWDay = true;
+                fields.haveWDay = true;
                 break;
 
             case wxT('b'):       // a month name
             case wxT('B'):
                 {
-                    mon = GetMonthFromName
+                    fields.mon = GetMonthFromName
                           (
                             input, end,
                             *fmt == 'b' ? Name_Abbr : Name_Full,
                             DateLang_Local
                           );
-                    if ( mon == Inv_Month )
+                    if ( fields.mon == Inv_Month )
                     {
                         // no match
                         return false;
                     }
                 }
-                haveMon = true;
+                fields.haveMon = true;
                 break;
 
             case wxT('c'):       // locale default date and time  representation
@@ -1152,100 +1512,33 @@ wxDateTime::ParseFormat(const wxString& date,
 
                     const Tm tm = dt.GetTm();
 
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
+                    fields.sec = tm.sec;
 
-                    year = tm.year;
-                    mon = tm.mon;
-                    mday = tm.mday;
+                    fields.year = tm.year;
+                    fields.mon = tm.mon;
+                    fields.mday = tm.mday;
 
-                    haveDay = haveMon = haveYear =
-                    haveHour = haveMin = haveSec = true;
+                    fields.haveDay = fields.haveMon = fields.haveYear =
+                    fields.haveHour = fields.haveMin = fields.haveSec = true;
                 }
                 break;
 
             case wxT('d'):       // day of a month (01-31)
             case 'e':           // day of a month (1-31) (GNU extension)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (num > 31) || (num < 1) )
-                {
-                    // no match
-                    return false;
-                }
-
-                // we can't check whether the day range is correct yet, will
-                // do it later - assume ok for now
-                haveDay = true;
-                mday = (wxDateTime_t)num;
-                break;
-
             case wxT('H'):       // hour in 24h format (00-23)
-                if ( !GetNumericToken(width, input, end, &num) || (num > 23) )
-                {
-                    // no match
-                    return false;
-                }
-
-                haveHour = true;
-                hour = (wxDateTime_t)num;
-                break;
-
             case wxT('I'):       // hour in 12h format (01-12)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        !num || (num > 12) )
-                {
-                    // no match
-                    return false;
-                }
-
-                haveHour = true;
-                hourIsIn12hFormat = true;
-                hour = (wxDateTime_t)(num % 12);        // 12 should be 0
-                break;
-
             case wxT('j'):       // day of the year
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        !num || (num > 366) )
-                {
-                    // no match
-                    return false;
-                }
-
-                haveYDay = true;
-                yday = (wxDateTime_t)num;
-                break;
-
             case wxT('l'):       // milliseconds (0-999)
-                if ( !GetNumericToken(width, input, end, &num) )
-                    return false;
-
-                haveMsec = true;
-                msec = (wxDateTime_t)num;
-                break;
-
             case wxT('m'):       // month as a number (01-12)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        !num || (num > 12) )
-                {
-                    // no match
-                    return false;
-                }
-
-                haveMon = true;
-                mon = (Month)(num - 1);
-                break;
-
             case wxT('M'):       // minute as a decimal number (00-59)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (num > 59) )
-                {
-                    // no match
+            case wxT('S'):       // second as a decimal number (00-61)
+            case wxT('w'):       // weekday as a number (0-6), Sunday = 0
+            case wxT('y'):       // year without century (00-99)
+            case wxT('Y'):       // year with century
+                if ( !fields.ParseNumber(*fmt, width, input, end) )
                     return false;
-                }
-
-                haveMin = true;
-                min = (wxDateTime_t)num;
                 break;
 
             case wxT('p'):       // AM or PM string
@@ -1260,7 +1553,7 @@ wxDateTime::ParseFormat(const wxString& date,
                     const size_t pos = input - date.begin();
                     if ( date.compare(pos, pm.length(), pm) == 0 )
                     {
-                        isPM = true;
+                        fields.isPM = true;
                         input += pm.length();
                     }
                     else if ( date.compare(pos, am.length(), am) == 0 )
@@ -1281,12 +1574,12 @@ wxDateTime::ParseFormat(const wxString& date,
                                          wxS("%I:%M:%S %p"), &input) )
                         return false;
 
-                    haveHour = haveMin = haveSec = true;
+                    fields.haveHour = fields.haveMin = fields.haveSec = true;
 
                     const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
+                    fields.sec = tm.sec;
                 }
                 break;
 
@@ -1297,25 +1590,13 @@ wxDateTime::ParseFormat(const wxString& date,
                     if ( !dt.IsValid() )
                         return false;
 
-                    haveHour =
-                    haveMin = true;
+                    fields.haveHour =
+                    fields.haveMin = true;
 
                     const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                }
-                break;
-
-            case wxT('S'):       // second as a decimal number (00-61)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (num > 61) )
-                {
-                    // no match
-                    return false;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
                 }
-
-                haveSec = true;
-                sec = (wxDateTime_t)num;
                 break;
 
             case wxT('T'):       // time as %H:%M:%S
@@ -1325,27 +1606,15 @@ wxDateTime::ParseFormat(const wxString& date,
                     if ( !dt.IsValid() )
                         return false;
 
-                    haveHour =
-                    haveMin =
-                    haveSec = true;
+                    fields.haveHour =
+                    fields.haveMin =
+                    fields.haveSec = true;
 
                     const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
-                }
-                break;
-
-            case wxT('w'):       // weekday as a number (0-6), Sunday = 0
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (wday > 6) )
-                {
-                    // no match
-                    return false;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
+                    fields.sec = tm.sec;
                 }
-
-                haveWDay = true;
-                wday = (WeekDay)num;
                 break;
 
             case wxT('x'):       // locale default date representation
@@ -1388,13 +1657,13 @@ wxDateTime::ParseFormat(const wxString& date,
 
                     const Tm tm = dt.GetTm();
 
-                    haveDay =
-                    haveMon =
-                    haveYear = true;
+                    fields.haveDay =
+                    fields.haveMon =
+                    fields.haveYear = true;
 
-                    year = tm.year;
-                    mon = tm.mon;
-                    mday = tm.mday;
+                    fields.year = tm.year;
+                    fields.mon = tm.mon;
+                    fields.mday = tm.mday;
                 }
 
                 break;
@@ -1421,125 +1690,21 @@ wxDateTime::ParseFormat(const wxString& date,
                     if ( !dt.IsValid() )
                         return false;
 
-                    haveHour =
-                    haveMin =
-                    haveSec = true;
+                    fields.haveHour =
+                    fields.haveMin =
+                    fields.haveSec = true;
 
                     const Tm tm = dt.GetTm();
-                    hour = tm.hour;
-                    min = tm.min;
-                    sec = tm.sec;
+                    fields.hour = tm.hour;
+                    fields.min = tm.min;
+                    fields.sec = tm.sec;
                 }
                 break;
 
-            case wxT('y'):       // year without century (00-99)
-                if ( !GetNumericToken(width, input, end, &num) ||
-                        (num > 99) )
-                {
-                    // no match
-                    return false;
-                }
-
-                haveYear = true;
-
-                // TODO should have an option for roll over date instead of
-                //      hard coding it here
-                year = (num > 30 ? 1900 : 2000) + (wxDateTime_t)num;
-                break;
-
-            case wxT('Y'):       // year with century
-                if ( !GetNumericToken(width, input, end, &num) )
-                {
-                    // no match
-                    return false;
-                }
-
-                haveYear = true;
-                year = (wxDateTime_t)num;
-                break;
-
             case wxT('z'):
-                {
-                    // check that we have something here at all
-                    if ( input == end )
-                        return false;
-
-                    if ( *input == wxS('Z') )
-                    {
-                        // Time is in UTC.
-                        ++input;
-                        haveTimeZone = true;
-                        break;
-                    }
-
-                    // Check if there's either a plus, hyphen-minus, or
-                    // minus sign.
-                    bool minusFound;
-                    if ( *input == wxS('+') )
-                        minusFound = false;
-                    else if
-                    (
-                        *input == wxS('-')
-#if wxUSE_UNICODE
-                        || *input == wxString::FromUTF8("\xe2\x88\x92")
-#endif
-                    )
-                        minusFound = true;
-                    else
-                        return false;   // no match
-
-                    ++input;
-
-                    // Here should follow exactly 2 digits for hours (HH).
-                    const size_t numRequiredDigits = 2;
-                    size_t numScannedDigits;
-
-                    unsigned long hours;
-                    if ( !GetNumericToken(numRequiredDigits, input, end,
-                                          &hours, &numScannedDigits)
-                         || numScannedDigits != numRequiredDigits)
-                    {
-                        return false; // No match.
-                    }
-
-                    // Optionally followed by a colon separator.
-                    bool mustHaveMinutes = false;
-                    if ( input != end && *input == wxS(':') )
-                    {
-                        mustHaveMinutes = true;
-                        ++input;
-                    }
-
-                    // Optionally followed by exactly 2 digits for minutes (MM).
-                    unsigned long minutes = 0;
-                    if ( !GetNumericToken(numRequiredDigits, input, end,
-                                          &minutes, &numScannedDigits)
-                         || numScannedDigits != numRequiredDigits)
-                    {
-                        if (mustHaveMinutes || numScannedDigits)
-                        {
-                            // No match if we must have minutes, or digits
-                            // for minutes were specified but not exactly 2.
-                            return false;
-                        }
-                    }
-
-                    /*
-                    Contemporary offset limits are -12:00 and +14:00.
-                    However historically offsets of over +/- 15 hours
-                    existed so be a bit more flexible. Info retrieved
-                    from Time Zone Database at
-                    https://www.iana.org/time-zones.
-                    */
-                    if ( hours > 15 || minutes > 59 )
-                        return false;   // bad format
-
-                    timeZone = 3600*hours + 60*minutes;
-                    if ( minusFound )
-                        timeZone = -timeZone;
-
-                    haveTimeZone = true;
-                }
+                if ( !ParseTimeZoneOffset(input, end, &fields.haveTimeZone,
+                                          &fields.timeZone) )
+                    return false;
                 break;
 
             case wxT('Z'):       // timezone name
@@ -1567,91 +1732,7 @@ wxDateTime::ParseFormat(const wxString& date,
     }
 
     // format matched, try to construct a date from what we have now
-    Tm tmDef;
-    if ( dateDef.IsValid() )
-    {
-        // take this date as default
-        tmDef = dateDef.GetTm();
-    }
-    else if ( IsValid() )
-    {
-        // if this date is valid, don't change it
-        tmDef = GetTm();
-    }
-    else
-    {
-        // no default and this date is invalid - fall back to Today()
-        tmDef = Today().GetTm();
-    }
-
-    Tm tm = tmDef;
-
-    // set the date
-    if ( haveMon )
-    {
-        tm.mon = mon;
-    }
-
-    if ( haveYear )
-    {
-        tm.year = year;
-    }
-
-    // TODO we don't check here that the values are consistent, if both year
-    //      day and month/day were found, we just ignore the year day and we
-    //      also always ignore the week day
-    if ( haveDay )
-    {
-        if ( mday > GetNumberOfDays(tm.mon, tm.year) )
-            return false;
-
-        tm.mday = mday;
-    }
-    else if ( haveYDay )
-    {
-        if ( yday > GetNumberOfDays(tm.year) )
-            return false;
-
-        Tm tm2 = wxDateTime(1, Jan, tm.year).SetToYearDay(yday).GetTm();
-
-        tm.mon = tm2.mon;
-        tm.mday = tm2.mday;
-    }
-
-    // deal with AM/PM
-    if ( haveHour && hourIsIn12hFormat && isPM )
-    {
-        // translate to 24hour format
-        hour += 12;
-    }
-    //else: either already in 24h format or no translation needed
-
-    // set the time
-    if ( haveHour )
-    {
-        tm.hour = hour;
-    }
-
-    if ( haveMin )
-    {
-        tm.min = min;
-    }
-
-    if ( haveSec )
-    {
-        tm.sec = sec;
-    }
-
-    if ( haveMsec )
-        tm.msec = msec;
-
-    Set(tm);
-
-    if ( haveTimeZone )
-        MakeFromTimezone(timeZone);
-
-    // finally check that the week day is consistent -- if we had it
-    if ( haveWDay && GetWeekDay() != wday )
+    if ( !fields.ApplyTo(*this, dateDef) )
         return false;
 
     *endParse = input;
@@ -2220,6 +2301,731 @@ bool wxDateTime::IsWorkDay(Country WXUNUSED(country)) const
     return !wxDateTimeHolidayAuthority::IsHoliday(*this);
 }
 
+// ============================================================================
+// wxDateTimeFormatter
+// ============================================================================
+
+namespace
+{
+
+// Helper appending characters to a fixed size buffer while still counting
+// all of them, as snprintf() does.
+class wxDateTimeFormatOutput
+{
+public:
+    wxDateTimeFormatOutput(wxChar* buf, size_t size)
+        : m_buf(buf), m_size(size), m_len(0)
+    {
+    }
+
+    void Append(wxChar ch)
+    {
+        if ( m_len + 1 < m_size )
+            m_buf[m_len] = ch;
+
+        m_len++;
+    }
+
+    void Append(const wxString& s)
+    {
+        for ( wxString::const_iterator p = s.begin(); p != s.end(); ++p )
+            Append(static_cast<wxChar>(*p));
+    }
+
+    // Append the number formatted as printf("%0*d", width, value) would do.
+    void AppendNumber(int value, int width)
+    {
+        unsigned long abs;
+        if ( value < 0 )
+        {
+            Append(wxT('-'));
+            abs = -static_cast<long>(value);
+            width--;
+        }
+        else
+        {
+            abs = value;
+        }
+
+        wxChar digits[32];
+        int n = 0;
+        do
+        {
+            digits[n++] = static_cast<wxChar>(wxT('0') + abs % 10);
+            abs /= 10;
+        } while ( abs );
+
+        for ( ; width > n; width-- )
+            Append(wxT('0'));
+
+        while ( n )
+            Append(digits[--n]);
+    }
+
+    // NUL-terminate the buffer and return the full length of the output.
+    size_t Finish()
+    {
+        if ( m_size )
+            m_buf[m_len < m_size ? m_len : m_size - 1] = wxT('\0');
+
+        return m_len;
+    }
+
+private:
+    wxChar* const m_buf;
+    const size_t m_size;
+    size_t m_len;
+};
+
+// Match one of the given names, case-insensitively, at the current position
+// and return its index or -1. If allowPeriod is true, the names ending with a
+// period are matched in the same way as GetMonthFromName() does it.
+int MatchName(wxString::const_iterator& p,
+              const wxString::const_iterator& end,
+              const wxString* names,
+              int count,
+              bool allowPeriod)
+{
+    const wxString::const_iterator pOrig = p;
+    const wxString name = GetAlphaToken(p, end);
+    if ( name.empty() )
+        return -1;
+
+    for ( int n = 0; n < count; n++ )
+    {
+        const wxString& candidate = names[n];
+        if ( allowPeriod && !candidate.empty() && *candidate.rbegin() == '.' )
+        {
+            if ( name.CmpNoCase(wxString(candidate, candidate.length() - 1)) == 0
+                    && p != end && *p == '.' )
+            {
+                ++p;
+                return n;
+            }
+        }
+        else if ( name.CmpNoCase(candidate) == 0 )
+        {
+            return n;
+        }
+    }
+
+    p = pOrig;
+    return -1;
+}
+
+} // anonymous namespace
+
+class wxDateTimeFormatterData
+{
+public:
+    enum TokenType
+    {
+        Token_Literal,      // text: output as is, matched as in ParseFormat()
+        Token_Number,       // spec: numeric field with the default width
+        Token_WeekDayName,  // abbr: week day name
+        Token_MonthName,    // abbr: month name
+        Token_AmPm,         // AM or PM string
+        Token_TimeZone,     // time zone as [-+]HHMM
+        Token_Other         // text: specifier formatted by wxDateTime itself
+    };
+
+    struct Token
+    {
+        TokenType type;
+        wxUniChar spec;
+        int width;          // field width, 0 if not specified
+        bool abbr;
+        wxString text;
+    };
+
+    explicit wxDateTimeFormatterData(const wxString& format)
+        : m_format(format)
+    {
+        Compile();
+    }
+
+    void Format(wxDateTimeFormatOutput& out,
+                const wxDateTime& dt,
+                const wxDateTime::TimeZone& tz) const;
+
+    bool Parse(const wxString& date,
+               wxDateTime* dt,
+               const wxDateTime& dateDef,
+               wxString::const_iterator* end) const;
+
+    const wxString m_format;
+
+private:
+    void Compile();
+
+    void AddLiteral(wxUniChar ch)
+    {
+        if ( m_tokens.empty() || m_tokens.back().type != Token_Literal )
+            AddToken(Token_Literal, ch);
+
+        m_tokens.back().text += ch;
+    }
+
+    Token& AddToken(TokenType type, wxUniChar spec)
+    {
+        Token token;
+        token.type = type;
+        token.spec = spec;
+        token.width = 0;
+        token.abbr = false;
+        m_tokens.push_back(token);
+        return m_tokens.back();
+    }
+
+    wxVector<Token> m_tokens;
+
+    // false if the format uses the specifiers not supported by Parse(), in
+    // which case it falls back to wxDateTime::ParseFormat()
+    bool m_canParse;
+
+    // the localized names, indexed by abbr flag
+    wxString m_weekDayNames[2][wxDateTime::Inv_WeekDay];
+    wxString m_monthNames[2][wxDateTime::Inv_Month];
+    wxString m_am,
+             m_pm;
+};
+
+void wxDateTimeFormatterData::Compile()
+{
+    m_canParse = true;
+
+    for ( int abbr = 0; abbr < 2; abbr++ )
+    {
+        const wxDateTime::NameFlags
+            flags = abbr ? wxDateTime::Name_Abbr : wxDateTime::Name_Full;
+
+        for ( wxDateTime::WeekDay wd = wxDateTime::Sun;
+              wd < wxDateTime::Inv_WeekDay;
+              wxNextWDay(wd) )
+        {
+            m_weekDayNames[abbr][wd] = wxDateTime::GetWeekDayName(wd, flags);
+        }
+
+        for ( wxDateTime::Month mon = wxDateTime::Jan;
+              mon < wxDateTime::Inv_Month;
+              wxNextMonth(mon) )
+        {
+            m_monthNames[abbr][mon] = wxDateTime::GetMonthName(mon, flags);
+        }
+    }
+
+    wxDateTime::GetAmPmStrings(&m_am, &m_pm);
+
+    for ( wxString::const_iterator p = m_format.begin();
+          p != m_format.end();
+          ++p )
+    {
+        if ( *p != wxT('%') )
+        {
+            AddLiteral(*p);
+            continue;
+        }
+
+        if ( ++p == m_format.end() )
+        {
+            wxFAIL_MSG(wxT("missing format at the end of string"));
+
+            // just put the '%' which was the last char in format, as Format()
+            // does, but we can't parse such format
+            AddLiteral(wxT('%'));
+            m_canParse = false;
+            break;
+        }
+
+        // collect the flags and the width, if any: they're handled by
+        // wxDateTime itself when formatting
+        wxString flags;
+        int width = 0;
+        for ( ; p != m_format.end() &&
+                (*p == wxT('-') || *p == wxT('+') ||
+                    *p == wxT(' ') || wxIsdigit(*p));
+              ++p )
+        {
+            flags += *p;
+
+            if ( wxIsdigit(*p) )
+                width = 10*width + (*p - wxT('0'));
+            else
+                m_canParse = false;
+        }
+
+        if ( p == m_format.end() )
+        {
+            // invalid format, let wxDateTime deal with it
+            AddToken(Token_Other, wxT('%')).text = wxT('%') + flags;
+            m_canParse = false;
+            break;
+        }
+
+        const wxUniChar spec = *p;
+        switch ( spec.GetValue() )
+        {
+            case wxT('a'):
+            case wxT('A'):
+                if ( !flags.empty() )
+                    m_canParse = false;
+                AddToken(Token_WeekDayName, spec).abbr = spec == wxT('a');
+                break;
+
+            case wxT('b'):
+            case wxT('B'):
+                if ( !flags.empty() )
+                    m_canParse = false;
+                AddToken(Token_MonthName, spec).abbr = spec == wxT('b');
+                break;
+
+            case wxT('e'):
+                // this is only supported by ParseFormat() and not by our own
+                // Format() code, so let wxDateTime deal with formatting it,
+                // but remember the width to parse it as ParseFormat() does
+                {
+                    Token& token = AddToken(Token_Other, spec);
+                    token.text = wxT('%') + flags + spec;
+                    token.width = width;
+                }
+                break;
+
+            case wxT('d'):
+            case wxT('H'):
+            case wxT('I'):
+            case wxT('j'):
+            case wxT('l'):
+            case wxT('m'):
+            case wxT('M'):
+            case wxT('S'):
+            case wxT('w'):
+            case wxT('y'):
+            case wxT('Y'):
+                if ( flags.empty() )
+                {
+                    AddToken(Token_Number, spec);
+                }
+                else
+                {
+                    // the field is formatted differently, but can still be
+                    // parsed by us if only the width is given
+                    Token& token = AddToken(Token_Other, spec);
+                    token.text = wxT('%') + flags + spec;
+                    token.width = width;
+                }
+                break;
+
+            case wxT('p'):
+                if ( !flags.empty() )
+                    m_canParse = false;
+                AddToken(Token_AmPm, spec);
+                break;
+
+            case wxT('z'):
+                if ( !flags.empty() )
+                {
+                    AddToken(Token_Other, spec).text = wxT('%') + flags + spec;
+                    m_canParse = false;
+                }
+                else
+                {
+                    AddToken(Token_TimeZone, spec);
+                }
+                break;
+
+            case wxT('%'):
+                if ( !flags.empty() )
+                    m_canParse = false;
+                AddLiteral(spec);
+                break;
+
+            default:
+                // all the other specifiers, such as locale-dependent "%c" or
+                // week numbers, are rare enough to not bother optimizing them
+                AddToken(Token_Other, spec).text = wxT('%') + flags + spec;
+                m_canParse = false;
+        }
+    }
+}
+
+void wxDateTimeFormatterData::Format(wxDateTimeFormatOutput& out,
+                                     const wxDateTime& dt,
+                                     const wxDateTime::TimeZone& tz) const
+{
+    wxDateTime::Tm tm = dt.GetTm(tz);
+
+    for ( wxVector<Token>::const_iterator it = m_tokens.begin();
+          it != m_tokens.end();
+          ++it )
+    {
+        const Token& token = *it;
+        switch ( token.type )
+        {
+            case Token_Literal:
+                out.Append(token.text);
+                break;
+
+            case Token_Number:
+                switch ( token.spec.GetValue() )
+                {
+                    case wxT('d'):
+                        out.AppendNumber(tm.mday, 2);
+                        break;
+
+                    case wxT('H'):
+                        out.AppendNumber(tm.hour, 2);
+                        break;
+
+                    case wxT('I'):
+                        // 24h -> 12h, 0h -> 12h too
+                        out.AppendNumber(tm.hour > 12 ? tm.hour - 12
+                                                      : tm.hour ? tm.hour : 12,
+                                         2);
+                        break;
+
+                    case wxT('j'):
+                        {
+                            int yday = tm.mday;
+                            for ( int mon = wxDateTime::Jan; mon < tm.mon; mon++ )
+                            {
+                                yday += wxDateTime::GetNumberOfDays
+                                        (
+                                            static_cast<wxDateTime::Month>(mon),
+                                            tm.year
+                                        );
+                            }
+
+                            out.AppendNumber(yday, 3);
+                        }
+                        break;
+
+                    case wxT('l'):
+                        out.AppendNumber(tm.msec, 3);
+                        break;
+
+                    case wxT('m'):
+                        out.AppendNumber(tm.mon + 1, 2);
+                        break;
+
+                    case wxT('M'):
+                        out.AppendNumber(tm.min, 2);
+                        break;
+
+                    case wxT('S'):
+                        out.AppendNumber(tm.sec, 2);
+                        break;
+
+                    case wxT('w'):
+                        out.AppendNumber(tm.GetWeekDay(), 1);
+                        break;
+
+                    case wxT('y'):
+                        out.AppendNumber(tm.year % 100, 2);
+                        break;
+
+                    case wxT('Y'):
+                        out.AppendNumber(tm.year, 4);
+                        break;
+                }
+                break;
+
+            case Token_WeekDayName:
+                out.Append(m_weekDayNames[token.abbr][tm.GetWeekDay()]);
+                break;
+
+            case Token_MonthName:
+                out.Append(m_monthNames[token.abbr][tm.mon]);
+                break;
+
+            case Token_AmPm:
+                out.Append(tm.hour < 12 ? m_am : m_pm);
+                break;
+
+            case Token_TimeZone:
+                {
+                    // this must be consistent with wxDateTime::Format()
+                    int ofs = tz.GetOffset();
+                    if ( ofs == -wxGetTimeZone() && dt.IsDST() == 1 )
+                        ofs += wxDateTime::DST_OFFSET;
+
+                    if ( ofs < 0 )
+                    {
+                        out.Append(wxT('-'));
+                        ofs = -ofs;
+                    }
+                    else
+                    {
+                        out.Append(wxT('+'));
+                    }
+
+                    out.AppendNumber(100*(ofs/3600) + (ofs/60)%60, 4);
+                }
+                break;
+
+            case Token_Other:
+                out.Append(dt.Format(token.text, tz));
+                break;
+        }
+    }
+}
+
+bool wxDateTimeFormatterData::Parse(const wxString& date,
+                                    wxDateTime* dt,
+                                    const wxDateTime& dateDef,
+                                    wxString::const_iterator* end) const
+{
+    if ( !m_canParse )
+    {
+        // parse into a temporary object to leave *dt unchanged on failure,
+        // as the code below does
+        wxDateTime result;
+        wxString::const_iterator endParse;
+        if ( !result.ParseFormat(date, m_format, dateDef, &endParse) )
+            return false;
+
+        if ( end )
+            *end = endParse;
+        else if ( endParse != date.end() )
+            return false;
+
+        *dt = result;
+
+        return true;
+    }
+
+    ParsedDateFields fields;
+
+    wxString::const_iterator input = date.begin();
+    const wxString::const_iterator last = date.end();
+    for ( wxVector<Token>::const_iterator it = m_tokens.begin();
+          it != m_tokens.end();
+          ++it )
+    {
+        const Token& token = *it;
+        switch ( token.type )
+        {
+            case Token_Literal:
+                for ( wxString::const_iterator p = token.text.begin();
+                      p != token.text.end();
+                      ++p )
+                {
+                    if ( wxIsspace(*p) )
+                    {
+                        // a white space in the format string matches 0 or
+                        // more white spaces in the input
+                        while ( input != last && wxIsspace(*input) )
+                            ++input;
+                    }
+                    else if ( input == last || *input++ != *p )
+                    {
+                        return false;
+                    }
+                }
+                break;
+
+            case Token_Number:
+            case Token_Other:
+                {
+                    // Token_Other can only be a numeric field here as we'd
+                    // have fallen back to ParseFormat() above otherwise
+                    size_t width = token.width;
+                    if ( !width )
+                    {
+                        switch ( token.spec.GetValue() )
+                        {
+                            case wxT('Y'):
+                                width = 4;
+                                break;
+
+                            case wxT('j'):
+                            case wxT('l'):
+                                width = 3;
+                                break;
+
+                            case wxT('w'):
+                                width = 1;
+                                break;
+
+                            default:
+                                width = 2;
+                        }
+                    }
+
+                    if ( !fields.ParseNumber(token.spec, width, input, last) )
+                        return false;
+                }
+                break;
+
+            case Token_WeekDayName:
+                {
+                    const int wd = MatchName(input, last,
+                                             m_weekDayNames[token.abbr],
+                                             wxDateTime::Inv_WeekDay,
+                                             false);
+                    if ( wd == -1 )
+                        return false;
+
+                    fields.haveWDay = true;
+                    fields.wday = static_cast<wxDateTime::WeekDay>(wd);
+                }
+                break;
+
+            case Token_MonthName:
+                {
+                    const int mon = MatchName(input, last,
+                                              m_monthNames[token.abbr],
+                                              wxDateTime::Inv_Month,
+                                              token.abbr);
+                    if ( mon == -1 )
+                        return false;
+
+                    fields.haveMon = true;
+                    fields.mon = static_cast<wxDateTime::Month>(mon);
+                }
+                break;
+
+            case Token_AmPm:
+                {
+                    // we can never match %p in locales which don't use AM/PM
+                    if ( m_am.empty() || m_pm.empty() )
+                        return false;
+
+                    const size_t pos = input - date.begin();
+                    if ( date.compare(pos, m_pm.length(), m_pm) == 0 )
+                    {
+                        fields.isPM = true;
+                        input += m_pm.length();
+                    }
+                    else if ( date.compare(pos, m_am.length(), m_am) == 0 )
+                    {
+                        input += m_am.length();
+                    }
+                    else // no match
+                    {
+                        return false;
+                    }
+                }
+                break;
+
+            case Token_TimeZone:
+                if ( !ParseTimeZoneOffset(input, last, &fields.haveTimeZone,
+                                          &fields.timeZone) )
+                    return false;
+                break;
+        }
+    }
+
+    if ( !end && input != last )
+        return false;
+
+    wxDateTime result(*dt);
+    if ( !fields.ApplyTo(result, dateDef) )
+        return false;
+
+    *dt = result;
+
+    if ( end )
+        *end = input;
+
+    return true;
+}
+
+wxDateTimeFormatter::wxDateTimeFormatter()
+{
+    m_data = new wxDateTimeFormatterData(wxDefaultDateTimeFormat);
+}
+
+wxDateTimeFormatter::wxDateTimeFormatter(const wxString& format)
+{
+    wxASSERT_MSG( !format.empty(), "format can't be empty" );
+
+    m_data = new wxDateTimeFormatterData(format.empty()
+                                            ? wxString(wxDefaultDateTimeFormat)
+                                            : format);
+}
+
+wxDateTimeFormatter::wxDateTimeFormatter(const wxDateTimeFormatter& other)
+{
+    m_data = new wxDateTimeFormatterData(*other.m_data);
+}
+
+wxDateTimeFormatter&
+wxDateTimeFormatter::operator=(const wxDateTimeFormatter& other)
+{
+    if ( &other != this )
+    {
+        wxDateTimeFormatterData* const data =
+            new wxDateTimeFormatterData(*other.m_data);
+        delete m_data;
+        m_data = data;
+    }
+
+    return *this;
+}
+
+wxDateTimeFormatter::~wxDateTimeFormatter()
+{
+    delete m_data;
+}
+
+bool wxDateTimeFormatter::SetFormat(const wxString& format)
+{
+    wxCHECK_MSG( !format.empty(), false, "format can't be empty" );
+
+    wxDateTimeFormatterData* const data = new wxDateTimeFormatterData(format);
+    delete m_data;
+    m_data = data;
+
+    return true;
+}
+
+const wxString& wxDateTimeFormatter::GetFormat() const
+{
+    return m_data->m_format;
+}
+
+wxString wxDateTimeFormatter::Format(const wxDateTime& dt,
+                                     const wxDateTime::TimeZone& tz) const
+{
+    wxCHECK_MSG( dt.IsValid(), wxString(), wxT("invalid wxDateTime") );
+
+    // most of the formatted dates fit into this buffer
+    wxChar buf[64];
+    const size_t len = FormatTo(buf, WXSIZEOF(buf), dt, tz);
+    if ( len < WXSIZEOF(buf) )
+        return wxString(buf, len);
+
+    wxScopedArray<wxChar> bufLarge(len + 1);
+    FormatTo(bufLarge.get(), len + 1, dt, tz);
+    return wxString(bufLarge.get(), len);
+}
+
+size_t wxDateTimeFormatter::FormatTo(wxChar* buf,
+                                     size_t size,
+                                     const wxDateTime& dt,
+                                     const wxDateTime::TimeZone& tz) const
+{
+    wxCHECK_MSG( buf || !size, 0, wxT("NULL buffer") );
+
+    wxDateTimeFormatOutput out(buf, size);
+    if ( dt.IsValid() )
+        m_data->Format(out, dt, tz);
+    else
+        wxFAIL_MSG( wxT("invalid wxDateTime") );
+
+    return out.Finish();
+}
+
+bool wxDateTimeFormatter::Parse(const wxString& date,
+                                wxDateTime* dt,
+                                const wxDateTime& dateDef,
+                                wxString::const_iterator* end) const
+{
+    wxCHECK_MSG( dt, false, wxT("NULL date pointer") );
+
+    return m_data->Parse(date, dt, dateDef, end);
+}
+
 // ============================================================================
 // wxDateSpan
 // ============================================================================
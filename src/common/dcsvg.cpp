@@ -29,6 +29,7 @@
 #include "wx/wfstream.h"
 #include "wx/filename.h"
 #include "wx/mstream.h"
+#include "wx/stream.h"
 #include "wx/scopedarray.h"
 
 #if wxUSE_MARKUP
@@ -378,6 +379,80 @@ void SetScaledScreenDCFont(wxScreenDC& sDC, const wxFont& font)
     }
 }
 
+// Size of the buffer used for the output file.
+const size_t OUTPUT_BUFFER_SIZE = 64*1024;
+
+// The accumulated path is written out once its data becomes longer than this
+// to avoid creating paths which are too long to be handled efficiently.
+const size_t MAX_PATH_DATA_LENGTH = 64*1024;
+
+// Append the decimal representation of the given number to the string, this
+// is much faster than using wxString::Format() for it.
+void AppendInt(wxString& s, int n)
+{
+    wxChar buf[16];
+    wxChar* const end = buf + WXSIZEOF(buf);
+    wxChar* p = end;
+
+    unsigned u = n < 0 ? 0u - static_cast<unsigned>(n) : n;
+    do
+    {
+        *--p = static_cast<wxChar>(wxT('0') + u % 10);
+        u /= 10;
+    } while ( u );
+
+    if ( n < 0 )
+        *--p = wxT('-');
+
+    s.append(p, end - p);
+}
+
+// Return the key identifying the bitmap contents: bitmaps with the same key
+// are considered to be identical.
+wxString GetBitmapContentsKey(const wxBitmap& bmp)
+{
+    const wxImage image = bmp.ConvertToImage();
+    if ( !image.IsOk() )
+        return wxString();
+
+    // Use two different hash functions (FNV-1a and DJB2) over all the image
+    // data to make the collisions negligibly improbable.
+    wxUint32 hash1 = 2166136261u,
+             hash2 = 5381;
+
+    const size_t numPixels = static_cast<size_t>(image.GetWidth())*image.GetHeight();
+
+    const unsigned char* p = image.GetData();
+    for ( const unsigned char* const end = p + 3*numPixels; p != end; ++p )
+    {
+        hash1 = (hash1 ^ *p) * 16777619u;
+        hash2 = hash2 * 33 + *p;
+    }
+
+    if ( image.HasAlpha() )
+    {
+        p = image.GetAlpha();
+        for ( const unsigned char* const end = p + numPixels; p != end; ++p )
+        {
+            hash1 = (hash1 ^ *p) * 16777619u;
+            hash2 = hash2 * 33 + *p;
+        }
+    }
+
+    wxString key = wxString::Format("%dx%d-%08x-%08x",
+                                    image.GetWidth(), image.GetHeight(),
+                                    hash1, hash2);
+    if ( image.HasMask() )
+    {
+        key << wxString::Format("-%02x%02x%02x",
+                                image.GetMaskRed(),
+                                image.GetMaskGreen(),
+                                image.GetMaskBlue());
+    }
+
+    return key;
+}
+
 } // anonymous namespace
 
 // ----------------------------------------------------------------------------
@@ -531,10 +606,20 @@ void wxSVGFileDCImpl::Init(const wxString& filename, int width, int height,
     m_bmp_handler.reset();
 
     if ( m_filename.empty() )
+    {
         m_outfile.reset();
+        m_outstream.reset();
+    }
     else
+    {
         m_outfile.reset(new wxFileOutputStream(m_filename));
 
+        // Writing many small chunks directly to the file would be slow, so
+        // buffer the output.
+        m_outstream.reset(new wxBufferedOutputStream(*m_outfile,
+                                                     OUTPUT_BUFFER_SIZE));
+    }
+
     wxString s;
     s += wxS("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n");
     s += wxS("<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.0//EN\" \"http://www.w3.org/TR/2001/REC-SVG-20010904/DTD/svg10.dtd\">\n\n");
@@ -556,6 +641,9 @@ wxSVGFileDCImpl::~wxSVGFileDCImpl()
 
     s += wxS("</g>\n</svg>\n");
     write(s);
+
+    // Flush the buffered data before closing the file.
+    m_outstream.reset();
 }
 
 void wxSVGFileDCImpl::DoGetSizeMM(int* width, int* height) const
@@ -587,14 +675,8 @@ void wxSVGFileDCImpl::DoDrawLine(wxCoord x1, wxCoord y1, wxCoord x2, wxCoord y2)
 {
     NewGraphicsIfNeeded();
 
-    wxString s;
-    s = wxString::Format(wxS("  <path d=\"M%d %d L%d %d\" %s %s/>\n"),
-        x1, y1, x2, y2, GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
-
-    write(s);
-
-    CalcBoundingBox(x1, y1);
-    CalcBoundingBox(x2, y2);
+    const wxPoint points[] = { wxPoint(x1, y1), wxPoint(x2, y2) };
+    AddToPath(WXSIZEOF(points), points, 0, 0);
 }
 
 void wxSVGFileDCImpl::DoDrawLines(int n, const wxPoint points[], wxCoord xoffset, wxCoord yoffset)
@@ -602,26 +684,73 @@ void wxSVGFileDCImpl::DoDrawLines(int n, const wxPoint points[], wxCoord xoffset
     if (n > 1)
     {
         NewGraphicsIfNeeded();
-        wxString s;
 
-        s = wxString::Format(wxS("  <path d=\"M%d %d"),
-            (points[0].x + xoffset), (points[0].y + yoffset));
+        AddToPath(n, points, xoffset, yoffset);
+    }
+}
 
-        CalcBoundingBox(points[0].x + xoffset, points[0].y + yoffset);
+void wxSVGFileDCImpl::AddToPath(int n, const wxPoint points[],
+                                wxCoord xoffset, wxCoord yoffset,
+                                bool close)
+{
+    const wxString attrs = wxString::Format(wxS("style=\"fill:none\" %s %s"),
+        GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
 
-        for (int i = 1; i < n; ++i)
-        {
-            s += wxString::Format(wxS(" L%d %d"), (points[i].x + xoffset), (points[i].y + yoffset));
-            CalcBoundingBox(points[i].x + xoffset, points[i].y + yoffset);
-        }
+    if ( attrs != m_pathAttrs )
+    {
+        FlushPath();
 
-        s += wxString::Format(wxS("\" style=\"fill:none\" %s %s/>\n"),
-            GetRenderMode(m_renderingMode), GetPenPattern(m_pen));
+        m_pathAttrs = attrs;
+    }
 
-        write(s);
+    if ( !m_pathData.empty() )
+        m_pathData += wxS(' ');
+
+    for (int i = 0; i < n; ++i)
+    {
+        const wxCoord x = points[i].x + xoffset,
+                      y = points[i].y + yoffset;
+
+        if ( i )
+            m_pathData += wxS(" L");
+        else
+            m_pathData += wxS('M');
+
+        AppendInt(m_pathData, x);
+        m_pathData += wxS(' ');
+        AppendInt(m_pathData, y);
+
+        CalcBoundingBox(x, y);
+    }
+
+    if ( close )
+        m_pathData += wxS(" Z");
+
+    // Drawing several lines as a single path is only equivalent to drawing
+    // them separately if the pen is opaque, as otherwise their intersections
+    // would be drawn differently, so don't accumulate them in this case.
+    if ( m_pen.GetColour().Alpha() != wxALPHA_OPAQUE ||
+            m_pathData.length() > MAX_PATH_DATA_LENGTH )
+    {
+        FlushPath();
     }
 }
 
+void wxSVGFileDCImpl::FlushPath()
+{
+    if ( m_pathData.empty() )
+        return;
+
+    wxString s;
+    s.reserve(m_pathData.length() + m_pathAttrs.length() + 20);
+    s << wxS("  <path d=\"") << m_pathData << wxS("\" ") << m_pathAttrs << wxS("/>\n");
+
+    // Clear the data before calling write() as it calls this function too.
+    m_pathData.clear();
+
+    write(s);
+}
+
 void wxSVGFileDCImpl::DoDrawPoint(wxCoord x, wxCoord y)
 {
     NewGraphicsIfNeeded();
@@ -783,6 +912,14 @@ void wxSVGFileDCImpl::DoDrawPolygon(int n, const wxPoint points[],
 {
     NewGraphicsIfNeeded();
 
+    // Polygons which are not filled can be merged with the other lines.
+    if ( m_brush.IsTransparent() )
+    {
+        if ( n > 1 )
+            AddToPath(n, points, xoffset, yoffset, true /* close */);
+        return;
+    }
+
     wxString s;
 
     s = wxS("  <polygon points=\"");
@@ -1314,23 +1451,49 @@ void wxSVGFileDCImpl::DoDrawBitmap(const wxBitmap& bmp, wxCoord x, wxCoord y,
     if ( !m_bmp_handler )
         m_bmp_handler.reset(new wxSVGBitmapFileHandler(m_filename));
 
-    m_OK = m_outfile && m_outfile->IsOk();
+    FlushPath();
+
+    m_OK = m_outstream && m_outfile->IsOk() && m_outstream->IsOk();
     if (!m_OK)
         return;
 
-    m_bmp_handler->ProcessBitmap(bmp, x, y, *m_outfile);
-    m_OK = m_outfile->IsOk();
+    // Write each distinct bitmap only once and reuse it later.
+    const wxString key = GetBitmapContentsKey(bmp);
+    BitmapIds::const_iterator it = m_bitmapIds.find(key);
+    if ( it == m_bitmapIds.end() )
+    {
+        const wxString
+            id = wxString::Format(wxS("bitmap%u"), unsigned(m_bitmapIds.size()));
+
+        write(wxString::Format(wxS("<defs>\n<g id=\"%s\">\n"), id));
+        if ( !m_OK )
+            return;
+
+        m_bmp_handler->ProcessBitmap(bmp, 0, 0, *m_outstream);
+
+        write(wxS("</g>\n</defs>\n"));
+        if ( !m_OK )
+            return;
+
+        it = m_bitmapIds.insert(BitmapIds::value_type(key, id)).first;
+    }
+
+    write(wxString::Format(wxS("  <use xlink:href=\"#%s\" x=\"%d\" y=\"%d\"/>\n"),
+                           it->second, x, y));
 }
 
 void wxSVGFileDCImpl::write(const wxString& s)
 {
-    m_OK = m_outfile && m_outfile->IsOk();
+    // Any accumulated path must be written before anything else.
+    FlushPath();
+
+    m_OK = m_outstream && m_outfile->IsOk() && m_outstream->IsOk();
     if (!m_OK)
         return;
 
     const wxCharBuffer buf = s.utf8_str();
-    m_outfile->Write(buf, strlen((const char*)buf));
-    m_OK = m_outfile->IsOk();
+    m_outstream->Write(buf, buf.length());
+    m_OK = m_outstream->IsOk();
 }
 
 #endif // wxUSE_SVG
@@ -33,6 +33,13 @@
 
 #include "wx/dir.h"
 #include "wx/filename.h"
+#include "wx/hashmap.h"
+#include "wx/scopedptr.h"
+#include "wx/vector.h"
+
+#if wxUSE_THREADS
+    #include "wx/threadpool.h"
+#endif // wxUSE_THREADS
 
 // ============================================================================
 // implementation
@@ -48,6 +55,22 @@ wxDirTraverser::OnOpenError(const wxString& WXUNUSED(dirname))
     return wxDIR_IGNORE;
 }
 
+// ----------------------------------------------------------------------------
+// wxDirBatchTraverser
+// ----------------------------------------------------------------------------
+
+wxDirTraverseResult
+wxDirBatchTraverser::OnDir(const wxString& WXUNUSED(dirname))
+{
+    return wxDIR_CONTINUE;
+}
+
+wxDirTraverseResult
+wxDirBatchTraverser::OnOpenError(const wxString& WXUNUSED(dirname))
+{
+    return wxDIR_IGNORE;
+}
+
 // ----------------------------------------------------------------------------
 // wxDir::HasFiles() and HasSubDirs()
 // ----------------------------------------------------------------------------
@@ -213,32 +236,474 @@ size_t wxDir::Traverse(wxDirTraverser& sink,
     return nFiles;
 }
 
+// ----------------------------------------------------------------------------
+// wxDir::TraverseParallel()
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// The contents of a single directory read by wxDirParallelReader.
+struct wxDirContents
+{
+    // the name of the directory as passed to wxDirParallelReader::Add()
+    wxString dirname;
+
+    // false if the directory couldn't be opened
+    bool ok;
+
+    // the names of the subdirectories and the files in it
+    wxArrayString subdirs,
+                  files;
+};
+
+// This class reads the directories using the pool threads and returns their
+// contents to the thread calling TraverseParallel(), which is the only one
+// calling the traverser methods. That thread also reads the directories
+// itself when it has nothing else to do, so it never blocks waiting for the
+// pool, even if it's one of the pool threads itself.
+class wxDirParallelReader
+{
+public:
+    wxDirParallelReader(const wxString& filespec, int flags)
+        : m_filespec(filespec),
+          m_flags(flags)
+#if wxUSE_THREADS
+          , m_cond(m_mutex)
+#endif // wxUSE_THREADS
+    {
+        m_numReading = 0;
+        m_stop = false;
+
+#if wxUSE_THREADS
+        m_numReaders = 0;
+        m_maxReaders = wxThreadPool::Get().GetThreadCount();
+#endif // wxUSE_THREADS
+    }
+
+    // Waits until all the reader tasks terminate.
+    ~wxDirParallelReader()
+    {
+        Stop();
+
+#if wxUSE_THREADS
+        // Notice that we can't just wait until m_numReaders becomes 0 as the
+        // tasks might not have even started yet and could be unable to start
+        // while we're blocked if we are running in a pool thread ourselves,
+        // while waiting for the tasks executes them in this case.
+        for ( size_t n = 0; n < m_readers.size(); n++ )
+            m_readers[n]->Wait();
+#endif // wxUSE_THREADS
+
+        for ( size_t n = 0; n < m_results.size(); n++ )
+            delete m_results[n];
+    }
+
+    // Queue the directory for reading.
+    void Add(const wxString& dirname)
+    {
+        Lock();
+
+        m_pending.push_back(dirname);
+
+#if wxUSE_THREADS
+        // There is no need to start more readers than we have directories to
+        // read, the existing ones will take care of the new directory if they
+        // are still running.
+        if ( m_numReaders < m_maxReaders && m_numReaders < m_pending.size() )
+        {
+            // Forget about the already finished tasks from time to time.
+            if ( m_readers.size() >= 2*m_maxReaders )
+            {
+                for ( size_t n = 0; n < m_readers.size(); )
+                {
+                    if ( m_readers[n]->IsDone() )
+                        m_readers.erase(m_readers.begin() + n);
+                    else
+                        n++;
+                }
+            }
+
+            m_numReaders++;
+            m_readers.push_back(wxThreadPool::Get().Run(ReaderTask(this)));
+        }
+#endif // wxUSE_THREADS
+
+        Unlock();
+    }
+
+    // Return the contents of the next directory or NULL if all directories
+    // have been read. The returned pointer must be deleted by the caller.
+    wxDirContents* GetNext()
+    {
+        wxDirContents* contents = NULL;
+
+        Lock();
+        for ( ;; )
+        {
+            if ( !m_results.empty() )
+            {
+                contents = m_results.back();
+                m_results.pop_back();
+                break;
+            }
+
+            if ( ReadPending() )
+                continue;
+
+            // Nothing left to do at all.
+            if ( !m_numReading )
+                break;
+
+#if wxUSE_THREADS
+            m_cond.Wait();
+#endif // wxUSE_THREADS
+        }
+        Unlock();
+
+        return contents;
+    }
+
+    // Don't read any more directories.
+    void Stop()
+    {
+        Lock();
+        m_stop = true;
+        m_pending.clear();
+        Unlock();
+    }
+
+private:
+#if wxUSE_THREADS
+    // Functor used for the pool tasks reading the directories while there are
+    // any left.
+    class ReaderTask
+    {
+    public:
+        explicit ReaderTask(wxDirParallelReader* reader) : m_reader(reader) { }
+
+        void operator()() const
+        {
+            m_reader->Lock();
+            while ( m_reader->ReadPending() )
+                ;
+            m_reader->m_numReaders--;
+            m_reader->Unlock();
+        }
+
+    private:
+        wxDirParallelReader* const m_reader;
+    };
+
+    void Lock() { m_mutex.Lock(); }
+    void Unlock() { m_mutex.Unlock(); }
+#else // !wxUSE_THREADS
+    void Lock() { }
+    void Unlock() { }
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    // Must be called with the lock held, read the next pending directory, if
+    // any, with the lock released in the meanwhile.
+    bool ReadPending()
+    {
+        if ( m_stop || m_pending.empty() )
+            return false;
+
+        // Read the directories in LIFO order, which approximates depth-first
+        // traversal order and so limits the number of pending ones.
+        wxDirContents* const contents = new wxDirContents;
+        contents->dirname = m_pending.back();
+        m_pending.pop_back();
+        m_numReading++;
+
+        Unlock();
+        Read(*contents);
+        Lock();
+
+        m_results.push_back(contents);
+        m_numReading--;
+
+#if wxUSE_THREADS
+        m_cond.Signal();
+#endif // wxUSE_THREADS
+
+        return true;
+    }
+
+    // Read the directory contents, this is the only function called without
+    // the lock.
+    void Read(wxDirContents& contents) const
+    {
+        // don't give the error messages for the directories which we can't
+        // open, just as Traverse() doesn't do it
+        wxLogNull noLog;
+
+        wxDir dir;
+        contents.ok = dir.Open(contents.dirname);
+        if ( !contents.ok )
+            return;
+
+        wxString filename;
+        if ( m_flags & wxDIR_DIRS )
+        {
+            for ( bool cont = dir.GetFirst(&filename, wxEmptyString,
+                                           (m_flags & ~(wxDIR_FILES | wxDIR_DOTDOT))
+                                           | wxDIR_DIRS);
+                  cont;
+                  cont = dir.GetNext(&filename) )
+            {
+                contents.subdirs.push_back(filename);
+            }
+        }
+
+        if ( m_flags & wxDIR_FILES )
+        {
+            for ( bool cont = dir.GetFirst(&filename, m_filespec,
+                                           m_flags & ~wxDIR_DIRS);
+                  cont;
+                  cont = dir.GetNext(&filename) )
+            {
+                contents.files.push_back(filename);
+            }
+        }
+    }
+
+
+    const wxString m_filespec;
+    const int m_flags;
+
+    // All the fields below are protected by m_mutex.
+
+    // The directories still to be read.
+    wxVector<wxString> m_pending;
+
+    // The directories which were read but not returned from GetNext() yet.
+    wxVector<wxDirContents*> m_results;
+
+    // The number of directories being read right now.
+    size_t m_numReading;
+
+    bool m_stop;
+
+#if wxUSE_THREADS
+    // The number of pool tasks currently running and their max number.
+    size_t m_numReaders,
+           m_maxReaders;
+
+    wxMutex m_mutex;
+
+    // Signalled whenever a directory is read.
+    wxCondition m_cond;
+
+    // The reader tasks which may be still running.
+    wxVector<wxThreadPoolTaskPtr> m_readers;
+#endif // wxUSE_THREADS
+
+    wxDECLARE_NO_COPY_CLASS(wxDirParallelReader);
+};
+
+// Append the path separator to the directory name, if necessary.
+wxString wxGetDirPrefix(const wxString& dirname)
+{
+    wxString prefix = dirname;
+    if ( !prefix.empty() && !wxFileName::IsPathSeparator(prefix.Last()) )
+        prefix += wxFILE_SEP_PATH;
+
+    return prefix;
+}
+
+} // anonymous namespace
+
+size_t wxDir::TraverseParallel(wxDirBatchTraverser& sink,
+                               const wxString& filespec,
+                               int flags) const
+{
+    wxCHECK_MSG( IsOpened(), (size_t)-1,
+                 wxT("dir must be opened before traversing it") );
+
+    // the total number of files found
+    size_t nFiles = 0;
+
+    wxDirParallelReader reader(filespec, flags);
+    reader.Add(GetName());
+
+    for ( ;; )
+    {
+        wxScopedPtr<wxDirContents> contents(reader.GetNext());
+        if ( !contents )
+            break;
+
+        if ( !contents->ok )
+        {
+            bool cont = true;
+            switch ( sink.OnOpenError(contents->dirname) )
+            {
+                default:
+                    wxFAIL_MSG(wxT("unexpected OnOpenError() return value") );
+                    wxFALLTHROUGH;
+
+                case wxDIR_STOP:
+                    cont = false;
+                    break;
+
+                case wxDIR_IGNORE:
+                    break;
+
+                case wxDIR_CONTINUE:
+                    // try again
+                    reader.Add(contents->dirname);
+            }
+
+            if ( !cont )
+                break;
+
+            continue;
+        }
+
+        const wxString prefix = wxGetDirPrefix(contents->dirname);
+
+        bool cont = true;
+
+        const wxArrayString& subdirs = contents->subdirs;
+        for ( size_t n = 0; n < subdirs.size() && cont; n++ )
+        {
+            const wxString fulldirname = prefix + subdirs[n];
+
+            switch ( sink.OnDir(fulldirname) )
+            {
+                default:
+                    wxFAIL_MSG(wxT("unexpected OnDir() return value") );
+                    wxFALLTHROUGH;
+
+                case wxDIR_STOP:
+                    cont = false;
+                    break;
+
+                case wxDIR_CONTINUE:
+                    reader.Add(fulldirname);
+                    break;
+
+                case wxDIR_IGNORE:
+                    // nothing to do
+                    ;
+            }
+        }
+
+        if ( cont && !contents->files.empty() )
+        {
+            const wxDirTraverseResult res = sink.OnFiles(prefix, contents->files);
+            if ( res == wxDIR_STOP )
+                break;
+
+            wxASSERT_MSG( res == wxDIR_CONTINUE,
+                          wxT("unexpected OnFiles() return value") );
+
+            nFiles += contents->files.size();
+        }
+
+        if ( !cont )
+            break;
+    }
+
+    return nFiles;
+}
+
 // ----------------------------------------------------------------------------
 // wxDir::GetAllFiles()
 // ----------------------------------------------------------------------------
 
-class wxDirTraverserSimple : public wxDirTraverser
+namespace
+{
+
+// This traverser collects all the files found by TraverseParallel() and
+// returns them in the same order as Traverse() would, i.e. the files under
+// all subdirectories first, in their enumeration order, followed by the
+// files of the directory itself.
+class wxDirTraverserAllFiles : public wxDirBatchTraverser
 {
 public:
-    wxDirTraverserSimple(wxArrayString& files) : m_files(files) { }
+    explicit wxDirTraverserAllFiles(const wxString& dirname)
+    {
+        m_nodes[wxGetDirPrefix(dirname)] = &m_root;
+    }
 
-    virtual wxDirTraverseResult OnFile(const wxString& filename) wxOVERRIDE
+    virtual ~wxDirTraverserAllFiles()
     {
-        m_files.push_back(filename);
+        for ( Nodes::iterator it = m_nodes.begin(); it != m_nodes.end(); ++it )
+        {
+            if ( it->second != &m_root )
+                delete it->second;
+        }
+    }
+
+    virtual wxDirTraverseResult OnFiles(const wxString& dirname,
+                                        const wxArrayString& filenames) wxOVERRIDE
+    {
+        DirNode* const node = m_nodes[dirname];
+        wxCHECK_MSG( node, wxDIR_STOP, "unexpected directory" );
+
+        node->prefix = dirname;
+        node->files = filenames;
+
         return wxDIR_CONTINUE;
     }
 
-    virtual wxDirTraverseResult OnDir(const wxString& WXUNUSED(dirname)) wxOVERRIDE
+    virtual wxDirTraverseResult OnDir(const wxString& dirname) wxOVERRIDE
     {
+        // the parent directory prefix includes the last separator
+        size_t len = dirname.length();
+        while ( len && !wxFileName::IsPathSeparator(dirname[len - 1]) )
+            len--;
+
+        DirNode* const parent = m_nodes[dirname.substr(0, len)];
+        wxCHECK_MSG( parent, wxDIR_STOP, "unexpected directory" );
+
+        DirNode* const node = new DirNode;
+        parent->children.push_back(node);
+        m_nodes[wxGetDirPrefix(dirname)] = node;
+
         return wxDIR_CONTINUE;
     }
 
+    void GetFiles(wxArrayString& files) const
+    {
+        AppendFiles(m_root, files);
+    }
+
 private:
-    wxArrayString& m_files;
+    struct DirNode
+    {
+        wxVector<DirNode*> children;
+
+        // the directory path with the trailing separator and the names of
+        // the files in it, only set if it has any files
+        wxString prefix;
+        wxArrayString files;
+    };
+
+    WX_DECLARE_STRING_HASH_MAP(DirNode*, Nodes);
+
+    void AppendFiles(const DirNode& node, wxArrayString& files) const
+    {
+        for ( size_t n = 0; n < node.children.size(); n++ )
+            AppendFiles(*node.children[n], files);
+
+        if ( node.files.empty() )
+            return;
 
-    wxDECLARE_NO_COPY_CLASS(wxDirTraverserSimple);
+        for ( size_t n = 0; n < node.files.size(); n++ )
+            files.push_back(node.prefix + node.files[n]);
+    }
+
+
+    DirNode m_root;
+    Nodes m_nodes;
+
+    wxDECLARE_NO_COPY_CLASS(wxDirTraverserAllFiles);
 };
 
+} // anonymous namespace
+
 /* static */
 size_t wxDir::GetAllFiles(const wxString& dirname,
                           wxArrayString *files,
@@ -252,9 +717,14 @@ size_t wxDir::GetAllFiles(const wxString& dirname,
     wxDir dir(dirname);
     if ( dir.IsOpened() )
     {
-        wxDirTraverserSimple traverser(*files);
+        // read the directories in parallel but return the files in the same
+        // order as a simple depth first traversal would
+        wxDirTraverserAllFiles traverser(dir.GetName());
+
+        nFiles += dir.TraverseParallel(traverser, filespec, flags);
 
-        nFiles += dir.Traverse(traverser, filespec, flags);
+        files->reserve(files->size() + nFiles);
+        traverser.GetFiles(*files);
     }
 
     return nFiles;
@@ -40,6 +40,7 @@
 #include  "wx/config.h"
 #include  "wx/fileconf.h"
 #include  "wx/filefn.h"
+#include  "wx/hashmap.h"
 
 #include "wx/base64.h"
 
@@ -63,8 +64,8 @@
 // ----------------------------------------------------------------------------
 
 // compare functions for sorting the arrays
-static int LINKAGEMODE CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2);
-static int LINKAGEMODE CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2);
+static int LINKAGEMODE CompareEntries(wxFileConfigEntry **p1, wxFileConfigEntry **p2);
+static int LINKAGEMODE CompareGroups(wxFileConfigGroup **p1, wxFileConfigGroup **p2);
 
 // filter strings
 static wxString FilterInValue(const wxString& str);
@@ -84,16 +85,60 @@ static wxString GetAppName(const wxString& appname);
 // "template" array types
 // ----------------------------------------------------------------------------
 
+// Notice that these arrays are not kept sorted all the time: this would make
+// adding N entries to a group O(N^2) which is too slow for big files. Instead
+// they are only sorted when the group contents is enumerated, while the hash
+// maps below are used for looking up the entries and groups by name.
 #ifdef WXMAKINGDLL_BASE
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigEntry *, ArrayEntries,
-                                         WXDLLIMPEXP_BASE);
-    WX_DEFINE_SORTED_USER_EXPORTED_ARRAY(wxFileConfigGroup *, ArrayGroups,
-                                         WXDLLIMPEXP_BASE);
+    WX_DEFINE_USER_EXPORTED_ARRAY_PTR(wxFileConfigEntry *, ArrayEntries,
+                                      WXDLLIMPEXP_BASE);
+    WX_DEFINE_USER_EXPORTED_ARRAY_PTR(wxFileConfigGroup *, ArrayGroups,
+                                      WXDLLIMPEXP_BASE);
 #else
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigEntry *, ArrayEntries);
-    WX_DEFINE_SORTED_ARRAY(wxFileConfigGroup *, ArrayGroups);
+    WX_DEFINE_ARRAY_PTR(wxFileConfigEntry *, ArrayEntries);
+    WX_DEFINE_ARRAY_PTR(wxFileConfigGroup *, ArrayGroups);
 #endif
 
+// ----------------------------------------------------------------------------
+// hash maps used for looking up entries and groups by name
+// ----------------------------------------------------------------------------
+
+#if wxCONFIG_CASE_SENSITIVE
+    typedef wxStringHash wxFileConfigNameHash;
+    typedef wxStringEqual wxFileConfigNameEqual;
+#else // !wxCONFIG_CASE_SENSITIVE
+    // these functors must be consistent with CmpNoCase() used for sorting
+    struct wxFileConfigNameHash
+    {
+        wxFileConfigNameHash() { }
+        unsigned long operator()(const wxString& name) const
+        {
+            unsigned long hash = 0;
+            for ( wxString::const_iterator i = name.begin(); i != name.end(); ++i )
+                hash = hash*31 + wxTolower(*i).GetValue();
+
+            return hash;
+        }
+    };
+
+    struct wxFileConfigNameEqual
+    {
+        wxFileConfigNameEqual() { }
+        bool operator()(const wxString& name1, const wxString& name2) const
+        {
+            return name1.length() == name2.length() &&
+                    name1.CmpNoCase(name2) == 0;
+        }
+    };
+#endif // wxCONFIG_CASE_SENSITIVE/!wxCONFIG_CASE_SENSITIVE
+
+WX_DECLARE_HASH_MAP(wxString, wxFileConfigEntry *,
+                    wxFileConfigNameHash, wxFileConfigNameEqual,
+                    IndexEntries);
+WX_DECLARE_HASH_MAP(wxString, wxFileConfigGroup *,
+                    wxFileConfigNameHash, wxFileConfigNameEqual,
+                    IndexGroups);
+
 // ----------------------------------------------------------------------------
 // wxFileConfigLineList
 // ----------------------------------------------------------------------------
@@ -160,8 +205,9 @@ public:
   wxFileConfigLineList *
                   GetLine()     const { return m_pLine;      }
 
-  // modify entry attributes
-  void SetValue(const wxString& strValue, bool bUser = true);
+  // modify entry attributes, SetValue() returns false if the value didn't
+  // change
+  bool SetValue(const wxString& strValue, bool bUser = true);
   void SetLine(wxFileConfigLineList *pLine);
 
     wxDECLARE_NO_COPY_CLASS(wxFileConfigEntry);
@@ -176,8 +222,12 @@ class wxFileConfigGroup
 private:
   wxFileConfig *m_pConfig;          // config object we belong to
   wxFileConfigGroup  *m_pParent;    // parent group (NULL for root group)
-  ArrayEntries  m_aEntries;         // entries in this group
-  ArrayGroups   m_aSubgroups;       // subgroups
+  mutable ArrayEntries m_aEntries;  // entries in this group
+  mutable ArrayGroups m_aSubgroups; // subgroups
+  IndexEntries  m_indexEntries;     // the same entries indexed by name
+  IndexGroups   m_indexSubgroups;   // the same subgroups indexed by name
+  mutable bool  m_entriesSorted,    // true if m_aEntries is currently sorted
+                m_subgroupsSorted;  // the same for m_aSubgroups
   wxString      m_strName;          // group's name
   wxFileConfigLineList *m_pLine;    // pointer to our line in the linked list
   wxFileConfigEntry *m_pLastEntry;  // last entry/subgroup of this group in the
@@ -201,9 +251,10 @@ public:
   wxFileConfigGroup    *Parent()  const { return m_pParent; }
   wxFileConfig   *Config()  const { return m_pConfig; }
 
-  const ArrayEntries& Entries() const { return m_aEntries;   }
-  const ArrayGroups&  Groups()  const { return m_aSubgroups; }
-  bool  IsEmpty() const { return Entries().IsEmpty() && Groups().IsEmpty(); }
+  // these accessors return the entries/subgroups sorted alphabetically
+  const ArrayEntries& Entries() const;
+  const ArrayGroups&  Groups()  const;
+  bool  IsEmpty() const { return m_aEntries.IsEmpty() && m_aSubgroups.IsEmpty(); }
 
   // find entry/subgroup (NULL if not found)
   wxFileConfigGroup *FindSubgroup(const wxString& name) const;
@@ -676,6 +727,47 @@ wxFileConfig::DoSetPath(const wxString& strPath, bool createMissingComponents)
         return true;
     }
 
+    // absolute paths not containing any "." or ".." components nor empty
+    // ones are by far the most common case (wxConfigPathChanger uses them for
+    // every access to an entry specified with its full path), so handle them
+    // without splitting the path into an array of components first
+    if ( strPath[0] == wxCONFIG_PATH_SEPARATOR &&
+            strPath.find(wxT("/.")) == wxString::npos &&
+                strPath.find(wxT("//")) == wxString::npos ) {
+        wxFileConfigGroup *pGroup = m_pRootGroup;
+
+        const size_t len = strPath.length();
+        for ( size_t start = 1; start < len; ) {
+            size_t end = strPath.find(wxCONFIG_PATH_SEPARATOR, start);
+            if ( end == wxString::npos )
+                end = len;
+
+            const wxString name(strPath, start, end - start);
+            wxFileConfigGroup *pNextGroup = pGroup->FindSubgroup(name);
+            if ( pNextGroup == NULL )
+            {
+                if ( !createMissingComponents )
+                    return false;
+
+                pNextGroup = pGroup->AddSubgroup(name);
+            }
+
+            pGroup = pNextGroup;
+            start = end + 1;
+        }
+
+        m_pCurrentGroup = pGroup;
+
+        // the path is already normalized except for the possible trailing
+        // separator which we never keep in m_strPath
+        if ( strPath.Last() == wxCONFIG_PATH_SEPARATOR )
+            m_strPath.assign(strPath, 0, len - 1);
+        else
+            m_strPath = strPath;
+
+        return true;
+    }
+
     if ( strPath[0] == wxCONFIG_PATH_SEPARATOR ) {
         // absolute path
         wxSplitPath(aParts, strPath);
@@ -954,9 +1046,11 @@ bool wxFileConfig::DoWriteString(const wxString& key, const wxString& szValue)
         wxLogTrace( FILECONF_TRACE_MASK,
                     wxT("  Setting value %s"),
                     szValue.c_str() );
-        pEntry->SetValue(szValue);
 
-        SetDirty();
+        // don't mark the config as dirty if the value didn't really change to
+        // avoid rewriting the file when the same values are written again
+        if ( pEntry->SetValue(szValue) )
+            SetDirty();
     }
 
     return true;
@@ -1158,22 +1252,13 @@ bool wxFileConfig::DeleteAll()
 // linked list functions
 // ----------------------------------------------------------------------------
 
-    // append a new line to the end of the list
-
+// append a new line to the end of the list
+//
+// notice that this function is called for every line of the file when parsing
+// it, so it intentionally doesn't log anything as even checking whether the
+// trace messages are enabled is relatively expensive
 wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
 {
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("    ** Adding Line '%s'"),
-                str.c_str() );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? (const wxChar*)m_linesHead->Text().c_str()
-                               : wxEmptyString) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? (const wxChar*)m_linesTail->Text().c_str()
-                               : wxEmptyString) );
-
     wxFileConfigLineList *pLine = new wxFileConfigLineList(str);
 
     if ( m_linesTail == NULL )
@@ -1190,15 +1275,6 @@ wxFileConfigLineList *wxFileConfig::LineListAppend(const wxString& str)
 
     m_linesTail = pLine;
 
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? (const wxChar*)m_linesHead->Text().c_str()
-                               : wxEmptyString) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? (const wxChar*)m_linesTail->Text().c_str()
-                               : wxEmptyString) );
-
     return m_linesTail;
 }
 
@@ -1211,15 +1287,6 @@ wxFileConfigLineList *wxFileConfig::LineListInsert(const wxString& str,
                 str.c_str(),
                 ((pLine) ? (const wxChar*)pLine->Text().c_str()
                          : wxEmptyString) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? (const wxChar*)m_linesHead->Text().c_str()
-                               : wxEmptyString) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? (const wxChar*)m_linesTail->Text().c_str()
-                               : wxEmptyString) );
-
     if ( pLine == m_linesTail )
         return LineListAppend(str);
 
@@ -1241,15 +1308,6 @@ wxFileConfigLineList *wxFileConfig::LineListInsert(const wxString& str,
         pLine->SetNext(pNewLine);
     }
 
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? (const wxChar*)m_linesHead->Text().c_str()
-                               : wxEmptyString) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? (const wxChar*)m_linesTail->Text().c_str()
-                               : wxEmptyString) );
-
     return pNewLine;
 }
 
@@ -1258,15 +1316,6 @@ void wxFileConfig::LineListRemove(wxFileConfigLineList *pLine)
     wxLogTrace( FILECONF_TRACE_MASK,
                 wxT("    ** Removing Line '%s'"),
                 pLine->Text().c_str() );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? (const wxChar*)m_linesHead->Text().c_str()
-                               : wxEmptyString) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? (const wxChar*)m_linesTail->Text().c_str()
-                               : wxEmptyString) );
-
     wxFileConfigLineList    *pPrev = pLine->Prev(),
                             *pNext = pLine->Next();
 
@@ -1284,15 +1333,6 @@ void wxFileConfig::LineListRemove(wxFileConfigLineList *pLine)
     else
         pNext->SetPrev(pPrev);
 
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        head: %s"),
-                ((m_linesHead) ? (const wxChar*)m_linesHead->Text().c_str()
-                               : wxEmptyString) );
-    wxLogTrace( FILECONF_TRACE_MASK,
-                wxT("        tail: %s"),
-                ((m_linesTail) ? (const wxChar*)m_linesTail->Text().c_str()
-                               : wxEmptyString) );
-
     delete pLine;
 }
 
@@ -1313,14 +1353,15 @@ bool wxFileConfig::LineListIsEmpty()
 wxFileConfigGroup::wxFileConfigGroup(wxFileConfigGroup *pParent,
                                        const wxString& strName,
                                        wxFileConfig *pConfig)
-                         : m_aEntries(CompareEntries),
-                           m_aSubgroups(CompareGroups),
-                           m_strName(strName)
+                         : m_strName(strName)
 {
   m_pConfig = pConfig;
   m_pParent = pParent;
   m_pLine   = NULL;
 
+  m_entriesSorted =
+  m_subgroupsSorted = true;
+
   m_pLastEntry = NULL;
   m_pLastGroup = NULL;
 }
@@ -1511,13 +1552,14 @@ void wxFileConfigGroup::Rename(const wxString& newName)
     if ( newName == m_strName )
         return;
 
-    // we need to remove the group from the parent and it back under the new
-    // name to keep the parents array of subgroups alphabetically sorted
-    m_pParent->m_aSubgroups.Remove(this);
+    // we need to reindex the group in the parent under the new name and
+    // resort the parents array of subgroups when it is needed next time
+    m_pParent->m_indexSubgroups.erase(m_strName);
 
     m_strName = newName;
 
-    m_pParent->m_aSubgroups.Add(this);
+    m_pParent->m_indexSubgroups[m_strName] = this;
+    m_pParent->m_subgroupsSorted = false;
 
     // update the group lines recursively
     UpdateGroupAndSubgroupsLines();
@@ -1536,67 +1578,46 @@ wxString wxFileConfigGroup::GetFullName() const
 // find an item
 // ----------------------------------------------------------------------------
 
-// use binary search because the array is sorted
+// use the hash maps: binary search in the sorted arrays would be slower and
+// also require keeping them sorted all the time
 wxFileConfigEntry *
 wxFileConfigGroup::FindEntry(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aEntries.GetCount();
-  wxFileConfigEntry *pEntry;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pEntry = m_aEntries[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pEntry->Name().compare(name);
-    #else
-      res = pEntry->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pEntry;
-  }
+  const IndexEntries::const_iterator it = m_indexEntries.find(name);
 
-  return NULL;
+  return it == m_indexEntries.end() ? NULL : it->second;
 }
 
 wxFileConfigGroup *
 wxFileConfigGroup::FindSubgroup(const wxString& name) const
 {
-  size_t
-       lo = 0,
-       hi = m_aSubgroups.GetCount();
-  wxFileConfigGroup *pGroup;
-
-  while ( lo < hi ) {
-    size_t i;
-    i = (lo + hi)/2;
-    pGroup = m_aSubgroups[i];
-
-    int res;
-    #if wxCONFIG_CASE_SENSITIVE
-      res = pGroup->Name().compare(name);
-    #else
-      res = pGroup->Name().CmpNoCase(name);
-    #endif
-
-    if ( res > 0 )
-      hi = i;
-    else if ( res < 0 )
-      lo = i + 1;
-    else
-      return pGroup;
+  const IndexGroups::const_iterator it = m_indexSubgroups.find(name);
+
+  return it == m_indexSubgroups.end() ? NULL : it->second;
+}
+
+// ----------------------------------------------------------------------------
+// sorted access to the items
+// ----------------------------------------------------------------------------
+
+const ArrayEntries& wxFileConfigGroup::Entries() const
+{
+  if ( !m_entriesSorted ) {
+    m_aEntries.Sort(CompareEntries);
+    m_entriesSorted = true;
   }
 
-  return NULL;
+  return m_aEntries;
+}
+
+const ArrayGroups& wxFileConfigGroup::Groups() const
+{
+  if ( !m_subgroupsSorted ) {
+    m_aSubgroups.Sort(CompareGroups);
+    m_subgroupsSorted = true;
+  }
+
+  return m_aSubgroups;
 }
 
 // ----------------------------------------------------------------------------
@@ -1611,6 +1632,9 @@ wxFileConfigEntry *wxFileConfigGroup::AddEntry(const wxString& strName, int nLin
     wxFileConfigEntry   *pEntry = new wxFileConfigEntry(this, strName, nLine);
 
     m_aEntries.Add(pEntry);
+    m_indexEntries[pEntry->Name()] = pEntry;
+    m_entriesSorted = false;
+
     return pEntry;
 }
 
@@ -1622,6 +1646,9 @@ wxFileConfigGroup *wxFileConfigGroup::AddSubgroup(const wxString& strName)
     wxFileConfigGroup   *pGroup = new wxFileConfigGroup(this, strName, m_pConfig);
 
     m_aSubgroups.Add(pGroup);
+    m_indexSubgroups[strName] = pGroup;
+    m_subgroupsSorted = false;
+
     return pGroup;
 }
 
@@ -1752,6 +1779,7 @@ bool wxFileConfigGroup::DeleteSubgroup(wxFileConfigGroup *pGroup)
     }
 
     m_aSubgroups.Remove(pGroup);
+    m_indexSubgroups.erase(pGroup->Name());
     delete pGroup;
 
     return true;
@@ -1800,6 +1828,7 @@ bool wxFileConfigGroup::DeleteEntry(const wxString& name)
   }
 
   m_aEntries.Remove(pEntry);
+  m_indexEntries.erase(pEntry->Name());
   delete pEntry;
 
   return true;
@@ -1847,19 +1876,19 @@ void wxFileConfigEntry::SetLine(wxFileConfigLineList *pLine)
 
 // second parameter is false if we read the value from file and prevents the
 // entry from being marked as 'dirty'
-void wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
+bool wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
 {
     if ( bUser && IsImmutable() )
     {
         wxLogWarning( _("attempt to change immutable key '%s' ignored."),
                       Name().c_str());
-        return;
+        return false;
     }
 
     // do nothing if it's the same value: but don't test for it if m_bHasValue
     // hadn't been set yet or we'd never write empty values to the file
     if ( m_bHasValue && strValue == m_strValue )
-        return;
+        return false;
 
     m_bHasValue = true;
     m_strValue = strValue;
@@ -1896,6 +1925,8 @@ void wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
             Group()->SetLastEntry(this);
         }
     }
+
+    return true;
 }
 
 // ============================================================================
@@ -1906,21 +1937,21 @@ void wxFileConfigEntry::SetValue(const wxString& strValue, bool bUser)
 // compare functions for array sorting
 // ----------------------------------------------------------------------------
 
-int CompareEntries(wxFileConfigEntry *p1, wxFileConfigEntry *p2)
+int CompareEntries(wxFileConfigEntry **p1, wxFileConfigEntry **p2)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return (*p1)->Name().compare((*p2)->Name());
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return (*p1)->Name().CmpNoCase((*p2)->Name());
 #endif
 }
 
-int CompareGroups(wxFileConfigGroup *p1, wxFileConfigGroup *p2)
+int CompareGroups(wxFileConfigGroup **p1, wxFileConfigGroup **p2)
 {
 #if wxCONFIG_CASE_SENSITIVE
-    return p1->Name().compare(p2->Name());
+    return (*p1)->Name().compare((*p2)->Name());
 #else
-    return p1->Name().CmpNoCase(p2->Name());
+    return (*p1)->Name().CmpNoCase((*p2)->Name());
 #endif
 }
 
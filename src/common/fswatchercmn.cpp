@@ -24,6 +24,7 @@
 // ============================================================================
 
 wxDEFINE_EVENT(wxEVT_FSWATCHER, wxFileSystemWatcherEvent);
+wxDEFINE_EVENT(wxEVT_FSWATCHER_BATCH, wxFileSystemWatcherBatchEvent);
 
 static wxString GetFSWEventChangeTypeName(int type)
 {
@@ -75,6 +76,31 @@ wxString wxFileSystemWatcherEvent::ToString() const
 }
 
 
+// ============================================================================
+// wxFileSystemWatcherBatchEvent implementation
+// ============================================================================
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxFileSystemWatcherBatchEvent, wxEvent);
+
+wxFileSystemWatcherBatchEvent::wxFileSystemWatcherBatchEvent(
+        const wxFileSystemWatcherBatchEvent& event)
+    : wxEvent(event)
+{
+    m_events.reserve(event.m_events.size());
+    for ( size_t n = 0; n < event.m_events.size(); n++ )
+    {
+        m_events.push_back(static_cast<wxFileSystemWatcherEvent*>(
+                                event.m_events[n]->Clone()));
+    }
+}
+
+wxFileSystemWatcherBatchEvent::~wxFileSystemWatcherBatchEvent()
+{
+    for ( size_t n = 0; n < m_events.size(); n++ )
+        delete m_events[n];
+}
+
+
 // ============================================================================
 // wxFileSystemWatcherEvent implementation
 // ============================================================================
@@ -181,9 +207,9 @@ bool wxFileSystemWatcherBase::AddTree(const wxFileName& path, int events,
     if (!path.DirExists())
         return false;
 
-    // OPT could be optimised if we stored information about relationships
-    // between paths
-    class AddTraverser : public wxDirTraverser
+    // Use TraverseParallel() to read the directories of big trees faster,
+    // OnDir() is still called from this thread only, so it can use AddAny().
+    class AddTraverser : public wxDirBatchTraverser
     {
     public:
         AddTraverser(wxFileSystemWatcherBase* watcher, int events,
@@ -192,7 +218,9 @@ bool wxFileSystemWatcherBase::AddTree(const wxFileName& path, int events,
         {
         }
 
-        virtual wxDirTraverseResult OnFile(const wxString& WXUNUSED(filename)) wxOVERRIDE
+        virtual wxDirTraverseResult
+        OnFiles(const wxString& WXUNUSED(dirname),
+                const wxArrayString& WXUNUSED(filenames)) wxOVERRIDE
         {
             // There is no need to watch individual files as we watch the
             // parent directory which will notify us about any changes in them.
@@ -224,7 +252,7 @@ bool wxFileSystemWatcherBase::AddTree(const wxFileName& path, int events,
         flags |= wxDIR_NO_FOLLOW;
     }
     AddTraverser traverser(this, events, filespec);
-    dir.Traverse(traverser, filespec, flags);
+    dir.TraverseParallel(traverser, filespec, flags);
 
     // Add the path itself explicitly as Traverse() doesn't return it.
     AddAny(path.GetPathWithSep(), events, wxFSWPath_Tree, filespec);
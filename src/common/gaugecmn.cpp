@@ -24,12 +24,15 @@
 #endif
 
 #ifndef WX_PRECOMP
+    #include "wx/timer.h"
+    #include "wx/utils.h"
 #endif //WX_PRECOMP
 
 #if wxUSE_GAUGE
 
 #include "wx/gauge.h"
 #include "wx/appprogress.h"
+#include "wx/progsrc.h"
 
 const char wxGaugeNameStr[] = "gauge";
 
@@ -41,6 +44,10 @@ wxGaugeBase::~wxGaugeBase()
 {
     // this destructor is required for Darwin
     delete m_appProgressIndicator;
+
+#if wxUSE_TIMER
+    delete m_progressTimer;
+#endif // wxUSE_TIMER
 }
 
 // ----------------------------------------------------------------------------
@@ -184,6 +191,47 @@ int wxGaugeBase::GetValue() const
     return m_gaugePos;
 }
 
+// ----------------------------------------------------------------------------
+// wxGauge progress source
+// ----------------------------------------------------------------------------
+
+#if wxUSE_TIMER
+
+void wxGaugeBase::SetProgressSource(wxProgressSource *source, int interval)
+{
+    m_progressSource = source;
+
+    if ( !source )
+    {
+        if ( m_progressTimer )
+            m_progressTimer->Stop();
+        return;
+    }
+
+    if ( !m_progressTimer )
+    {
+        m_progressTimer = new wxTimer(this);
+        Bind(wxEVT_TIMER, &wxGaugeBase::OnProgressTimer, this,
+             m_progressTimer->GetId());
+    }
+
+    m_progressTimer->Start(interval);
+}
+
+void wxGaugeBase::OnProgressTimer(wxTimerEvent& WXUNUSED(event))
+{
+    if ( !m_progressSource )
+        return;
+
+    // Only update the gauge if the value really changed, there may be no
+    // progress at all between two timer ticks.
+    const int value = wxMin(m_progressSource->GetValue(), GetRange());
+    if ( value != GetValue() )
+        SetValue(value);
+}
+
+#endif // wxUSE_TIMER
+
 // ----------------------------------------------------------------------------
 // wxGauge indeterminate mode
 // ----------------------------------------------------------------------------
@@ -103,6 +103,7 @@ bool wxGBSizerItem::SetPos( const wxGBPosition& pos )
                  wxT("An item is already at that position") );
     }
     m_pos = pos;
+    InvalidateContainingSizer();
     return true;
 }
 
@@ -114,6 +115,7 @@ bool wxGBSizerItem::SetSpan( const wxGBSpan& span )
                  wxT("An item is already at that position") );
     }
     m_span = span;
+    InvalidateContainingSizer();
     return true;
 }
 
@@ -217,6 +219,7 @@ wxSizerItem* wxGridBagSizer::Add( wxGBSizerItem *item )
                  wxT("An item is already at that position") );
     m_children.Append(item);
     item->SetGBSizer(this);
+    item->SetContainingSizer(this);
     if ( item->GetWindow() )
         item->GetWindow()->SetContainingSizer( this );
 
@@ -232,6 +235,8 @@ wxSizerItem* wxGridBagSizer::Add( wxGBSizerItem *item )
     if ( col > GetCols() )
         SetCols(col);
 
+    InvalidateMinSize();
+
     return item;
 }
 
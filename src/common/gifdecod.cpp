@@ -60,11 +60,15 @@ public:
     int transparent;                // transparent color index (-1 = none)
     wxAnimationDisposal disposal;   // disposal method
     long delay;                     // delay in ms (-1 = unused)
-    unsigned char *p;               // bitmap
+    unsigned char *p;               // bitmap (NULL if not decoded)
     unsigned char *pal;             // palette
     unsigned int ncolours;          // number of colours
     wxString comment;
 
+    int bits;                       // initial LZW code size
+    bool interlaced;                // true if the image is interlaced
+    wxMemoryBuffer data;            // LZW data, without the block sizes
+
     wxDECLARE_NO_COPY_CLASS(GIFImage);
 };
 
@@ -87,8 +91,68 @@ GIFImage::GIFImage()
     p = (unsigned char *) NULL;
     pal = (unsigned char *) NULL;
     ncolours = 0;
+    bits = 0;
+    interlaced = false;
 }
 
+//---------------------------------------------------------------------------
+// GIFBitReader
+//---------------------------------------------------------------------------
+
+namespace
+{
+
+// Reader extracting variable-sized LZW codes from the frame data.
+//
+// As the data of the frame is entirely in memory, without the sub-block
+// sizes, the bits can be simply accumulated from it without any checks other
+// than for the end of the data.
+class GIFBitReader
+{
+public:
+    GIFBitReader(const wxMemoryBuffer& buf)
+    {
+        m_p = static_cast<const unsigned char *>(buf.GetData());
+        m_end = m_p + buf.GetDataLen();
+        m_acc = 0;
+        m_nbits = 0;
+    }
+
+    // Return the next code of the given size or the end of information code
+    // if there is no more data.
+    int GetCode(int bits, int ab_fin)
+    {
+        while ( m_nbits < bits )
+        {
+            if ( m_p == m_end )
+                return ab_fin;
+
+            m_acc |= static_cast<wxUint32>(*m_p++) << m_nbits;
+            m_nbits += 8;
+        }
+
+        const int code = m_acc & ((1 << bits) - 1);
+        m_acc >>= bits;
+        m_nbits -= bits;
+
+        return code;
+    }
+
+private:
+    const unsigned char *m_p;
+    const unsigned char *m_end;
+
+    wxUint32 m_acc;                 // bits not consumed yet
+    int m_nbits;                    // number of valid bits in m_acc
+
+    wxDECLARE_NO_COPY_CLASS(GIFBitReader);
+};
+
+// The maximal number of frames kept decoded at any given moment.
+const size_t GIF_MAX_DECODED_FRAMES = 4;
+
+} // anonymous namespace
+
 //---------------------------------------------------------------------------
 // wxGIFDecoder constructor and destructor
 //---------------------------------------------------------------------------
@@ -114,6 +178,7 @@ void wxGIFDecoder::Destroy()
     }
 
     m_frames.Clear();
+    m_decodedFrames.Clear();
     m_nFrames = 0;
 }
 
@@ -135,6 +200,10 @@ bool wxGIFDecoder::ConvertToImage(unsigned int frame, wxImage *image) const
     const wxString&
         transparency = image->GetOption(wxIMAGE_OPTION_GIF_TRANSPARENCY);
 
+    src = GetData(frame);
+    if (!src)
+        return false;
+
     // create the image
     wxSize sz = GetFrameSize(frame);
     image->Create(sz.GetWidth(), sz.GetHeight());
@@ -144,7 +213,6 @@ bool wxGIFDecoder::ConvertToImage(unsigned int frame, wxImage *image) const
         return false;
 
     pal = GetPalette(frame);
-    src = GetData(frame);
     dst = image->GetData();
     transparent = GetTransparentColourIndex(frame);
 
@@ -276,7 +344,14 @@ wxColour wxGIFDecoder::GetTransparentColour(unsigned int frame) const
                     pal[n*3 + 2]);
 }
 
-unsigned char* wxGIFDecoder::GetData(unsigned int frame) const    { return (GetFrame(frame)->p); }
+unsigned char* wxGIFDecoder::GetData(unsigned int frame) const
+{
+    if ( DecodeFrame(frame) != wxGIF_OK )
+        return NULL;
+
+    return GetFrame(frame)->p;
+}
+
 unsigned char* wxGIFDecoder::GetPalette(unsigned int frame) const { return (GetFrame(frame)->pal); }
 unsigned int wxGIFDecoder::GetNcolours(unsigned int frame) const  { return (GetFrame(frame)->ncolours); }
 int wxGIFDecoder::GetTransparentColourIndex(unsigned int frame) const  { return (GetFrame(frame)->transparent); }
@@ -287,71 +362,58 @@ int wxGIFDecoder::GetTransparentColourIndex(unsigned int frame) const  { return
 // GIF reading and decoding
 //---------------------------------------------------------------------------
 
-// getcode:
-//  Reads the next code from the file stream, with size 'bits'
+// DecodeFrame:
+//  Decodes the frame if it's not in the cache of the decoded frames yet,
+//  evicting the least recently used frame from it if it's full.
 //
-int wxGIFDecoder::getcode(wxInputStream& stream, int bits, int ab_fin)
+wxGIFErrorCode wxGIFDecoder::DecodeFrame(unsigned int frame) const
 {
-    unsigned int mask;          // bit mask
-    unsigned int code;          // code (result)
+    const int pos = m_decodedFrames.Index(frame);
+    if ( pos != wxNOT_FOUND )
+    {
+        if ( static_cast<size_t>(pos) != m_decodedFrames.size() - 1 )
+        {
+            m_decodedFrames.RemoveAt(pos);
+            m_decodedFrames.Add(frame);
+        }
 
-    // get remaining bits from last byte read
-    mask = (1 << bits) - 1;
-    code = (m_lastbyte >> (8 - m_restbits)) & mask;
+        return wxGIF_OK;
+    }
 
-    // keep reading new bytes while needed
-    while (bits > m_restbits)
+    if ( m_decodedFrames.size() == GIF_MAX_DECODED_FRAMES )
     {
-        // if no bytes left in this block, read the next block
-        if (m_restbyte == 0)
-        {
-            m_restbyte = stream.GetC();
-
-            /* Some encoders are a bit broken: instead of issuing
-             * an end-of-image symbol (ab_fin) they come up with
-             * a zero-length subblock!! We catch this here so
-             * that the decoder sees an ab_fin code.
-             */
-            if (m_restbyte == 0)
-            {
-                code = ab_fin;
-                break;
-            }
+        GIFImage * const old = GetFrame(m_decodedFrames[0]);
+        free(old->p);
+        old->p = NULL;
 
-            // prefetch data
-            stream.Read((void *) m_buffer, m_restbyte);
-            if (stream.LastRead() != m_restbyte)
-            {
-                code = ab_fin;
-                return code;
-            }
-            m_bufp = m_buffer;
-        }
+        m_decodedFrames.RemoveAt(0);
+    }
 
-        // read next byte and isolate the bits we need
-        m_lastbyte = (unsigned char) (*m_bufp++);
-        mask       = (1 << (bits - m_restbits)) - 1;
-        code       = code + ((m_lastbyte & mask) << m_restbits);
-        m_restbyte--;
+    GIFImage * const img = GetFrame(frame);
+    img->p = (unsigned char *) malloc(img->w * img->h);
+    if ( !img->p )
+        return wxGIF_MEMERR;
 
-        // adjust total number of bits extracted from the buffer
-        m_restbits = m_restbits + 8;
+    const wxGIFErrorCode result = dgif(img);
+    if ( result != wxGIF_OK )
+    {
+        free(img->p);
+        img->p = NULL;
+        return result;
     }
 
-    // find number of bits remaining for next code
-    m_restbits = (m_restbits - bits);
+    m_decodedFrames.Add(frame);
 
-    return code;
+    return wxGIF_OK;
 }
 
 
 // dgif:
-//  GIF decoding function. The initial code size (aka root size)
-//  is 'bits'. Supports interlaced images (interl == 1).
+//  GIF decoding function, decodes the LZW data of the image into its
+//  bitmap which must be already allocated. Supports interlaced images.
 //  Returns wxGIF_OK (== 0) on success, or an error code if something
 // fails (see header file for details)
-wxGIFErrorCode
-wxGIFDecoder::dgif(wxInputStream& stream, GIFImage *img, int interl, int bits)
+wxGIFErrorCode wxGIFDecoder::dgif(GIFImage *img)
 {
     static const int allocSize = 4096 + 1;
 
@@ -367,6 +429,10 @@ wxGIFDecoder::dgif(wxInputStream& stream, GIFImage *img, int interl, int bits)
     if ( !stack )
         return wxGIF_MEMERR;
 
+    GIFBitReader reader(img->data);
+    const int bits = img->bits;
+    const bool interl = img->interlaced;
+
     int ab_clr;                     // clear code
     int ab_fin;                     // end of info code
     int ab_bits;                    // actual symbol width, in bits
@@ -391,16 +457,11 @@ wxGIFDecoder::dgif(wxInputStream& stream, GIFImage *img, int interl, int bits)
     pass     = 1;
     pos = x = y = 0;
 
-    // reset decoder vars
-    m_restbits = 0;
-    m_restbyte = 0;
-    m_lastbyte = 0;
-
     do
     {
         // get next code
         int readcode;
-        readcode = code = getcode(stream, ab_bits, ab_fin);
+        readcode = code = reader.GetCode(ab_bits, ab_fin);
 
         // end of image?
         if (code == ab_fin) break;
@@ -612,8 +673,10 @@ bool wxGIFDecoder::DoCanRead(wxInputStream &stream) const
 
 
 // LoadGIF:
-//  Reads and decodes one or more GIF images, depending on whether
-//  animated GIF support is enabled. Can read GIFs with any bit
+//  Reads one or more GIF images, depending on whether animated GIF
+//  support is enabled. Only the compressed data of the frames is read
+//  and it is decoded on demand, with the exception of the first frame
+//  which is decoded immediately to check its validity. Can read GIFs with any bit
 //  size (color depth), but the output images are always expanded
 //  to 8 bits per pixel. Also, the image palettes always contain
 //  256 colors, although some of them may be unused. Returns wxGIF_OK
@@ -623,9 +686,8 @@ bool wxGIFDecoder::DoCanRead(wxInputStream &stream) const
 wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
 {
     unsigned int  global_ncolors = 0;
-    int           bits, interl, i;
+    int           bits, i;
     wxAnimationDisposal disposal;
-    long          size;
     long          delay;
     unsigned char type = 0;
     unsigned char pal[768];
@@ -834,18 +896,17 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                     }
                 }
 
-                interl = ((buf[8] & 0x40)? 1 : 0);
-                size = pimg->w * pimg->h;
+                pimg->interlaced = (buf[8] & 0x40) != 0;
 
                 pimg->transparent = transparent;
                 pimg->disposal = disposal;
                 pimg->delay = delay;
 
-                // allocate memory for image and palette
-                pimg->p   = (unsigned char *) malloc((unsigned int)size);
+                // allocate memory for palette, the image itself is only
+                // allocated when it is decoded
                 pimg->pal = (unsigned char *) malloc(768);
 
-                if ((!pimg->p) || (!pimg->pal))
+                if (!pimg->pal)
                     return wxGIF_MEMERR;
 
                 // load local color map if available, else use global map
@@ -869,10 +930,23 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
                 if (bits == 0)
                     return wxGIF_INVFORMAT;
 
-                // decode image
-                wxGIFErrorCode result = dgif(stream, pimg.get(), interl, bits);
-                if (result != wxGIF_OK)
-                    return result;
+                pimg->bits = bits;
+
+                // read the image data sub-blocks, stopping at the terminating
+                // zero-length one or if the data is truncated
+                for ( ;; )
+                {
+                    const int len = stream.GetC();
+                    if ( len == wxEOF || len == 0 )
+                        break;
+
+                    stream.Read(pimg->data.GetAppendBuf(len), len);
+
+                    const size_t lastRead = stream.LastRead();
+                    pimg->data.UngetAppendBuf(lastRead);
+                    if ( lastRead != static_cast<size_t>(len) )
+                        break;
+                }
 
                 guardDestroy.Dismiss();
 
@@ -894,6 +968,15 @@ wxGIFErrorCode wxGIFDecoder::LoadGIF(wxInputStream& stream)
         return wxGIF_INVFORMAT;
     }
 
+    // decode the first frame, which is almost always going to be needed, to
+    // report errors in it immediately
+    const wxGIFErrorCode result = DecodeFrame(0);
+    if (result != wxGIF_OK)
+    {
+        Destroy();
+        return result;
+    }
+
     // try to read to the end of the stream
     while (type != GIF_MARKER_ENDOFDATA)
     {
@@ -37,6 +37,7 @@
 #include "wx/scopedptr.h"
 #include "wx/anidecod.h"
 #include "wx/private/icondir.h"
+#include "wx/private/image.h"
 
 // For memcpy
 #include <string.h>
@@ -75,7 +76,8 @@ wxIMPLEMENT_DYNAMIC_CLASS(wxBMPHandler,wxImageHandler);
 #define BI_BITFIELDS 3
 #endif
 
-#define poffset (line * width * 3 + column * 3)
+// offset of the current pixel in the current line
+#define poffset (column * 3)
 
 bool wxBMPHandler::SaveFile(wxImage *image,
                             wxOutputStream& stream,
@@ -548,9 +550,24 @@ bool wxBMPHandler::DoLoadDib(wxImage * image, int width, int height,
         height = -height;
     }
 
+    // Scale the bitmap down while reading it if it's too big: this is only
+    // possible for the uncompressed bitmaps, as RLE-compressed ones don't
+    // necessarily store all rows in order, and not for the icons as their
+    // mask would need to be scaled too.
+    wxSize size(width, height);
+    if ( IsBmp && comp != BI_RLE4 && comp != BI_RLE8 )
+    {
+        size = wxImageDownscaler::GetScaledSize
+               (
+                width, height,
+                image->GetOptionInt(wxIMAGE_OPTION_MAX_WIDTH),
+                image->GetOptionInt(wxIMAGE_OPTION_MAX_HEIGHT)
+               );
+    }
+
     // destroy existing here instead of:
     image->Destroy();
-    image->Create(width, height);
+    image->Create(size.x, size.y);
 
     unsigned char *ptr = image->GetData();
 
@@ -583,6 +600,20 @@ bool wxBMPHandler::DoLoadDib(wxImage * image, int width, int height,
         alpha = NULL;
     }
 
+    // if we do scale the image, the rows are read into the downscaler buffers
+    // instead of the image itself
+    wxScopedPtr<wxImageDownscaler> downscaler;
+    if ( size.x != width || size.y != height )
+    {
+        downscaler.reset(new wxImageDownscaler(image, width, height,
+                                               alpha != NULL));
+
+        // the alpha channel is discarded below if it's all zero, so the
+        // colours must not be weighted by it in this case
+        if ( alpha )
+            downscaler->IgnoreZeroAlpha();
+    }
+
     // Reading the palette, if it exists:
     if ( bpp < 16 && ncolors != 0 )
     {
@@ -722,10 +753,23 @@ bool wxBMPHandler::DoLoadDib(wxImage * image, int width, int height,
     // this case (see #10915)
     bool hasValidAlpha = false;
 
+    unsigned char *lineAlpha = NULL;
     for ( int row = 0; row < height; row++ )
     {
         int line = isUpsideDown ? height - 1 - row : row;
 
+        if ( downscaler )
+        {
+            ptr = downscaler->GetRowData();
+            lineAlpha = downscaler->GetRowAlpha();
+        }
+        else
+        {
+            ptr = data + line * width * 3;
+            if ( alpha )
+                lineAlpha = alpha + line * width;
+        }
+
         int linepos = 0;
         for ( int column = 0; column < width ; )
         {
@@ -973,7 +1017,7 @@ bool wxBMPHandler::DoLoadDib(wxImage * image, int width, int height,
                 if ( alpha )
                 {
                     temp = (unsigned char)((aDword & amask) >> ashift);
-                    alpha[line * width + column] = temp;
+                    lineAlpha[column] = temp;
 
                     if ( temp != wxALPHA_TRANSPARENT )
                         hasValidAlpha = true;
@@ -987,6 +1031,15 @@ bool wxBMPHandler::DoLoadDib(wxImage * image, int width, int height,
             if ( !stream.ReadAll(&aByte, 1) )
                 break;
         }
+
+        if ( downscaler )
+            downscaler->AddRow(line);
+    }
+
+    if ( downscaler )
+    {
+        downscaler->Finish();
+        wxImageDownscaler::SetOriginalSize(image, width, height);
     }
 
     image->SetMask(false);
@@ -30,6 +30,7 @@
 
 #include "wx/wfstream.h"
 #include "wx/xpmdecod.h"
+#include "wx/private/image.h"
 
 // For memcpy
 #include <string.h>
@@ -716,6 +717,238 @@ wxImage wxImage::ResampleBox(int width, int height) const
     return ret_image;
 }
 
+// ----------------------------------------------------------------------------
+// wxImageDownscaler
+// ----------------------------------------------------------------------------
+
+/* static */
+wxSize wxImageDownscaler::GetScaledSize(int width, int height,
+                                        unsigned maxWidth, unsigned maxHeight)
+{
+    // this uses the same (trivial) algorithm as the JPEG handler
+    while ( (maxWidth && unsigned(width) > maxWidth) ||
+                (maxHeight && unsigned(height) > maxHeight) )
+    {
+        if ( width < 2 || height < 2 )
+            break;
+
+        width /= 2;
+        height /= 2;
+    }
+
+    return wxSize(width, height);
+}
+
+/* static */
+void wxImageDownscaler::SetOriginalSize(wxImage* image, int width, int height)
+{
+    if ( image->GetWidth() != width || image->GetHeight() != height )
+    {
+        image->SetOption(wxIMAGE_OPTION_ORIGINAL_WIDTH, width);
+        image->SetOption(wxIMAGE_OPTION_ORIGINAL_HEIGHT, height);
+    }
+}
+
+wxImageDownscaler::wxImageDownscaler(wxImage* image,
+                                     int width, int height,
+                                     bool hasAlpha)
+    : m_image(image),
+      m_srcWidth(width),
+      m_hasAlpha(hasAlpha),
+      m_weightByAlpha(hasAlpha),
+      m_numSums(hasAlpha ? 4 : 3)
+{
+    const int dstWidth = image->GetWidth(),
+              dstHeight = image->GetHeight();
+
+    wxASSERT_MSG( dstWidth <= width && dstHeight <= height,
+                  "can only scale the image down" );
+    wxASSERT_MSG( !hasAlpha || image->HasAlpha(),
+                  "destination image must have alpha" );
+
+    // Use the same boxes as ResampleBox() to get the same results.
+    wxVector<BoxPrecalc> boxes(dstWidth);
+    ResampleBoxPrecalc(boxes, width);
+    m_hBoxes.resize(dstWidth);
+    for ( int x = 0; x < dstWidth; x++ )
+    {
+        m_hBoxes[x].start = boxes[x].boxStart;
+        m_hBoxes[x].end = boxes[x].boxEnd;
+    }
+
+    boxes.resize(dstHeight);
+    ResampleBoxPrecalc(boxes, height);
+    m_vBoxes.resize(dstHeight);
+    for ( int y = 0; y < dstHeight; y++ )
+    {
+        m_vBoxes[y].start = boxes[y].boxStart;
+        m_vBoxes[y].end = boxes[y].boxEnd;
+    }
+
+    m_rowData.resize(3*width);
+    if ( hasAlpha )
+        m_rowAlpha.resize(width);
+
+    for ( size_t n = 0; n < WXSIZEOF(m_rows); n++ )
+    {
+        m_rows[n].y = -1;
+        m_rows[n].sums.resize(m_numSums*dstWidth);
+    }
+}
+
+void wxImageDownscaler::IgnoreZeroAlpha()
+{
+    wxASSERT_MSG( m_hasAlpha, "only makes sense for images with alpha" );
+    wxASSERT_MSG( m_rows[0].y == -1 && m_rows[1].y == -1,
+                  "must be called before adding any rows" );
+
+    m_weightByAlpha = false;
+}
+
+void wxImageDownscaler::StartWeightingByAlpha()
+{
+    m_weightByAlpha = true;
+
+    // All the pixels added so far were fully transparent, so their weighted
+    // sums are all zero and the rows already written, which are not going to
+    // be changed any more, must be black.
+    for ( size_t n = 0; n < WXSIZEOF(m_rows); n++ )
+        m_rows[n].sums.assign(m_rows[n].sums.size(), 0.);
+
+    memset(m_image->GetData(), 0, 3*m_image->GetWidth()*m_image->GetHeight());
+}
+
+void wxImageDownscaler::AddRow(int y)
+{
+    if ( m_hasAlpha && !m_weightByAlpha )
+    {
+        for ( int i = 0; i < m_srcWidth; i++ )
+        {
+            if ( m_rowAlpha[i] )
+            {
+                StartWeightingByAlpha();
+                break;
+            }
+        }
+    }
+
+    // Find the first destination row containing this source row: it is the
+    // one which would contain it if the boxes didn't overlap or the previous
+    // one otherwise.
+    const int dstHeight = m_vBoxes.size();
+    const int srcHeight = m_vBoxes.back().end + 1;
+    int yDst = static_cast<int>((static_cast<double>(y)*dstHeight)/srcHeight);
+    while ( yDst > 0 && m_vBoxes[yDst - 1].end >= y )
+        yDst--;
+    while ( yDst < dstHeight - 1 && m_vBoxes[yDst].end < y )
+        yDst++;
+
+    for ( ; yDst < dstHeight && m_vBoxes[yDst].start <= y; yDst++ )
+    {
+        Row& row = m_rows[yDst % 2];
+        if ( row.y != yDst )
+        {
+            FlushRow(row);
+            row.y = yDst;
+        }
+
+        double* sums = &row.sums[0];
+        const size_t dstWidth = m_hBoxes.size();
+        for ( size_t x = 0; x < dstWidth; x++, sums += m_numSums )
+        {
+            const Box& box = m_hBoxes[x];
+            for ( int i = box.start; i <= box.end; i++ )
+            {
+                const unsigned char* const src = &m_rowData[3*i];
+                if ( m_weightByAlpha )
+                {
+                    const unsigned char a = m_rowAlpha[i];
+                    sums[0] += src[0] * a;
+                    sums[1] += src[1] * a;
+                    sums[2] += src[2] * a;
+                    sums[3] += a;
+                }
+                else
+                {
+                    // If we have alpha, it's still all zero, so there is no
+                    // need to update its sum.
+                    sums[0] += src[0];
+                    sums[1] += src[1];
+                    sums[2] += src[2];
+                }
+            }
+        }
+    }
+}
+
+void wxImageDownscaler::FlushRow(Row& row)
+{
+    if ( row.y == -1 )
+        return;
+
+    const Box& vBox = m_vBoxes[row.y];
+    const int rows = vBox.end - vBox.start + 1;
+
+    const int dstWidth = m_hBoxes.size();
+    unsigned char* data = m_image->GetData() + 3*dstWidth*row.y;
+    unsigned char* alpha = m_hasAlpha ? m_image->GetAlpha() + dstWidth*row.y
+                                      : NULL;
+
+    double* sums = &row.sums[0];
+    for ( int x = 0; x < dstWidth; x++, sums += m_numSums )
+    {
+        const Box& hBox = m_hBoxes[x];
+        const int count = rows*(hBox.end - hBox.start + 1);
+
+        // Just as ResampleBox(), use the values weighted by alpha if we have
+        // it and black if all the pixels are transparent.
+        if ( m_weightByAlpha )
+        {
+            if ( sums[3] )
+            {
+                data[0] = (unsigned char)(sums[0] / sums[3]);
+                data[1] = (unsigned char)(sums[1] / sums[3]);
+                data[2] = (unsigned char)(sums[2] / sums[3]);
+            }
+            else
+            {
+                data[0] = 0;
+                data[1] = 0;
+                data[2] = 0;
+            }
+        }
+        else
+        {
+            data[0] = (unsigned char)(sums[0] / count);
+            data[1] = (unsigned char)(sums[1] / count);
+            data[2] = (unsigned char)(sums[2] / count);
+        }
+        data += 3;
+
+        if ( m_hasAlpha )
+            *alpha++ = (unsigned char)(sums[3] / count);
+    }
+
+    row.y = -1;
+    row.sums.assign(row.sums.size(), 0.);
+}
+
+void wxImageDownscaler::Finish()
+{
+    // Flush the rows in the order of their indices, although it doesn't
+    // really matter.
+    if ( m_rows[0].y > m_rows[1].y )
+    {
+        FlushRow(m_rows[1]);
+        FlushRow(m_rows[0]);
+    }
+    else
+    {
+        FlushRow(m_rows[0]);
+        FlushRow(m_rows[1]);
+    }
+}
+
 namespace
 {
 
@@ -2781,21 +3014,19 @@ bool wxImage::DoLoad(wxImageHandler& handler, wxInputStream& stream, int index)
         return false;
     }
 
-    // rescale the image to the specified size if needed
+    // rescale the image to the specified size if needed: notice that the
+    // handler could have already done it while loading the image
     if ( maxWidth || maxHeight )
     {
-        const unsigned widthOrig = GetWidth(),
-                       heightOrig = GetHeight();
+        const int widthOrig = GetWidth(),
+                  heightOrig = GetHeight();
 
-        // this uses the same (trivial) algorithm as the JPEG handler
-        unsigned width = widthOrig,
-                 height = heightOrig;
-        while ( (maxWidth && width > maxWidth) ||
-                    (maxHeight && height > maxHeight) )
-        {
-            width /= 2;
-            height /= 2;
-        }
+        const wxSize size = wxImageDownscaler::GetScaledSize(widthOrig,
+                                                             heightOrig,
+                                                             maxWidth,
+                                                             maxHeight);
+        const int width = size.x,
+                  height = size.y;
 
         if ( width != widthOrig || height != heightOrig )
         {
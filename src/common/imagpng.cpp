@@ -25,6 +25,7 @@
 
 #include "wx/imagpng.h"
 #include "wx/versioninfo.h"
+#include "wx/private/image.h"
 
 #ifndef WX_PRECOMP
     #include "wx/log.h"
@@ -110,6 +111,7 @@ struct wxPNGImageData
         m_buf = NULL;
         info_ptr = (png_infop) NULL;
         png_ptr = (png_structp) NULL;
+        downscaler = NULL;
         ok = false;
     }
 
@@ -142,6 +144,7 @@ struct wxPNGImageData
 
     ~wxPNGImageData()
     {
+        delete downscaler;
         free(m_buf);
         free( lines );
 
@@ -156,10 +159,16 @@ struct wxPNGImageData
 
     void DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo);
 
+    // read the image row by row scaling it down to the image size
+    void DoReadScaled(wxImage* image,
+                      png_uint_32 width, png_uint_32 height,
+                      bool hasAlpha);
+
     unsigned char** lines;
     unsigned char* m_buf;
     png_infop info_ptr;
     png_structp png_ptr;
+    wxImageDownscaler* downscaler;
     bool ok;
 };
 
@@ -297,7 +306,11 @@ void
 wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
 {
     png_uint_32 width, height = 0;
-    int bit_depth, color_type;
+    int bit_depth, color_type, interlace_type;
+
+    // save this before calling Destroy()
+    const unsigned maxWidth = image->GetOptionInt(wxIMAGE_OPTION_MAX_WIDTH),
+                   maxHeight = image->GetOptionInt(wxIMAGE_OPTION_MAX_HEIGHT);
 
     image->Destroy();
 
@@ -323,26 +336,45 @@ wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
         return;
 
     png_read_info( png_ptr, info_ptr );
-    png_get_IHDR( png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, NULL, NULL, NULL );
+    png_get_IHDR( png_ptr, info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, NULL, NULL );
 
     png_set_expand(png_ptr);
     png_set_gray_to_rgb(png_ptr);
     png_set_strip_16( png_ptr );
     png_set_packing( png_ptr );
 
-    image->Create((int)width, (int)height, (bool) false /* no need to init pixels */);
-
-    if (!image->IsOk())
-        return;
-
     const bool needCopy =
         (color_type & PNG_COLOR_MASK_ALPHA) ||
         png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS);
 
-    if (!Alloc(width, height, needCopy ? NULL : image->GetData()))
+    // If the image needs to be scaled down, do it while reading it to avoid
+    // having to allocate memory for the full size image. This is only done
+    // for non-interlaced images because the interlaced ones can't be read
+    // row by row, they will be scaled by wxImage itself after loading them.
+    wxSize size((int)width, (int)height);
+    if ( (maxWidth || maxHeight) && interlace_type == PNG_INTERLACE_NONE )
+        size = wxImageDownscaler::GetScaledSize(size.x, size.y,
+                                                maxWidth, maxHeight);
+
+    image->Create(size.x, size.y, (bool) false /* no need to init pixels */);
+
+    if (!image->IsOk())
         return;
 
-    png_read_image( png_ptr, lines );
+    if ( size.x != (int)width || size.y != (int)height )
+    {
+        DoReadScaled(image, width, height, needCopy);
+        if ( !downscaler )
+            return;
+    }
+    else
+    {
+        if (!Alloc(width, height, needCopy ? NULL : image->GetData()))
+            return;
+
+        png_read_image( png_ptr, lines );
+    }
+
     png_read_end( png_ptr, info_ptr );
 
 #if wxUSE_PALETTE
@@ -413,13 +445,79 @@ wxPNGImageData::DoLoadPNGFile(wxImage* image, wxPNGInfoStruct& wxinfo)
 
 
     // loaded successfully, now init wxImage with this data
-    if (needCopy)
+    if (downscaler)
+        wxImageDownscaler::SetOriginalSize(image, width, height);
+    else if (needCopy)
         CopyDataFromPNG(image, lines, width, height);
 
     // This will indicate to the caller that loading succeeded.
     ok = true;
 }
 
+void
+wxPNGImageData::DoReadScaled(wxImage* image,
+                             png_uint_32 width, png_uint_32 height,
+                             bool hasAlpha)
+{
+    if ( hasAlpha )
+    {
+        image->SetAlpha();
+
+        // read RGBA rows into the intermediate buffer
+        if ( !Alloc(width, 1, NULL) )
+            return;
+    }
+
+    downscaler = new wxImageDownscaler(image, width, height, hasAlpha);
+
+    if ( !hasAlpha )
+    {
+        // read RGB rows directly into the downscaler buffer
+        if ( !Alloc(width, 1, downscaler->GetRowData()) )
+        {
+            wxDELETE(downscaler);
+            return;
+        }
+    }
+
+    // this is initially set to false and becomes true if we find any
+    // non-opaque pixels: in this case we keep the alpha channel, otherwise
+    // we get rid of it at the end, just as CopyDataFromPNG() does
+    bool hasTransparency = false;
+
+    unsigned char* const rowData = downscaler->GetRowData();
+    unsigned char* const rowAlpha = downscaler->GetRowAlpha();
+    for ( png_uint_32 y = 0; y < height; y++ )
+    {
+        png_read_row( png_ptr, lines[0], NULL );
+
+        if ( hasAlpha )
+        {
+            const unsigned char *ptrSrc = lines[0];
+            unsigned char *ptrDst = rowData;
+            for ( png_uint_32 x = 0; x < width; x++ )
+            {
+                *ptrDst++ = *ptrSrc++;
+                *ptrDst++ = *ptrSrc++;
+                *ptrDst++ = *ptrSrc++;
+
+                const unsigned char a = *ptrSrc++;
+                if ( !IsOpaque(a) )
+                    hasTransparency = true;
+
+                rowAlpha[x] = a;
+            }
+        }
+
+        downscaler->AddRow(y);
+    }
+
+    downscaler->Finish();
+
+    if ( hasAlpha && !hasTransparency )
+        image->ClearAlpha();
+}
+
 bool
 wxPNGHandler::LoadFile(wxImage *image,
                        wxInputStream& stream,
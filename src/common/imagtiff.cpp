@@ -42,6 +42,8 @@ extern "C"
 }
 #include "wx/filefn.h"
 #include "wx/wfstream.h"
+#include "wx/scopedptr.h"
+#include "wx/private/image.h"
 
 #ifndef TIFFLINKAGEMODE
     #define TIFFLINKAGEMODE LINKAGEMODE
@@ -290,6 +292,9 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     if (index == -1)
         index = 0;
 
+    const unsigned maxWidth = image->GetOptionInt(wxIMAGE_OPTION_MAX_WIDTH),
+                   maxHeight = image->GetOptionInt(wxIMAGE_OPTION_MAX_HEIGHT);
+
     image->Destroy();
 
     TIFF *tif = TIFFwxOpen( stream, "image", "r" );
@@ -322,6 +327,58 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     TIFFGetField( tif, TIFFTAG_IMAGEWIDTH, &w );
     TIFFGetField( tif, TIFFTAG_IMAGELENGTH, &h );
 
+    // Check if we need to scale the image down while loading it.
+    const uint32 wOrig = w,
+                 hOrig = h;
+    const wxSize sizeScaled = wxImageDownscaler::GetScaledSize(w, h,
+                                                               maxWidth,
+                                                               maxHeight);
+    const bool scale = sizeScaled != wxSize(w, h);
+    if ( scale )
+    {
+        // If the file contains reduced resolution versions of this image, as
+        // pyramidal TIFFs do, use the smallest of them which is still at least
+        // as big as the size we need.
+        tdir_t dirBest = TIFFCurrentDirectory(tif);
+        uint32 wBest = w,
+               hBest = h;
+        while ( TIFFReadDirectory(tif) )
+        {
+            uint32 subfileType = 0;
+            if ( !TIFFGetField(tif, TIFFTAG_SUBFILETYPE, &subfileType) ||
+                    !(subfileType & FILETYPE_REDUCEDIMAGE) )
+                break;
+
+            uint32 wSub = 0,
+                   hSub = 0;
+            TIFFGetField( tif, TIFFTAG_IMAGEWIDTH, &wSub );
+            TIFFGetField( tif, TIFFTAG_IMAGELENGTH, &hSub );
+
+            if ( wSub >= (uint32)sizeScaled.x && hSub >= (uint32)sizeScaled.y &&
+                    wSub < wBest && hSub < hBest )
+            {
+                dirBest = TIFFCurrentDirectory(tif);
+                wBest = wSub;
+                hBest = hSub;
+            }
+        }
+
+        if ( !TIFFSetDirectory(tif, dirBest) )
+        {
+            if (verbose)
+            {
+                wxLogError( _("TIFF: Error loading image.") );
+            }
+
+            TIFFClose( tif );
+
+            return false;
+        }
+
+        w = wBest;
+        h = hBest;
+    }
+
     uint16 samplesPerPixel = 0;
     (void) TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesPerPixel);
 
@@ -345,9 +402,47 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         || (extraSamples == 0 && samplesPerPixel == 4
             && photometric == PHOTOMETRIC_RGB);
 
+    uint16 planarConfig = PLANARCONFIG_CONTIG;
+    (void) TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &planarConfig);
+
+    char msg[1024] = "";
+    const bool readScanlines =
+        (planarConfig == PLANARCONFIG_CONTIG && samplesPerPixel == 2
+            && extraSamples == 1)
+        &&
+        (
+            ( !TIFFRGBAImageOK(tif, msg) )
+            || (bitsPerSample == 8)
+        );
+
+    // When scaling the image, we don't need to decode all of it at once, but
+    // can do it strip by strip (or row of tiles by row of tiles), as long as
+    // the rows are stored in the top to bottom order.
+    uint32 rowsPerChunk = h;
+    if ( scale )
+    {
+        uint16 orientation = ORIENTATION_TOPLEFT;
+        (void) TIFFGetFieldDefaulted(tif, TIFFTAG_ORIENTATION, &orientation);
+
+        if ( readScanlines )
+        {
+            rowsPerChunk = 1;
+        }
+        else if ( orientation == ORIENTATION_TOPLEFT )
+        {
+            if ( TIFFIsTiled(tif) )
+                (void) TIFFGetField(tif, TIFFTAG_TILELENGTH, &rowsPerChunk);
+            else
+                (void) TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerChunk);
+
+            if ( !rowsPerChunk || rowsPerChunk > h )
+                rowsPerChunk = h;
+        }
+    }
+
     // guard against integer overflow during multiplication which could result
     // in allocating a too small buffer and then overflowing it
-    const double bytesNeeded = (double)w * (double)h * sizeof(uint32);
+    const double bytesNeeded = (double)w * (double)rowsPerChunk * sizeof(uint32);
     if ( bytesNeeded >= wxUINT32_MAX )
     {
         if ( verbose )
@@ -374,7 +469,7 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         return false;
     }
 
-    image->Create( (int)w, (int)h );
+    image->Create( sizeScaled.x, sizeScaled.y );
     if (!image->IsOk())
     {
         if (verbose)
@@ -391,75 +486,140 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
     if ( hasAlpha )
         image->SetAlpha();
 
-    uint16 planarConfig = PLANARCONFIG_CONTIG;
-    (void) TIFFGetField(tif, TIFFTAG_PLANARCONFIG, &planarConfig);
+    wxScopedPtr<wxImageDownscaler> downscaler;
+    if ( scale )
+        downscaler.reset(new wxImageDownscaler(image, w, h, hasAlpha));
 
-    bool ok = true;
-    char msg[1024] = "";
-    if
-    (
-        (planarConfig == PLANARCONFIG_CONTIG && samplesPerPixel == 2
-            && extraSamples == 1)
-        &&
-        (
-            ( !TIFFRGBAImageOK(tif, msg) )
-            || (bitsPerSample == 8)
-        )
-    )
+    // This is only used when reading the image in chunks.
+    TIFFRGBAImage img;
+    const bool readChunks = !readScanlines && rowsPerChunk != h;
+    if ( readChunks )
     {
-        const bool isGreyScale = (bitsPerSample == 8);
-        unsigned char *buf = (unsigned char *)_TIFFmalloc(TIFFScanlineSize(tif));
-        uint32 pos = 0;
-        const bool minIsWhite = (photometric == PHOTOMETRIC_MINISWHITE);
-        const int minValue =  minIsWhite ? 255 : 0;
-        const int maxValue = 255 - minValue;
-
-        /*
-        Decode to ABGR format as that is what the code, that converts to
-        wxImage, later on expects (normally TIFFReadRGBAImageOriented is
-        used to decode which uses an ABGR layout).
-        */
-        for (uint32 y = 0; y < h; ++y)
+        if ( !TIFFRGBAImageBegin(&img, tif, 0, msg) )
         {
-            if (TIFFReadScanline(tif, buf, y, 0) != 1)
+            if (verbose)
             {
-                ok = false;
-                break;
+                wxLogError( _("TIFF: Error reading image.") );
             }
 
-            if (isGreyScale)
+            _TIFFfree( raster );
+            image->Destroy();
+            TIFFClose( tif );
+
+            return false;
+        }
+
+        img.req_orientation = ORIENTATION_TOPLEFT;
+    }
+
+    unsigned char *buf = NULL;
+    if ( readScanlines )
+        buf = (unsigned char *)_TIFFmalloc(TIFFScanlineSize(tif));
+
+    bool ok = true;
+    for ( uint32 y0 = 0; y0 < h && ok; y0 += rowsPerChunk )
+    {
+        const uint32 rows = wxMin(rowsPerChunk, h - y0);
+
+        if ( readScanlines )
+        {
+            const bool isGreyScale = (bitsPerSample == 8);
+            uint32 pos = 0;
+            const bool minIsWhite = (photometric == PHOTOMETRIC_MINISWHITE);
+            const int minValue =  minIsWhite ? 255 : 0;
+            const int maxValue = 255 - minValue;
+
+            /*
+            Decode to ABGR format as that is what the code, that converts to
+            wxImage, later on expects (normally TIFFReadRGBAImageOriented is
+            used to decode which uses an ABGR layout).
+            */
+            for (uint32 y = y0; y < y0 + rows; ++y)
             {
-                for (uint32 x = 0; x < w; ++x)
+                if (TIFFReadScanline(tif, buf, y, 0) != 1)
                 {
-                    uint8 val = minIsWhite ? 255 - buf[x*2] : buf[x*2];
-                    uint8 alpha = minIsWhite ? 255 - buf[x*2+1] : buf[x*2+1];
-                    raster[pos] = val + (val << 8) + (val << 16)
-                        + (alpha << 24);
-                    pos++;
+                    ok = false;
+                    break;
                 }
-            }
-            else
-            {
-                for (uint32 x = 0; x < w; ++x)
+
+                if (isGreyScale)
                 {
-                    int mask = buf[x*2/8] << ((x*2)%8);
+                    for (uint32 x = 0; x < w; ++x)
+                    {
+                        uint8 val = minIsWhite ? 255 - buf[x*2] : buf[x*2];
+                        uint8 alpha = minIsWhite ? 255 - buf[x*2+1] : buf[x*2+1];
+                        raster[pos] = val + (val << 8) + (val << 16)
+                            + (alpha << 24);
+                        pos++;
+                    }
+                }
+                else
+                {
+                    for (uint32 x = 0; x < w; ++x)
+                    {
+                        int mask = buf[x*2/8] << ((x*2)%8);
 
-                    uint8 val = mask & 128 ? maxValue : minValue;
-                    raster[pos] = val + (val << 8) + (val << 16)
-                        + ((mask & 64 ? maxValue : minValue) << 24);
-                    pos++;
+                        uint8 val = mask & 128 ? maxValue : minValue;
+                        raster[pos] = val + (val << 8) + (val << 16)
+                            + ((mask & 64 ? maxValue : minValue) << 24);
+                        pos++;
+                    }
                 }
             }
         }
+        else if ( readChunks )
+        {
+            img.row_offset = y0;
+            img.col_offset = 0;
+            ok = TIFFRGBAImageGet(&img, raster, w, rows) != 0;
+        }
+        else
+        {
+            ok = TIFFReadRGBAImageOriented( tif, w, h, raster,
+                ORIENTATION_TOPLEFT, 0 ) != 0;
+        }
 
-        _TIFFfree(buf);
-    }
-    else
-    {
-        ok = TIFFReadRGBAImageOriented( tif, w, h, raster,
-            ORIENTATION_TOPLEFT, 0 ) != 0;
+        if ( !ok )
+            break;
+
+        uint32 pos = 0;
+
+        for (uint32 i = y0; i < y0 + rows; i++)
+        {
+            unsigned char *ptr;
+            unsigned char *alpha;
+            if ( downscaler )
+            {
+                ptr = downscaler->GetRowData();
+                alpha = downscaler->GetRowAlpha();
+            }
+            else
+            {
+                ptr = image->GetData() + i*w*3;
+                alpha = hasAlpha ? image->GetAlpha() + i*w : NULL;
+            }
+
+            for (uint32 j = 0; j < w; j++)
+            {
+                *(ptr++) = (unsigned char)TIFFGetR(raster[pos]);
+                *(ptr++) = (unsigned char)TIFFGetG(raster[pos]);
+                *(ptr++) = (unsigned char)TIFFGetB(raster[pos]);
+                if ( hasAlpha )
+                    *(alpha++) = (unsigned char)TIFFGetA(raster[pos]);
+
+                pos++;
+            }
+
+            if ( downscaler )
+                downscaler->AddRow(i);
+        }
     }
 
+    if ( readChunks )
+        TIFFRGBAImageEnd(&img);
+
+    if ( buf )
+        _TIFFfree(buf);
 
     if (!ok)
     {
@@ -475,24 +635,10 @@ bool wxTIFFHandler::LoadFile( wxImage *image, wxInputStream& stream, bool verbos
         return false;
     }
 
-    unsigned char *ptr = image->GetData();
-
-    unsigned char *alpha = image->GetAlpha();
-
-    uint32 pos = 0;
-
-    for (uint32 i = 0; i < h; i++)
+    if ( downscaler )
     {
-        for (uint32 j = 0; j < w; j++)
-        {
-            *(ptr++) = (unsigned char)TIFFGetR(raster[pos]);
-            *(ptr++) = (unsigned char)TIFFGetG(raster[pos]);
-            *(ptr++) = (unsigned char)TIFFGetB(raster[pos]);
-            if ( hasAlpha )
-                *(alpha++) = (unsigned char)TIFFGetA(raster[pos]);
-
-            pos++;
-        }
+        downscaler->Finish();
+        wxImageDownscaler::SetOriginalSize(image, wOrig, hOrig);
     }
 
 
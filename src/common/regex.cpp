@@ -33,8 +33,13 @@
     #include "wx/log.h"
     #include "wx/intl.h"
     #include "wx/crt.h"
+    #include "wx/module.h"
 #endif //WX_PRECOMP
 
+#include "wx/atomic.h"
+#include "wx/hashmap.h"
+#include "wx/thread.h"
+
 // At least FreeBSD requires this.
 #if defined(__UNIX__)
 #   include <sys/types.h>
@@ -44,15 +49,12 @@
 
 // WXREGEX_USING_BUILTIN    defined when using the built-in regex lib
 // WXREGEX_USING_RE_SEARCH  defined when using re_search in the GNU regex lib
-// WXREGEX_IF_NEED_LEN()    wrap the len parameter only used with the built-in
-//                          or GNU regex
 // WXREGEX_CONVERT_TO_MB    defined when the regex lib is using chars and
 //                          wxChar is wide, so conversion must be done
 // WXREGEX_CHAR(x)          Convert wxChar to wxRegChar
 //
 #ifdef __REG_NOFRONT
 #   define WXREGEX_USING_BUILTIN
-#   define WXREGEX_IF_NEED_LEN(x) ,x
 #   if wxUSE_UNICODE
 #       define WXREGEX_CHAR(x) (x).wc_str()
 #   else
@@ -60,10 +62,7 @@
 #   endif
 #else
 #   ifdef HAVE_RE_SEARCH
-#       define WXREGEX_IF_NEED_LEN(x) ,x
 #       define WXREGEX_USING_RE_SEARCH
-#   else
-#       define WXREGEX_IF_NEED_LEN(x)
 #   endif
 #   if wxUSE_UNICODE
 #       define WXREGEX_CONVERT_TO_MB
@@ -102,6 +101,12 @@ public:
         return wx_truncate_cast(size_t, m_matches[n].rm_eo);
     }
 
+    void Set(size_t n, size_t start, size_t end)
+    {
+        m_matches[n].rm_so = start;
+        m_matches[n].rm_eo = end;
+    }
+
     regmatch_t *get() const         { return m_matches; }
 
 private:
@@ -132,6 +137,12 @@ public:
     size_t Start(size_t n) const    { return m_matches.start[n]; }
     size_t End(size_t n) const      { return m_matches.end[n]; }
 
+    void Set(size_t n, size_t start, size_t end)
+    {
+        m_matches.start[n] = start;
+        m_matches.end[n] = end;
+    }
+
     re_registers *get()             { return &m_matches; }
 
 private:
@@ -147,6 +158,57 @@ typedef wxChar wxRegChar;
 typedef char wxRegChar;
 #endif
 
+// the compiled regular expression: this object is immutable once created and
+// can be shared by several wxRegExImpl objects using the same expression,
+// possibly in different threads, which is why it uses an atomic reference
+// count instead of deriving from wxRefCounter
+class wxRegExCompiled
+{
+public:
+    wxRegExCompiled()
+        : m_nMatches(0), m_isLiteral(false), m_isCompiled(false), m_count(1)
+    {
+    }
+
+    void IncRef() { wxAtomicInc(m_count); }
+    void DecRef()
+    {
+        if ( wxAtomicDec(m_count) == 0 )
+            delete this;
+    }
+
+    // compiled RE
+    regex_t         m_RegEx;
+
+    // the number of subexpressions plus one, or 0 if wxRE_NOSUB was used
+    size_t          m_nMatches;
+
+    // the literal string which must occur in any match of this expression,
+    // it is empty if we couldn't find any such string
+    wxCharTypeBuffer<wxRegChar> m_literal;
+
+    // true if the expression is just m_literal, without any special
+    // characters
+    bool            m_isLiteral;
+
+    // true if m_RegEx is valid
+    bool            m_isCompiled;
+
+private:
+    // only DecRef() can delete this object
+    ~wxRegExCompiled()
+    {
+        if ( m_isCompiled )
+            wx_regfree(&m_RegEx);
+    }
+
+    wxAtomicInt     m_count;
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExCompiled);
+};
+
+typedef wxObjectDataPtr<wxRegExCompiled> wxRegExCompiledPtr;
+
 // the real implementation of wxRegEx
 class wxRegExImpl
 {
@@ -156,25 +218,42 @@ public:
     ~wxRegExImpl();
 
     // return true if Compile() had been called successfully
-    bool IsValid() const { return m_isCompiled; }
+    bool IsValid() const { return m_compiled.get() != NULL; }
 
     // RE operations
     bool Compile(const wxString& expr, int flags = 0);
-    bool Matches(const wxRegChar *str, int flags
-                 WXREGEX_IF_NEED_LEN(size_t len)) const;
+    bool Matches(const wxRegChar *str, int flags, size_t len) const;
     bool GetMatch(size_t *start, size_t *len, size_t index = 0) const;
     size_t GetMatchCount() const;
     int Replace(wxString *pattern, const wxString& replacement,
                 size_t maxMatches = 0) const;
 
+    // check if the string matches without computing the positions of the
+    // matches, which is faster
+    bool Test(const wxRegChar *str, int flags, size_t len) const;
+
 private:
     // return the string containing the error message for the given err code
-    wxString GetErrorMsg(int errorcode, bool badconv) const;
+    static wxString GetErrorMsg(const regex_t *re, int errorcode, bool badconv);
+    wxString GetErrorMsg(int errorcode, bool badconv) const
+    {
+        return GetErrorMsg(&m_compiled->m_RegEx, errorcode, badconv);
+    }
+
+    // really compile the expression, return NULL on error
+    static wxRegExCompiled *DoCompile(const wxString& expr, int flags);
+
+    // return false if the literal part of the expression, if any, doesn't
+    // occur in the string, in which case it can't match, otherwise return
+    // true and fill *pos with its position
+    bool FindLiteral(const wxRegChar *str, size_t len, size_t *pos) const;
+
+    // translate our flags to regexec() ones
+    static int GetExecFlags(int flags);
 
     // init the members
     void Init()
     {
-        m_isCompiled = false;
         m_Matches = NULL;
         m_nMatches = 0;
     }
@@ -182,10 +261,7 @@ private:
     // free the RE if compiled
     void Free()
     {
-        if ( IsValid() )
-        {
-            wx_regfree(&m_RegEx);
-        }
+        m_compiled.reset(NULL);
 
         delete m_Matches;
     }
@@ -197,17 +273,182 @@ private:
         Init();
     }
 
-    // compiled RE
-    regex_t         m_RegEx;
+    // compiled RE, NULL if we're not compiled
+    wxRegExCompiledPtr m_compiled;
 
     // the subexpressions data
     wxRegExMatches *m_Matches;
     size_t          m_nMatches;
+};
 
-    // true if m_RegEx is valid
-    bool            m_isCompiled;
+// ----------------------------------------------------------------------------
+// wxRegExCache: LRU cache of the compiled expressions
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+struct wxRegExCacheEntry
+{
+    wxString key;
+    wxRegExCompiledPtr compiled;
+
+    // the entries form a doubly-linked list in the order of use, the most
+    // recently used one first
+    wxRegExCacheEntry *prev,
+                      *next;
 };
 
+WX_DECLARE_STRING_HASH_MAP(wxRegExCacheEntry *, wxRegExCacheMap);
+
+class wxRegExCache
+{
+public:
+    wxRegExCache() : m_maxSize(64), m_first(NULL), m_last(NULL) { }
+    ~wxRegExCache() { Clear(); }
+
+    // return the cached expression or NULL
+    wxRegExCompiled *Get(const wxString& key)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+
+        const wxRegExCacheMap::const_iterator it = m_map.find(key);
+        if ( it == m_map.end() )
+            return NULL;
+
+        wxRegExCacheEntry * const entry = it->second;
+        Unlink(entry);
+        LinkFirst(entry);
+
+        wxRegExCompiled * const compiled = entry->compiled.get();
+        compiled->IncRef();
+        return compiled;
+    }
+
+    void Add(const wxString& key, wxRegExCompiled *compiled)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+
+        if ( !m_maxSize )
+            return;
+
+        wxRegExCacheEntry *& entry = m_map[key];
+        if ( entry )
+        {
+            // another thread has compiled the same expression in the
+            // meanwhile, just keep using the existing one
+            return;
+        }
+
+        entry = new wxRegExCacheEntry;
+        entry->key = key;
+        compiled->IncRef();
+        entry->compiled = compiled;
+        LinkFirst(entry);
+
+        Shrink(m_maxSize);
+    }
+
+    void SetMaxSize(size_t size)
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+
+        m_maxSize = size;
+        Shrink(m_maxSize);
+    }
+
+    size_t GetMaxSize() const { return m_maxSize; }
+
+    void Clear()
+    {
+#if wxUSE_THREADS
+        wxCriticalSectionLocker lock(m_cs);
+#endif
+
+        Shrink(0);
+    }
+
+private:
+    void LinkFirst(wxRegExCacheEntry *entry)
+    {
+        entry->prev = NULL;
+        entry->next = m_first;
+        if ( m_first )
+            m_first->prev = entry;
+        else
+            m_last = entry;
+        m_first = entry;
+    }
+
+    void Unlink(wxRegExCacheEntry *entry)
+    {
+        if ( entry->prev )
+            entry->prev->next = entry->next;
+        else
+            m_first = entry->next;
+
+        if ( entry->next )
+            entry->next->prev = entry->prev;
+        else
+            m_last = entry->prev;
+    }
+
+    // remove the least recently used entries exceeding the given size
+    void Shrink(size_t size)
+    {
+        while ( m_map.size() > size )
+        {
+            wxRegExCacheEntry * const entry = m_last;
+            Unlink(entry);
+            m_map.erase(entry->key);
+            delete entry;
+        }
+    }
+
+    size_t m_maxSize;
+
+    wxRegExCacheMap m_map;
+    wxRegExCacheEntry *m_first,
+                      *m_last;
+
+#if wxUSE_THREADS
+    wxCriticalSection m_cs;
+#endif
+
+    wxDECLARE_NO_COPY_CLASS(wxRegExCache);
+};
+
+// use a function-local static to ensure that the cache is constructed before
+// its first use, even from the ctors of other global objects
+wxRegExCache& GetRegExCache()
+{
+    static wxRegExCache s_regexCache;
+
+    return s_regexCache;
+}
+
+} // anonymous namespace
+
+// ensure the cache is cleared before the library shutdown
+class wxRegExModule : public wxModule
+{
+public:
+    wxRegExModule() { }
+
+    virtual bool OnInit() wxOVERRIDE { return true; }
+    virtual void OnExit() wxOVERRIDE { GetRegExCache().Clear(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxRegExModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxRegExModule, wxModule);
 
 // ============================================================================
 // implementation
@@ -227,7 +468,10 @@ wxRegExImpl::~wxRegExImpl()
     Free();
 }
 
-wxString wxRegExImpl::GetErrorMsg(int errorcode, bool badconv) const
+/* static */
+wxString wxRegExImpl::GetErrorMsg(const regex_t *re,
+                                  int errorcode,
+                                  bool badconv)
 {
 #ifdef WXREGEX_CONVERT_TO_MB
     // currently only needed when using system library in Unicode mode
@@ -243,12 +487,12 @@ wxString wxRegExImpl::GetErrorMsg(int errorcode, bool badconv) const
     wxString szError;
 
     // first get the string length needed
-    int len = wx_regerror(errorcode, &m_RegEx, NULL, 0);
+    int len = wx_regerror(errorcode, re, NULL, 0);
     if ( len > 0 )
     {
         char* szcmbError = new char[++len];
 
-        (void)wx_regerror(errorcode, &m_RegEx, szcmbError, len);
+        (void)wx_regerror(errorcode, re, szcmbError, len);
 
         szError = wxConvLibc.cMB2WX(szcmbError);
         delete [] szcmbError;
@@ -275,6 +519,36 @@ bool wxRegExImpl::Compile(const wxString& expr, int flags)
     wxASSERT_MSG( !(flags & ~(FLAVORS | wxRE_ICASE | wxRE_NOSUB | wxRE_NEWLINE)),
                   wxT("unrecognized flags in wxRegEx::Compile") );
 
+    // re_search() modifies the compiled expression, so it can't be shared
+#ifndef WXREGEX_USING_RE_SEARCH
+    wxString key;
+    key << flags << wxT(':') << expr;
+
+    m_compiled = GetRegExCache().Get(key);
+    if ( !m_compiled )
+    {
+        m_compiled = DoCompile(expr, flags);
+        if ( m_compiled )
+            GetRegExCache().Add(key, m_compiled.get());
+    }
+#else // WXREGEX_USING_RE_SEARCH
+    m_compiled = DoCompile(expr, flags);
+#endif // !WXREGEX_USING_RE_SEARCH/WXREGEX_USING_RE_SEARCH
+
+    if ( !m_compiled )
+        return false;
+
+    // don't allocate the matches array now, but do it later if necessary
+    m_nMatches = m_compiled->m_nMatches;
+
+    return true;
+}
+
+/* static */
+wxRegExCompiled *wxRegExImpl::DoCompile(const wxString& expr, int flags)
+{
+    wxRegExCompiledPtr compiled(new wxRegExCompiled);
+
     // translate our flags to regcomp() ones
     int flagsRE = 0;
     if ( !(flags & wxRE_BASIC) )
@@ -294,69 +568,117 @@ bool wxRegExImpl::Compile(const wxString& expr, int flags)
         flagsRE |= REG_NEWLINE;
 
     // compile it
+    regex_t * const re = &compiled->m_RegEx;
 #ifdef WXREGEX_USING_BUILTIN
     bool conv = true;
     // FIXME-UTF8: use wc_str() after removing ANSI build
-    int errorcode = wx_re_comp(&m_RegEx, expr.c_str(), expr.length(), flagsRE);
+    int errorcode = wx_re_comp(re, expr.c_str(), expr.length(), flagsRE);
 #else
     // FIXME-UTF8: this is potentially broken, we shouldn't even try it
     //             and should always use builtin regex library (or PCRE?)
     const wxWX2MBbuf conv = expr.mbc_str();
-    int errorcode = conv ? regcomp(&m_RegEx, conv, flagsRE) : REG_BADPAT;
+    int errorcode = conv ? regcomp(re, conv, flagsRE) : REG_BADPAT;
 #endif
 
     if ( errorcode )
     {
         wxLogError(_("Invalid regular expression '%s': %s"),
-                   expr.c_str(), GetErrorMsg(errorcode, !conv).c_str());
+                   expr.c_str(), GetErrorMsg(re, errorcode, !conv).c_str());
 
-        m_isCompiled = false;
+        return NULL;
     }
-    else // ok
+
+    compiled->m_isCompiled = true;
+
+    if ( flags & wxRE_NOSUB )
     {
-        // don't allocate the matches array now, but do it later if necessary
-        if ( flags & wxRE_NOSUB )
-        {
-            // we don't need it at all
-            m_nMatches = 0;
-        }
-        else
-        {
-            // we will alloc the array later (only if really needed) but count
-            // the number of sub-expressions in the regex right now
+        // we don't need the matches array at all
+        compiled->m_nMatches = 0;
+    }
+    else
+    {
+        // we will alloc the array later (only if really needed) but count
+        // the number of sub-expressions in the regex right now
 
-            // there is always one for the whole expression
-            m_nMatches = 1;
+        // there is always one for the whole expression
+        compiled->m_nMatches = 1;
 
-            // and some more for bracketed subexperessions
-            for ( const wxChar *cptr = expr.c_str(); *cptr; cptr++ )
+        // and some more for bracketed subexperessions
+        for ( const wxChar *cptr = expr.c_str(); *cptr; cptr++ )
+        {
+            if ( *cptr == wxT('\\') )
             {
-                if ( *cptr == wxT('\\') )
-                {
-                    // in basic RE syntax groups are inside \(...\)
-                    if ( *++cptr == wxT('(') && (flags & wxRE_BASIC) )
-                    {
-                        m_nMatches++;
-                    }
-                }
-                else if ( *cptr == wxT('(') && !(flags & wxRE_BASIC) )
+                // in basic RE syntax groups are inside \(...\)
+                if ( *++cptr == wxT('(') && (flags & wxRE_BASIC) )
                 {
-                    // we know that the previous character is not an unquoted
-                    // backslash because it would have been eaten above, so we
-                    // have a bare '(' and this indicates a group start for the
-                    // extended syntax. '(?' is used for extensions by perl-
-                    // like REs (e.g. advanced), and is not valid for POSIX
-                    // extended, so ignore them always.
-                    if ( cptr[1] != wxT('?') )
-                        m_nMatches++;
+                    compiled->m_nMatches++;
                 }
             }
+            else if ( *cptr == wxT('(') && !(flags & wxRE_BASIC) )
+            {
+                // we know that the previous character is not an unquoted
+                // backslash because it would have been eaten above, so we
+                // have a bare '(' and this indicates a group start for the
+                // extended syntax. '(?' is used for extensions by perl-
+                // like REs (e.g. advanced), and is not valid for POSIX
+                // extended, so ignore them always.
+                if ( cptr[1] != wxT('?') )
+                    compiled->m_nMatches++;
+            }
         }
+    }
+
+    // Find the literal prefix of the expression: any match must contain it,
+    // so we can avoid running the regex engine at all for the strings which
+    // don't, which is the case for most of them when filtering. We only
+    // consider the ordinary characters up to the first special one, which
+    // is simple but still covers the most common case of searching for some
+    // text, and don't bother with case-insensitive expressions or the ones
+    // using alternatives at all.
+    if ( !(flags & wxRE_ICASE) && expr.find(wxT('|')) == wxString::npos )
+    {
+        static const wxChar *const metaChars = wxT("\\^$.|?*+()[]{}");
+
+        wxString::const_iterator p = expr.begin();
+        const bool anchored = p != expr.end() && *p == wxT('^');
+        if ( anchored )
+            ++p;
+
+        wxString literal;
+        for ( ; p != expr.end(); ++p )
+        {
+            if ( wxStrchr(metaChars, *p) )
+                break;
 
-        m_isCompiled = true;
+            literal += *p;
+        }
+
+        if ( p == expr.end() )
+        {
+            // the whole expression is a literal, we can find its matches
+            // ourselves, unless it is anchored
+            compiled->m_isLiteral = !anchored;
+        }
+        else if ( wxStrchr(wxT("?*+{\\"), *p) && !literal.empty() )
+        {
+            // the last character is (maybe) optional, or could be followed
+            // by some escaped quantifier
+            literal.RemoveLast();
+        }
+
+        if ( !literal.empty() )
+        {
+            compiled->m_literal = wxCharTypeBuffer<wxRegChar>
+                                  (
+                                    WXREGEX_CHAR(literal)
+                                  );
+        }
+
+        if ( !compiled->m_literal.length() )
+            compiled->m_isLiteral = false;
     }
 
-    return IsValid();
+    return compiled.release();
 }
 
 #ifdef WXREGEX_USING_RE_SEARCH
@@ -386,12 +708,9 @@ static int ReSearch(const regex_t *preg,
 
 #endif // WXREGEX_USING_RE_SEARCH
 
-bool wxRegExImpl::Matches(const wxRegChar *str,
-                          int flags
-                          WXREGEX_IF_NEED_LEN(size_t len)) const
+/* static */
+int wxRegExImpl::GetExecFlags(int flags)
 {
-    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
-
     // translate our flags to regexec() ones
     wxASSERT_MSG( !(flags & ~(wxRE_NOTBOL | wxRE_NOTEOL)),
                   wxT("unrecognized flags in wxRegEx::Matches") );
@@ -402,6 +721,46 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
     if ( flags & wxRE_NOTEOL )
         flagsRE |= REG_NOTEOL;
 
+    return flagsRE;
+}
+
+bool wxRegExImpl::FindLiteral(const wxRegChar *str, size_t len, size_t *pos) const
+{
+    const wxCharTypeBuffer<wxRegChar>& literal = m_compiled->m_literal;
+    const size_t lenLiteral = literal.length();
+    if ( !lenLiteral )
+    {
+        *pos = 0;
+        return true;
+    }
+
+    const wxRegChar first = literal[0];
+    for ( const wxRegChar *p = str; len >= lenLiteral; )
+    {
+        const wxRegChar *
+            found = wxTmemchr(p, first, len - lenLiteral + 1);
+        if ( !found )
+            break;
+
+        if ( wxTmemcmp(found + 1, literal.data() + 1, lenLiteral - 1) == 0 )
+        {
+            *pos = found - str;
+            return true;
+        }
+
+        len -= found + 1 - p;
+        p = found + 1;
+    }
+
+    return false;
+}
+
+bool wxRegExImpl::Matches(const wxRegChar *str, int flags, size_t len) const
+{
+    wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
+
+    int flagsRE = GetExecFlags(flags);
+
     // allocate matches array if needed
     wxRegExImpl *self = wxConstCast(this, wxRegExImpl);
     if ( !m_Matches && m_nMatches )
@@ -409,15 +768,33 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
         self->m_Matches = new wxRegExMatches(m_nMatches);
     }
 
+    // check if we can avoid calling the regex engine
+    if ( str )
+    {
+        size_t pos;
+        if ( !FindLiteral(str, len, &pos) )
+            return false;
+
+        if ( m_compiled->m_isLiteral )
+        {
+            if ( m_Matches )
+                m_Matches->Set(0, pos, pos + m_compiled->m_literal.length());
+
+            return true;
+        }
+    }
+
     wxRegExMatches::match_type matches = m_Matches ? m_Matches->get() : NULL;
 
     // do match it
+    regex_t * const re = &m_compiled->m_RegEx;
 #if defined WXREGEX_USING_BUILTIN
-    int rc = wx_re_exec(&self->m_RegEx, str, len, NULL, m_nMatches, matches, flagsRE);
+    int rc = wx_re_exec(re, str, len, NULL, m_nMatches, matches, flagsRE);
 #elif defined WXREGEX_USING_RE_SEARCH
-    int rc = str ? ReSearch(&self->m_RegEx, str, len, matches, flagsRE) : REG_BADPAT;
+    int rc = str ? ReSearch(re, str, len, matches, flagsRE) : REG_BADPAT;
 #else
-    int rc = str ? regexec(&self->m_RegEx, str, m_nMatches, matches, flagsRE) : REG_BADPAT;
+    wxUnusedVar(len);
+    int rc = str ? regexec(re, str, m_nMatches, matches, flagsRE) : REG_BADPAT;
 #endif
 
     switch ( rc )
@@ -438,6 +815,51 @@ bool wxRegExImpl::Matches(const wxRegChar *str,
     }
 }
 
+bool wxRegExImpl::Test(const wxRegChar *str, int flags, size_t len) const
+{
+    int flagsRE = GetExecFlags(flags);
+
+    if ( !str )
+    {
+        wxLogError(_("Failed to find match for regular expression: %s"),
+                   GetErrorMsg(0, true).c_str());
+        return false;
+    }
+
+    size_t pos;
+    if ( !FindLiteral(str, len, &pos) )
+        return false;
+
+    if ( m_compiled->m_isLiteral )
+        return true;
+
+    // when we don't need the positions of the subexpressions, the regex
+    // engine can avoid a lot of work, e.g. the built-in one only runs its
+    // DFA and doesn't need to backtrack at all
+    regex_t * const re = &m_compiled->m_RegEx;
+#if defined WXREGEX_USING_BUILTIN
+    int rc = wx_re_exec(re, str, len, NULL, 0, NULL, flagsRE);
+#elif defined WXREGEX_USING_RE_SEARCH
+    int rc = ReSearch(re, str, len, NULL, flagsRE);
+#else
+    int rc = regexec(re, str, 0, NULL, flagsRE);
+#endif
+
+    switch ( rc )
+    {
+        case 0:
+            return true;
+
+        default:
+            wxLogError(_("Failed to find match for regular expression: %s"),
+                       GetErrorMsg(rc, false).c_str());
+            wxFALLTHROUGH;
+
+        case REG_NOMATCH:
+            return false;
+    }
+}
+
 bool wxRegExImpl::GetMatch(size_t *start, size_t *len, size_t index) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
@@ -517,8 +939,8 @@ int wxRegExImpl::Replace(wxString *text,
 #else
                     textstr.data() + matchStart,
 #endif
-                    countRepl ? wxRE_NOTBOL : 0
-                    WXREGEX_IF_NEED_LEN(textlen - matchStart)) )
+                    countRepl ? wxRE_NOTBOL : 0,
+                    textlen - matchStart) )
     {
         // the string possibly contains back references: we need to calculate
         // the replacement text anew after each match
@@ -654,8 +1076,66 @@ bool wxRegEx::Matches(const wxString& str, int flags) const
 {
     wxCHECK_MSG( IsValid(), false, wxT("must successfully Compile() first") );
 
-    return m_impl->Matches(WXREGEX_CHAR(str), flags
-                            WXREGEX_IF_NEED_LEN(str.length()));
+#ifndef WXREGEX_CONVERT_TO_MB
+    return m_impl->Matches(WXREGEX_CHAR(str), flags, str.length());
+#else
+    const wxCharBuffer buf(WXREGEX_CHAR(str));
+    return m_impl->Matches(buf, flags, buf.length());
+#endif
+}
+
+size_t wxRegEx::Filter(const wxArrayString& strings,
+                       wxArrayInt *indices,
+                       int flags) const
+{
+    wxCHECK_MSG( IsValid(), 0, wxT("must successfully Compile() first") );
+
+    const size_t count = strings.size();
+    size_t matched = 0;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( Filter(&strings[n], 1, NULL, flags) )
+        {
+            if ( indices )
+                indices->push_back(n);
+
+            matched++;
+        }
+    }
+
+    return matched;
+}
+
+size_t wxRegEx::Filter(const wxString *strings,
+                       size_t count,
+                       wxArrayInt *indices,
+                       int flags) const
+{
+    wxCHECK_MSG( IsValid(), 0, wxT("must successfully Compile() first") );
+    wxCHECK_MSG( strings || !count, 0, wxT("NULL strings array") );
+
+    size_t matched = 0;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const wxString& str = strings[n];
+
+#ifndef WXREGEX_CONVERT_TO_MB
+        const bool ok = m_impl->Test(WXREGEX_CHAR(str), flags, str.length());
+#else
+        const wxCharBuffer buf(WXREGEX_CHAR(str));
+        const bool ok = m_impl->Test(buf, flags, buf.length());
+#endif
+
+        if ( ok )
+        {
+            if ( indices )
+                indices->push_back(n);
+
+            matched++;
+        }
+    }
+
+    return matched;
 }
 
 bool wxRegEx::GetMatch(size_t *start, size_t *len, size_t index) const
@@ -715,4 +1195,16 @@ wxString wxRegEx::QuoteMeta(const wxString& str)
     return strEscaped;
 }
 
+/* static */
+void wxRegEx::SetCacheSize(size_t size)
+{
+    GetRegExCache().SetMaxSize(size);
+}
+
+/* static */
+size_t wxRegEx::GetCacheSize()
+{
+    return GetRegExCache().GetMaxSize();
+}
+
 #endif // wxUSE_REGEX
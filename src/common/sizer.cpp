@@ -210,7 +210,8 @@ wxSizerItem::wxSizerItem(wxWindow *window,
              m_border(border),
              m_flag(flag),
              m_id(wxID_NONE),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
@@ -222,6 +223,9 @@ void wxSizerItem::DoSetSizer(wxSizer *sizer)
 {
     m_kind = Item_Sizer;
     m_sizer = sizer;
+
+    if ( m_containingSizer )
+        m_sizer->SetContainingSizer(m_containingSizer);
 }
 
 wxSizerItem::wxSizerItem(wxSizer *sizer,
@@ -236,7 +240,8 @@ wxSizerItem::wxSizerItem(wxSizer *sizer,
              m_flag(flag),
              m_id(wxID_NONE),
              m_ratio(0.0),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
@@ -294,7 +299,8 @@ wxSizerItem::wxSizerItem(int width,
              m_border(border),
              m_flag(flag),
              m_id(wxID_NONE),
-             m_userData(userData)
+             m_userData(userData),
+             m_containingSizer(NULL)
 {
     ASSERT_VALID_SIZER_FLAGS( m_flag );
 
@@ -334,6 +340,20 @@ void wxSizerItem::Free()
     m_kind = Item_None;
 }
 
+void wxSizerItem::SetContainingSizer(wxSizer *sizer)
+{
+    m_containingSizer = sizer;
+
+    if ( IsSizer() )
+        m_sizer->SetContainingSizer(sizer);
+}
+
+void wxSizerItem::InvalidateContainingSizer()
+{
+    if ( m_containingSizer )
+        m_containingSizer->InvalidateMinSize();
+}
+
 wxSize wxSizerItem::GetSpacer() const
 {
     wxSize size;
@@ -409,7 +429,11 @@ bool wxSizerItem::InformFirstDirection(int direction, int size, int availableOth
     {
         didUse = GetSizer()->InformFirstDirection(direction,size,availableOtherDir);
         if (didUse)
+        {
+            // The cached minimal size of the sizer is not valid any more.
+            GetSizer()->InvalidateMinSize();
             m_minSize = GetSizer()->CalcMin();
+        }
     }
     else if (IsWindow())
     {
@@ -445,6 +469,11 @@ bool wxSizerItem::InformFirstDirection(int direction, int size, int availableOth
         }
     }
 
+    // The minimal size of the item now depends on its size, so it must be
+    // recalculated during the next layout.
+    if ( didUse )
+        InvalidateContainingSizer();
+
     return didUse;
 }
 
@@ -625,6 +654,10 @@ void wxSizerItem::Show( bool show )
 
         case Item_Spacer:
             m_spacer->Show(show);
+
+            // unlike windows, spacers don't notify the sizer about their
+            // visibility changes themselves
+            InvalidateContainingSizer();
             break;
 
         case Item_Max:
@@ -678,12 +711,16 @@ wxSizerItem* wxSizer::DoInsert( size_t index, wxSizerItem *item )
 {
     m_children.Insert( index, item );
 
+    item->SetContainingSizer( this );
+
     if ( item->GetWindow() )
         item->GetWindow()->SetContainingSizer( this );
 
     if ( item->GetSizer() )
         item->GetSizer()->SetContainingWindow( m_containingWindow );
 
+    InvalidateMinSize();
+
     return item;
 }
 
@@ -723,6 +760,7 @@ bool wxSizer::Remove( wxSizer *sizer )
         {
             delete item;
             m_children.Erase( node );
+            InvalidateMinSize();
             return true;
         }
 
@@ -744,6 +782,7 @@ bool wxSizer::Remove( int index )
 
     delete node->GetData();
     m_children.Erase( node );
+    InvalidateMinSize();
 
     return true;
 }
@@ -759,9 +798,11 @@ bool wxSizer::Detach( wxSizer *sizer )
 
         if (item->GetSizer() == sizer)
         {
+            sizer->SetContainingSizer(NULL);
             item->DetachSizer();
             delete item;
             m_children.Erase( node );
+            InvalidateMinSize();
             return true;
         }
         node = node->GetNext();
@@ -783,6 +824,7 @@ bool wxSizer::Detach( wxWindow *window )
         {
             delete item;
             m_children.Erase( node );
+            InvalidateMinSize();
             return true;
         }
         node = node->GetNext();
@@ -804,10 +846,14 @@ bool wxSizer::Detach( int index )
     wxSizerItem *item = node->GetData();
 
     if ( item->IsSizer() )
+    {
+        item->GetSizer()->SetContainingSizer(NULL);
         item->DetachSizer();
+    }
 
     delete item;
     m_children.Erase( node );
+    InvalidateMinSize();
     return true;
 }
 
@@ -825,6 +871,7 @@ bool wxSizer::Replace( wxWindow *oldwin, wxWindow *newwin, bool recursive )
         {
             item->AssignWindow(newwin);
             newwin->SetContainingSizer( this );
+            InvalidateMinSize();
             return true;
         }
         else if (recursive && item->IsSizer())
@@ -852,6 +899,8 @@ bool wxSizer::Replace( wxSizer *oldsz, wxSizer *newsz, bool recursive )
         if (item->GetSizer() == oldsz)
         {
             item->AssignSizer(newsz);
+            newsz->SetContainingWindow( m_containingWindow );
+            InvalidateMinSize();
             return true;
         }
         else if (recursive && item->IsSizer())
@@ -883,6 +932,9 @@ bool wxSizer::Replace( size_t old, wxSizerItem *newitem )
 
     delete item;
 
+    newitem->SetContainingSizer(this);
+    InvalidateMinSize();
+
     return true;
 }
 
@@ -905,6 +957,8 @@ void wxSizer::Clear( bool delete_windows )
 
     // Now empty the list
     WX_CLEAR_LIST(wxSizerItemList, m_children);
+
+    InvalidateMinSize();
 }
 
 void wxSizer::DeleteWindows()
@@ -1016,6 +1070,19 @@ void wxSizer::RecalcSizes()
     wxFAIL_MSG( wxS("Must be overridden if RepositionChildren() is not") );
 }
 
+void wxSizer::SetDimension(const wxPoint& pos, const wxSize& size)
+{
+    m_position = pos;
+    m_size = size;
+    Layout();
+
+    // This call is required for wxWrapSizer to be able to calculate its
+    // minimal size correctly and, if it uses the size, our minimal size
+    // changes and the layout needs to be redone the next time.
+    if ( InformFirstDirection(wxHORIZONTAL, size.x, size.y) )
+        InvalidateMinSize();
+}
+
 void wxSizer::Layout()
 {
     // (re)calculates minimums needed for each item and other preparations
@@ -1099,16 +1166,62 @@ wxSize wxSizer::VirtualFitSize( wxWindow *window )
 
 wxSize wxSizer::GetMinSize()
 {
+    if ( m_minSizeCache.IsFullySpecified() )
+        return m_minSizeCache;
+
     wxSize ret( CalcMin() );
     if (ret.x < m_minSize.x) ret.x = m_minSize.x;
     if (ret.y < m_minSize.y) ret.y = m_minSize.y;
+
+    // Only cache the result if the minimal sizes of all our children sizers
+    // were cached too, they are always computed by CalcMin() if shown.
+    bool cache = m_cacheMinSize;
+    for ( wxSizerItemList::compatibility_iterator node = m_children.GetFirst();
+          cache && node;
+          node = node->GetNext() )
+    {
+        const wxSizerItem * const item = node->GetData();
+        if ( item->IsSizer() && item->IsShown() &&
+                !item->GetSizer()->m_minSizeCache.IsFullySpecified() )
+            cache = false;
+    }
+
+    if ( cache )
+        m_minSizeCache = ret;
+
     return ret;
 }
 
+void wxSizer::DoInvalidateMinSize()
+{
+    // Our minimal size affects the minimal sizes of all the sizers containing
+    // us, so invalidate them too. Notice that we can't stop when finding an
+    // already invalidated sizer as its parent could have been recalculated
+    // without recalculating it if it was hidden.
+    for ( wxSizer* sizer = this; sizer; sizer = sizer->m_containingSizer )
+        sizer->m_minSizeCache = wxDefaultSize;
+}
+
+void wxSizer::InvalidateMinSize()
+{
+    DoInvalidateMinSize();
+
+    // The best size of the window using the top level sizer is its minimal
+    // size, so it changes too.
+    wxSizer* top = this;
+    while ( top->m_containingSizer )
+        top = top->m_containingSizer;
+
+    if ( top->m_containingWindow )
+        top->m_containingWindow->InvalidateBestSize();
+}
+
 void wxSizer::DoSetMinSize( int width, int height )
 {
     m_minSize.x = width;
     m_minSize.y = height;
+
+    InvalidateMinSize();
 }
 
 bool wxSizer::DoSetItemMinSize( wxWindow *window, int width, int height )
@@ -2043,6 +2156,8 @@ void wxFlexGridSizer::AddGrowableRow( size_t idx, int proportion )
 
     m_growableRows.Add( idx );
     m_growableRowsProportions.Add( proportion );
+
+    InvalidateMinSize();
 }
 
 void wxFlexGridSizer::AddGrowableCol( size_t idx, int proportion )
@@ -2056,6 +2171,8 @@ void wxFlexGridSizer::AddGrowableCol( size_t idx, int proportion )
 
     m_growableCols.Add( idx );
     m_growableColsProportions.Add( proportion );
+
+    InvalidateMinSize();
 }
 
 // helper function for RemoveGrowableCol/Row()
@@ -2079,11 +2196,15 @@ DoRemoveFromArrays(size_t idx, wxArrayInt& items, wxArrayInt& proportions)
 void wxFlexGridSizer::RemoveGrowableCol( size_t idx )
 {
     DoRemoveFromArrays(idx, m_growableCols, m_growableColsProportions);
+
+    InvalidateMinSize();
 }
 
 void wxFlexGridSizer::RemoveGrowableRow( size_t idx )
 {
     DoRemoveFromArrays(idx, m_growableRows, m_growableRowsProportions);
+
+    InvalidateMinSize();
 }
 
 //---------------------------------------------------------------------------
@@ -191,4 +191,252 @@ bool wxTextFile::OnWrite(wxTextFileType typeNew, const wxMBConv& conv)
     return fileTmp.Commit();
 }
 
+// ============================================================================
+// wxIndexedTextFile class implementation
+// ============================================================================
+
+namespace
+{
+
+// the size of the chunks in which the file is read
+const size_t TEXTFILE_CHUNK_SIZE = 65536;
+
+// the minimal amount of data read when accessing a line at random
+const size_t TEXTFILE_RANDOM_READ_SIZE = 4096;
+
+} // anonymous namespace
+
+wxIndexedTextFile::wxIndexedTextFile(const wxString& strFileName,
+                                     const wxMBConv& conv)
+{
+    Init();
+
+    Open(strFileName, conv);
+}
+
+void wxIndexedTextFile::Init()
+{
+    m_conv = NULL;
+    m_bufStart = 0;
+}
+
+wxIndexedTextFile::~wxIndexedTextFile()
+{
+    delete m_conv;
+}
+
+bool wxIndexedTextFile::Open(const wxString& strFileName, const wxMBConv& conv)
+{
+    Close();
+
+    m_strFileName = strFileName;
+    if ( !m_file.Open(strFileName) )
+        return false;
+
+    m_conv = conv.Clone();
+
+    if ( !BuildIndex() )
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool wxIndexedTextFile::Close()
+{
+    wxDELETE(m_conv);
+
+    wxVector<wxFileOffset>().swap(m_aOffsets);
+    wxVector<unsigned char>().swap(m_aTypes);
+
+    m_buf = wxMemoryBuffer();
+    m_bufStart = 0;
+
+    return !m_file.IsOpened() || m_file.Close();
+}
+
+bool wxIndexedTextFile::BuildIndex()
+{
+    char buf[TEXTFILE_CHUNK_SIZE];
+
+    ssize_t nRead = m_file.Read(buf, WXSIZEOF(buf));
+    if ( nRead == wxInvalidOffset )
+    {
+        wxLogError(_("Failed to read text file \"%s\"."), GetName());
+        return false;
+    }
+
+    // Only encodings in which CR and LF are always represented by single bytes
+    // can be indexed, so skip the UTF-8 BOM but reject UTF-16/32 ones.
+    wxFileOffset start = 0;
+    switch ( wxConvAuto::DetectBOM(buf, nRead) )
+    {
+        case wxBOM_UTF8:
+            start = 3;
+            break;
+
+        case wxBOM_UTF16BE:
+        case wxBOM_UTF16LE:
+        case wxBOM_UTF32BE:
+        case wxBOM_UTF32LE:
+            wxLogError(_("Text file \"%s\" uses unsupported UTF-16 or UTF-32 encoding."),
+                       GetName());
+            return false;
+
+        case wxBOM_Unknown:
+        case wxBOM_None:
+            break;
+    }
+
+    m_aOffsets.push_back(start);
+
+    // The offset of the chunk in the file and whether the previous chunk
+    // ended with CR, which may be followed by LF at the start of this one.
+    wxFileOffset ofsChunk = 0;
+    bool pendingCR = false;
+    for ( ;; )
+    {
+        for ( ssize_t n = ofsChunk ? 0 : static_cast<ssize_t>(start);
+              n < nRead;
+              n++ )
+        {
+            const char ch = buf[n];
+
+            if ( pendingCR )
+            {
+                pendingCR = false;
+
+                if ( ch == '\n' )
+                {
+                    m_aTypes.push_back(wxTextFileType_Dos);
+                    m_aOffsets.push_back(ofsChunk + n + 1);
+                    continue;
+                }
+
+                m_aTypes.push_back(wxTextFileType_Mac);
+                m_aOffsets.push_back(ofsChunk + n);
+            }
+
+            if ( ch == '\r' )
+            {
+                pendingCR = true;
+            }
+            else if ( ch == '\n' )
+            {
+                m_aTypes.push_back(wxTextFileType_Unix);
+                m_aOffsets.push_back(ofsChunk + n + 1);
+            }
+        }
+
+        ofsChunk += nRead;
+
+        // Don't rely on the file length as it's not known for the special
+        // files, just read until there is nothing more to read.
+        if ( !nRead )
+            break;
+
+        nRead = m_file.Read(buf, WXSIZEOF(buf));
+        if ( nRead == wxInvalidOffset )
+        {
+            wxLogError(_("Failed to read text file \"%s\"."), GetName());
+            return false;
+        }
+    }
+
+    if ( pendingCR )
+    {
+        m_aTypes.push_back(wxTextFileType_Mac);
+        m_aOffsets.push_back(ofsChunk);
+    }
+    else if ( m_aOffsets.back() != ofsChunk )
+    {
+        // the last line is not terminated with a newline
+        m_aTypes.push_back(wxTextFileType_None);
+        m_aOffsets.push_back(ofsChunk);
+    }
+
+    return true;
+}
+
+const char *wxIndexedTextFile::ReadBytes(wxFileOffset ofs, size_t len) const
+{
+    // Reuse the data read previously if possible: this is the common case when
+    // accessing the lines sequentially.
+    const size_t bufLen = m_buf.GetDataLen();
+    if ( ofs >= m_bufStart &&
+            ofs + static_cast<wxFileOffset>(len) <=
+                m_bufStart + static_cast<wxFileOffset>(bufLen) )
+    {
+        return static_cast<const char *>(m_buf.GetData()) + (ofs - m_bufStart);
+    }
+
+    // Otherwise read enough data for this line and, hopefully, the next ones
+    // if the lines seem to be accessed sequentially. For random access, don't
+    // read much more than needed as it would be just wasted.
+    const bool sequential = ofs >= m_bufStart &&
+                                ofs <= m_bufStart + static_cast<wxFileOffset>(bufLen);
+    size_t sizeNeeded = sequential ? TEXTFILE_CHUNK_SIZE
+                                   : TEXTFILE_RANDOM_READ_SIZE;
+    if ( len > sizeNeeded )
+        sizeNeeded = len;
+    if ( m_file.Seek(ofs) == wxInvalidOffset )
+        return NULL;
+
+    void * const data = m_buf.GetWriteBuf(sizeNeeded);
+    const ssize_t nRead = m_file.Read(data, sizeNeeded);
+    if ( nRead == wxInvalidOffset || static_cast<size_t>(nRead) < len )
+    {
+        m_buf.UngetWriteBuf(0);
+        return NULL;
+    }
+
+    m_buf.UngetWriteBuf(nRead);
+    m_bufStart = ofs;
+
+    return static_cast<const char *>(data);
+}
+
+wxString wxIndexedTextFile::GetLine(size_t n) const
+{
+    wxCHECK_MSG( n < GetLineCount(), wxString(), wxT("invalid line index") );
+
+    size_t len = static_cast<size_t>(m_aOffsets[n + 1] - m_aOffsets[n]);
+    switch ( GetLineType(n) )
+    {
+        case wxTextFileType_Dos:
+            len -= 2;
+            break;
+
+        case wxTextFileType_Unix:
+        case wxTextFileType_Mac:
+            len--;
+            break;
+
+        default:
+            break;
+    }
+
+    if ( !len )
+        return wxString();
+
+    const char * const data = ReadBytes(m_aOffsets[n], len);
+    if ( !data )
+    {
+        wxLogError(_("Failed to read text file \"%s\"."), GetName());
+        return wxString();
+    }
+
+    wxString line(data, *m_conv, len);
+
+    // Fall back to Latin-1 for the lines which are invalid in the encoding
+    // being used, this is consistent with what wxConvAuto does for the entire
+    // files and ensures that we never lose the line contents entirely.
+    if ( line.empty() )
+        line = wxString(data, wxConvISO8859_1, len);
+
+    return line;
+}
+
 #endif // wxUSE_TEXTFILE
@@ -0,0 +1,475 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/threadpool.cpp
+// Purpose:     wxThreadPool implementation
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#if wxUSE_THREADS
+
+#include "wx/threadpool.h"
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+    #include "wx/log.h"
+    #include "wx/module.h"
+#endif // WX_PRECOMP
+
+#include "wx/except.h"
+#include "wx/tls.h"
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolWorker: one of the pool threads and its queue of tasks
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolWorker : public wxThread
+{
+public:
+    wxThreadPoolWorker(wxThreadPool& pool, size_t index)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_pool(pool),
+          m_index(index),
+          m_head(0),
+          m_count(0)
+    {
+    }
+
+    virtual void* Entry() wxOVERRIDE;
+
+    wxThreadPool& GetPool() const { return m_pool; }
+    size_t GetIndex() const { return m_index; }
+
+    bool HasTasks() const { return m_count != 0; }
+
+    // Add a task to the end of the queue.
+    void Push(wxThreadPoolTask* task)
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        m_tasks.push_back(task);
+        wxAtomicInc(m_count);
+    }
+
+    // Take the task from the end of the queue, only used by the worker itself.
+    wxThreadPoolTask* Pop()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        if ( m_tasks.size() == m_head )
+            return NULL;
+
+        wxThreadPoolTask* const task = m_tasks.back();
+        m_tasks.pop_back();
+        OnRemoved();
+
+        return task;
+    }
+
+    // Take the task from the start of the queue, used by the other threads.
+    wxThreadPoolTask* Steal()
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        if ( m_tasks.size() == m_head )
+            return NULL;
+
+        wxThreadPoolTask* const task = m_tasks[m_head++];
+        OnRemoved();
+
+        return task;
+    }
+
+private:
+    // Must be called with m_cs locked after removing a task from the queue.
+    void OnRemoved()
+    {
+        wxAtomicDec(m_count);
+
+        // Reclaim the space used by the stolen tasks, but avoid doing it too
+        // often, as it requires moving all the remaining tasks.
+        if ( m_head == m_tasks.size() )
+        {
+            m_tasks.clear();
+            m_head = 0;
+        }
+        else if ( m_head >= 64 && m_head >= m_tasks.size() / 2 )
+        {
+            m_tasks.erase(m_tasks.begin(), m_tasks.begin() + m_head);
+            m_head = 0;
+        }
+    }
+
+
+    wxThreadPool& m_pool;
+    const size_t m_index;
+
+    wxCriticalSection m_cs;
+
+    // The tasks in the queue are in [m_head, m_tasks.size()) range.
+    wxVector<wxThreadPoolTask*> m_tasks;
+    size_t m_head;
+
+    // The number of tasks in the queue, can be checked without locking m_cs.
+    wxAtomicInt m_count;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPoolWorker);
+};
+
+namespace
+{
+
+// The worker corresponding to the current thread.
+inline wxTLS_TYPE_REF(wxThreadPoolWorker*) GetThisThreadWorker()
+{
+    static wxTLS_TYPE(wxThreadPoolWorker*) s_thisThreadWorker;
+
+    return s_thisThreadWorker;
+}
+
+#define wxTHIS_THREAD_WORKER wxTLS_VALUE(GetThisThreadWorker())
+
+#ifdef wxHAS_CALL_AFTER
+
+// Functor used to call OnCompleted() of the task in the main thread, it keeps
+// a reference to the task until then.
+class wxThreadPoolTaskCompletion
+{
+public:
+    explicit wxThreadPoolTaskCompletion(wxThreadPoolTask* task)
+        : m_task(task)
+    {
+        task->IncRef();
+    }
+
+    void operator()() const { m_task->OnCompleted(); }
+
+private:
+    wxThreadPoolTaskPtr m_task;
+};
+
+#endif // wxHAS_CALL_AFTER
+
+// The global pool.
+wxThreadPool* gs_threadPool = NULL;
+
+inline wxCriticalSection& GetThreadPoolCS()
+{
+    static wxCriticalSection s_csThreadPool;
+
+    return s_csThreadPool;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolTask
+// ----------------------------------------------------------------------------
+
+wxThreadPoolTask::wxThreadPoolTask()
+    : m_refCount(1),
+      m_pending(1)
+{
+    m_pool = NULL;
+    m_group = NULL;
+    m_handler = NULL;
+}
+
+wxThreadPoolTask::~wxThreadPoolTask()
+{
+}
+
+void wxThreadPoolTask::Wait()
+{
+    wxCHECK_RET( m_pool, wxS("can't wait for the task which wasn't queued") );
+
+    m_pool->WaitFor(m_pending);
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolWorker
+// ----------------------------------------------------------------------------
+
+void* wxThreadPoolWorker::Entry()
+{
+    wxTHIS_THREAD_WORKER = this;
+
+    for ( ;; )
+    {
+        wxThreadPoolTask* const task = m_pool.TakeTask(this);
+        if ( task )
+        {
+            m_pool.ExecuteTask(task);
+            continue;
+        }
+
+        wxMutexLocker lock(m_pool.m_mutex);
+
+        // Incrementing m_numSleeping before checking m_numQueued, while
+        // DoQueue() does it in the opposite order, ensures that we can't miss
+        // a task queued concurrently.
+        wxAtomicInc(m_pool.m_numSleeping);
+        while ( m_pool.m_numQueued <= 0 && !m_pool.m_exiting )
+            m_pool.m_condWork.Wait();
+        wxAtomicDec(m_pool.m_numSleeping);
+
+        // Still execute all the remaining tasks before exiting.
+        if ( m_pool.m_exiting && m_pool.m_numQueued <= 0 )
+            break;
+    }
+
+    return NULL;
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPool
+// ----------------------------------------------------------------------------
+
+wxThreadPool::wxThreadPool(int numThreads)
+    : m_numQueued(0),
+      m_numSleeping(0),
+      m_numWaiting(0),
+      m_nextWorker(0),
+      m_condWork(m_mutex),
+      m_condDone(m_mutex),
+      m_exiting(false)
+{
+    if ( numThreads <= 0 )
+    {
+        numThreads = wxThread::GetCPUCount();
+        if ( numThreads <= 0 )
+            numThreads = 1;
+    }
+
+    // Create all the threads before running any of them as they access
+    // m_workers.
+    m_workers.reserve(numThreads);
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        wxThreadPoolWorker* const worker = new wxThreadPoolWorker(*this, n);
+        if ( worker->Create() != wxTHREAD_NO_ERROR )
+        {
+            wxLogError(_("Failed to create a thread pool thread."));
+
+            delete worker;
+            break;
+        }
+
+        m_workers.push_back(worker);
+    }
+
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+        m_workers[n]->Run();
+
+    // We can't do anything without threads at all, so this is fatal.
+    wxASSERT_MSG( !m_workers.empty(), "failed to create any pool threads" );
+}
+
+wxThreadPool::~wxThreadPool()
+{
+    {
+        wxMutexLocker lock(m_mutex);
+        m_exiting = true;
+        m_condWork.Broadcast();
+    }
+
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+    {
+        m_workers[n]->Wait();
+        delete m_workers[n];
+    }
+}
+
+/* static */
+wxThreadPool& wxThreadPool::Get()
+{
+    wxCriticalSectionLocker lock(GetThreadPoolCS());
+
+    if ( !gs_threadPool )
+        gs_threadPool = new wxThreadPool;
+
+    return *gs_threadPool;
+}
+
+wxThreadPoolWorker* wxThreadPool::GetCurrentWorker() const
+{
+    wxThreadPoolWorker* const worker = wxTHIS_THREAD_WORKER;
+
+    return worker && &worker->GetPool() == this ? worker : NULL;
+}
+
+void wxThreadPool::DoQueue(wxThreadPoolTask* task,
+                           wxEvtHandler* handler,
+                           wxTaskGroup* group)
+{
+    wxCHECK_RET( task, wxS("NULL task") );
+    wxCHECK_RET( !task->m_pool, wxS("task can't be queued more than once") );
+    wxCHECK_RET( !m_workers.empty(), wxS("no threads in the pool") );
+
+#ifndef wxHAS_CALL_AFTER
+    wxASSERT_MSG( !handler, wxS("completion handlers are not supported") );
+#endif // !wxHAS_CALL_AFTER
+
+    task->m_pool = this;
+    task->m_group = group;
+    task->m_handler = handler;
+
+    if ( group )
+        wxAtomicInc(group->m_pending);
+
+    // This reference is released by ExecuteTask().
+    task->IncRef();
+
+    wxThreadPoolWorker* worker = GetCurrentWorker();
+    if ( !worker )
+    {
+        const unsigned n = static_cast<unsigned>(m_nextWorker);
+        wxAtomicInc(m_nextWorker);
+
+        worker = m_workers[n % m_workers.size()];
+    }
+
+    worker->Push(task);
+
+    wxAtomicInc(m_numQueued);
+    if ( m_numSleeping )
+    {
+        wxMutexLocker lock(m_mutex);
+        m_condWork.Signal();
+    }
+}
+
+wxThreadPoolTask* wxThreadPool::TakeTask(wxThreadPoolWorker* worker)
+{
+    wxThreadPoolTask* task = worker ? worker->Pop() : NULL;
+    if ( !task )
+    {
+        // Start with the next worker, to avoid all threads trying to steal
+        // from the same one.
+        const size_t count = m_workers.size();
+        const size_t start = worker ? worker->GetIndex() : 0;
+
+        for ( size_t n = 1; n <= count && !task; n++ )
+        {
+            wxThreadPoolWorker* const victim = m_workers[(start + n) % count];
+            if ( victim != worker && victim->HasTasks() )
+                task = victim->Steal();
+        }
+
+        if ( !task )
+            return NULL;
+    }
+
+    wxAtomicDec(m_numQueued);
+
+    return task;
+}
+
+void wxThreadPool::ExecuteTask(wxThreadPoolTask* task)
+{
+    wxTRY
+    {
+        task->Run();
+    }
+    wxCATCH_ALL
+    (
+        if ( wxTheApp )
+            wxTheApp->OnUnhandledException();
+    )
+
+#ifdef wxHAS_CALL_AFTER
+    if ( task->m_handler )
+        task->m_handler->CallAfter(wxThreadPoolTaskCompletion(task));
+#endif // wxHAS_CALL_AFTER
+
+    // Notice that the group may be destroyed as soon as its counter reaches 0,
+    // so it must not be used after this.
+    wxTaskGroup* const group = task->m_group;
+    wxAtomicDec(task->m_pending);
+    if ( group )
+        wxAtomicDec(group->m_pending);
+
+    // As in the worker loop, the order of the operations here and in
+    // WaitFor() ensures that the waiting threads are always woken up.
+    if ( m_numWaiting )
+    {
+        wxMutexLocker lock(m_mutex);
+        m_condDone.Broadcast();
+    }
+
+    task->DecRef();
+}
+
+void wxThreadPool::WaitFor(wxAtomicInt& pending)
+{
+    wxThreadPoolWorker* const worker = GetCurrentWorker();
+
+    while ( pending != 0 )
+    {
+        // Help executing the tasks instead of just waiting, this is not only
+        // more efficient but also avoids deadlocks when the pool thread waits
+        // for the tasks queued by it.
+        wxThreadPoolTask* const task = TakeTask(worker);
+        if ( task )
+        {
+            ExecuteTask(task);
+            continue;
+        }
+
+        wxMutexLocker lock(m_mutex);
+
+        wxAtomicInc(m_numWaiting);
+        while ( pending != 0 && m_numQueued <= 0 )
+            m_condDone.Wait();
+        wxAtomicDec(m_numWaiting);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// wxThreadPoolModule: destroys the global pool
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolModule : public wxModule
+{
+public:
+    bool OnInit() wxOVERRIDE { return true; }
+    void OnExit() wxOVERRIDE
+    {
+        wxThreadPool* pool;
+        {
+            wxCriticalSectionLocker lock(GetThreadPoolCS());
+            pool = gs_threadPool;
+            gs_threadPool = NULL;
+        }
+
+        // Don't keep the lock while waiting for the pool tasks to complete.
+        delete pool;
+    }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxThreadPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxThreadPoolModule, wxModule);
+
+#endif // wxUSE_THREADS
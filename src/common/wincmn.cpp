@@ -662,6 +662,12 @@ void wxWindowBase::InvalidateBestSize()
 {
     m_bestSizeCache = wxDefaultSize;
 
+    // the minimal size of the sizer containing this window depends on it too
+    // (notice that the sizer doesn't need to invalidate the parent best size
+    // as it's done just below anyhow)
+    if ( m_containingSizer )
+        m_containingSizer->DoInvalidateMinSize();
+
     // parent's best size calculation may depend on its children's
     // as long as child window we are in is not top level window itself
     // (because the TLW size is never resized automatically)
@@ -1075,6 +1081,9 @@ void wxWindowBase::DoSetSizeHints( int minW, int minH,
     m_maxWidth = maxW;
     m_minHeight = minH;
     m_maxHeight = maxH;
+
+    // the minimal size of the sizer containing this window depends on it
+    InvalidateBestSize();
 }
 
 
@@ -1169,6 +1178,10 @@ bool wxWindowBase::Show(bool show)
     {
         m_isShown = show;
 
+        // hidden windows are not taken into account by the sizers
+        if ( m_containingSizer )
+            m_containingSizer->InvalidateMinSize();
+
         return true;
     }
     else
@@ -81,6 +81,12 @@ wxWrapSizer::wxWrapSizer(int orient, int flags)
              m_minItemMajor(INT_MAX),
              m_rows(orient ^ wxBOTH)
 {
+    // the row sizers contain our items, so changes to them must propagate to
+    // this sizer and the sizers containing it
+    m_rows.SetContainingSizer(this);
+
+    // our minimal size depends on the size we had been given before
+    m_cacheMinSize = false;
 }
 
 wxWrapSizer::~wxWrapSizer()
@@ -58,6 +58,7 @@
 #if wxUSE_ACCESSIBILITY
 #include "wx/private/markupparser.h"
 #endif // wxUSE_ACCESSIBILITY
+#include "wx/private/parallelsort.h"
 
 //-----------------------------------------------------------------------------
 // classes
@@ -1717,6 +1718,73 @@ void wxDataViewRenameTimer::Notify()
 namespace
 {
 
+// Sort key of a tree node, used when the model provides the sort keys.
+struct wxDataViewNodeSortEntry
+{
+    void Init(wxDataViewModel* model,
+              wxDataViewTreeNode* node_,
+              unsigned int column)
+    {
+        node = node_;
+        id = wxPtrToUInt(node->GetItem().GetID());
+        model->GetSortKey(key, node->GetItem(), column);
+    }
+
+    // Return negative, zero or positive value depending on whether the first
+    // entry is less than, equal to or greater than the second one, using the
+    // same order as the default wxDataViewModel::Compare() does.
+    static int Compare(const wxDataViewNodeSortEntry& first,
+                       const wxDataViewNodeSortEntry& second,
+                       bool ascending)
+    {
+        int res = first.key.Compare(second.key);
+        if ( !res )
+        {
+            // Use the IDs to order the items with the same key.
+            if ( first.id == second.id )
+                return 0;
+
+            res = first.id < second.id ? -1 : 1;
+        }
+
+        return ascending ? res : -res;
+    }
+
+    wxDataViewSortKey key;
+    wxUIntPtr id;
+    wxDataViewTreeNode* node;
+};
+
+typedef wxVector<const wxDataViewNodeSortEntry*> wxDataViewNodeSortEntries;
+
+// Comparator for the sort entries used by std::sort().
+class wxDataViewNodeSortEntryCmp
+{
+public:
+    explicit wxDataViewNodeSortEntryCmp(bool ascending)
+        : m_ascending(ascending)
+    {
+    }
+
+    bool operator()(const wxDataViewNodeSortEntry* first,
+                    const wxDataViewNodeSortEntry* second) const
+    {
+        return wxDataViewNodeSortEntry::Compare(*first, *second,
+                                                m_ascending) < 0;
+    }
+
+private:
+    const bool m_ascending;
+};
+
+// Return true if the items should be sorted using the keys provided by the
+// model rather than by calling its Compare().
+inline bool UseSortKeys(const wxDataViewModel* model, const SortOrder& sortOrder)
+{
+    return sortOrder.GetColumn() != SortColumn_Default &&
+            model->HasSortKeys(sortOrder.GetColumn());
+}
+
 // Comparator used for sorting the tree nodes using the model-defined sort
 // order and also for performing binary search in our own code.
 class wxGenericTreeModelNodeCmp
@@ -1725,7 +1793,8 @@ public:
     wxGenericTreeModelNodeCmp(wxDataViewMainWindow* window,
                               const SortOrder& sortOrder)
         : m_model(window->GetModel()),
-          m_sortOrder(sortOrder)
+          m_sortOrder(sortOrder),
+          m_useKeys(UseSortKeys(m_model, sortOrder))
     {
         wxASSERT_MSG( !m_sortOrder.IsNone(), "should have sort order" );
     }
@@ -1734,6 +1803,17 @@ public:
     // item is less than, equal to or greater than the second one.
     int Compare(wxDataViewTreeNode* first, wxDataViewTreeNode* second) const
     {
+        if ( m_useKeys )
+        {
+            // Compare the items in the same way as SortNodesByKeys() does.
+            wxDataViewNodeSortEntry entry1, entry2;
+            entry1.Init(m_model, first, m_sortOrder.GetColumn());
+            entry2.Init(m_model, second, m_sortOrder.GetColumn());
+
+            return wxDataViewNodeSortEntry::Compare(entry1, entry2,
+                                                    m_sortOrder.IsAscending());
+        }
+
         return m_model->Compare(first->GetItem(), second->GetItem(),
                                 m_sortOrder.GetColumn(),
                                 m_sortOrder.IsAscending());
@@ -1749,8 +1829,42 @@ public:
 private:
     wxDataViewModel* const m_model;
     const SortOrder m_sortOrder;
+    const bool m_useKeys;
 };
 
+// Sort the nodes using the keys provided by the model, retrieving the key of
+// each node only once, if the model supports it. Return false if it doesn't.
+bool SortNodesByKeys(wxDataViewModel* model,
+                     wxDataViewTreeNodes& nodes,
+                     const SortOrder& sortOrder)
+{
+    if ( !UseSortKeys(model, sortOrder) )
+        return false;
+
+    const unsigned int column = sortOrder.GetColumn();
+
+    // Notice that the keys must be retrieved in this thread, as the model
+    // is not supposed to be used from the other ones, but they can be
+    // compared in any of them, as long as only the pointers are moved and the
+    // keys themselves are not copied.
+    const size_t count = nodes.size();
+    wxVector<wxDataViewNodeSortEntry> entries(count);
+    wxDataViewNodeSortEntries sorted(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        entries[n].Init(model, nodes[n], column);
+        sorted[n] = &entries[n];
+    }
+
+    wxParallelSort(sorted.begin(), sorted.end(),
+                   wxDataViewNodeSortEntryCmp(sortOrder.IsAscending()));
+
+    for ( size_t n = 0; n < count; n++ )
+        nodes[n] = sorted[n]->node;
+
+    return true;
+}
+
 } // anonymous namespace
 
 void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
@@ -1857,9 +1971,11 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         // criteria.
         if ( m_branchData->sortOrder != sortOrder )
         {
-            std::sort(m_branchData->children.begin(),
-                      m_branchData->children.end(),
-                      wxGenericTreeModelNodeCmp(window, sortOrder));
+            if ( !SortNodesByKeys(window->GetModel(), nodes, sortOrder) )
+            {
+                std::sort(nodes.begin(), nodes.end(),
+                          wxGenericTreeModelNodeCmp(window, sortOrder));
+            }
 
             m_branchData->sortOrder = sortOrder;
         }
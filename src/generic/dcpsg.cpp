@@ -33,6 +33,16 @@
 #include "wx/paper.h"
 #include "wx/filename.h"
 #include "wx/stdpaths.h"
+#include "wx/mstream.h"
+#include "wx/zstream.h"
+#include "wx/generic/private/dcpsg.h"
+
+// Use zlib for compressing the images data if possible.
+#if wxUSE_ZLIB && wxUSE_STREAMS
+    #define wxPS_USE_FLATE 1
+#else
+    #define wxPS_USE_FLATE 0
+#endif
 
 #ifdef __WXMSW__
 
@@ -177,6 +187,29 @@ static const char *wxPostScriptHeaderColourImage = "\
   } ifelse          % end of 'false' case\n\
 ";
 
+// The procedures below use PostScript Level 2 image dictionaries and are only
+// used if the language level is at least 2.
+static const char *wxPostScriptHeaderImage = "\
+% Draw the RGB image of the given size from the given data source\n\
+% into the unit square: src width height wxImage\n\
+/wxImage {\n\
+  3 dict begin\n\
+  /h exch def\n\
+  /w exch def\n\
+  /src exch def\n\
+  /DeviceRGB setcolorspace\n\
+  << /ImageType 1 /Width w /Height h /BitsPerComponent 8\n\
+     /Decode [0 1 0 1 0 1] /ImageMatrix [w 0 0 h neg 0 h]\n\
+     /DataSource src >> image\n\
+  end\n\
+} bind def\n\
+% Draw the image using the data following the procedure call and skip\n\
+% the remaining data: a85filter src width height wxInlineImage\n\
+/wxInlineImage {\n\
+  wxImage flushfile\n\
+} bind def\n\
+";
+
 static const char wxPostScriptHeaderReencodeISO1[] =
     "\n/reencodeISO {\n"
 "dup dup findfont dup length dict begin\n"
@@ -248,11 +281,61 @@ wxPostScriptDC::wxPostScriptDC(const wxPrintData& printData)
 {
 }
 
+void wxPostScriptDC::SetLanguageLevel(int level)
+{
+    static_cast<wxPostScriptDCImpl*>(GetImpl())->SetLanguageLevel(level);
+}
+
+int wxPostScriptDC::GetLanguageLevel() const
+{
+    return static_cast<const wxPostScriptDCImpl*>(GetImpl())->GetLanguageLevel();
+}
+
 // we don't want to use only 72 dpi from PS print
 static const int DPI = 600;
 static const double PS2DEV = 600.0 / 72.0;
 static const double DEV2PS = 72.0 / 600.0;
 
+// Return the key identifying the image contents: images with the same key are
+// considered to be identical.
+static wxString GetImageContentsKey(const wxImage& image)
+{
+    // Use two different hash functions, FNV-1a and DJB2, to make collisions
+    // practically impossible.
+    wxUint32 fnv = 2166136261u,
+             djb = 5381;
+
+    const unsigned char* p = image.GetData();
+    const unsigned char* const end = p + 3*image.GetWidth()*image.GetHeight();
+    for ( ; p != end; ++p )
+    {
+        fnv = (fnv ^ *p) * 16777619u;
+        djb = djb * 33 + *p;
+    }
+
+    return wxString::Format("%dx%d-%08x-%08x",
+                            image.GetWidth(), image.GetHeight(), fnv, djb);
+}
+
+#if wxPS_USE_FLATE
+
+// Compress the image data in the format used by FlateDecode filter.
+static void CompressImageDataFlate(const unsigned char* data, size_t len,
+                                   wxMemoryBuffer& out)
+{
+    wxMemoryOutputStream mem;
+    {
+        wxZlibOutputStream zstream(mem, -1, wxZLIB_ZLIB);
+        zstream.Write(data, len);
+    }
+
+    const size_t size = mem.GetSize();
+    mem.CopyTo(out.GetWriteBuf(size), size);
+    out.UngetWriteBuf(size);
+}
+
+#endif // wxPS_USE_FLATE
+
 #define XLOG2DEV(x)     ((double)(LogicalToDeviceX(x)) * DEV2PS)
 #define XLOG2DEVREL(x)  ((double)(LogicalToDeviceXRel(x)) * DEV2PS)
 #define YLOG2DEV(x)     ((m_pageHeight - (double)LogicalToDeviceY(x)) * DEV2PS)
@@ -324,6 +407,9 @@ void wxPostScriptDCImpl::Init()
     m_underlineThickness = 0.0;
 
     m_isFontChanged = false;
+
+    m_numDefinedImages = 0;
+    m_languageLevel = 1;
 }
 
 wxPostScriptDCImpl::~wxPostScriptDCImpl ()
@@ -983,6 +1069,74 @@ void wxPostScriptDCImpl::DoDrawBitmap( const wxBitmap& bitmap, wxCoord x, wxCoor
     double xx = XLOG2DEV(x);
     double yy = YLOG2DEV(y + bitmap.GetHeight());
 
+    if ( m_languageLevel < 2 )
+    {
+        DoDrawImageLevel1(image, xx, yy, ww, hh);
+        return;
+    }
+
+    const char* const filter = GetImageDataFilter();
+
+    // With Level 3, images drawn more than once are stored in a reusable
+    // stream to avoid including their data in the output every time they're
+    // drawn. But don't do it for the images drawn only once, which are
+    // common, as it would waste the printer memory.
+    ImageIndices::iterator it = m_drawnImages.end();
+    wxString key;
+    if ( m_languageLevel >= 3 )
+    {
+        key = GetImageContentsKey(image);
+        it = m_drawnImages.find(key);
+    }
+
+    wxString buffer;
+    if ( it != m_drawnImages.end() && it->second == -1 )
+    {
+        it->second = m_numDefinedImages++;
+
+        buffer.Printf( "/wxImageData%d currentfile /ASCII85Decode filter\n"
+                       "<< /Filter /%s >> /ReusableStreamDecode filter\n",
+                       it->second, filter );
+        PsPrint( buffer );
+        PsWriteImageData( image );
+        PsPrint( "def\n" );
+    }
+
+    buffer.Printf( "/origstate save def\n"
+                   "%f %f translate\n"
+                   "%f %f scale\n",
+                   xx, yy, ww, hh );
+    buffer.Replace( ",", "." );
+    PsPrint( buffer );
+
+    if ( it != m_drawnImages.end() )
+    {
+        buffer.Printf( "wxImageData%d dup 0 setfileposition %d %d wxImage\n",
+                       it->second, w, h );
+        PsPrint( buffer );
+    }
+    else
+    {
+        if ( m_languageLevel >= 3 )
+            m_drawnImages[key] = -1;
+
+        buffer.Printf( "currentfile /ASCII85Decode filter dup /%s filter\n"
+                       "%d %d wxInlineImage\n",
+                       filter, w, h );
+        PsPrint( buffer );
+        PsWriteImageData( image );
+    }
+
+    PsPrint( "origstate restore\n" );
+}
+
+void wxPostScriptDCImpl::DoDrawImageLevel1(const wxImage& image,
+                                           double xx, double yy,
+                                           double ww, double hh)
+{
+    const int w = image.GetWidth();
+    const int h = image.GetHeight();
+
     wxString buffer;
     buffer.Printf( "/origstate save def\n"
                    "20 dict begin\n"
@@ -1000,7 +1154,7 @@ void wxPostScriptDCImpl::DoDrawBitmap( const wxBitmap& bitmap, wxCoord x, wxCoor
     buffer.Replace( ",", "." );
     PsPrint( buffer );
 
-    unsigned char* data = image.GetData();
+    const unsigned char* data = image.GetData();
 
     // size of the buffer = width*rgb(3)*hexa(2)+'\n'
     wxCharBuffer charbuffer(w*6 + 1);
@@ -1021,18 +1175,48 @@ void wxPostScriptDCImpl::DoDrawBitmap( const wxBitmap& bitmap, wxCoord x, wxCoor
             data++;
         }
         *(bufferindex++) = '\n';
-        *bufferindex = 0;
 
-        if (m_pstream)
-            fwrite( charbuffer, 1, strlen( charbuffer ), m_pstream );
-        else
-            PsPrint( charbuffer );
+        PsWrite( charbuffer, w*6 + 1 );
     }
 
     PsPrint( "end\n" );
     PsPrint( "origstate restore\n" );
 }
 
+const char* wxPostScriptDCImpl::GetImageDataFilter() const
+{
+#if wxPS_USE_FLATE
+    if ( m_languageLevel >= 3 )
+        return "FlateDecode";
+#endif // wxPS_USE_FLATE
+
+    return "RunLengthDecode";
+}
+
+void wxPostScriptDCImpl::PsWriteImageData(const wxImage& image)
+{
+    const unsigned char* const data = image.GetData();
+    const size_t len = 3*image.GetWidth()*image.GetHeight();
+
+    wxMemoryBuffer compressed;
+#if wxPS_USE_FLATE
+    if ( m_languageLevel >= 3 )
+        CompressImageDataFlate(data, len, compressed);
+    else
+#endif // wxPS_USE_FLATE
+        wxPostScriptEncodeRunLength(data, len, compressed);
+
+    wxMemoryBuffer encoded;
+    wxPostScriptEncodeASCII85
+    (
+        static_cast<const unsigned char*>(compressed.GetData()),
+        compressed.GetDataLen(),
+        encoded
+    );
+
+    PsWrite(static_cast<const char*>(encoded.GetData()), encoded.GetDataLen());
+}
+
 // Set PostScript color
 void wxPostScriptDCImpl::SetPSColour(const wxColor& col)
 {
@@ -1675,7 +1859,8 @@ bool wxPostScriptDCImpl::StartDoc( const wxString& WXUNUSED(message) )
 
     wxString buffer;
 
-    PsPrint( "%!PS-Adobe-2.0\n" );
+    // %%LanguageLevel comment written below is only defined in DSC 3.0
+    PsPrint( m_languageLevel >= 2 ? "%!PS-Adobe-3.0\n" : "%!PS-Adobe-2.0\n" );
 
     PsPrint( "%%Creator: wxWidgets PostScript renderer\n" );
 
@@ -1710,13 +1895,22 @@ bool wxPostScriptDCImpl::StartDoc( const wxString& WXUNUSED(message) )
     buffer.Printf( "%%%%DocumentPaperSizes: %s\n", paper );
     PsPrint( buffer );
 
+    if ( m_languageLevel >= 2 )
+    {
+        buffer.Printf( "%%%%LanguageLevel: %d\n", m_languageLevel );
+        PsPrint( buffer );
+    }
+
     PsPrint( "%%EndComments\n\n" );
 
     PsPrint( "%%BeginProlog\n" );
     PsPrint( wxPostScriptHeaderConicTo );
     PsPrint( wxPostScriptHeaderEllipse );
     PsPrint( wxPostScriptHeaderEllipticArc );
-    PsPrint( wxPostScriptHeaderColourImage );
+    if ( m_languageLevel >= 2 )
+        PsPrint( wxPostScriptHeaderImage );
+    else
+        PsPrint( wxPostScriptHeaderColourImage );
     PsPrint( wxPostScriptHeaderReencodeISO1 );
     PsPrint( wxPostScriptHeaderReencodeISO2 );
     if (wxPostScriptHeaderSpline)
@@ -1735,6 +1929,9 @@ bool wxPostScriptDCImpl::StartDoc( const wxString& WXUNUSED(message) )
     m_pageNumber = 1;
     // Reset the list of fonts for which PS font registration code was generated.
     m_definedPSFonts.Empty();
+    // And the images defined in the previous document.
+    m_drawnImages.clear();
+    m_numDefinedImages = 0;
 
     return true;
 }
@@ -1926,6 +2123,11 @@ void wxPostScriptDCImpl::PsPrint( const wxString& str )
 {
     const wxCharBuffer psdata(str.utf8_str());
 
+    PsWrite( psdata, psdata.length() );
+}
+
+void wxPostScriptDCImpl::PsWrite( const char* psdata, size_t len )
+{
     switch (m_printData.GetPrintMode())
     {
 #if wxUSE_STREAMS
@@ -1940,7 +2142,7 @@ void wxPostScriptDCImpl::PsPrint( const wxString& str )
                 wxCHECK_RET( data, wxS("Cannot obtain output stream") );
                 wxOutputStream* outputstream = data->GetOutputStream();
                 wxCHECK_RET( outputstream, wxT("invalid outputstream") );
-                outputstream->Write( psdata, strlen( psdata ) );
+                outputstream->Write( psdata, len );
             }
             break;
 #endif // wxUSE_STREAMS
@@ -1948,7 +2150,7 @@ void wxPostScriptDCImpl::PsPrint( const wxString& str )
         // save data into file
         default:
             wxCHECK_RET( m_pstream, wxT("invalid postscript dc") );
-            fwrite( psdata, 1, strlen( psdata ), m_pstream );
+            fwrite( psdata, 1, len, m_pstream );
     }
 }
 
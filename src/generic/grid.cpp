@@ -63,6 +63,8 @@ const char wxGridNameStr[] = "grid";
 // Required for wxIs... functions
 #include <ctype.h>
 
+#include <algorithm>
+
 WX_DECLARE_HASH_SET_WITH_DECL_PTR(int, wxIntegerHash, wxIntegerEqual,
                                   wxGridFixedIndicesSet, class WXDLLIMPEXP_ADV);
 
@@ -2517,6 +2519,7 @@ wxBEGIN_EVENT_TABLE( wxGrid, wxScrolledCanvas )
     EVT_KEY_UP( wxGrid::OnKeyUp )
     EVT_CHAR ( wxGrid::OnChar )
     EVT_COMMAND(wxID_ANY, wxEVT_GRID_HIDE_EDITOR, wxGrid::OnHideEditor )
+    EVT_IDLE( wxGrid::OnIdle )
 wxEND_EVENT_TABLE()
 
 bool wxGrid::Create(wxWindow *parent, wxWindowID id,
@@ -2572,6 +2575,8 @@ wxGrid::~wxGrid()
 
     delete m_setFixedRows;
     delete m_setFixedCols;
+
+    delete m_textExtentCache;
 }
 
 //
@@ -2890,6 +2895,8 @@ void wxGrid::Init()
     m_inOnKeyDown = false;
     m_batchCount = 0;
 
+    m_textExtentCache = NULL;
+
     m_extraWidth =
     m_extraHeight = 0;
 
@@ -5586,6 +5593,8 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
 {
     InitPixelFields();
 
+    ClearTextExtentCache();
+
     // If we have any non-default row sizes, we need to scale them (default
     // ones will be scaled due to the reinitialization of m_defaultRowHeight
     // inside InitPixelFields() above).
@@ -6565,7 +6574,7 @@ wxGrid::DrawRangeGridLines(wxDC& dc,
 // This is used to redraw all grid lines e.g. when the grid line colour
 // has been changed
 //
-void wxGrid::DrawAllGridWindowLines(wxDC& dc, const wxRegion & WXUNUSED(reg), wxGridWindow *gridWindow)
+void wxGrid::DrawAllGridWindowLines(wxDC& dc, const wxRegion & reg, wxGridWindow *gridWindow)
 {
     if ( !m_gridLinesEnabled || !gridWindow )
          return;
@@ -6576,8 +6585,24 @@ void wxGrid::DrawAllGridWindowLines(wxDC& dc, const wxRegion & WXUNUSED(reg), wx
 
     int cw, ch;
     gridWindow->GetClientSize(&cw, &ch);
-    CalcGridWindowUnscrolledPosition( gridOffset.x, gridOffset.y, &left, &top, gridWindow );
-    CalcGridWindowUnscrolledPosition( cw + gridOffset.x, ch + gridOffset.y, &right, &bottom, gridWindow );
+
+    // only draw the lines in the part of the window being repainted, if it's
+    // specified: this matters when only a few cells are refreshed (don't do
+    // it in RTL layout, where the update region may be mirrored)
+    wxRect updateRect(0, 0, cw, ch);
+    if ( !reg.IsEmpty() && GetLayoutDirection() != wxLayout_RightToLeft )
+    {
+        updateRect.Intersect(reg.GetBox());
+        if ( updateRect.IsEmpty() )
+            return;
+    }
+
+    CalcGridWindowUnscrolledPosition( updateRect.x + gridOffset.x,
+                                      updateRect.y + gridOffset.y,
+                                      &left, &top, gridWindow );
+    CalcGridWindowUnscrolledPosition( updateRect.GetRight() + 1 + gridOffset.x,
+                                      updateRect.GetBottom() + 1 + gridOffset.y,
+                                      &right, &bottom, gridWindow );
 
     // avoid drawing grid lines past the last row and col
     if ( m_gridLinesClipHorz )
@@ -6608,7 +6633,7 @@ void wxGrid::DrawAllGridWindowLines(wxDC& dc, const wxRegion & WXUNUSED(reg), wx
 
     if ( gridWindow == m_gridWin )
     {
-        wxRegion clippedcells(0, 0, cw, ch);
+        wxRegion clippedcells(updateRect);
 
         int cell_rows, cell_cols;
         wxRect rect;
@@ -6980,9 +7005,9 @@ void wxGrid::DrawTextRectangle(wxDC& dc,
             continue;
         }
 
-        wxCoord lineWidth = 0,
-             lineHeight = 0;
-        dc.GetTextExtent(line, &lineWidth, &lineHeight);
+        const wxSize lineSize = GetCellTextExtent(dc, line);
+        const wxCoord lineWidth = lineSize.x,
+                      lineHeight = lineSize.y;
 
         switch ( horizAlign )
         {
@@ -7086,7 +7111,6 @@ void wxGrid::GetTextBoxSize( const wxDC& dc,
 {
     wxCoord w = 0;
     wxCoord h = 0;
-    wxCoord lineW = 0, lineH = 0;
 
     size_t i;
     for ( i = 0; i < lines.GetCount(); i++ )
@@ -7099,9 +7123,9 @@ void wxGrid::GetTextBoxSize( const wxDC& dc,
         }
         else
         {
-            dc.GetTextExtent( lines[i], &lineW, &lineH );
-            w = wxMax( w, lineW );
-            h += lineH;
+            const wxSize size = GetCellTextExtent( dc, lines[i] );
+            w = wxMax( w, size.x );
+            h += size.y;
         }
     }
 
@@ -7109,6 +7133,33 @@ void wxGrid::GetTextBoxSize( const wxDC& dc,
     *height = h;
 }
 
+wxSize wxGrid::GetCellTextExtent( const wxDC& dc, const wxString& text ) const
+{
+    if ( m_textExtentCache )
+        return m_textExtentCache->GetTextExtent(dc, text);
+
+    return dc.GetTextExtent(text);
+}
+
+void wxGrid::EnableTextExtentCache(bool enable)
+{
+    if ( enable )
+    {
+        if ( !m_textExtentCache )
+            m_textExtentCache = new wxGridTextExtentCache;
+    }
+    else
+    {
+        wxDELETE(m_textExtentCache);
+    }
+}
+
+void wxGrid::ClearTextExtentCache()
+{
+    if ( m_textExtentCache )
+        m_textExtentCache->Clear();
+}
+
 //
 // ------ Batch processing.
 //
@@ -7135,6 +7186,146 @@ void wxGrid::ForceRefresh()
     EndBatch();
 }
 
+namespace
+{
+
+// Compare the cells by their row and then by their column, used for sorting
+// the changed cells.
+bool wxGridCellCoordsLess(const wxGridCellCoords& c1, const wxGridCellCoords& c2)
+{
+    if ( c1.GetRow() != c2.GetRow() )
+        return c1.GetRow() < c2.GetRow();
+
+    return c1.GetCol() < c2.GetCol();
+}
+
+} // anonymous namespace
+
+wxVector<wxGridBlockCoords>
+wxGridCombineChangedCells(const wxGrid& grid,
+                          const wxVector<wxGridCellCoords>& changedCells)
+{
+    // Sort the cells by their row and the position of their column, so that
+    // the adjacent cells can be combined into blocks, dropping the ones which
+    // don't exist any more.
+    const int numRows = grid.GetNumberRows(),
+              numCols = grid.GetNumberCols();
+
+    wxVector<wxGridCellCoords> cells;
+    cells.reserve(changedCells.size());
+    for ( size_t n = 0; n < changedCells.size(); n++ )
+    {
+        const wxGridCellCoords& coords = changedCells[n];
+        if ( coords.GetRow() < 0 || coords.GetRow() >= numRows ||
+                coords.GetCol() < 0 || coords.GetCol() >= numCols )
+            continue;
+
+        cells.push_back(wxGridCellCoords(coords.GetRow(),
+                                         grid.GetColPos(coords.GetCol())));
+    }
+
+    std::sort(cells.begin(), cells.end(), wxGridCellCoordsLess);
+
+    // Combine the adjacent changed cells in each row into horizontal blocks
+    // and then extend the blocks of the previous row into this one if they
+    // cover exactly the same columns.
+    wxVector<wxGridBlockCoords> blocks,
+                                prevBlocks,
+                                rowBlocks;
+    const size_t count = cells.size();
+    for ( size_t n = 0; n < count; )
+    {
+        const int row = cells[n].GetRow();
+
+        rowBlocks.clear();
+        while ( n < count && cells[n].GetRow() == row )
+        {
+            const int pos = cells[n++].GetCol();
+            wxGridBlockCoords block(row, pos, row, pos);
+
+            // notice that "<=" also skips over the duplicate cells
+            while ( n < count && cells[n].GetRow() == row &&
+                        cells[n].GetCol() <= block.GetRightCol() + 1 )
+            {
+                block.SetRightCol(cells[n++].GetCol());
+            }
+
+            rowBlocks.push_back(block);
+        }
+
+        size_t prev = 0;
+        for ( size_t b = 0; b < rowBlocks.size(); b++ )
+        {
+            wxGridBlockCoords& block = rowBlocks[b];
+
+            while ( prev < prevBlocks.size() &&
+                        prevBlocks[prev].GetLeftCol() <= block.GetLeftCol() )
+            {
+                const wxGridBlockCoords& prevBlock = prevBlocks[prev++];
+                if ( prevBlock.GetLeftCol() == block.GetLeftCol() &&
+                        prevBlock.GetRightCol() == block.GetRightCol() &&
+                            prevBlock.GetBottomRow() == row - 1 )
+                {
+                    block.SetTopRow(prevBlock.GetTopRow());
+                    break;
+                }
+
+                blocks.push_back(prevBlock);
+            }
+        }
+
+        for ( ; prev < prevBlocks.size(); prev++ )
+            blocks.push_back(prevBlocks[prev]);
+
+        prevBlocks.swap(rowBlocks);
+    }
+
+    for ( size_t prev = 0; prev < prevBlocks.size(); prev++ )
+        blocks.push_back(prevBlocks[prev]);
+
+    return blocks;
+}
+
+void wxGrid::MarkCellsChanged(const wxGridCellCoordsArray& cells)
+{
+    for ( size_t n = 0; n < cells.size(); n++ )
+        m_changedCells.push_back(cells[n]);
+}
+
+void wxGrid::RefreshChangedCells()
+{
+    if ( m_changedCells.empty() )
+        return;
+
+    // If we can't refresh anything right now, there is no need to remember
+    // the changed cells neither, as the entire grid will be refreshed when
+    // it's shown or at the end of the batch anyhow.
+    if ( !m_created || !ShouldRefresh() )
+    {
+        m_changedCells.clear();
+        return;
+    }
+
+    const wxVector<wxGridBlockCoords>
+        blocks = wxGridCombineChangedCells(*this, m_changedCells);
+
+    m_changedCells.clear();
+
+    for ( size_t b = 0; b < blocks.size(); b++ )
+    {
+        const wxGridBlockCoords& block = blocks[b];
+        RefreshBlock(block.GetTopRow(), GetColAt(block.GetLeftCol()),
+                     block.GetBottomRow(), GetColAt(block.GetRightCol()));
+    }
+}
+
+void wxGrid::OnIdle(wxIdleEvent& event)
+{
+    RefreshChangedCells();
+
+    event.Skip();
+}
+
 void wxGrid::DoEnable(bool enable)
 {
     wxScrolledCanvas::DoEnable(enable);
@@ -10773,6 +10964,99 @@ wxGridEditorCreatedEvent::wxGridEditorCreatedEvent(int id, wxEventType type,
 }
 
 
+// ----------------------------------------------------------------------------
+// wxGridTextExtentCache
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// The maximal number of the text extents cached by a single grid: when it is
+// reached, the cache is simply cleared.
+const size_t GRID_TEXT_EXTENT_CACHE_SIZE = 100000;
+
+} // anonymous namespace
+
+wxGridTextExtentCache::wxGridTextExtentCache()
+    : m_lastFont(0),
+      m_numEntries(0),
+      m_maxEntries(GRID_TEXT_EXTENT_CACHE_SIZE)
+{
+}
+
+wxGridTextExtentCache::wxGridTextExtentCache(size_t maxEntries)
+    : m_lastFont(0),
+      m_numEntries(0),
+      m_maxEntries(maxEntries)
+{
+}
+
+wxSize wxGridTextExtentCache::GetTextExtent(const wxDC& dc, const wxString& text)
+{
+    // The cached extents can't be used if the DC is scaled, which happens e.g.
+    // when using wxGrid::Render().
+    double scaleX, scaleY, logicalScaleX, logicalScaleY;
+    dc.GetUserScale(&scaleX, &scaleY);
+    dc.GetLogicalScale(&logicalScaleX, &logicalScaleY);
+    if ( scaleX != 1. || scaleY != 1. ||
+            logicalScaleX != 1. || logicalScaleY != 1. )
+        return dc.GetTextExtent(text);
+
+    // And if the DC resolution changed, the existing extents are not valid any
+    // more.
+    const wxSize ppi = dc.GetPPI();
+    if ( ppi != m_ppi )
+    {
+        Clear();
+        m_ppi = ppi;
+    }
+
+    const wxFont& font = dc.GetFont();
+    if ( m_lastFont >= m_fonts.size() || !(m_fonts[m_lastFont]->font == font) )
+    {
+        for ( m_lastFont = 0; m_lastFont < m_fonts.size(); m_lastFont++ )
+        {
+            if ( m_fonts[m_lastFont]->font == font )
+                break;
+        }
+
+        if ( m_lastFont == m_fonts.size() )
+            m_fonts.push_back(new FontExtents(font));
+    }
+
+    TextExtents& extents = m_fonts[m_lastFont]->extents;
+    TextExtents::const_iterator it = extents.find(text);
+    if ( it != extents.end() )
+        return it->second;
+
+    const wxSize size = dc.GetTextExtent(text);
+
+    if ( m_numEntries == m_maxEntries )
+    {
+        // Don't bother with anything more complicated, if the cache is full
+        // it's not really effective anyhow.
+        for ( size_t n = 0; n < m_fonts.size(); n++ )
+            m_fonts[n]->extents.clear();
+
+        m_numEntries = 0;
+    }
+
+    extents[text] = size;
+    m_numEntries++;
+
+    return size;
+}
+
+void wxGridTextExtentCache::Clear()
+{
+    for ( size_t n = 0; n < m_fonts.size(); n++ )
+        delete m_fonts[n];
+
+    m_fonts.clear();
+    m_lastFont = 0;
+    m_numEntries = 0;
+}
+
 // ----------------------------------------------------------------------------
 // wxGridTypeRegistry
 // ----------------------------------------------------------------------------
@@ -162,7 +162,7 @@ wxSize wxGridCellDateRenderer::GetBestSize(wxGrid& grid,
                                            wxDC& dc,
                                            int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 void wxGridCellDateRenderer::SetParameters(const wxString& params)
@@ -257,7 +257,7 @@ wxSize wxGridCellEnumRenderer::GetBestSize(wxGrid& grid,
                                             wxDC& dc,
                                             int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 void wxGridCellEnumRenderer::SetParameters(const wxString& params)
@@ -336,10 +336,10 @@ wxGridCellAutoWrapStringRenderer::GetTextLines(wxGrid& grid,
     {
         const wxString& line = *it;
 
-        if ( dc.GetTextExtent(line).x > maxWidth )
+        if ( grid.GetCellTextExtent(dc, line).x > maxWidth )
         {
             // Line does not fit, break it up.
-            BreakLine(dc, line, maxWidth, physicalLines);
+            BreakLine(grid, dc, line, maxWidth, physicalLines);
         }
         else // The entire line fits as is
         {
@@ -351,7 +351,8 @@ wxGridCellAutoWrapStringRenderer::GetTextLines(wxGrid& grid,
 }
 
 void
-wxGridCellAutoWrapStringRenderer::BreakLine(wxDC& dc,
+wxGridCellAutoWrapStringRenderer::BreakLine(const wxGrid& grid,
+                                            wxDC& dc,
                                             const wxString& logicalLine,
                                             wxCoord maxWidth,
                                             wxArrayString& lines)
@@ -364,7 +365,7 @@ wxGridCellAutoWrapStringRenderer::BreakLine(wxDC& dc,
     while ( wordTokenizer.HasMoreTokens() )
     {
         const wxString word = wordTokenizer.GetNextToken();
-        const wxCoord wordWidth = dc.GetTextExtent(word).x;
+        const wxCoord wordWidth = grid.GetCellTextExtent(dc, word).x;
         if ( lineWidth + wordWidth < maxWidth )
         {
             // Word fits, just add it to this line.
@@ -393,7 +394,7 @@ wxGridCellAutoWrapStringRenderer::BreakLine(wxDC& dc,
                 }
 
                 // Break it up in several lines.
-                lineWidth = BreakWord(dc, word, maxWidth, lines, line);
+                lineWidth = BreakWord(grid, dc, word, maxWidth, lines, line);
             }
         }
     }
@@ -404,7 +405,8 @@ wxGridCellAutoWrapStringRenderer::BreakLine(wxDC& dc,
 
 
 wxCoord
-wxGridCellAutoWrapStringRenderer::BreakWord(wxDC& dc,
+wxGridCellAutoWrapStringRenderer::BreakWord(const wxGrid& grid,
+                                            wxDC& dc,
                                             const wxString& word,
                                             wxCoord maxWidth,
                                             wxArrayString& lines,
@@ -439,7 +441,7 @@ wxGridCellAutoWrapStringRenderer::BreakWord(wxDC& dc,
     // separate line instead of as part of the same one, so we have to
     // recompute it.
     const wxString rest = word.substr(n);
-    const wxCoord restWidth = dc.GetTextExtent(rest).x;
+    const wxCoord restWidth = grid.GetCellTextExtent(dc, rest).x;
     if ( restWidth <= maxWidth )
     {
         line = rest;
@@ -450,7 +452,7 @@ wxGridCellAutoWrapStringRenderer::BreakWord(wxDC& dc,
     //
     // TODO: Perhaps avoid recursion? The code is simpler like this but using a
     // loop in this function would probably be more efficient.
-    return BreakWord(dc, rest, maxWidth, lines, line);
+    return BreakWord(grid, dc, rest, maxWidth, lines, line);
 }
 
 wxSize
@@ -553,17 +555,20 @@ void wxGridCellStringRenderer::SetTextColoursAndFont(const wxGrid& grid,
     dc.SetFont( attr.GetFont() );
 }
 
-wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGridCellAttr& attr,
-                                               wxDC& dc,
-                                               const wxString& text)
+// Compute the extent of the possibly multiline text, using the grid text
+// extents cache if a grid is given.
+static wxSize
+wxGetGridCellTextSize(const wxGrid* grid, wxDC& dc, const wxString& text)
 {
-    wxCoord x = 0, y = 0, max_x = 0;
-    dc.SetFont(attr.GetFont());
+    wxCoord y = 0, max_x = 0;
     wxStringTokenizer tk(text, wxT('\n'));
     while ( tk.HasMoreTokens() )
     {
-        dc.GetTextExtent(tk.GetNextToken(), &x, &y);
-        max_x = wxMax(max_x, x);
+        const wxString line = tk.GetNextToken();
+        const wxSize size = grid ? grid->GetCellTextExtent(dc, line)
+                                 : dc.GetTextExtent(line);
+        max_x = wxMax(max_x, size.x);
+        y = size.y;
     }
 
     y *= 1 + text.Freq(wxT('\n')); // multiply by the number of lines.
@@ -571,12 +576,31 @@ wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGridCellAttr& attr,
     return wxSize(max_x, y);
 }
 
+wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGridCellAttr& attr,
+                                               wxDC& dc,
+                                               const wxString& text)
+{
+    dc.SetFont(attr.GetFont());
+
+    return wxGetGridCellTextSize(NULL, dc, text);
+}
+
+wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGrid& grid,
+                                               const wxGridCellAttr& attr,
+                                               wxDC& dc,
+                                               const wxString& text)
+{
+    dc.SetFont(attr.GetFont());
+
+    return wxGetGridCellTextSize(&grid, dc, text);
+}
+
 wxSize wxGridCellStringRenderer::GetBestSize(wxGrid& grid,
                                              wxGridCellAttr& attr,
                                              wxDC& dc,
                                              int row, int col)
 {
-    return DoGetBestSize(attr, dc, grid.GetCellValue(row, col));
+    return DoGetBestSize(grid, attr, dc, grid.GetCellValue(row, col));
 }
 
 void wxGridCellStringRenderer::Draw(wxGrid& grid,
@@ -723,7 +747,7 @@ wxSize wxGridCellNumberRenderer::GetBestSize(wxGrid& grid,
                                              wxDC& dc,
                                              int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 // ----------------------------------------------------------------------------
@@ -835,7 +859,7 @@ wxSize wxGridCellFloatRenderer::GetBestSize(wxGrid& grid,
                                             wxDC& dc,
                                             int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 void wxGridCellFloatRenderer::SetParameters(const wxString& params)
@@ -24,6 +24,7 @@
 #endif
 
 #ifndef WX_PRECOMP
+    #include "wx/app.h"
     #include "wx/dcclient.h"
 #endif //WX_PRECOMP
 
@@ -31,6 +32,9 @@
 
 #include "wx/htmllbox.h"
 
+#include "wx/hashmap.h"
+#include "wx/vector.h"
+
 #include "wx/html/htmlcell.h"
 #include "wx/html/winpars.h"
 
@@ -45,6 +49,12 @@ FORCE_WXHTML_MODULES()
 // small border always added to the cells:
 static const wxCoord CELL_BORDER = 2;
 
+// return the height of the item containing the given cell
+static inline wxCoord GetItemHeightForCell(const wxHtmlCell *cell)
+{
+    return cell->GetHeight() + cell->GetDescent() + 2*CELL_BORDER;
+}
+
 const char wxHtmlListBoxNameStr[] = "htmlListBox";
 const char wxSimpleHtmlListBoxNameStr[] = "simpleHtmlListBox";
 
@@ -56,98 +66,319 @@ const char wxSimpleHtmlListBoxNameStr[] = "simpleHtmlListBox";
 // wxHtmlListBoxCache
 // ----------------------------------------------------------------------------
 
+WX_DECLARE_HASH_MAP(size_t, size_t, wxIntegerHash, wxIntegerEqual,
+                    wxHtmlListBoxCacheSlots);
+
 // this class is used by wxHtmlListBox to cache the parsed representation of
 // the items to avoid doing it anew each time an item must be drawn
+//
+// the cells are kept in the most recently used order and the least recently
+// used ones are discarded when either the maximal number of cached items or
+// the maximal amount of memory used by them is exceeded, while the heights of
+// the items are remembered independently of the cells, as they are much
+// cheaper to store and are needed for all items, and not only visible ones
 class wxHtmlListBoxCache
 {
-private:
-    // invalidate a single item, used by Clear() and InvalidateRange()
-    void InvalidateItem(size_t n)
+public:
+    wxHtmlListBoxCache()
     {
-        m_items[n] = (size_t)-1;
-        wxDELETE(m_cells[n]);
+        m_maxItems = DEFAULT_MAX_ITEMS;
+        m_maxBytes = DEFAULT_MAX_BYTES;
+        m_bytes = 0;
+        m_head =
+        m_tail = NO_SLOT;
     }
 
-public:
-    wxHtmlListBoxCache()
+    ~wxHtmlListBoxCache()
+    {
+        ClearCells();
+    }
+
+    void SetLimits(size_t maxItems, size_t maxBytes)
+    {
+        m_maxItems = maxItems;
+        m_maxBytes = maxBytes;
+
+        Trim(0, 0);
+    }
+
+    size_t GetMaxItems() const { return m_maxItems; }
+
+    // completely invalidate the cache
+    void Clear()
+    {
+        ClearCells();
+
+        m_heights.clear();
+    }
+
+    // return the cached cell for this index or NULL if none, the cell becomes
+    // the most recently used one
+    wxHtmlCell *Get(size_t item)
+    {
+        const wxHtmlListBoxCacheSlots::const_iterator it = m_slots.find(item);
+        if ( it == m_slots.end() )
+            return NULL;
+
+        Unlink(it->second);
+        LinkAtHead(it->second);
+
+        return m_entries[it->second].cell;
+    }
+
+    // returns true if we already have this item cached
+    bool Has(size_t item) const { return m_slots.find(item) != m_slots.end(); }
+
+    // ensure that the item is cached, discarding the least recently used
+    // items if necessary, except for those in [keepFrom, keepTo) range
+    void Store(size_t item, wxHtmlCell *cell, size_t keepFrom, size_t keepTo)
+    {
+        DoStore(item, cell, GetCellCost(cell));
+
+        Trim(keepFrom, keepTo);
+    }
+
+    // cache the item only if it can be done without discarding any other
+    // items, return false if it wasn't done
+    bool StoreIfRoom(size_t item, wxHtmlCell *cell)
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        const size_t cost = GetCellCost(cell);
+        if ( m_slots.size() >= m_maxItems ||
+                (m_maxBytes && m_bytes + cost > m_maxBytes) )
+            return false;
+
+        DoStore(item, cell, cost);
+
+        return true;
+    }
+
+    // returns true if another item can be cached without discarding any of
+    // the items in [keepFrom, keepTo) range, assuming that it uses as much
+    // memory as the items in this range do on average
+    bool HasRoomFor(size_t keepFrom, size_t keepTo) const
+    {
+        size_t count = 0,
+               bytes = 0;
+        for ( size_t slot = m_head; slot != NO_SLOT; slot = m_entries[slot].next )
         {
-            m_items[n] = (size_t)-1;
-            m_cells[n] = NULL;
+            const Entry& entry = m_entries[slot];
+            if ( entry.item >= keepFrom && entry.item < keepTo )
+            {
+                count++;
+                bytes += entry.cost;
+            }
         }
 
-        m_next = 0;
+        if ( count >= m_maxItems )
+            return false;
+
+        return !m_maxBytes || !count || bytes + bytes/count <= m_maxBytes;
     }
 
-    ~wxHtmlListBoxCache()
+    // forget the cached value of the item(s) between the given ones (inclusive)
+    void InvalidateRange(size_t from, size_t to)
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        for ( size_t slot = m_head; slot != NO_SLOT; )
+        {
+            const Entry& entry = m_entries[slot];
+            const size_t next = entry.next;
+            if ( entry.item >= from && entry.item <= to )
+                Discard(slot);
+
+            slot = next;
+        }
+
+        if ( from < m_heights.size() )
         {
-            delete m_cells[n];
+            const size_t last = wxMin(to + 1, m_heights.size());
+            for ( size_t n = from; n < last; n++ )
+                m_heights[n] = NO_HEIGHT;
         }
     }
 
-    // completely invalidate the cache
-    void Clear()
+    // return the remembered height of the item, if any
+    bool GetHeight(size_t item, wxCoord& height) const
+    {
+        if ( item >= m_heights.size() || m_heights[item] == NO_HEIGHT )
+            return false;
+
+        height = m_heights[item];
+        return true;
+    }
+
+    void SetHeight(size_t item, wxCoord height)
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        if ( item >= m_heights.size() )
+            m_heights.resize(item + 1, wxCoord(NO_HEIGHT));
+
+        m_heights[item] = height;
+    }
+
+private:
+    // the default limits, the number of items is chosen to be big enough to
+    // cover a few screens worth of items
+    enum
+    {
+        DEFAULT_MAX_ITEMS = 200,
+        DEFAULT_MAX_BYTES = 4*1024*1024
+    };
+
+    static const size_t NO_SLOT = (size_t)-1;
+    static const wxCoord NO_HEIGHT = -1;
+
+    struct Entry
+    {
+        // the index of the item and its parsed representation
+        size_t item;
+        wxHtmlCell *cell;
+
+        // the estimated memory used by the cell
+        size_t cost;
+
+        // the slots of the more and less recently used entries
+        size_t prev,
+               next;
+    };
+
+    // estimate the memory used by the given cell and all its children, this
+    // doesn't need to be exact as it's only used to limit the cache size
+    static size_t GetCellCost(const wxHtmlCell *cell)
+    {
+        size_t cost = 0;
+        for ( ; cell; cell = cell->GetNext() )
         {
-            InvalidateItem(n);
+            cost += sizeof(wxHtmlWordCell) + GetCellCost(cell->GetFirstChild());
         }
+
+        return cost;
     }
 
-    // return the cached cell for this index or NULL if none
-    wxHtmlCell *Get(size_t item) const
+    void DoStore(size_t item, wxHtmlCell *cell, size_t cost)
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        wxASSERT_MSG( !Has(item), wxT("item is already cached") );
+
+        size_t slot;
+        if ( m_freeSlots.empty() )
         {
-            if ( m_items[n] == item )
-                return m_cells[n];
+            slot = m_entries.size();
+            m_entries.push_back(Entry());
         }
+        else
+        {
+            slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+
+        Entry& entry = m_entries[slot];
+        entry.item = item;
+        entry.cell = cell;
+        entry.cost = cost;
 
-        return NULL;
+        LinkAtHead(slot);
+
+        m_slots[item] = slot;
+        m_bytes += cost;
     }
 
-    // returns true if we already have this item cached
-    bool Has(size_t item) const { return Get(item) != NULL; }
+    // discard the least recently used items until we don't exceed the limits
+    // any longer, but never discard the most recently used item nor any items
+    // in the specified range
+    void Trim(size_t keepFrom, size_t keepTo)
+    {
+        size_t slot = m_tail;
+        while ( slot != NO_SLOT && slot != m_head &&
+                    (m_slots.size() > m_maxItems ||
+                        (m_maxBytes && m_bytes > m_maxBytes)) )
+        {
+            const Entry& entry = m_entries[slot];
+            const size_t prev = entry.prev;
+            if ( entry.item < keepFrom || entry.item >= keepTo )
+                Discard(slot);
 
-    // ensure that the item is cached
-    void Store(size_t item, wxHtmlCell *cell)
+            slot = prev;
+        }
+    }
+
+    void Discard(size_t slot)
     {
-        delete m_cells[m_next];
-        m_cells[m_next] = cell;
-        m_items[m_next] = item;
+        Entry& entry = m_entries[slot];
+
+        Unlink(slot);
+
+        m_slots.erase(entry.item);
+        m_bytes -= entry.cost;
+        wxDELETE(entry.cell);
 
-        // advance to the next item wrapping around if there are no more
-        if ( ++m_next == SIZE )
-            m_next = 0;
+        m_freeSlots.push_back(slot);
     }
 
-    // forget the cached value of the item(s) between the given ones (inclusive)
-    void InvalidateRange(size_t from, size_t to)
+    void ClearCells()
     {
-        for ( size_t n = 0; n < SIZE; n++ )
+        for ( size_t slot = m_head; slot != NO_SLOT; slot = m_entries[slot].next )
         {
-            if ( m_items[n] >= from && m_items[n] <= to )
-            {
-                InvalidateItem(n);
-            }
+            delete m_entries[slot].cell;
         }
+
+        m_entries.clear();
+        m_freeSlots.clear();
+        m_slots.clear();
+        m_bytes = 0;
+        m_head =
+        m_tail = NO_SLOT;
     }
 
-private:
-    // the max number of the items we cache
-    enum { SIZE = 50 };
+    void Unlink(size_t slot)
+    {
+        const Entry& entry = m_entries[slot];
+
+        if ( entry.prev != NO_SLOT )
+            m_entries[entry.prev].next = entry.next;
+        else
+            m_head = entry.next;
+
+        if ( entry.next != NO_SLOT )
+            m_entries[entry.next].prev = entry.prev;
+        else
+            m_tail = entry.prev;
+    }
+
+    void LinkAtHead(size_t slot)
+    {
+        Entry& entry = m_entries[slot];
+        entry.prev = NO_SLOT;
+        entry.next = m_head;
+
+        if ( m_head != NO_SLOT )
+            m_entries[m_head].prev = slot;
+        else
+            m_tail = slot;
+
+        m_head = slot;
+    }
 
-    // the index of the LRU (oldest) cell
-    size_t m_next;
 
-    // the parsed representation of the cached item or NULL
-    wxHtmlCell *m_cells[SIZE];
+    // the limits on the number of cached items and the memory used by them
+    // (0 if unlimited)
+    size_t m_maxItems,
+           m_maxBytes;
 
-    // the index of the currently cached item (only valid if m_cells != NULL)
-    size_t m_items[SIZE];
+    // the estimated memory used by all the cached cells
+    size_t m_bytes;
+
+    // all the entries, including the unused ones whose slots are in
+    // m_freeSlots, linked in the most recently used order
+    wxVector<Entry> m_entries;
+    wxVector<size_t> m_freeSlots;
+    size_t m_head,
+           m_tail;
+
+    // the map from the item index to the slot of its entry
+    wxHtmlListBoxCacheSlots m_slots;
+
+    // the heights of the items or NO_HEIGHT if unknown
+    wxVector<wxCoord> m_heights;
+
+    wxDECLARE_NO_COPY_CLASS(wxHtmlListBoxCache);
 };
 
 // ----------------------------------------------------------------------------
@@ -240,6 +471,7 @@ void wxHtmlListBox::Init()
     m_htmlParser = NULL;
     m_htmlRendStyle = new wxHtmlListBoxStyle(*this);
     m_cache = new wxHtmlListBoxCache;
+    m_cacheWidth = 0;
 }
 
 bool wxHtmlListBox::Create(wxWindow *parent,
@@ -322,21 +554,104 @@ wxHtmlCell* wxHtmlListBox::CreateCellForItem(size_t n) const
     // can quickly find the item:
     cell->SetId(wxString::Format(wxT("%lu"), (unsigned long)n));
 
-    cell->Layout(GetClientSize().x - 2*GetMargins().x);
+    cell->Layout(GetCellsWidth());
 
     return cell;
 }
 
+int wxHtmlListBox::GetCellsWidth() const
+{
+    return GetClientSize().x - 2*GetMargins().x;
+}
+
+void wxHtmlListBox::SetCacheSize(size_t maxItems, size_t maxBytes)
+{
+    wxCHECK_RET( maxItems, wxT("at least one item must be cached") );
+
+    m_cache->SetLimits(maxItems, maxBytes);
+}
+
 void wxHtmlListBox::CacheItem(size_t n) const
 {
-    if ( !m_cache->Has(n) )
-        m_cache->Store(n, CreateCellForItem(n));
+    if ( m_cache->Has(n) )
+        return;
+
+    wxHtmlCell * const cell = CreateCellForItem(n);
+    if ( !cell )
+        return;
+
+    m_cache->SetHeight(n, GetItemHeightForCell(cell));
+
+    // don't discard the visible items to make room for this one, as they're
+    // going to be needed again soon
+    m_cache->Store(n, cell, GetVisibleBegin(), GetVisibleEnd());
+}
+
+void wxHtmlListBox::PrefetchItems()
+{
+    const size_t count = GetItemCount();
+    const size_t begin = GetVisibleBegin(),
+                 end = wxMin(GetVisibleEnd(), count);
+    if ( begin >= end || !IsShownOnScreen() )
+        return;
+
+    // prefetch up to a page of items before and after the visible ones, but
+    // not more than can be kept in the cache together with the visible items
+    size_t page = end - begin;
+    const size_t maxItems = m_cache->GetMaxItems();
+    if ( maxItems < 3*page )
+        page = maxItems > page ? (maxItems - page) / 2 : 0;
+
+    const size_t keepFrom = begin - wxMin(begin, page),
+                 keepTo = end + page;
+    if ( !m_cache->HasRoomFor(keepFrom, keepTo) )
+        return;
+
+    // the items after the visible ones are more likely to be needed first
+    size_t n;
+    for ( n = end; n < count && n < keepTo; n++ )
+    {
+        if ( !m_cache->Has(n) )
+            break;
+    }
+
+    if ( n == count || n == keepTo )
+    {
+        for ( n = begin; n > keepFrom; n-- )
+        {
+            if ( !m_cache->Has(n - 1) )
+                break;
+        }
+
+        if ( n == keepFrom )
+            return;
+
+        n--;
+    }
+
+    wxHtmlCell * const cell = CreateCellForItem(n);
+    if ( !cell )
+        return;
+
+    m_cache->SetHeight(n, GetItemHeightForCell(cell));
+    m_cache->Store(n, cell, keepFrom, keepTo);
+
+    // only a single item is parsed during each idle event to keep the
+    // program responsive, so ask for more idle events to continue
+    wxWakeUpIdle();
 }
 
 void wxHtmlListBox::OnSize(wxSizeEvent& event)
 {
-    // we need to relayout all the cached cells
-    m_cache->Clear();
+    // we need to relayout all the cached cells if the width changed, which
+    // may also change their heights, but not otherwise
+    const int width = GetCellsWidth();
+    if ( width != m_cacheWidth )
+    {
+        m_cacheWidth = width;
+
+        RefreshAll();
+    }
 
     event.Skip();
 }
@@ -400,7 +715,8 @@ void wxHtmlListBox::OnDrawItem(wxDC& dc, const wxRect& rect, size_t n) const
     CacheItem(n);
 
     wxHtmlCell *cell = m_cache->Get(n);
-    wxCHECK_RET( cell, wxT("this cell should be cached!") );
+    if ( !cell )
+        return;
 
     wxHtmlRenderingInfo htmlRendInfo;
 
@@ -430,16 +746,33 @@ void wxHtmlListBox::OnDrawItem(wxDC& dc, const wxRect& rect, size_t n) const
 
 wxCoord wxHtmlListBox::OnMeasureItem(size_t n) const
 {
-    // Notice that we can't cache the cell here because we could be called from
-    // some code updating an existing cell which could be displaced from the
-    // cache if we called CacheItem() and destroyed -- resulting in a crash
-    // when we return to its method from here, see #16651.
-    wxHtmlCell * const cell = CreateCellForItem(n);
-    if ( !cell )
-        return 0;
+    wxCoord h;
+    if ( m_cache->GetHeight(n, h) )
+        return h;
 
-    const wxCoord h = cell->GetHeight() + cell->GetDescent() + 4;
-    delete cell;
+    wxHtmlCell *cell = m_cache->Get(n);
+    if ( cell )
+    {
+        h = GetItemHeightForCell(cell);
+    }
+    else
+    {
+        cell = CreateCellForItem(n);
+        if ( !cell )
+            return 0;
+
+        h = GetItemHeightForCell(cell);
+
+        // Notice that we can't discard any other cells from the cache here
+        // because we could be called from some code updating an existing cell
+        // which would be destroyed then -- resulting in a crash when we return
+        // to its method from here, see #16651. But we can still keep this cell
+        // if there is enough space for it.
+        if ( !m_cache->StoreIfRoom(n, cell) )
+            delete cell;
+    }
+
+    m_cache->SetHeight(n, h);
 
     return h;
 }
@@ -567,6 +900,10 @@ void wxHtmlListBox::OnInternalIdle()
 {
     wxVListBox::OnInternalIdle();
 
+    // use the idle time to prepare the items which are going to be shown if
+    // the window is scrolled
+    PrefetchItems();
+
     if ( wxHtmlWindowMouseHelper::DidMouseMove() )
     {
         wxPoint pos = ScreenToClient(wxGetMousePosition());
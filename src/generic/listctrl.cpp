@@ -40,6 +40,7 @@
 #include "wx/renderer.h"
 #include "wx/generic/private/listctrl.h"
 #include "wx/generic/private/widthcalc.h"
+#include "wx/private/parallelsort.h"
 
 #ifdef __WXMAC__
     #include "wx/osx/private.h"
@@ -4563,6 +4564,221 @@ void wxListMainWindow::SortItems( wxListCtrlCompare fn, wxIntPtr data )
     m_dirty = true;
 }
 
+namespace
+{
+
+// The sort key of a single line for a single column, extracted from the line
+// text only once before sorting.
+struct wxListLineSortKey
+{
+    wxString text;
+    double number;
+    bool isNumber;
+};
+
+inline bool wxIsSortDigit(const wxUniChar& ch)
+{
+    return ch >= wxT('0') && ch <= wxT('9');
+}
+
+// Compare the strings treating the runs of digits in them as numbers, so that
+// "item9" comes before "item10".
+int wxCompareNatural(const wxString& s1, const wxString& s2)
+{
+    wxString::const_iterator p1 = s1.begin(),
+                             p2 = s2.begin();
+    const wxString::const_iterator end1 = s1.end(),
+                                   end2 = s2.end();
+
+    while ( p1 != end1 && p2 != end2 )
+    {
+        if ( wxIsSortDigit(*p1) && wxIsSortDigit(*p2) )
+        {
+            // leading zeros don't affect the value of the number
+            while ( p1 != end1 && *p1 == wxT('0') )
+                ++p1;
+            while ( p2 != end2 && *p2 == wxT('0') )
+                ++p2;
+
+            const wxString::const_iterator start1 = p1,
+                                           start2 = p2;
+            size_t len1 = 0,
+                   len2 = 0;
+            for ( ; p1 != end1 && wxIsSortDigit(*p1); ++p1 )
+                len1++;
+            for ( ; p2 != end2 && wxIsSortDigit(*p2); ++p2 )
+                len2++;
+
+            // the longer number is the greater one
+            if ( len1 != len2 )
+                return len1 < len2 ? -1 : 1;
+
+            for ( wxString::const_iterator q1 = start1, q2 = start2;
+                  q1 != p1;
+                  ++q1, ++q2 )
+            {
+                if ( *q1 != *q2 )
+                    return *q1 < *q2 ? -1 : 1;
+            }
+
+            continue;
+        }
+
+        if ( *p1 != *p2 )
+            return *p1 < *p2 ? -1 : 1;
+
+        ++p1;
+        ++p2;
+    }
+
+    if ( p1 != end1 )
+        return 1;
+    if ( p2 != end2 )
+        return -1;
+
+    return 0;
+}
+
+// Compares the lines, identified by their original indices, using the keys
+// extracted from them. This is used from multiple threads, so it must only
+// access the keys and not the lines themselves.
+class wxListLineKeysComparator
+{
+public:
+    wxListLineKeysComparator(const wxVector<wxListSortKey>& keys,
+                             const wxVector<wxListLineSortKey>& lineKeys)
+        : m_keys(keys),
+          m_lineKeys(lineKeys)
+    {
+    }
+
+    bool operator()(size_t line1, size_t line2) const
+    {
+        const size_t numKeys = m_keys.size();
+        for ( size_t n = 0; n < numKeys; n++ )
+        {
+            const int flags = m_keys[n].GetFlags();
+            int rc = Compare(m_lineKeys[line1*numKeys + n],
+                             m_lineKeys[line2*numKeys + n],
+                             flags);
+            if ( rc )
+                return flags & wxLIST_SORT_DESCENDING ? rc > 0 : rc < 0;
+        }
+
+        // keep the original order of equal lines
+        return line1 < line2;
+    }
+
+private:
+    static int Compare(const wxListLineSortKey& key1,
+                       const wxListLineSortKey& key2,
+                       int flags)
+    {
+        if ( flags & wxLIST_SORT_NUMERIC )
+        {
+            // the lines without numbers come before the ones with them
+            if ( key1.isNumber != key2.isNumber )
+                return key1.isNumber ? 1 : -1;
+
+            if ( key1.isNumber )
+            {
+                if ( key1.number != key2.number )
+                    return key1.number < key2.number ? -1 : 1;
+
+                return 0;
+            }
+        }
+
+        if ( flags & wxLIST_SORT_NATURAL )
+            return wxCompareNatural(key1.text, key2.text);
+
+        return key1.text.compare(key2.text);
+    }
+
+    const wxVector<wxListSortKey>& m_keys;
+    const wxVector<wxListLineSortKey>& m_lineKeys;
+};
+
+} // anonymous namespace
+
+bool wxListMainWindow::SortItemsByColumns(const wxVector<wxListSortKey>& keys)
+{
+    wxCHECK_MSG( !IsVirtual(), false,
+                 wxT("can't sort virtual list control items") );
+
+    const size_t numKeys = keys.size();
+    for ( size_t n = 0; n < numKeys; n++ )
+    {
+        const int col = keys[n].GetColumn();
+        wxCHECK_MSG( col == 0 || (col > 0 && col < GetColumnCount()), false,
+                     wxT("invalid column index in sort key") );
+    }
+
+    const size_t count = m_lines.size();
+    if ( !count || !numKeys )
+        return true;
+
+    // extract the keys only once for each line instead of doing it in every
+    // comparison
+    wxVector<wxListLineSortKey> lineKeys(count*numKeys);
+    for ( size_t line = 0; line < count; line++ )
+    {
+        const wxListLineData* const ld = m_lines[line];
+        for ( size_t n = 0; n < numKeys; n++ )
+        {
+            wxListLineSortKey& key = lineKeys[line*numKeys + n];
+            key.text = ld->GetText(keys[n].GetColumn());
+
+            const int flags = keys[n].GetFlags();
+            if ( flags & wxLIST_SORT_NOCASE )
+                key.text.MakeLower();
+
+            key.isNumber = (flags & wxLIST_SORT_NUMERIC) &&
+                                key.text.ToDouble(&key.number);
+        }
+    }
+
+    wxVector<size_t> order(count);
+    for ( size_t line = 0; line < count; line++ )
+        order[line] = line;
+
+    wxParallelSort(order.begin(), order.end(),
+                   wxListLineKeysComparator(keys, lineKeys));
+
+    // reorder the lines and update the indices referring to them: as the
+    // selection is stored in the lines themselves, it's preserved as is
+    wxVector<size_t> newIndices(count);
+    wxVector<wxListLineData*> lines(count);
+    for ( size_t line = 0; line < count; line++ )
+    {
+        lines[line] = m_lines[order[line]];
+        newIndices[order[line]] = line;
+    }
+
+    // notice that we can't just swap the arrays as wxListLineDataArray
+    // deletes its contents when it's destroyed
+    for ( size_t line = 0; line < count; line++ )
+        m_lines[line] = lines[line];
+
+    size_t* const indices[] =
+    {
+        &m_current,
+        &m_lineLastClicked,
+        &m_lineBeforeLastClicked,
+        &m_lineSelectSingleOnUp,
+    };
+
+    for ( size_t n = 0; n < WXSIZEOF(indices); n++ )
+    {
+        if ( *indices[n] < count )
+            *indices[n] = newIndices[*indices[n]];
+    }
+
+    m_dirty = true;
+
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // scrolling
 // ----------------------------------------------------------------------------
@@ -5406,6 +5622,19 @@ bool wxGenericListCtrl::SortItems( wxListCtrlCompare fn, wxIntPtr data )
     return true;
 }
 
+bool wxGenericListCtrl::SortItemsByColumn( int col, int flags )
+{
+    wxVector<wxListSortKey> keys;
+    keys.push_back(wxListSortKey(col, flags));
+
+    return m_mainWin->SortItemsByColumns( keys );
+}
+
+bool wxGenericListCtrl::SortItemsByColumns( const wxVector<wxListSortKey>& keys )
+{
+    return m_mainWin->SortItemsByColumns( keys );
+}
+
 // ----------------------------------------------------------------------------
 // event handlers
 // ----------------------------------------------------------------------------
@@ -41,6 +41,7 @@
 #endif
 
 #include "wx/progdlg.h"
+#include "wx/progsrc.h"
 #include "wx/evtloop.h"
 
 // ----------------------------------------------------------------------------
@@ -110,6 +111,12 @@ void wxGenericProgressDialog::Init()
     m_winDisabler = NULL;
     m_tempEventLoop = NULL;
 
+#if wxUSE_TIMER
+    m_progressSource = NULL;
+    m_progressTimer = NULL;
+    m_progressSourceValue = -1;
+#endif // wxUSE_TIMER
+
     SetWindowStyle(wxDEFAULT_DIALOG_STYLE);
 }
 
@@ -542,6 +549,79 @@ void wxGenericProgressDialog::DoAfterUpdate()
     wxEventLoopBase::GetActive()->YieldFor(wxEVT_CATEGORY_UI);
 }
 
+#if wxUSE_TIMER
+
+void wxGenericProgressDialog::SetProgressSource(wxProgressSource *source,
+                                                int interval)
+{
+    m_progressSource = source;
+
+    if ( !source )
+    {
+        if ( m_progressTimer )
+            m_progressTimer->Stop();
+        return;
+    }
+
+    // Force the update on the next timer tick.
+    m_progressSourceValue = -1;
+
+    if ( !m_progressTimer )
+    {
+        m_progressTimer = new wxTimer(this);
+        Bind(wxEVT_TIMER, &wxGenericProgressDialog::OnProgressTimer, this,
+             m_progressTimer->GetId());
+    }
+
+    m_progressTimer->Start(interval);
+}
+
+void wxGenericProgressDialog::OnProgressTimer(wxTimerEvent& WXUNUSED(event))
+{
+    wxProgressSource * const source = m_progressSource;
+    if ( !source )
+        return;
+
+    // The clicks on the "Cancel" button are processed by the main event loop
+    // in the meanwhile, just forward them to the worker.
+    if ( WasCancelled() )
+    {
+        source->Cancel();
+        SetProgressSource(NULL);
+        return;
+    }
+
+    wxString newmsg;
+    const bool messageChanged = source->GetNewMessage(newmsg);
+
+    // Update() takes the values in the original range, before scaling it.
+    int range = m_maximum;
+#ifdef __WXMSW__
+    range *= m_factor;
+#endif // __WXMSW__
+
+    // Don't do anything if there was no progress since the last time, this
+    // avoids redrawing the dialog needlessly.
+    const int value = wxMin(source->GetValue(), range);
+    if ( value == m_progressSourceValue && !messageChanged )
+        return;
+
+    m_progressSourceValue = value;
+
+    // Stop sampling before updating the dialog with the maximal value as this
+    // may show it modally, and we must not be reentered from there.
+    if ( value == range )
+        SetProgressSource(NULL);
+
+    if ( !Update(value, newmsg) )
+    {
+        source->Cancel();
+        SetProgressSource(NULL);
+    }
+}
+
+#endif // wxUSE_TIMER
+
 void wxGenericProgressDialog::Resume()
 {
     m_state = Continue;
@@ -703,6 +783,10 @@ wxGenericProgressDialog::~wxGenericProgressDialog()
     // normally this should have been already done, but just in case
     ReenableOtherWindows();
 
+#if wxUSE_TIMER
+    delete m_progressTimer;
+#endif // wxUSE_TIMER
+
     if ( m_tempEventLoop )
     {
         // If another event loop has been installed as active during the life
@@ -24,21 +24,159 @@
 
 #include "wx/selstore.h"
 
+#ifndef WX_PRECOMP
+    #include "wx/utils.h"
+#endif // WX_PRECOMP
+
 // ============================================================================
 // wxSelectionStore
 // ============================================================================
 
 const unsigned wxSelectionStore::NO_SELECTION = static_cast<unsigned>(-1);
 
+namespace
+{
+
+// 100 is hardcoded but it shouldn't matter much: the important thing is that
+// we don't refresh everything when really few (e.g. 1 or 2) items change state
+const unsigned MANY_ITEMS = 100;
+
+// append the items in the given range to itemsChanged unless there are
+// already too many of them there
+void AddChangedItems(wxArrayInt *itemsChanged, unsigned from, unsigned to)
+{
+    if ( !itemsChanged )
+        return;
+
+    for ( unsigned item = from;
+          item < to && itemsChanged->size() <= MANY_ITEMS;
+          item++ )
+    {
+        itemsChanged->Add(item);
+    }
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// ranges
+// ----------------------------------------------------------------------------
+
+size_t wxSelectionStore::FindRangeEndingAfter(unsigned item) const
+{
+    size_t lo = 0,
+           hi = m_ranges.size();
+    while ( lo < hi )
+    {
+        const size_t mid = lo + (hi - lo)/2;
+        if ( m_ranges[mid].to < item )
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+unsigned
+wxSelectionStore::AddRange(unsigned from, unsigned to, wxArrayInt *itemsChanged)
+{
+    if ( from >= to )
+        return 0;
+
+    // find all the ranges overlapping or adjacent to the new one: they will
+    // be merged with it
+    const size_t first = FindRangeEndingAfter(from);
+    size_t last = first;
+
+    unsigned numAdded = to - from,
+             item = from;
+    Range merged(from, to);
+    for ( ; last < m_ranges.size() && m_ranges[last].from <= to; last++ )
+    {
+        const Range& r = m_ranges[last];
+
+        // the items in the gap before this range are the ones really added
+        if ( r.from > item )
+            AddChangedItems(itemsChanged, item, r.from);
+        if ( r.to > item )
+            item = r.to;
+
+        numAdded -= wxMin(r.to, to) - wxMax(r.from, from);
+
+        merged.from = wxMin(merged.from, r.from);
+        merged.to = wxMax(merged.to, r.to);
+    }
+
+    if ( item < to )
+        AddChangedItems(itemsChanged, item, to);
+
+    if ( first == last )
+    {
+        m_ranges.insert(m_ranges.begin() + first, merged);
+    }
+    else
+    {
+        m_ranges[first] = merged;
+        m_ranges.erase(m_ranges.begin() + first + 1, m_ranges.begin() + last);
+    }
+
+    m_numItemsSel += numAdded;
+
+    return numAdded;
+}
+
+unsigned
+wxSelectionStore::RemoveRange(unsigned from, unsigned to, wxArrayInt *itemsChanged)
+{
+    if ( from >= to )
+        return 0;
+
+    // find all the ranges overlapping the removed one
+    const size_t first = FindRangeEndingAfter(from + 1);
+    size_t last = first;
+
+    unsigned numRemoved = 0;
+    for ( ; last < m_ranges.size() && m_ranges[last].from < to; last++ )
+    {
+        const Range& r = m_ranges[last];
+
+        const unsigned start = wxMax(r.from, from),
+                       end = wxMin(r.to, to);
+        AddChangedItems(itemsChanged, start, end);
+        numRemoved += end - start;
+    }
+
+    if ( first == last )
+        return 0;
+
+    // the parts of the first and last ranges outside of the removed one
+    // remain
+    const Range before(m_ranges[first].from, from),
+                after(to, m_ranges[last - 1].to);
+
+    m_ranges.erase(m_ranges.begin() + first, m_ranges.begin() + last);
+
+    if ( after.from < after.to )
+        m_ranges.insert(m_ranges.begin() + first, after);
+    if ( before.from < before.to )
+        m_ranges.insert(m_ranges.begin() + first, before);
+
+    m_numItemsSel -= numRemoved;
+
+    return numRemoved;
+}
+
 // ----------------------------------------------------------------------------
 // tests
 // ----------------------------------------------------------------------------
 
 bool wxSelectionStore::IsSelected(unsigned item) const
 {
-    bool isSel = m_itemsSel.Index(item) != wxNOT_FOUND;
+    const size_t n = FindRangeEndingAfter(item + 1);
+    bool isSel = n < m_ranges.size() && m_ranges[n].from <= item;
 
-    // if the default state is to be selected, being in m_itemsSel means that
+    // if the default state is to be selected, being in m_ranges means that
     // the item is not selected, so we have to inverse the logic
     return m_defaultState ? !isSel : isSel;
 }
@@ -49,143 +187,59 @@ bool wxSelectionStore::IsSelected(unsigned item) const
 
 bool wxSelectionStore::SelectItem(unsigned item, bool select)
 {
-    // search for the item ourselves as like this we get the index where to
-    // insert it later if needed, so we do only one search in the array instead
-    // of two (adding item to a sorted array requires a search)
-    size_t index = m_itemsSel.IndexForInsert(item);
-    bool isSel = index < m_itemsSel.GetCount() && m_itemsSel[index] == item;
-
     if ( select != m_defaultState )
-    {
-        if ( !isSel )
-        {
-            m_itemsSel.AddAt(item, index);
-
-            return true;
-        }
-    }
+        return AddRange(item, item + 1, NULL) != 0;
     else // reset to default state
-    {
-        if ( isSel )
-        {
-            m_itemsSel.RemoveAt(index);
-            return true;
-        }
-    }
-
-    return false;
+        return RemoveRange(item, item + 1, NULL) != 0;
 }
 
 bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
                                    bool select,
                                    wxArrayInt *itemsChanged)
 {
-    // 100 is hardcoded but it shouldn't matter much: the important thing is
-    // that we don't refresh everything when really few (e.g. 1 or 2) items
-    // change state
-    static const unsigned MANY_ITEMS = 100;
-
     wxASSERT_MSG( itemFrom <= itemTo, wxT("should be in order") );
 
+    if ( itemsChanged )
+        itemsChanged->Empty();
+
     // are we going to have more [un]selected items than the other ones?
-    if ( itemTo - itemFrom > m_count/2 )
-    {
-        if ( select != m_defaultState )
-        {
-            // the default state now becomes the same as 'select'
-            m_defaultState = select;
-
-            // so all the old selections (which had state select) shouldn't be
-            // selected any more, but all the other ones should
-            wxSelectedIndices selOld = m_itemsSel;
-            m_itemsSel.Empty();
-
-            // TODO: it should be possible to optimize the searches a bit
-            //       knowing the possible range
-
-            unsigned item;
-            for ( item = 0; item < itemFrom; item++ )
-            {
-                if ( selOld.Index(item) == wxNOT_FOUND )
-                    m_itemsSel.Add(item);
-            }
-
-            for ( item = itemTo + 1; item < m_count; item++ )
-            {
-                if ( selOld.Index(item) == wxNOT_FOUND )
-                    m_itemsSel.Add(item);
-            }
-
-            // many items (> half) changed state
-            itemsChanged = NULL;
-        }
-        else // select == m_defaultState
-        {
-            // get the inclusive range of items between itemFrom and itemTo
-            size_t count = m_itemsSel.GetCount(),
-                   start = m_itemsSel.IndexForInsert(itemFrom),
-                   end = m_itemsSel.IndexForInsert(itemTo);
-
-            if ( start == count || m_itemsSel[start] < itemFrom )
-            {
-                start++;
-            }
-
-            if ( end == count || m_itemsSel[end] > itemTo )
-            {
-                end--;
-            }
-
-            if ( start <= end )
-            {
-                // delete all of them (from end to avoid changing indices)
-                for ( int i = end; i >= (int)start; i-- )
-                {
-                    if ( itemsChanged )
-                    {
-                        if ( itemsChanged->GetCount() > MANY_ITEMS )
-                        {
-                            // stop counting (see comment below)
-                            itemsChanged = NULL;
-                        }
-                        else
-                        {
-                            itemsChanged->Add(m_itemsSel[i]);
-                        }
-                    }
-
-                    m_itemsSel.RemoveAt(i);
-                }
-            }
-        }
-    }
-    else // "few" items change state
+    if ( itemTo - itemFrom > m_count/2 && select != m_defaultState )
     {
-        if ( itemsChanged )
+        // the default state now becomes the same as 'select'
+        m_defaultState = select;
+
+        // so all the old selections (which had state select) shouldn't be
+        // selected any more, but all the other ones should, except for
+        // those in the range which now have the default state
+        wxVector<Range> rangesOld;
+        rangesOld.swap(m_ranges);
+        m_numItemsSel = 0;
+
+        unsigned item = 0;
+        for ( size_t n = 0; n < rangesOld.size(); n++ )
         {
-            itemsChanged->Empty();
-        }
+            const Range& r = rangesOld[n];
+            if ( r.from >= m_count )
+                break;
 
-        // just add the items to the selection
-        for ( unsigned item = itemFrom; item <= itemTo; item++ )
-        {
-            if ( SelectItem(item, select) && itemsChanged )
-            {
-                itemsChanged->Add(item);
-
-                if ( itemsChanged->GetCount() > MANY_ITEMS )
-                {
-                    // stop counting them, we'll just eat gobs of memory
-                    // for nothing at all - faster to refresh everything in
-                    // this case
-                    itemsChanged = NULL;
-                }
-            }
+            AddRange(item, r.from, NULL);
+            item = r.to;
         }
+
+        AddRange(item, m_count, NULL);
+        RemoveRange(itemFrom, itemTo + 1, NULL);
+
+        // many items (> half) changed state
+        return false;
     }
 
-    // we set it to NULL if there are many items changing state
-    return itemsChanged != NULL;
+    const unsigned numChanged = select != m_defaultState
+                                    ? AddRange(itemFrom, itemTo + 1, itemsChanged)
+                                    : RemoveRange(itemFrom, itemTo + 1, itemsChanged);
+
+    // if too many items changed state we didn't collect all of them, it's
+    // faster to refresh everything in this case anyhow
+    return numChanged <= MANY_ITEMS;
 }
 
 // ----------------------------------------------------------------------------
@@ -194,24 +248,33 @@ bool wxSelectionStore::SelectRange(unsigned itemFrom, unsigned itemTo,
 
 void wxSelectionStore::OnItemsInserted(unsigned item, unsigned numItems)
 {
-    const size_t count = m_itemsSel.GetCount();
+    // nothing to do, and splitting the range below would be harmful
+    if ( !numItems )
+        return;
+
+    size_t n = FindRangeEndingAfter(item + 1);
 
-    size_t idx = m_itemsSel.IndexForInsert(item);
+    // split the range containing the insertion point, if any
+    if ( n < m_ranges.size() && m_ranges[n].from < item )
+    {
+        const Range after(item, m_ranges[n].to);
+        m_ranges[n].to = item;
+        m_ranges.insert(m_ranges.begin() + ++n, after);
+    }
 
-    for ( size_t i = idx; i < count; i++ )
+    // and shift all the ranges after it
+    for ( ; n < m_ranges.size(); n++ )
     {
-        m_itemsSel[i] += numItems;
+        m_ranges[n].from += numItems;
+        m_ranges[n].to += numItems;
     }
 
     if ( m_defaultState )
     {
         // All newly inserted items are not selected, so if the default state
         // is to be selected, we need to manually add them to the deselected
-        // items indices.
-        for ( unsigned n = item; n < item + numItems; n++ )
-        {
-            m_itemsSel.AddAt(item, idx++);
-        }
+        // items.
+        AddRange(item, item + numItems, NULL);
     }
 
     m_count += numItems;
@@ -219,60 +282,33 @@ void wxSelectionStore::OnItemsInserted(unsigned item, unsigned numItems)
 
 void wxSelectionStore::OnItemDelete(unsigned item)
 {
-    size_t count = m_itemsSel.GetCount(),
-           i = m_itemsSel.IndexForInsert(item);
-
-    if ( i < count && m_itemsSel[i] == item )
-    {
-        // this item itself was in m_itemsSel, remove it from there
-        m_itemsSel.RemoveAt(i);
-
-        count--;
-    }
-
-    // and adjust the index of all which follow it
-    while ( i < count )
-    {
-        // all following elements must be greater than the one we deleted
-        wxASSERT_MSG( m_itemsSel[i] > item, wxT("logic error") );
-
-        m_itemsSel[i++]--;
-    }
-
-    m_count--;
+    OnItemsDeleted(item, 1);
 }
 
 bool wxSelectionStore::OnItemsDeleted(unsigned item, unsigned numItems)
 {
-    bool anyDeletedInSelItems = false,
-         allDeletedInSelItems = true;
-
-    size_t i = m_itemsSel.IndexForInsert(item);
-
-    const unsigned firstAfterDeleted = item + numItems;
-    while ( i < m_itemsSel.size() )
+    // Forget about the deleted items entirely.
+    const unsigned numRemoved = RemoveRange(item, item + numItems, NULL);
+
+    // All the remaining ranges after the deleted ones need to be shifted and
+    // the one just before them may need to be merged with the first of them.
+    size_t n = FindRangeEndingAfter(item + 1);
+    if ( n > 0 && n < m_ranges.size() &&
+            m_ranges[n - 1].to + numItems == m_ranges[n].from )
     {
-        if ( m_itemsSel[i] < firstAfterDeleted )
-        {
-            // This item is going to be deleted, so remove it from the
-            // selected indices entirely. Notice that we do not update i here
-            // as it now refers to the next element.
-            m_itemsSel.RemoveAt(i);
-
-            anyDeletedInSelItems = true;
-        }
-        else
-        {
-            // This item remains, just update its index.
-            m_itemsSel[i++] -= numItems;
+        m_ranges[n - 1].to = m_ranges[n].to - numItems;
+        m_ranges.erase(m_ranges.begin() + n);
+    }
 
-            allDeletedInSelItems = false;
-        }
+    for ( ; n < m_ranges.size(); n++ )
+    {
+        m_ranges[n].from -= numItems;
+        m_ranges[n].to -= numItems;
     }
 
     m_count -= numItems;
 
-    return m_defaultState ? allDeletedInSelItems : anyDeletedInSelItems;
+    return m_defaultState ? numRemoved < numItems : numRemoved != 0;
 }
 
 
@@ -280,14 +316,8 @@ void wxSelectionStore::SetItemCount(unsigned count)
 {
     // forget about all items whose indices are now invalid if the size
     // decreased
-    if ( count < m_count )
-    {
-        for ( size_t i = m_itemsSel.GetCount(); i > 0; i-- )
-        {
-            if ( m_itemsSel[i - 1] >= count )
-                m_itemsSel.RemoveAt(i - 1);
-        }
-    }
+    if ( !m_ranges.empty() && m_ranges.back().to > count )
+        RemoveRange(count, m_ranges.back().to, NULL);
 
     // remember the new number of items
     m_count = count;
@@ -306,28 +336,30 @@ unsigned wxSelectionStore::GetFirstSelectedItem(IterationState& cookie) const
 
 unsigned wxSelectionStore::GetNextSelectedItem(IterationState& cookie) const
 {
+    // The cookie is just the index of the next item to check.
+    unsigned item = static_cast<unsigned>(cookie);
+
+    const size_t n = FindRangeEndingAfter(item + 1);
     if ( m_defaultState )
     {
-        // We have no choice but to iterate over all items in this case. It
-        // shouldn't be that bad in practice because (almost) all items are
-        // supposed to be selected if m_defaultState == true anyhow.
-        for ( unsigned item = cookie; ; item++ )
-        {
-            if ( item >= m_count )
-                return NO_SELECTION;
-
-            if ( IsSelected(item) )
-            {
-                cookie = item + 1;
-                return item;
-            }
-        }
+        // All items are selected except for those in the ranges, so skip the
+        // range containing this item if there is one: as the ranges are never
+        // adjacent, the item following it is selected.
+        if ( n < m_ranges.size() && m_ranges[n].from <= item )
+            item = m_ranges[n].to;
+
+        if ( item >= m_count )
+            return NO_SELECTION;
     }
     else // Simple case when we directly have the selected items.
     {
-        if ( cookie >= m_itemsSel.size() )
+        if ( n == m_ranges.size() )
             return NO_SELECTION;
 
-        return m_itemsSel[cookie++];
+        item = wxMax(item, m_ranges[n].from);
     }
+
+    cookie = item + 1;
+
+    return item;
 }
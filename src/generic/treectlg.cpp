@@ -135,6 +135,37 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxTreeFindTimer);
 };
 
+// number of rows taken by the children of an expanded item of a virtual tree
+//
+// This is a Fenwick (binary indexed) tree storing the number of rows of each
+// child, which allows to find the row of a child, the child at the given row
+// and update the number of rows of a single child in O(log N).
+class wxTreeChildrenRows
+{
+public:
+    wxTreeChildrenRows() { }
+
+    // (re)build the index for the given children and return the total number
+    // of rows taken by them
+    unsigned int Build(const wxArrayGenericTreeItems& children);
+
+    // return the number of rows taken by the children in [0, n) range
+    unsigned int GetRowsBefore(size_t n) const;
+
+    // change the number of rows taken by the given child
+    void AddRows(size_t n, int delta);
+
+    // return the index of the child containing the given row, counted from
+    // the first row of the first child, and make the row relative to it
+    size_t FindChild(unsigned int& row) const;
+
+private:
+    // the tree itself, using 1-based indices, so its element 0 is unused
+    wxVector<unsigned int> m_tree;
+
+    wxDECLARE_NO_COPY_CLASS(wxTreeChildrenRows);
+};
+
 // a tree item
 class WXDLLEXPORT wxGenericTreeItem
 {
@@ -143,6 +174,7 @@ public:
     wxGenericTreeItem()
     {
         m_data = NULL;
+        m_childrenRows = NULL;
         m_widthText =
         m_heightText = -1;
     }
@@ -247,6 +279,31 @@ public:
     void Insert(wxGenericTreeItem *child, size_t index)
         { m_children.Insert(child, index); }
 
+    // get the number of rows taken by this item and all its shown descendants
+    // (only used in virtual mode, in which the children array may contain
+    // NULL entries for the items which haven't been created yet, each of them
+    // taking exactly one row)
+    unsigned int GetRowCount();
+
+    // get the number of rows taken by the children before the given one, or
+    // 0 if this item is collapsed
+    unsigned int GetChildrenRowsBefore(size_t index);
+
+    // get the index of the child containing the given row of an expanded
+    // item, counted from the first row of its first child, and make the row
+    // relative to this child
+    size_t FindChildAtRow(unsigned int& row);
+
+    // must be called after the number of rows under this item changes, i.e.
+    // after expanding or collapsing it or reloading its children, updates the
+    // row counts of its parents too
+    void UpdateRowCount();
+
+    // index of this item in its parent children array, only used in virtual
+    // mode, in which the children are never inserted nor removed
+    size_t GetIndexInParent() const { return m_indexInParent; }
+    void SetIndexInParent(size_t index) { m_indexInParent = index; }
+
     // calculate and cache the item size using either the provided DC (which is
     // supposed to have wxGenericTreeCtrl::m_normalFont selected into it!) or a
     // wxClientDC on the control window
@@ -269,6 +326,12 @@ public:
                                 int &flags,
                                 int level );
 
+        // return this item if the given position is inside it, without
+        // checking its children, or NULL otherwise
+    wxGenericTreeItem *HitTestItem( const wxPoint& point,
+                                    const wxGenericTreeCtrl *,
+                                    int &flags );
+
     void Expand() { m_isCollapsed = false; }
     void Collapse() { m_isCollapsed = true; }
 
@@ -347,6 +410,13 @@ private:
     int                 m_width;        // width of this item
     int                 m_height;       // height of this item
 
+    unsigned int        m_rowCount;     // see GetRowCount(), 0 if unknown
+    size_t              m_indexInParent; // see GetIndexInParent()
+
+    // rows taken by the children, valid if the item is expanded and its row
+    // count is known, may be NULL if it has never been computed
+    wxTreeChildrenRows *m_childrenRows;
+
     // use bitfields to save size
     unsigned int        m_isCollapsed :1;
     unsigned int        m_hasHilight  :1; // same as focused
@@ -591,6 +661,9 @@ wxGenericTreeItem::wxGenericTreeItem(wxGenericTreeItem *parent,
     m_data = data;
     m_state = wxTREE_ITEMSTATE_NONE;
     m_x = m_y = 0;
+    m_rowCount = 0;
+    m_indexInParent = 0;
+    m_childrenRows = NULL;
 
     m_isCollapsed = true;
     m_hasHilight = false;
@@ -613,6 +686,7 @@ wxGenericTreeItem::wxGenericTreeItem(wxGenericTreeItem *parent,
 wxGenericTreeItem::~wxGenericTreeItem()
 {
     delete m_data;
+    delete m_childrenRows;
 
     if (m_ownsAttr) delete m_attr;
 
@@ -626,6 +700,12 @@ void wxGenericTreeItem::DeleteChildren(wxGenericTreeCtrl *tree)
     for ( size_t n = 0; n < count; n++ )
     {
         wxGenericTreeItem *child = m_children[n];
+        if ( !child )
+        {
+            // item of a virtual control which had never been created
+            continue;
+        }
+
         tree->SendDeleteEvent(child);
 
         child->DeleteChildren(tree);
@@ -646,7 +726,8 @@ size_t wxGenericTreeItem::GetChildrenCount(bool recursively) const
     size_t total = count;
     for (size_t n = 0; n < count; ++n)
     {
-        total += m_children[n]->GetChildrenCount();
+        if ( m_children[n] )
+            total += m_children[n]->GetChildrenCount();
     }
 
     return total;
@@ -665,7 +746,8 @@ void wxGenericTreeItem::GetSize( int &x, int &y,
         size_t count = m_children.GetCount();
         for ( size_t n = 0; n < count; ++n )
         {
-            m_children[n]->GetSize( x, y, theButton );
+            if ( m_children[n] )
+                m_children[n]->GetSize( x, y, theButton );
         }
     }
 }
@@ -678,81 +760,9 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
     // for a hidden root node, don't evaluate it, but do evaluate children
     if ( !(level == 0 && theCtrl->HasFlag(wxTR_HIDE_ROOT)) )
     {
-        // evaluate the item
-        int h = theCtrl->GetLineHeight(this);
-        if ((point.y > m_y) && (point.y < m_y + h))
-        {
-            int y_mid = m_y + h/2;
-            if (point.y < y_mid )
-                flags |= wxTREE_HITTEST_ONITEMUPPERPART;
-            else
-                flags |= wxTREE_HITTEST_ONITEMLOWERPART;
-
-            int xCross = m_x - theCtrl->GetSpacing();
-#ifdef __WXMAC__
-            // according to the drawing code the triangels are drawn
-            // at -4 , -4  from the position up to +10/+10 max
-            const int triangleStart = theCtrl->FromDIP(4);
-            const int triangleEnd = theCtrl->FromDIP(10);
-            if ((point.x > xCross - triangleStart) && (point.x < xCross + triangleEnd) &&
-                (point.y > y_mid - triangleStart) && (point.y < y_mid + triangleEnd) &&
-                HasPlus() && theCtrl->HasButtons() )
-#else
-            // 5 is the size of the plus sign
-            const int plusSize = 1 + theCtrl->FromDIP(5);
-            if ((point.x > xCross - plusSize) && (point.x < xCross + plusSize) &&
-                (point.y > y_mid - plusSize) && (point.y < y_mid + plusSize) &&
-                HasPlus() && theCtrl->HasButtons() )
-#endif
-            {
-                flags |= wxTREE_HITTEST_ONITEMBUTTON;
-                return this;
-            }
-
-            if ((point.x >= m_x) && (point.x <= m_x+m_width))
-            {
-                int image_w = -1;
-
-                // assuming every image (normal and selected) has the same size!
-                if ( (GetImage() != NO_IMAGE) && theCtrl->m_imageListNormal )
-                {
-                    int image_h;
-                    theCtrl->m_imageListNormal->GetSize(GetImage(),
-                                                        image_w, image_h);
-                }
-
-                int state_w = -1;
-
-                if ( (GetState() != wxTREE_ITEMSTATE_NONE) &&
-                        theCtrl->m_imageListState )
-                {
-                    int state_h;
-                    theCtrl->m_imageListState->GetSize(GetState(),
-                                                       state_w, state_h);
-                }
-
-                if ((state_w != -1) && (point.x <= m_x + state_w + 1))
-                    flags |= wxTREE_HITTEST_ONITEMSTATEICON;
-                else if ((image_w != -1) &&
-                         (point.x <= m_x +
-                            (state_w != -1 ? state_w +
-                                                MARGIN_BETWEEN_STATE_AND_IMAGE
-                                           : 0)
-                                            + image_w + 1))
-                    flags |= wxTREE_HITTEST_ONITEMICON;
-                else
-                    flags |= wxTREE_HITTEST_ONITEMLABEL;
-
-                return this;
-            }
-
-            if (point.x < m_x)
-                flags |= wxTREE_HITTEST_ONITEMINDENT;
-            if (point.x > m_x+m_width)
-                flags |= wxTREE_HITTEST_ONITEMRIGHT;
-
-            return this;
-        }
+        wxGenericTreeItem * const res = HitTestItem(point, theCtrl, flags);
+        if ( res )
+            return res;
 
         // if children are expanded, fall through to evaluate them
         if (m_isCollapsed) return NULL;
@@ -762,6 +772,9 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
     size_t count = m_children.GetCount();
     for ( size_t n = 0; n < count; n++ )
     {
+        if ( !m_children[n] )
+            continue;
+
         wxGenericTreeItem *res = m_children[n]->HitTest( point,
                                                          theCtrl,
                                                          flags,
@@ -773,6 +786,89 @@ wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
     return NULL;
 }
 
+wxGenericTreeItem *wxGenericTreeItem::HitTestItem(const wxPoint& point,
+                                                  const wxGenericTreeCtrl *theCtrl,
+                                                  int &flags)
+{
+    // evaluate the item
+    int h = theCtrl->GetLineHeight(this);
+    if ((point.y > m_y) && (point.y < m_y + h))
+    {
+        int y_mid = m_y + h/2;
+        if (point.y < y_mid )
+            flags |= wxTREE_HITTEST_ONITEMUPPERPART;
+        else
+            flags |= wxTREE_HITTEST_ONITEMLOWERPART;
+
+        int xCross = m_x - theCtrl->GetSpacing();
+#ifdef __WXMAC__
+        // according to the drawing code the triangels are drawn
+        // at -4 , -4  from the position up to +10/+10 max
+        const int triangleStart = theCtrl->FromDIP(4);
+        const int triangleEnd = theCtrl->FromDIP(10);
+        if ((point.x > xCross - triangleStart) && (point.x < xCross + triangleEnd) &&
+            (point.y > y_mid - triangleStart) && (point.y < y_mid + triangleEnd) &&
+            HasPlus() && theCtrl->HasButtons() )
+#else
+        // 5 is the size of the plus sign
+        const int plusSize = 1 + theCtrl->FromDIP(5);
+        if ((point.x > xCross - plusSize) && (point.x < xCross + plusSize) &&
+            (point.y > y_mid - plusSize) && (point.y < y_mid + plusSize) &&
+            HasPlus() && theCtrl->HasButtons() )
+#endif
+        {
+            flags |= wxTREE_HITTEST_ONITEMBUTTON;
+            return this;
+        }
+
+        if ((point.x >= m_x) && (point.x <= m_x+m_width))
+        {
+            int image_w = -1;
+
+            // assuming every image (normal and selected) has the same size!
+            if ( (GetImage() != NO_IMAGE) && theCtrl->m_imageListNormal )
+            {
+                int image_h;
+                theCtrl->m_imageListNormal->GetSize(GetImage(),
+                                                    image_w, image_h);
+            }
+
+            int state_w = -1;
+
+            if ( (GetState() != wxTREE_ITEMSTATE_NONE) &&
+                    theCtrl->m_imageListState )
+            {
+                int state_h;
+                theCtrl->m_imageListState->GetSize(GetState(),
+                                                   state_w, state_h);
+            }
+
+            if ((state_w != -1) && (point.x <= m_x + state_w + 1))
+                flags |= wxTREE_HITTEST_ONITEMSTATEICON;
+            else if ((image_w != -1) &&
+                     (point.x <= m_x +
+                        (state_w != -1 ? state_w +
+                                            MARGIN_BETWEEN_STATE_AND_IMAGE
+                                       : 0)
+                                        + image_w + 1))
+                flags |= wxTREE_HITTEST_ONITEMICON;
+            else
+                flags |= wxTREE_HITTEST_ONITEMLABEL;
+
+            return this;
+        }
+
+        if (point.x < m_x)
+            flags |= wxTREE_HITTEST_ONITEMINDENT;
+        if (point.x > m_x+m_width)
+            flags |= wxTREE_HITTEST_ONITEMRIGHT;
+
+        return this;
+    }
+
+    return NULL;
+}
+
 int wxGenericTreeItem::GetCurrentImage() const
 {
     int image = NO_IMAGE;
@@ -889,7 +985,10 @@ void wxGenericTreeItem::RecursiveResetSize()
 
     const size_t count = m_children.Count();
     for (size_t i = 0; i < count; i++ )
-        m_children[i]->RecursiveResetSize();
+    {
+        if ( m_children[i] )
+            m_children[i]->RecursiveResetSize();
+    }
 }
 
 void wxGenericTreeItem::RecursiveResetTextSize()
@@ -899,7 +998,138 @@ void wxGenericTreeItem::RecursiveResetTextSize()
 
     const size_t count = m_children.Count();
     for (size_t i = 0; i < count; i++ )
-        m_children[i]->RecursiveResetTextSize();
+    {
+        if ( m_children[i] )
+            m_children[i]->RecursiveResetTextSize();
+    }
+}
+
+unsigned int wxGenericTreeItem::GetRowCount()
+{
+    if ( !m_rowCount )
+    {
+        m_rowCount = 1;
+
+        if ( IsExpanded() )
+        {
+            if ( !m_childrenRows )
+                m_childrenRows = new wxTreeChildrenRows;
+
+            m_rowCount += m_childrenRows->Build(m_children);
+        }
+    }
+
+    return m_rowCount;
+}
+
+unsigned int wxGenericTreeItem::GetChildrenRowsBefore(size_t index)
+{
+    // the children of a collapsed item are not shown at all
+    if ( GetRowCount() == 1 )
+        return 0;
+
+    return m_childrenRows->GetRowsBefore(index);
+}
+
+size_t wxGenericTreeItem::FindChildAtRow(unsigned int& row)
+{
+    wxASSERT_MSG( row + 1 < GetRowCount(), "invalid row" );
+
+    return m_childrenRows->FindChild(row);
+}
+
+void wxGenericTreeItem::UpdateRowCount()
+{
+    // if the count hadn't been computed yet, the item must have been created
+    // after its parent count was, which means that it was collapsed then and
+    // took a single row
+    const unsigned int oldCount = m_rowCount ? m_rowCount : 1;
+
+    m_rowCount = 0;
+    const int delta = static_cast<int>(GetRowCount()) -
+                        static_cast<int>(oldCount);
+    if ( !delta )
+        return;
+
+    // update the counts of all our parents, stopping at the first one whose
+    // count is not affected because it's collapsed or hasn't been computed
+    // yet (and then neither have been the counts of its own parents)
+    wxGenericTreeItem *child = this;
+    for ( wxGenericTreeItem *parent = m_parent;
+          parent && parent->m_rowCount && parent->IsExpanded();
+          child = parent, parent = parent->m_parent )
+    {
+        parent->m_rowCount += delta;
+        parent->m_childrenRows->AddRows(child->m_indexInParent, delta);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// wxTreeChildrenRows
+// -----------------------------------------------------------------------------
+
+unsigned int wxTreeChildrenRows::Build(const wxArrayGenericTreeItems& children)
+{
+    const size_t count = children.GetCount();
+    m_tree.assign(count + 1, 0);
+
+    // build the tree in linear time by propagating each node into its parent
+    unsigned int total = 0;
+    for ( size_t n = 1; n <= count; ++n )
+    {
+        wxGenericTreeItem * const child = children[n - 1];
+        const unsigned int rows = child ? child->GetRowCount() : 1;
+
+        total += rows;
+        m_tree[n] += rows;
+
+        const size_t parent = n + (n & (~n + 1));
+        if ( parent <= count )
+            m_tree[parent] += m_tree[n];
+    }
+
+    return total;
+}
+
+unsigned int wxTreeChildrenRows::GetRowsBefore(size_t n) const
+{
+    unsigned int rows = 0;
+    for ( ; n; n &= n - 1 )
+        rows += m_tree[n];
+
+    return rows;
+}
+
+void wxTreeChildrenRows::AddRows(size_t n, int delta)
+{
+    const size_t count = m_tree.size() - 1;
+    for ( ++n; n <= count; n += n & (~n + 1) )
+        m_tree[n] += delta;
+}
+
+size_t wxTreeChildrenRows::FindChild(unsigned int& row) const
+{
+    const size_t count = m_tree.size() - 1;
+
+    size_t step = 1;
+    while ( step <= count / 2 )
+        step <<= 1;
+
+    // descend the tree, advancing while the row is after the end of the
+    // children before the next candidate, which works because each child
+    // takes at least one row
+    size_t n = 0;
+    for ( ; step; step >>= 1 )
+    {
+        const size_t next = n + step;
+        if ( next <= count && m_tree[next] <= row )
+        {
+            n = next;
+            row -= m_tree[next];
+        }
+    }
+
+    return n;
 }
 
 // -----------------------------------------------------------------------------
@@ -975,6 +1205,8 @@ void wxGenericTreeCtrl::Init()
 
     m_lastOnSame = false;
 
+    m_virtualWidth = 0;
+
 #if defined( __WXMAC__ )
     m_normalFont = wxFont(wxOSX_SYSTEM_FONT_VIEWS);
 #else
@@ -1015,6 +1247,11 @@ bool wxGenericTreeCtrl::Create(wxWindow *parent,
     m_dottedPen = wxPen(wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT),
                         1, wxPENSTYLE_DOT);
 
+    // in virtual mode the line height must be known before any items are
+    // created as it determines their positions
+    if ( IsVirtual() )
+        CalculateLineHeight();
+
     SetInitialSize(size);
 
     return true;
@@ -1082,8 +1319,12 @@ void wxGenericTreeCtrl::SetWindowStyleFlag(long styles)
     if (m_anchor && !HasFlag(wxTR_HIDE_ROOT) && (styles & wxTR_HIDE_ROOT))
     {
         // if we will hide the root, make sure children are visible
+        if ( IsVirtual() )
+            LoadVirtualChildren(m_anchor);
         m_anchor->SetHasPlus();
         m_anchor->Expand();
+        if ( IsVirtual() )
+            m_anchor->UpdateRowCount();
         CalculatePositions();
     }
 
@@ -1394,7 +1635,7 @@ wxTreeItemId wxGenericTreeCtrl::GetNextChild(const wxTreeItemId& item,
     size_t *pIndex = (size_t *)&cookie;
     if ( *pIndex < children.GetCount() )
     {
-        return children.Item((*pIndex)++);
+        return DoGetChild((wxGenericTreeItem*) item.m_pItem, (*pIndex)++);
     }
     else
     {
@@ -1409,7 +1650,10 @@ wxTreeItemId wxGenericTreeCtrl::GetLastChild(const wxTreeItemId& item) const
 
     wxArrayGenericTreeItems&
         children = ((wxGenericTreeItem*) item.m_pItem)->GetChildren();
-    return children.IsEmpty() ? wxTreeItemId() : wxTreeItemId(children.Last());
+    return children.IsEmpty() ? wxTreeItemId()
+                              : wxTreeItemId(DoGetChild((wxGenericTreeItem*)
+                                                            item.m_pItem,
+                                                        children.size() - 1));
 }
 
 wxTreeItemId wxGenericTreeCtrl::GetNextSibling(const wxTreeItemId& item) const
@@ -1430,7 +1674,7 @@ wxTreeItemId wxGenericTreeCtrl::GetNextSibling(const wxTreeItemId& item) const
 
     size_t n = (size_t)(index + 1);
     return n == siblings.GetCount() ? wxTreeItemId()
-                                    : wxTreeItemId(siblings[n]);
+                                    : wxTreeItemId(DoGetChild(parent, n));
 }
 
 wxTreeItemId wxGenericTreeCtrl::GetPrevSibling(const wxTreeItemId& item) const
@@ -1450,7 +1694,7 @@ wxTreeItemId wxGenericTreeCtrl::GetPrevSibling(const wxTreeItemId& item) const
     wxASSERT( index != wxNOT_FOUND ); // I'm not a child of my parent?
 
     return index == 0 ? wxTreeItemId()
-                      : wxTreeItemId(siblings[(size_t)(index - 1)]);
+                      : wxTreeItemId(DoGetChild(parent, (size_t)(index - 1)));
 }
 
 // Only for internal use right now, but should probably be public
@@ -1464,7 +1708,7 @@ wxTreeItemId wxGenericTreeCtrl::GetNext(const wxTreeItemId& item) const
     wxArrayGenericTreeItems& children = i->GetChildren();
     if (children.GetCount() > 0)
     {
-         return children.Item(0);
+         return DoGetChild(i, 0);
     }
     else
     {
@@ -1549,6 +1793,157 @@ wxTreeItemId wxGenericTreeCtrl::GetPrevVisible(const wxTreeItemId& item) const
     return prevItem;
 }
 
+// -----------------------------------------------------------------------------
+// virtual mode
+// -----------------------------------------------------------------------------
+
+size_t
+wxGenericTreeCtrl::OnGetChildrenCount(const wxTreeItemId& WXUNUSED(item)) const
+{
+    // this is a pure virtual function, in fact - which is not really pure
+    // because the controls which are not virtual don't need to implement it
+    wxFAIL_MSG("wxGenericTreeCtrl::OnGetChildrenCount not supposed to be called");
+
+    return 0;
+}
+
+wxString
+wxGenericTreeCtrl::OnGetItemText(const wxTreeItemId& WXUNUSED(parent),
+                                 size_t WXUNUSED(n)) const
+{
+    // this is a pure virtual function, in fact - which is not really pure
+    // because the controls which are not virtual don't need to implement it
+    wxFAIL_MSG("wxGenericTreeCtrl::OnGetItemText not supposed to be called");
+
+    return wxEmptyString;
+}
+
+int
+wxGenericTreeCtrl::OnGetItemImage(const wxTreeItemId& WXUNUSED(parent),
+                                  size_t WXUNUSED(n)) const
+{
+    wxCHECK_MSG(!GetImageList(),
+                NO_IMAGE,
+                "Tree control has an image list, OnGetItemImage should be overridden.");
+    return NO_IMAGE;
+}
+
+wxTreeItemData *
+wxGenericTreeCtrl::OnGetItemData(const wxTreeItemId& WXUNUSED(parent),
+                                 size_t WXUNUSED(n)) const
+{
+    return NULL;
+}
+
+void wxGenericTreeCtrl::LoadVirtualChildren(wxGenericTreeItem *item)
+{
+    wxArrayGenericTreeItems& children = item->GetChildren();
+    if ( !children.IsEmpty() )
+        return;
+
+    // don't create the items themselves yet, this will be done by DoGetChild()
+    // when they're really needed, typically because they become visible
+    const size_t count = OnGetChildrenCount(item);
+    children.SetCount(count);
+    item->SetHasPlus(count != 0);
+}
+
+wxGenericTreeItem *
+wxGenericTreeCtrl::DoGetChild(wxGenericTreeItem *parent, size_t n) const
+{
+    wxGenericTreeItem *child = parent->GetChildren()[n];
+    if ( !child )
+    {
+        wxTreeItemData * const data = OnGetItemData(parent, n);
+
+        child = new wxGenericTreeItem(parent,
+                                      OnGetItemText(parent, n),
+                                      OnGetItemImage(parent, n), NO_IMAGE,
+                                      data);
+        if ( data != NULL )
+        {
+            data->m_pItem = child;
+        }
+
+        parent->GetChildren()[n] = child;
+        child->SetIndexInParent(n);
+
+        // the children themselves are only created when the item is expanded
+        child->SetHasPlus(OnGetChildrenCount(child) != 0);
+    }
+
+    return child;
+}
+
+unsigned int wxGenericTreeCtrl::GetVirtualRow(wxGenericTreeItem *item) const
+{
+    unsigned int row = 0;
+    for ( wxGenericTreeItem *parent = item->GetParent();
+          parent;
+          item = parent, parent = parent->GetParent() )
+    {
+        // count the parent itself and all the siblings above this item
+        row++;
+        row += parent->GetChildrenRowsBefore(item->GetIndexInParent());
+    }
+
+    return row;
+}
+
+wxGenericTreeItem *
+wxGenericTreeCtrl::GetVirtualItemAtRow(unsigned int row,
+                                       wxVector<size_t> *path) const
+{
+    if ( path )
+        path->clear();
+
+    wxGenericTreeItem *item = m_anchor;
+    if ( !item || row >= item->GetRowCount() )
+        return NULL;
+
+    while ( row )
+    {
+        // skip the item itself, the row is then necessarily one of its
+        // children rows because it's less than the item row count
+        row--;
+
+        const size_t n = item->FindChildAtRow(row);
+
+        if ( path )
+            path->push_back(n);
+
+        item = DoGetChild(item, n);
+    }
+
+    return item;
+}
+
+void wxGenericTreeCtrl::CalculateItemPosition(wxGenericTreeItem *item) const
+{
+    if ( !IsVirtual() )
+        return;
+
+    int level = 0;
+    for ( wxGenericTreeItem *parent = item->GetParent();
+          parent;
+          parent = parent->GetParent() )
+    {
+        level++;
+    }
+
+    int x = level*m_indent;
+    if ( !HasFlag(wxTR_HIDE_ROOT) )
+        x += m_indent;
+
+    int row = GetVirtualRow(item);
+    if ( HasFlag(wxTR_HIDE_ROOT) )
+        row--;
+
+    item->SetX(x + m_spacing);
+    item->SetY(2 + row*m_lineHeight);
+    item->CalculateSize(const_cast<wxGenericTreeCtrl *>(this));
+}
+
 // called by wxTextTreeCtrl when it marks itself for deletion
 void wxGenericTreeCtrl::ResetTextControl()
 {
@@ -1633,6 +2028,9 @@ wxTreeItemId wxGenericTreeCtrl::DoInsertItem(const wxTreeItemId& parentId,
         return AddRoot(text, image, selImage, data);
     }
 
+    wxCHECK_MSG( !IsVirtual(), wxTreeItemId(),
+                 "can't insert items into a virtual tree control" );
+
     m_dirty = true;     // do this first so stuff below doesn't cause flicker
 
     wxGenericTreeItem *item =
@@ -1670,10 +2068,16 @@ wxTreeItemId wxGenericTreeCtrl::AddRoot(const wxString& text,
     {
         // if root is hidden, make sure we can navigate
         // into children
+        if ( IsVirtual() )
+            LoadVirtualChildren(m_anchor);
         m_anchor->SetHasPlus();
         m_anchor->Expand();
         CalculatePositions();
     }
+    else if ( IsVirtual() )
+    {
+        m_anchor->SetHasPlus(OnGetChildrenCount(m_anchor) != 0);
+    }
 
     if (!HasFlag(wxTR_MULTIPLE))
     {
@@ -1755,15 +2159,33 @@ void wxGenericTreeCtrl::DeleteChildren(const wxTreeItemId& itemId)
     wxGenericTreeItem *item = (wxGenericTreeItem*) itemId.m_pItem;
     ChildrenClosing(item);
     item->DeleteChildren(this);
+
+    if ( IsVirtual() )
+    {
+        // the children of an expanded item must be always loaded, so reload
+        // them, which allows to use this function to update the items after
+        // the data they represent changes
+        if ( item->IsExpanded() )
+            LoadVirtualChildren(item);
+        else
+            item->SetHasPlus(OnGetChildrenCount(item) != 0);
+
+        item->UpdateRowCount();
+    }
+
     InvalidateBestSize();
 }
 
 void wxGenericTreeCtrl::Delete(const wxTreeItemId& itemId)
 {
-    m_dirty = true;     // do this first so stuff below doesn't cause flicker
-
     wxGenericTreeItem *item = (wxGenericTreeItem*) itemId.m_pItem;
 
+    wxCHECK_RET( !IsVirtual() || item == m_anchor,
+                 "can't delete items of a virtual tree control, "
+                 "use DeleteChildren() to update them instead" );
+
+    m_dirty = true;     // do this first so stuff below doesn't cause flicker
+
     if (m_textCtrl != NULL && IsDescendantOf(item, m_textCtrl->item()))
     {
         // can't delete the item being edited, cancel editing it first
@@ -1840,6 +2262,8 @@ void wxGenericTreeCtrl::DeleteAllItems()
     {
         Delete(m_anchor);
     }
+
+    m_virtualWidth = 0;
 }
 
 void wxGenericTreeCtrl::Expand(const wxTreeItemId& itemId)
@@ -1864,7 +2288,12 @@ void wxGenericTreeCtrl::Expand(const wxTreeItemId& itemId)
         return;
     }
 
+    if ( IsVirtual() )
+        LoadVirtualChildren(item);
+
     item->Expand();
+    if ( IsVirtual() )
+        item->UpdateRowCount();
     if ( !IsFrozen() )
     {
         CalculatePositions();
@@ -1907,6 +2336,8 @@ void wxGenericTreeCtrl::Collapse(const wxTreeItemId& itemId)
 
     ChildrenClosing(item);
     item->Collapse();
+    if ( IsVirtual() )
+        item->UpdateRowCount();
 
 #if 0  // TODO why should items be collapsed recursively?
     wxArrayGenericTreeItems& children = item->GetChildren();
@@ -1983,7 +2414,8 @@ void wxGenericTreeCtrl::UnselectAllChildren(wxGenericTreeItem *item)
         size_t count = children.GetCount();
         for ( size_t n = 0; n < count; ++n )
         {
-            UnselectAllChildren(children[n]);
+            if ( children[n] )
+                UnselectAllChildren(children[n]);
         }
     }
 }
@@ -2015,7 +2447,7 @@ void wxGenericTreeCtrl::SelectChildren(const wxTreeItemId& parent)
     size_t count = children.GetCount();
 
     wxGenericTreeItem *
-        item = (wxGenericTreeItem*) ((wxTreeItemId)children[0]).m_pItem;
+        item = DoGetChild((wxGenericTreeItem*) parent.m_pItem, 0);
     wxTreeEvent event(wxEVT_TREE_SEL_CHANGING, this, item);
     event.m_itemOld = m_current;
 
@@ -2024,7 +2456,8 @@ void wxGenericTreeCtrl::SelectChildren(const wxTreeItemId& parent)
 
     for ( size_t n = 0; n < count; ++n )
     {
-        m_current = m_key_current = children[n];
+        m_current = m_key_current =
+            DoGetChild((wxGenericTreeItem*) parent.m_pItem, n);
         m_current->SetHilight(true);
         RefreshSelected();
     }
@@ -2058,7 +2491,7 @@ wxGenericTreeCtrl::TagNextChildren(wxGenericTreeItem *crt_item,
     size_t count = children.GetCount();
     for (size_t n=(size_t)(index+1); n<count; ++n)
     {
-        if ( TagAllChildrenUntilLast(children[n], last_item, select) )
+        if ( TagAllChildrenUntilLast(DoGetChild(parent, n), last_item, select) )
             return true;
     }
 
@@ -2083,7 +2516,8 @@ wxGenericTreeCtrl::TagAllChildrenUntilLast(wxGenericTreeItem *crt_item,
         size_t count = children.GetCount();
         for ( size_t n = 0; n < count; ++n )
         {
-            if (TagAllChildrenUntilLast(children[n], last_item, select))
+            if (TagAllChildrenUntilLast(DoGetChild(crt_item, n),
+                                        last_item, select))
                 return true;
         }
     }
@@ -2099,6 +2533,8 @@ wxGenericTreeCtrl::SelectItemRange(wxGenericTreeItem *item1,
 
     // item2 is not necessary after item1
     // choice first' and 'last' between item1 and item2
+    CalculateItemPosition(item1);
+    CalculateItemPosition(item2);
     wxGenericTreeItem *first= (item1->GetY()<item2->GetY()) ? item1 : item2;
     wxGenericTreeItem *last = (item1->GetY()<item2->GetY()) ? item2 : item1;
 
@@ -2233,7 +2669,10 @@ void wxGenericTreeCtrl::FillArray(wxGenericTreeItem *item,
         wxArrayGenericTreeItems& children = item->GetChildren();
         size_t count = children.GetCount();
         for ( size_t n = 0; n < count; ++n )
-            FillArray(children[n], array);
+        {
+            if ( children[n] )
+                FillArray(children[n], array);
+        }
     }
 }
 
@@ -2303,6 +2742,7 @@ void wxGenericTreeCtrl::ScrollTo(const wxTreeItemId &item)
 
     wxGenericTreeItem *gitem = (wxGenericTreeItem*) item.m_pItem;
 
+    CalculateItemPosition(gitem);
     int itemY = gitem->GetY();
 
     int start_x = 0;
@@ -2354,6 +2794,8 @@ void wxGenericTreeCtrl::SortChildren(const wxTreeItemId& itemId)
     wxCHECK_RET( !s_treeBeingSorted,
                  wxT("wxGenericTreeCtrl::SortChildren is not reentrant") );
 
+    wxCHECK_RET( !IsVirtual(), "can't sort items of a virtual tree control" );
+
     wxArrayGenericTreeItems& children = item->GetChildren();
     if ( children.GetCount() > 1 )
     {
@@ -2479,7 +2921,19 @@ void wxGenericTreeCtrl::AdjustMyScrollbars()
     if (m_anchor)
     {
         int x = 0, y = 0;
-        m_anchor->GetSize( x, y, this );
+        if ( IsVirtual() )
+        {
+            unsigned int rows = m_anchor->GetRowCount();
+            if ( HasFlag(wxTR_HIDE_ROOT) )
+                rows--;
+
+            x = m_virtualWidth;
+            y = 2 + rows*m_lineHeight;
+        }
+        else
+        {
+            m_anchor->GetSize( x, y, this );
+        }
         y += PIXELS_PER_UNIT+2; // one more scrollbar unit + 2 pixels
         x += PIXELS_PER_UNIT+2; // one more scrollbar unit + 2 pixels
         int x_pos = GetScrollPos( wxHORIZONTAL );
@@ -2496,7 +2950,9 @@ void wxGenericTreeCtrl::AdjustMyScrollbars()
 
 int wxGenericTreeCtrl::GetLineHeight(wxGenericTreeItem *item) const
 {
-    if (GetWindowStyleFlag() & wxTR_HAS_VARIABLE_ROW_HEIGHT)
+    // all rows have the same height in virtual mode as we couldn't find the
+    // position of an item without creating all the items above it otherwise
+    if ( HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) && !IsVirtual() )
         return item->GetHeight();
     else
         return m_lineHeight;
@@ -2717,6 +3173,122 @@ void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
     }
 }
 
+void wxGenericTreeCtrl::PaintRow(wxGenericTreeItem *item,
+                                 wxDC& dc,
+                                 int x,
+                                 int y_top)
+{
+    int h = GetLineHeight(item);
+    int y_mid = y_top + (h>>1);
+    int y = y_top + h;
+
+    const wxPen *pen =
+#ifndef __WXMAC__
+        // don't draw rect outline if we already have the
+        // background color under Mac
+        (item->IsSelected() && m_hasFocus) ? wxBLACK_PEN :
+#endif // !__WXMAC__
+        wxTRANSPARENT_PEN;
+
+    wxColour colText;
+    if ( item->IsSelected() )
+    {
+#ifdef __WXMAC__
+        colText = *wxWHITE;
+#else
+        if (m_hasFocus)
+            colText = wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHTTEXT);
+        else
+            colText = wxSystemSettings::GetColour(wxSYS_COLOUR_LISTBOXHIGHLIGHTTEXT);
+#endif
+    }
+    else
+    {
+        wxItemAttr *attr = item->GetAttributes();
+        if (attr && attr->HasTextColour())
+            colText = attr->GetTextColour();
+        else
+            colText = GetForegroundColour();
+    }
+
+    // prepare to draw
+    dc.SetTextForeground(colText);
+    dc.SetPen(*pen);
+
+    // draw
+    PaintItem(item, dc);
+
+    if (HasFlag(wxTR_ROW_LINES))
+    {
+        // if the background colour is white, choose a
+        // contrasting color for the lines
+        dc.SetPen(*((GetBackgroundColour() == *wxWHITE)
+                     ? wxMEDIUM_GREY_PEN : wxWHITE_PEN));
+        dc.DrawLine(0, y_top, 10000, y_top);
+        dc.DrawLine(0, y, 10000, y);
+    }
+
+    // restore DC objects
+    dc.SetBrush(*wxWHITE_BRUSH);
+    dc.SetPen(m_dottedPen);
+    dc.SetTextForeground(*wxBLACK);
+
+    if ( !HasFlag(wxTR_NO_LINES) )
+    {
+        // draw the horizontal line here
+        int x_start = x;
+        if (x > (signed)m_indent)
+            x_start -= m_indent;
+        else if (HasFlag(wxTR_LINES_AT_ROOT))
+            x_start = 3;
+        dc.DrawLine(x_start, y_mid, x + m_spacing, y_mid);
+    }
+
+    // should the item show a button?
+    if ( item->HasPlus() && HasButtons() )
+    {
+        if ( m_imageListButtons )
+        {
+            // draw the image button here
+            int image_h = 0,
+                image_w = 0;
+            int image = item->IsExpanded() ? wxTreeItemIcon_Expanded
+                                           : wxTreeItemIcon_Normal;
+            if ( item->IsSelected() )
+                image += wxTreeItemIcon_Selected - wxTreeItemIcon_Normal;
+
+            m_imageListButtons->GetSize(image, image_w, image_h);
+            int xx = x - image_w/2;
+            int yy = y_mid - image_h/2;
+
+            wxDCClipper clip(dc, xx, yy, image_w, image_h);
+            m_imageListButtons->Draw(image, dc, xx, yy,
+                                     wxIMAGELIST_DRAW_TRANSPARENT);
+        }
+        else // no custom buttons
+        {
+            const int wImage = FromDIP(9);
+            const int hImage = FromDIP(9);
+
+            int flag = 0;
+            if (item->IsExpanded())
+                flag |= wxCONTROL_EXPANDED;
+            if (item == m_underMouse)
+                flag |= wxCONTROL_CURRENT;
+
+            wxRendererNative::Get().DrawTreeItemButton
+                                    (
+                                        this,
+                                        dc,
+                                        wxRect(x - wImage/2,
+                                               y_mid - hImage/2,
+                                               wImage, hImage),
+                                        flag
+                                    );
+        }
+    }
+}
+
 void
 wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
                               wxDC &dc,
@@ -2766,113 +3338,7 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
     int exposed_y = dc.LogicalToDeviceY(y_top);
 
     if (IsExposed(exposed_x, exposed_y, 10000, h))  // 10000 = very much
-    {
-        const wxPen *pen =
-#ifndef __WXMAC__
-            // don't draw rect outline if we already have the
-            // background color under Mac
-            (item->IsSelected() && m_hasFocus) ? wxBLACK_PEN :
-#endif // !__WXMAC__
-            wxTRANSPARENT_PEN;
-
-        wxColour colText;
-        if ( item->IsSelected() )
-        {
-#ifdef __WXMAC__
-            colText = *wxWHITE;
-#else
-            if (m_hasFocus)
-                colText = wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHTTEXT);
-            else
-                colText = wxSystemSettings::GetColour(wxSYS_COLOUR_LISTBOXHIGHLIGHTTEXT);
-#endif
-        }
-        else
-        {
-            wxItemAttr *attr = item->GetAttributes();
-            if (attr && attr->HasTextColour())
-                colText = attr->GetTextColour();
-            else
-                colText = GetForegroundColour();
-        }
-
-        // prepare to draw
-        dc.SetTextForeground(colText);
-        dc.SetPen(*pen);
-
-        // draw
-        PaintItem(item, dc);
-
-        if (HasFlag(wxTR_ROW_LINES))
-        {
-            // if the background colour is white, choose a
-            // contrasting color for the lines
-            dc.SetPen(*((GetBackgroundColour() == *wxWHITE)
-                         ? wxMEDIUM_GREY_PEN : wxWHITE_PEN));
-            dc.DrawLine(0, y_top, 10000, y_top);
-            dc.DrawLine(0, y, 10000, y);
-        }
-
-        // restore DC objects
-        dc.SetBrush(*wxWHITE_BRUSH);
-        dc.SetPen(m_dottedPen);
-        dc.SetTextForeground(*wxBLACK);
-
-        if ( !HasFlag(wxTR_NO_LINES) )
-        {
-            // draw the horizontal line here
-            int x_start = x;
-            if (x > (signed)m_indent)
-                x_start -= m_indent;
-            else if (HasFlag(wxTR_LINES_AT_ROOT))
-                x_start = 3;
-            dc.DrawLine(x_start, y_mid, x + m_spacing, y_mid);
-        }
-
-        // should the item show a button?
-        if ( item->HasPlus() && HasButtons() )
-        {
-            if ( m_imageListButtons )
-            {
-                // draw the image button here
-                int image_h = 0,
-                    image_w = 0;
-                int image = item->IsExpanded() ? wxTreeItemIcon_Expanded
-                                               : wxTreeItemIcon_Normal;
-                if ( item->IsSelected() )
-                    image += wxTreeItemIcon_Selected - wxTreeItemIcon_Normal;
-
-                m_imageListButtons->GetSize(image, image_w, image_h);
-                int xx = x - image_w/2;
-                int yy = y_mid - image_h/2;
-
-                wxDCClipper clip(dc, xx, yy, image_w, image_h);
-                m_imageListButtons->Draw(image, dc, xx, yy,
-                                         wxIMAGELIST_DRAW_TRANSPARENT);
-            }
-            else // no custom buttons
-            {
-                const int wImage = FromDIP(9);
-                const int hImage = FromDIP(9);
-
-                int flag = 0;
-                if (item->IsExpanded())
-                    flag |= wxCONTROL_EXPANDED;
-                if (item == m_underMouse)
-                    flag |= wxCONTROL_CURRENT;
-
-                wxRendererNative::Get().DrawTreeItemButton
-                                        (
-                                            this,
-                                            dc,
-                                            wxRect(x - wImage/2,
-                                                   y_mid - hImage/2,
-                                                   wImage, hImage),
-                                            flag
-                                        );
-            }
-        }
-    }
+        PaintRow(item, dc, x, y_top);
 
     if (item->IsExpanded())
     {
@@ -2915,6 +3381,120 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
     }
 }
 
+void wxGenericTreeCtrl::PaintVirtualRows(wxDC& dc)
+{
+    const bool hideRoot = HasFlag(wxTR_HIDE_ROOT);
+    const int lineHeight = m_lineHeight;
+
+    // only paint the rows intersecting the update region
+    wxRect rectUpdate = GetUpdateRegion().GetBox();
+    CalcUnscrolledPosition(rectUpdate.x, rectUpdate.y,
+                           &rectUpdate.x, &rectUpdate.y);
+
+    int row = rectUpdate.y > 2 ? (rectUpdate.y - 2) / lineHeight : 0;
+    int y = 2 + row*lineHeight;
+    if ( hideRoot )
+        row++;
+
+    wxVector<size_t> path;
+    wxGenericTreeItem *item = GetVirtualItemAtRow(row, &path);
+    while ( item && y <= rectUpdate.GetBottom() )
+    {
+        int x = path.size()*m_indent;
+        if ( !hideRoot )
+            x += m_indent;
+
+        item->SetX(x + m_spacing);
+        item->SetY(y);
+
+        PaintRow(item, dc, x, y);
+
+        if ( item->GetX() + item->GetWidth() > m_virtualWidth )
+        {
+            // update the scrollbars later, when not painting
+            m_virtualWidth = item->GetX() + item->GetWidth();
+            m_dirty = true;
+        }
+
+        if ( !HasFlag(wxTR_NO_LINES) )
+        {
+            // we can't draw the lines down to the last child as PaintLevel()
+            // does because it can be very far away, so draw just the parts of
+            // the vertical lines crossing this row: the one connecting this
+            // item to its parent and the ones of its ancestors which have
+            // more children below it
+            const int y_mid = y + (lineHeight>>1);
+
+            if ( item->IsExpanded() && item->HasChildren() )
+                dc.DrawLine(x, HasButtons() ? y_mid + 5 : y_mid,
+                            x, y + lineHeight);
+
+            wxGenericTreeItem *child = item;
+            int xLine = x;
+            for ( size_t level = path.size(); level > 0; level-- )
+            {
+                wxGenericTreeItem * const parent = child->GetParent();
+
+                xLine -= m_indent;
+                if ( xLine <= 0 )
+                {
+                    // these are the children of the hidden root
+                    if ( !HasFlag(wxTR_LINES_AT_ROOT) )
+                        break;
+
+                    xLine = 3;
+                }
+
+                const bool
+                    hasNext = path[level - 1] + 1 < parent->GetChildren().size();
+                if ( child == item )
+                    dc.DrawLine(xLine, y, xLine, hasNext ? y + lineHeight
+                                                         : y_mid);
+                else if ( hasNext )
+                    dc.DrawLine(xLine, y, xLine, y + lineHeight);
+
+                child = parent;
+            }
+        }
+
+        y += lineHeight;
+
+        // advance to the next shown item
+        if ( item->IsExpanded() && item->HasChildren() )
+        {
+            path.push_back(0);
+            item = DoGetChild(item, 0);
+            continue;
+        }
+
+        for ( ;; )
+        {
+            if ( path.empty() )
+            {
+                item = NULL;
+                break;
+            }
+
+            wxGenericTreeItem * const parent = item->GetParent();
+            const size_t next = path.back() + 1;
+            if ( next < parent->GetChildren().size() )
+            {
+                path.back() = next;
+                item = DoGetChild(parent, next);
+                break;
+            }
+
+            path.pop_back();
+            item = parent;
+        }
+    }
+
+    // measuring the items could have changed the line height, in which case
+    // the positions of all of them need to be updated
+    if ( m_lineHeight != lineHeight )
+        m_dirty = true;
+}
+
 void wxGenericTreeCtrl::DrawDropEffect(wxGenericTreeItem *item)
 {
     if ( item )
@@ -2957,6 +3537,7 @@ void wxGenericTreeCtrl::DrawBorder(const wxTreeItemId &item)
         m_dndEffectItem = NULL;
     }
 
+    CalculateItemPosition(i);
     wxRect rect( i->GetX()-1, i->GetY()-1, i->GetWidth()+2, GetLineHeight(i)+2 );
     CalcScrolledPosition( rect.x, rect.y, &rect.x, &rect.y );
     RefreshRect( rect );
@@ -2982,6 +3563,7 @@ void wxGenericTreeCtrl::DrawLine(const wxTreeItemId &item, bool below)
         m_dndEffectItem = NULL;
     }
 
+    CalculateItemPosition(i);
     wxRect rect( i->GetX()-1, i->GetY()-1, i->GetWidth()+2, GetLineHeight(i)+2 );
     CalcScrolledPosition( rect.x, rect.y, &rect.x, &rect.y );
     RefreshRect( rect );
@@ -3016,6 +3598,12 @@ void wxGenericTreeCtrl::OnPaint( wxPaintEvent &WXUNUSED(event) )
     //if(GetImageList() == NULL)
     // m_lineHeight = (int)(dc.GetCharHeight() + 4);
 
+    if ( IsVirtual() )
+    {
+        PaintVirtualRows(dc);
+        return;
+    }
+
     int y = 2;
     PaintLevel( m_anchor, dc, 0, y );
 }
@@ -3425,8 +4013,29 @@ wxGenericTreeCtrl::DoTreeHitTest(const wxPoint& point, int& flags) const
         return wxTreeItemId();
     }
 
-    wxGenericTreeItem *hit =  m_anchor->HitTest(CalcUnscrolledPosition(point),
-                                                this, flags, 0);
+    wxGenericTreeItem *hit = NULL;
+    if ( IsVirtual() )
+    {
+        const wxPoint pos = CalcUnscrolledPosition(point);
+        if ( pos.y >= 2 )
+        {
+            unsigned int row = (pos.y - 2) / m_lineHeight;
+            if ( HasFlag(wxTR_HIDE_ROOT) )
+                row++;
+
+            hit = GetVirtualItemAtRow(row);
+            if ( hit )
+            {
+                CalculateItemPosition(hit);
+                hit = hit->HitTestItem(pos, this, flags);
+            }
+        }
+    }
+    else
+    {
+        hit = m_anchor->HitTest(CalcUnscrolledPosition(point), this, flags, 0);
+    }
+
     if (hit == NULL)
     {
         flags = wxTREE_HITTEST_NOWHERE;
@@ -3445,6 +4054,8 @@ bool wxGenericTreeCtrl::GetBoundingRect(const wxTreeItemId& item,
 
     wxGenericTreeItem *i = (wxGenericTreeItem*) item.m_pItem;
 
+    CalculateItemPosition(i);
+
     if ( textOnly )
     {
         int image_w = 0;
@@ -3996,6 +4607,10 @@ void wxGenericTreeCtrl::CalculatePositions()
 {
     if ( !m_anchor ) return;
 
+    // the positions of the items are computed on demand in virtual mode, see
+    // CalculateItemPosition()
+    if ( IsVirtual() ) return;
+
     wxClientDC dc(this);
     PrepareDC( dc );
 
@@ -4022,6 +4637,8 @@ void wxGenericTreeCtrl::RefreshSubtree(wxGenericTreeItem *item)
 
     wxSize client = GetClientSize();
 
+    CalculateItemPosition(item);
+
     wxRect rect;
     CalcScrolledPosition(0, item->GetY(), NULL, &rect.y);
     rect.width = client.x;
@@ -4037,6 +4654,8 @@ void wxGenericTreeCtrl::RefreshLine( wxGenericTreeItem *item )
     if (m_dirty || IsFrozen() )
         return;
 
+    CalculateItemPosition(item);
+
     wxRect rect;
     CalcScrolledPosition(0, item->GetY(), NULL, &rect.y);
     rect.width = GetClientSize().x;
@@ -4068,7 +4687,8 @@ void wxGenericTreeCtrl::RefreshSelectedUnder(wxGenericTreeItem *item)
     size_t count = children.GetCount();
     for ( size_t n = 0; n < count; n++ )
     {
-        RefreshSelectedUnder(children[n]);
+        if ( children[n] )
+            RefreshSelectedUnder(children[n]);
     }
 }
 
@@ -4110,7 +4730,8 @@ void wxGenericTreeCtrl::OnGetToolTip( wxTreeEvent &event )
 {
 #if wxUSE_TOOLTIPS
     wxTreeItemId itemId = event.GetItem();
-    const wxGenericTreeItem* const pItem = (wxGenericTreeItem*)itemId.m_pItem;
+    wxGenericTreeItem* const pItem = (wxGenericTreeItem*)itemId.m_pItem;
+    CalculateItemPosition(pItem);
 
     // Check if the item fits into the client area:
     if ( pItem->GetX() + pItem->GetWidth() > GetClientSize().x )
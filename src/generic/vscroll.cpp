@@ -31,6 +31,7 @@
 #include "wx/vscroll.h"
 
 #include "wx/utils.h"   // For wxMin/wxMax().
+#include "wx/vector.h"
 
 // ============================================================================
 // wxVarScrollHelperEvtHandler declaration
@@ -57,6 +58,120 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxVarScrollHelperEvtHandler);
 };
 
+// ----------------------------------------------------------------------------
+// wxVarScrollUnitSizeIndex: prefix sums of the unit sizes
+// ----------------------------------------------------------------------------
+
+// This is a Fenwick (binary indexed) tree storing the sizes of all units,
+// which allows to compute the total size of any range of units, update the
+// size of a single unit and find the unit at the given offset in O(log N).
+class wxVarScrollUnitSizeIndex
+{
+public:
+    wxVarScrollUnitSizeIndex() { }
+
+    bool IsEmpty() const { return m_sizes.empty(); }
+
+    void Clear()
+    {
+        m_sizes.clear();
+        m_tree.clear();
+    }
+
+    // (re)build the index for the given number of units, querying all their
+    // sizes from the helper
+    void Build(const wxVarScrollHelperBase& helper, size_t count);
+
+    size_t GetCount() const { return m_sizes.size(); }
+
+    wxCoord GetSize(size_t unit) const { return m_sizes[unit]; }
+
+    void SetSize(size_t unit, wxCoord size);
+
+    // return the total size of the units in [0, unit) range
+    wxCoord GetOffset(size_t unit) const;
+
+    // return the largest index of the unit such that GetOffset() for it is
+    // strictly less than the given offset (or 0 if there is none)
+    size_t FindLastBefore(wxCoord offset) const;
+
+private:
+    // the sizes of all units, used to compute the deltas in SetSize()
+    wxVector<wxCoord> m_sizes;
+
+    // the tree itself, using 1-based indices, so its element 0 is unused
+    wxVector<wxCoord> m_tree;
+
+    wxDECLARE_NO_COPY_CLASS(wxVarScrollUnitSizeIndex);
+};
+
+void
+wxVarScrollUnitSizeIndex::Build(const wxVarScrollHelperBase& helper,
+                                size_t count)
+{
+    m_sizes.resize(count);
+    m_tree.assign(count + 1, 0);
+
+    helper.OnGetUnitsSizeHint(0, count);
+
+    // build the tree in linear time by propagating each node into its parent
+    for ( size_t n = 1; n <= count; ++n )
+    {
+        m_sizes[n - 1] = helper.OnGetUnitSize(n - 1);
+        m_tree[n] += m_sizes[n - 1];
+
+        const size_t parent = n + (n & (~n + 1));
+        if ( parent <= count )
+            m_tree[parent] += m_tree[n];
+    }
+}
+
+void wxVarScrollUnitSizeIndex::SetSize(size_t unit, wxCoord size)
+{
+    const wxCoord delta = size - m_sizes[unit];
+    if ( !delta )
+        return;
+
+    m_sizes[unit] = size;
+
+    const size_t count = m_sizes.size();
+    for ( size_t n = unit + 1; n <= count; n += n & (~n + 1) )
+        m_tree[n] += delta;
+}
+
+wxCoord wxVarScrollUnitSizeIndex::GetOffset(size_t unit) const
+{
+    wxCoord offset = 0;
+    for ( size_t n = unit; n; n &= n - 1 )
+        offset += m_tree[n];
+
+    return offset;
+}
+
+size_t wxVarScrollUnitSizeIndex::FindLastBefore(wxCoord offset) const
+{
+    const size_t count = m_sizes.size();
+
+    size_t step = 1;
+    while ( step <= count / 2 )
+        step <<= 1;
+
+    // descend the tree, advancing while the prefix sum stays below offset,
+    // which works because the unit sizes are never negative
+    size_t unit = 0;
+    for ( ; step; step >>= 1 )
+    {
+        const size_t next = unit + step;
+        if ( next <= count && m_tree[next] < offset )
+        {
+            unit = next;
+            offset -= m_tree[next];
+        }
+    }
+
+    return unit;
+}
+
 // ============================================================================
 // wxVarScrollHelperEvtHandler implementation
 // ============================================================================
@@ -197,6 +312,7 @@ wxVarScrollHelperBase::wxVarScrollHelperBase(wxWindow *win)
 
     m_physicalScrolling = true;
     m_handler = NULL;
+    m_sizeIndex = NULL;
 
     // by default, the associated window is also the target window
     DoSetTargetWindow(win);
@@ -205,6 +321,8 @@ wxVarScrollHelperBase::wxVarScrollHelperBase(wxWindow *win)
 wxVarScrollHelperBase::~wxVarScrollHelperBase()
 {
     DeleteEvtHandler();
+
+    delete m_sizeIndex;
 }
 
 // ----------------------------------------------------------------------------
@@ -247,8 +365,11 @@ wxCoord wxVarScrollHelperBase::DoEstimateTotalSize() const
     static const size_t NUM_UNITS_TO_SAMPLE = 10;
 
     wxCoord sizeTotal;
-    if ( m_unitMax < 3*NUM_UNITS_TO_SAMPLE )
+    if ( m_unitMax < 3*NUM_UNITS_TO_SAMPLE || m_sizeIndex )
     {
+        // this is also the case if we have the unit size cache, as we need to
+        // retrieve the sizes of all units to build it anyhow
+
         // in this case, full calculations are faster and more correct than
         // guessing
         sizeTotal = GetUnitsSize(0, m_unitMax);
@@ -279,6 +400,9 @@ wxCoord wxVarScrollHelperBase::GetUnitsSize(size_t unitMin, size_t unitMax) cons
         return -GetUnitsSize(unitMax, unitMin);
     //else: unitMin < unitMax
 
+    if ( wxVarScrollUnitSizeIndex * const index = GetUnitSizeIndex() )
+        return index->GetOffset(unitMax) - index->GetOffset(unitMin);
+
     // let the user code know that we're going to need all these units
     OnGetUnitsSizeHint(unitMin, unitMax);
 
@@ -296,6 +420,19 @@ size_t wxVarScrollHelperBase::FindFirstVisibleFromLast(size_t unitLast, bool ful
 {
     const wxCoord sWindow = GetOrientationTargetSize();
 
+    if ( wxVarScrollUnitSizeIndex * const index = GetUnitSizeIndex() )
+    {
+        // find the last unit such that the units from it to unitLast don't
+        // fit into the window any more
+        const wxCoord offset =
+            index->GetOffset(wxMin(unitLast + 1, m_unitMax)) - sWindow;
+        if ( offset <= 0 )
+            return 0;
+
+        const size_t unitFirst = index->FindLastBefore(offset);
+        return full ? unitFirst + 1 : unitFirst;
+    }
+
     // go upwards until we arrive at a unit such that unitLast is not visible
     // any more when it is shown
     size_t unitFirst = unitLast;
@@ -469,11 +606,36 @@ void wxVarScrollHelperBase::SetTargetWindow(wxWindow *target)
     DoSetTargetWindow(target);
 }
 
+void wxVarScrollHelperBase::EnableUnitSizeCache(bool enable)
+{
+    if ( enable )
+    {
+        if ( !m_sizeIndex )
+            m_sizeIndex = new wxVarScrollUnitSizeIndex;
+    }
+    else
+    {
+        wxDELETE(m_sizeIndex);
+    }
+}
+
+wxVarScrollUnitSizeIndex *wxVarScrollHelperBase::GetUnitSizeIndex() const
+{
+    if ( m_sizeIndex && m_sizeIndex->GetCount() != m_unitMax )
+        m_sizeIndex->Build(*this, m_unitMax);
+
+    return m_sizeIndex;
+}
+
 void wxVarScrollHelperBase::SetUnitCount(size_t count)
 {
     // save the number of units
     m_unitMax = count;
 
+    // the sizes of all units must be retrieved again
+    if ( m_sizeIndex )
+        m_sizeIndex->Clear();
+
     // and our estimate for their total height
     m_sizeTotal = EstimateTotalSize();
 
@@ -491,6 +653,10 @@ void wxVarScrollHelperBase::SetUnitCount(size_t count)
 
 void wxVarScrollHelperBase::RefreshUnit(size_t unit)
 {
+    // the size of this unit could have changed
+    if ( m_sizeIndex && unit < m_sizeIndex->GetCount() )
+        m_sizeIndex->SetSize(unit, OnGetUnitSize(unit));
+
     // is this unit visible?
     if ( !IsVisible(unit) )
     {
@@ -516,6 +682,19 @@ void wxVarScrollHelperBase::RefreshUnits(size_t from, size_t to)
 {
     wxASSERT_MSG( from <= to, wxT("RefreshUnits(): empty range") );
 
+    // the sizes of these units could have changed
+    if ( m_sizeIndex && !m_sizeIndex->IsEmpty() )
+    {
+        const size_t last = wxMin(to + 1, m_sizeIndex->GetCount());
+        if ( from < last )
+        {
+            OnGetUnitsSizeHint(from, last);
+
+            for ( size_t n = from; n < last; ++n )
+                m_sizeIndex->SetSize(n, OnGetUnitSize(n));
+        }
+    }
+
     // clump the range to just the visible units -- it is useless to refresh
     // the other ones
     if ( from < GetVisibleBegin() )
@@ -552,6 +731,10 @@ void wxVarScrollHelperBase::RefreshUnits(size_t from, size_t to)
 
 void wxVarScrollHelperBase::RefreshAll()
 {
+    // the sizes of any units could have changed
+    if ( m_sizeIndex )
+        m_sizeIndex->Clear();
+
     UpdateScrollbar();
 
     m_targetWindow->Refresh();
@@ -581,6 +764,18 @@ bool wxVarScrollHelperBase::ScrollLayout()
 int wxVarScrollHelperBase::VirtualHitTest(wxCoord coord) const
 {
     const size_t unitMax = GetVisibleEnd();
+
+    if ( wxVarScrollUnitSizeIndex * const index = GetUnitSizeIndex() )
+    {
+        if ( coord < 0 )
+            coord = 0;
+
+        // find the unit starting at or before the given position
+        const size_t unit = index->FindLastBefore(
+                                index->GetOffset(GetVisibleBegin()) + coord + 1);
+
+        return unit < unitMax ? (int)unit : wxNOT_FOUND;
+    }
     for ( size_t unit = GetVisibleBegin(); unit < unitMax; ++unit )
     {
         coord -= OnGetUnitSize(unit);
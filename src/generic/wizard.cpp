@@ -500,6 +500,9 @@ void wxWizard::SetPageSize(const wxSize& size)
 {
     wxCHECK_RET(!m_started, wxT("wxWizard::SetPageSize after RunWizard"));
     m_sizePage = size;
+
+    if ( m_sizerPage )
+        m_sizerPage->InvalidateMinSize();
 }
 
 void wxWizard::FitToPage(const wxWizardPage *page)
@@ -514,6 +517,9 @@ void wxWizard::FitToPage(const wxWizardPage *page)
 
         page = page->GetNext();
     }
+
+    if ( m_sizerPage )
+        m_sizerPage->InvalidateMinSize();
 }
 
 bool wxWizard::ShowPage(wxWizardPage *page, bool goingForward)
@@ -870,6 +876,10 @@ void wxWizard::SetBitmap(const wxBitmap& bitmap)
     m_bitmap = bitmap;
     if (m_statbmp)
         m_statbmp->SetBitmap(m_bitmap);
+
+    // the page size depends on the bitmap height
+    if ( m_sizerPage )
+        m_sizerPage->InvalidateMinSize();
 }
 
 // ----------------------------------------------------------------------------
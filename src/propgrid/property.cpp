@@ -469,6 +469,7 @@ void wxPGProperty::Init()
 {
     m_commonValue = -1;
     m_arrIndex = 0xFFFF;
+    m_rowIndex = (unsigned int)-1;
     m_parent = NULL;
 
     m_parentState = NULL;
@@ -1979,7 +1980,13 @@ void wxPGProperty::SetFlagsFromString( const wxString& str )
         }
     WX_PG_TOKENIZER1_END()
 
+    const FlagType oldFlags = m_flags;
     m_flags = (m_flags & ~wxPG_STRING_STORED_FLAGS) | flags;
+
+    // Hiding or collapsing the property changes the rows shown in the grid.
+    if ( m_parentState &&
+            ((oldFlags ^ m_flags) & (wxPG_PROP_HIDDEN|wxPG_PROP_COLLAPSED)) )
+        m_parentState->VirtualHeightChanged();
 }
 
 wxValidator* wxPGProperty::DoGetValidator() const
@@ -2149,10 +2156,21 @@ bool wxPGProperty::Hide( bool hide, int flags )
     return DoHide( hide, flags );
 }
 
+void wxPGProperty::SetExpanded( bool expanded )
+{
+    ChangeFlag(wxPG_PROP_COLLAPSED, !expanded);
+
+    if ( m_parentState )
+        m_parentState->VirtualHeightChanged();
+}
+
 bool wxPGProperty::DoHide( bool hide, int flags )
 {
     ChangeFlag(wxPG_PROP_HIDDEN, hide);
 
+    if ( m_parentState )
+        m_parentState->VirtualHeightChanged();
+
     if ( flags & wxPG_RECURSE )
     {
         for ( unsigned int i = 0; i < GetChildCount(); i++ )
@@ -2266,6 +2284,14 @@ wxPropertyGrid* wxPGProperty::GetGridIfDisplayed() const
 
 int wxPGProperty::GetY2( int lh ) const
 {
+    // Use the index of the visible rows if this property is shown.
+    if ( m_parentState )
+    {
+        const int row = m_parentState->GetRowOfProperty(this);
+        if ( row != -1 )
+            return row*lh;
+    }
+
     const wxPGProperty* parent;
     const wxPGProperty* child = this;
 
@@ -2310,6 +2336,8 @@ void wxPGProperty::DoAddChild( wxPGProperty* prop, int index,
     }
 
     prop->m_parent = this;
+
+    ChildrenChanged();
 }
 
 void wxPGProperty::DoPreAddChild( int index, wxPGProperty* prop )
@@ -2327,6 +2355,8 @@ void wxPGProperty::DoPreAddChild( int index, wxPGProperty* prop )
         prop->m_flags |= wxPG_PROP_CUSTOMIMAGE;
 
     prop->m_parent = this;
+
+    ChildrenChanged();
 }
 
 void wxPGProperty::AddPrivateChild( wxPGProperty* prop )
@@ -2378,17 +2408,31 @@ wxPGProperty* wxPGProperty::InsertChild( int index,
 void wxPGProperty::RemoveChild( wxPGProperty* p )
 {
     wxPGRemoveItemFromVector<wxPGProperty*>(m_children, p);
+
+    ChildrenChanged();
 }
 
 void wxPGProperty::RemoveChild(unsigned int index)
 {
     m_children.erase(m_children.begin()+index);
+
+    ChildrenChanged();
 }
 
 void wxPGProperty::SortChildren(int (*fCmp)(wxPGProperty**, wxPGProperty**))
 {
     wxArray_SortFunction<wxPGProperty*> sf(fCmp);
     std::sort(m_children.begin(), m_children.end(), sf);
+
+    ChildrenChanged();
+}
+
+void wxPGProperty::ChildrenChanged()
+{
+    // The visible rows of the page depend on our children, so they must be
+    // recalculated.
+    if ( m_parentState )
+        m_parentState->VirtualHeightChanged();
 }
 
 void wxPGProperty::AdaptListToValue( wxVariant& list, wxVariant* value ) const
@@ -2758,6 +2802,8 @@ void wxPGProperty::SubPropsChanged( int oldSelInd )
     wxPropertyGridPageState* state = GetParentState();
     wxPropertyGrid* grid = state->GetGrid();
 
+    ChildrenChanged();
+
     //
     // Re-repare children (recursively)
     for ( unsigned int i=0; i<GetChildCount(); i++ )
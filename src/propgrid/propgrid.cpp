@@ -1874,8 +1874,7 @@ wxPGProperty* wxPropertyGrid::DoGetItemAtY( int y ) const
     if ( y < 0 )
         return NULL;
 
-    unsigned int a = 0;
-    return m_pState->DoGetRoot()->GetItemAtY(y, m_lineHeight, &a);
+    return m_pState->GetPropertyAtRow(y / m_lineHeight);
 }
 
 // -----------------------------------------------------------------------
@@ -2152,28 +2151,24 @@ int wxPropertyGrid::DoDrawItems( wxDC& dc,
 
     dc.SetFont(normalFont);
 
-    wxPropertyGridConstIterator it( state, wxPG_ITERATE_VISIBLE, firstItem );
     int endScanBottomY = lastItemBottomY + lh;
     int y = firstItemTopY;
 
     //
-    // Pre-generate list of visible properties.
+    // Pre-generate list of visible properties, starting directly at the row
+    // of the first one (firstItemTopY is aligned to it).
     wxVector<wxPGProperty*> visPropArray;
     visPropArray.reserve((m_height/m_lineHeight)+6);
 
-    for ( ; !it.AtEnd(); it.Next() )
+    const unsigned int rowCount = state->GetVisibleRowCount();
+    for ( unsigned int row = firstItemTopY / lh; row < rowCount; row++ )
     {
-        const wxPGProperty* p = *it;
+        visPropArray.push_back(state->GetPropertyAtRow(row));
 
-        if ( !p->HasFlag(wxPG_PROP_HIDDEN) )
-        {
-            visPropArray.push_back(const_cast<wxPGProperty*>(p));
-
-            if ( y > endScanBottomY )
-                break;
+        if ( y > endScanBottomY )
+            break;
 
-            y += lh;
-        }
+        y += lh;
     }
 
     visPropArray.push_back(NULL);
@@ -211,6 +211,7 @@ wxPropertyGridPageState::wxPropertyGridPageState()
 
     m_isSplitterPreSet = false;
     m_dontCenterSplitter = false;
+    m_visibleRowsPending = true;
 
     // By default, we only have the 'value' column editable
     m_editableColumns.push_back(1);
@@ -307,6 +308,9 @@ void wxPropertyGridPageState::DoClear()
 
         m_virtualHeight = 0;
         m_vhCalcPending = false;
+
+        m_visibleRows.clear();
+        m_visibleRowsPending = true;
     }
 }
 
@@ -699,8 +703,46 @@ wxPGProperty* wxPropertyGridPageState::DoGetItemAtY( int y ) const
     if ( y < 0 )
         return NULL;
 
-    unsigned int a = 0;
-    return m_properties->GetItemAtY(y, GetGrid()->GetRowHeight(), &a);
+    return GetPropertyAtRow(y / GetGrid()->GetRowHeight());
+}
+
+int wxPropertyGridPageState::GetRowOfProperty( const wxPGProperty* p ) const
+{
+    EnsureVisibleRows();
+
+    // The row index stored in the property is only valid if it's still
+    // shown in this row, otherwise it's not visible at all.
+    const unsigned int row = p->m_rowIndex;
+    if ( row < m_visibleRows.size() && m_visibleRows[row] == p )
+        return (int)row;
+
+    return -1;
+}
+
+void wxPropertyGridPageState::RecalculateVisibleRows() const
+{
+    m_visibleRows.clear();
+    DoAddVisibleRows(m_properties);
+
+    m_visibleRowsPending = false;
+}
+
+void wxPropertyGridPageState::DoAddVisibleRows( const wxPGProperty* parent ) const
+{
+    const unsigned int count = parent->GetChildCount();
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        wxPGProperty* p = parent->Item(i);
+
+        if ( p->HasFlag(wxPG_PROP_HIDDEN) )
+            continue;
+
+        p->m_rowIndex = (unsigned int)m_visibleRows.size();
+        m_visibleRows.push_back(p);
+
+        if ( p->IsExpanded() )
+            DoAddVisibleRows(p);
+    }
 }
 
 // -----------------------------------------------------------------------
@@ -1254,6 +1254,7 @@ void wxRibbonBar::RecalculateMinSize()
 
     m_minWidth = min_size.GetWidth();
     m_minHeight = m_arePanelsShown ? min_size.GetHeight() : m_tab_height;
+    InvalidateBestSize();
 }
 
 wxSize wxRibbonBar::DoGetBestSize() const
@@ -103,6 +103,122 @@ wxColour wxColourFromCDandAlpha(ColourDesired& cd, int alpha) {
 namespace
 {
 
+// Cache of the widths of the text measured using the given font.
+//
+// For the fonts in which all printable ASCII characters have the same integer
+// width, as is the case for the monospace fonts typically used for editing the
+// source code, the positions in the ASCII-only text are computed directly and
+// for the other text the positions of the characters in the short runs of text
+// are remembered in a fixed size hash table.
+class wxSTCTextWidthCache
+{
+public:
+    // The parameters of the DC affecting the text measurements.
+    struct DCInfo
+    {
+        DCInfo() : scaleX(0), scaleY(0) { }
+
+        bool operator==(const DCInfo& other) const
+        {
+            return ppi == other.ppi &&
+                    scaleX == other.scaleX && scaleY == other.scaleY;
+        }
+
+        bool operator!=(const DCInfo& other) const { return !(*this == other); }
+
+        wxSize ppi;
+        double scaleX,
+               scaleY;
+    };
+
+    // Longest run of text, in bytes, for which the positions are cached.
+    enum { MAX_RUN_LENGTH = 64 };
+
+    wxSTCTextWidthCache() : m_asciiWidth(-1) { }
+
+    // Must be called before using the cache with a DC: as the widths depend
+    // on the DC resolution and scale, all the cached values are discarded if
+    // they differ from the ones used before.
+    void Validate(const DCInfo& dcInfo)
+    {
+        if ( dcInfo != m_dcInfo )
+        {
+            m_dcInfo = dcInfo;
+            m_asciiWidth = -1;
+            m_runs.clear();
+        }
+    }
+
+    // Width of all printable ASCII characters if they are the same, 0 if they
+    // are not or -1 if it hadn't been determined yet.
+    int GetAsciiWidth() const { return m_asciiWidth; }
+    void SetAsciiWidth(int width) { m_asciiWidth = width; }
+
+    static bool IsPrintableAscii(const char* s, int len)
+    {
+        for ( int i = 0; i < len; i++ )
+        {
+            if ( s[i] < ' ' || s[i] > '~' )
+                return false;
+        }
+
+        return true;
+    }
+
+    // Return the cached positions for the given text or NULL.
+    const XYPOSITION* FindRun(const char* s, int len) const
+    {
+        if ( m_runs.empty() )
+            return NULL;
+
+        const Run& run = m_runs[GetRunIndex(s, len)];
+        if ( run.text.size() != static_cast<size_t>(len) ||
+                memcmp(&run.text[0], s, len) != 0 )
+            return NULL;
+
+        return &run.positions[0];
+    }
+
+    void AddRun(const char* s, int len, const XYPOSITION* positions)
+    {
+        wxASSERT( len > 0 && len <= MAX_RUN_LENGTH );
+
+        if ( m_runs.empty() )
+            m_runs.resize(NUM_RUNS);
+
+        // Just overwrite the previous run with the same hash, if any.
+        Run& run = m_runs[GetRunIndex(s, len)];
+        run.text.assign(s, s + len);
+        run.positions.assign(positions, positions + len);
+    }
+
+private:
+    enum { NUM_RUNS = 512 };
+
+    static size_t GetRunIndex(const char* s, int len)
+    {
+        // FNV-1a hash.
+        wxUint32 hash = 2166136261u;
+        for ( int i = 0; i < len; i++ )
+        {
+            hash ^= static_cast<unsigned char>(s[i]);
+            hash *= 16777619u;
+        }
+
+        return hash % NUM_RUNS;
+    }
+
+    struct Run
+    {
+        wxVector<char> text;
+        wxVector<XYPOSITION> positions;
+    };
+
+    DCInfo m_dcInfo;
+    int m_asciiWidth;
+    wxVector<Run> m_runs;
+};
+
 // wxFont with ascent cached, a pointer to this type is stored in Font::fid.
 class wxFontWithAscent : public wxFont
 {
@@ -130,9 +246,12 @@ public:
     SurfaceData* GetSurfaceFontData() const { return m_surfaceFontData; }
     void SetSurfaceFontData(SurfaceData* data) { m_surfaceFontData=data; }
 
+    wxSTCTextWidthCache& GetTextWidthCache() { return m_textWidthCache; }
+
 private:
     int m_ascent;
     SurfaceData* m_surfaceFontData;
+    wxSTCTextWidthCache m_textWidthCache;
 };
 
 void SetAscent(Font& f, int ascent)
@@ -210,6 +329,10 @@ private:
     int         y;
     bool        unicodeMode;
 
+    // parameters of hdc used for the text width cache, computed on demand
+    wxSTCTextWidthCache::DCInfo dcInfo;
+    bool        dcInfoValid;
+
 public:
     SurfaceImpl();
     ~SurfaceImpl();
@@ -258,13 +381,22 @@ public:
 
     void BrushColour(ColourDesired back);
     void SetFont(Font &font_);
+
+private:
+    // return the text width cache for the given font, valid for our DC
+    wxSTCTextWidthCache& GetTextWidthCache(Font &font_);
+
+    // return the width of the printable ASCII characters if it's the same for
+    // all of them or 0 otherwise
+    int GetAsciiWidth(Font &font_, wxSTCTextWidthCache& cache);
 };
 
 
 
 SurfaceImpl::SurfaceImpl() :
     hdc(0), hdcOwned(0), bitmap(0),
-    x(0), y(0), unicodeMode(0)
+    x(0), y(0), unicodeMode(0),
+    dcInfoValid(false)
 {}
 
 SurfaceImpl::~SurfaceImpl() {
@@ -320,6 +452,7 @@ void SurfaceImpl::Release() {
         hdc = 0;
         hdcOwned = false;
     }
+    dcInfoValid = false;
 }
 
 
@@ -614,8 +747,69 @@ void SurfaceImpl::DrawTextTransparent(PRectangle rc, Font &font, XYPOSITION ybas
 }
 
 
+wxSTCTextWidthCache& SurfaceImpl::GetTextWidthCache(Font &font) {
+    if (!dcInfoValid) {
+        dcInfo.ppi = hdc->GetPPI();
+        hdc->GetUserScale(&dcInfo.scaleX, &dcInfo.scaleY);
+        dcInfo.scaleX *= hdc->GetContentScaleFactor();
+        dcInfo.scaleY *= hdc->GetContentScaleFactor();
+        dcInfoValid = true;
+    }
+
+    wxSTCTextWidthCache&
+        cache = wxFontWithAscent::FromFID(font.GetID())->GetTextWidthCache();
+    cache.Validate(dcInfo);
+    return cache;
+}
+
+int SurfaceImpl::GetAsciiWidth(Font &font, wxSTCTextWidthCache& cache) {
+    int width = cache.GetAsciiWidth();
+    if (width == -1) {
+        wxString str;
+        for (char ch = ' '; ch <= '~'; ++ch)
+            str += ch;
+
+        wxArrayInt tpos;
+        SetFont(font);
+        hdc->GetPartialTextExtents(str, tpos);
+
+        // Check that all characters have the same width and that there is no
+        // kerning, so that the positions can be computed directly.
+        width = tpos.empty() ? 0 : tpos[0];
+        for (size_t i = 0; i < tpos.size(); ++i) {
+            if (tpos[i] != static_cast<int>(i + 1)*width) {
+                width = 0;
+                break;
+            }
+        }
+
+        cache.SetAsciiWidth(width);
+    }
+
+    return width;
+}
+
 void SurfaceImpl::MeasureWidths(Font &font, const char *s, int len, XYPOSITION *positions) {
 
+    wxSTCTextWidthCache& cache = GetTextWidthCache(font);
+
+    const int asciiWidth = GetAsciiWidth(font, cache);
+    if (asciiWidth && wxSTCTextWidthCache::IsPrintableAscii(s, len)) {
+        for (int i = 0; i < len; i++) {
+            positions[i] = (i + 1)*asciiWidth;
+        }
+        return;
+    }
+
+    const bool cacheRun = len > 0 && len <= wxSTCTextWidthCache::MAX_RUN_LENGTH;
+    if (cacheRun) {
+        const XYPOSITION* const cached = cache.FindRun(s, len);
+        if (cached) {
+            memcpy(positions, cached, len*sizeof(XYPOSITION));
+            return;
+        }
+    }
+
     wxString   str = stc2wx(s, len);
     wxArrayInt tpos;
 
@@ -656,10 +850,19 @@ void SurfaceImpl::MeasureWidths(Font &font, const char *s, int len, XYPOSITION *
         positions[i] = tpos[i];
     }
 #endif // wxUSE_UNICODE/!wxUSE_UNICODE
+
+    // Don't cache the positions if the string couldn't be converted, they
+    // were not filled in at all then.
+    if (cacheRun && !str.empty())
+        cache.AddRun(s, len, positions);
 }
 
 
 XYPOSITION SurfaceImpl::WidthText(Font &font, const char *s, int len) {
+    const int asciiWidth = GetAsciiWidth(font, GetTextWidthCache(font));
+    if (asciiWidth && wxSTCTextWidthCache::IsPrintableAscii(s, len))
+        return len*asciiWidth;
+
     SetFont(font);
     int w;
     int h;
@@ -670,6 +873,10 @@ XYPOSITION SurfaceImpl::WidthText(Font &font, const char *s, int len) {
 
 
 XYPOSITION SurfaceImpl::WidthChar(Font &font, char ch) {
+    const int asciiWidth = GetAsciiWidth(font, GetTextWidthCache(font));
+    if (asciiWidth && wxSTCTextWidthCache::IsPrintableAscii(&ch, 1))
+        return asciiWidth;
+
     SetFont(font);
     int w;
     int h;
@@ -38,6 +38,11 @@
 
 #include <dirent.h>
 
+// the type of the entry is returned by readdir() under Linux and BSD systems
+#if defined(DT_DIR) && defined(DT_UNKNOWN) && defined(DT_LNK)
+    #define wxHAS_DIRENT_D_TYPE
+#endif
+
 // ----------------------------------------------------------------------------
 // macros
 // ----------------------------------------------------------------------------
@@ -149,36 +154,52 @@ bool wxDirData::Read(wxString *filename)
             break;
         }
 
-        // check the type now: notice that we may want to check the type of
-        // the path itself and not whatever it points to in case of a symlink
-        wxFileName fn = wxFileName::DirName(path + de_d_name);
-        if ( m_flags & wxDIR_NO_FOLLOW )
-        {
-            fn.DontFollowLink();
-        }
-
-        if ( !(m_flags & wxDIR_FILES) && !fn.DirExists() )
+        // check the name first as it's much cheaper than checking the type
+        if ( m_filespec.empty() )
         {
-            // it's a file, but we don't want them
-            continue;
+            if ( !(m_flags & wxDIR_HIDDEN) && de->d_name[0] == '.' )
+                continue;
         }
-        else if ( !(m_flags & wxDIR_DIRS) && fn.DirExists() )
+        else
         {
-            // it's a dir, and we don't want it
-            continue;
+            // test against the pattern
+            if ( !wxMatchWild(m_filespec, de_d_name,
+                              !(m_flags & wxDIR_HIDDEN)) )
+                continue;
         }
 
-        // finally, check the name
-        if ( m_filespec.empty() )
-        {
-            matches = m_flags & wxDIR_HIDDEN ? true : de->d_name[0] != '.';
-        }
+        // we don't need to check the type at all if we want both files and
+        // directories
+        if ( (m_flags & (wxDIR_FILES | wxDIR_DIRS)) == (wxDIR_FILES | wxDIR_DIRS) )
+            break;
+
+        // check the type now: notice that we may want to check the type of
+        // the path itself and not whatever it points to in case of a symlink
+        bool isDir;
+#ifdef wxHAS_DIRENT_D_TYPE
+        // avoid calling stat() if the type is already known, which is the
+        // case for most file systems
+        if ( de->d_type == DT_DIR )
+            isDir = true;
+        else if ( de->d_type != DT_UNKNOWN &&
+                    (de->d_type != DT_LNK || (m_flags & wxDIR_NO_FOLLOW)) )
+            isDir = false;
         else
+#endif // wxHAS_DIRENT_D_TYPE
         {
-            // test against the pattern
-            matches = wxMatchWild(m_filespec, de_d_name,
-                                  !(m_flags & wxDIR_HIDDEN));
+            wxFileName fn = wxFileName::DirName(path + de_d_name);
+            if ( m_flags & wxDIR_NO_FOLLOW )
+            {
+                fn.DontFollowLink();
+            }
+
+            isDir = fn.DirExists();
         }
+
+        if ( isDir )
+            matches = (m_flags & wxDIR_DIRS) != 0;
+        else
+            matches = (m_flags & wxDIR_FILES) != 0;
     }
 
     *filename = de_d_name;
@@ -23,19 +23,41 @@
 #include <sys/inotify.h>
 #include <unistd.h>
 #include "wx/private/fswatcher.h"
+#include "wx/scopedarray.h"
+
+#if wxUSE_THREADS && defined(wxHAS_CALL_AFTER)
+    #include "wx/threadpool.h"
+#endif
 
 // ============================================================================
 // wxFSWatcherImpl implementation & helper wxFSWSourceHandler implementation
 // ============================================================================
 
-// inotify watch descriptor => wxFSWatchEntry* map
-WX_DECLARE_HASH_MAP(int, wxFSWatchEntry*, wxIntegerHash, wxIntegerEqual,
-                                              wxFSWatchEntryDescriptors);
-
 // inotify event cookie => inotify_event* map
 WX_DECLARE_HASH_MAP(int, inotify_event*, wxIntegerHash, wxIntegerEqual,
                                                       wxInotifyCookies);
 
+// path => index of the last event for it in the current batch
+WX_DECLARE_STRING_HASH_MAP(size_t, wxInotifyBatchIndices);
+
+// The size of the buffer used for reading the events: this is big enough to
+// read all the events generated by the changes to many files at once, which
+// allows to deliver them in a single batch.
+static const size_t wxINOTIFY_BUFFER_SIZE = 64*1024;
+
+// Information about a single inotify watch descriptor.
+struct wxInotifyWatchSlot
+{
+    wxInotifyWatchSlot() : watch(NULL), stale(false) { }
+
+    // the watch using this descriptor or NULL
+    wxFSWatchEntry* watch;
+
+    // true if the watch has been removed, but we didn't get IN_IGNORED for it
+    // yet, so events for it can still arrive
+    bool stale;
+};
+
 /**
  * Helper class encapsulating inotify mechanism
  */
@@ -58,6 +80,9 @@ public:
             Close();
         }
 
+        for (size_t n = 0; n < m_batch.size(); n++)
+            delete m_batch[n];
+
         delete m_handler;
     }
 
@@ -110,14 +135,20 @@ public:
             return false;
         }
 
-        wxFSWatchEntryDescriptors::value_type val(wd, watch.get());
-        if (!m_watchMap.insert(val).second)
+        wxInotifyWatchSlot& slot = GetOrCreateSlot(wd);
+        if (slot.watch)
         {
             wxFAIL_MSG( wxString::Format( "Path %s is already watched",
                                            watch->GetPath()) );
             return false;
         }
 
+        slot.watch = watch.get();
+
+        // The descriptor may be reused by inotify once IN_IGNORED was sent
+        // for it, so it's not stale any more even if we didn't get it yet.
+        slot.stale = false;
+
         return true;
     }
 
@@ -145,13 +176,19 @@ public:
             SendEvent(event);
         }
 
-        if (m_watchMap.erase(watch->GetWatchDescriptor()) != 1)
+        wxInotifyWatchSlot* const slot = GetSlot(watch->GetWatchDescriptor());
+        if (!slot || !slot->watch)
         {
             wxFAIL_MSG( wxString::Format("Path %s is not watched",
                                           watch->GetPath()) );
         }
-        // Cache the wd in case any events arrive late
-        m_staleDescriptors.Add(watch->GetWatchDescriptor());
+        else
+        {
+            slot->watch = NULL;
+
+            // Remember the wd in case any events arrive late
+            slot->stale = true;
+        }
 
         watch->SetWatchDescriptor(-1);
         return true;
@@ -174,14 +211,15 @@ public:
                     "Inotify not initialized or invalid inotify descriptor" );
 
         // read events
-        // TODO differentiate depending on params
-        char buf[128 * sizeof(inotify_event)];
-        int left = ReadEventsToBuf(buf, sizeof(buf));
+        if (!m_buffer)
+            m_buffer.reset(new char[wxINOTIFY_BUFFER_SIZE]);
+
+        int left = ReadEventsToBuf(m_buffer.get(), wxINOTIFY_BUFFER_SIZE);
         if (left == -1)
             return -1;
 
         // left > 0, we have events
-        char* memory = buf;
+        char* memory = m_buffer.get();
         int event_count = 0;
         while (left > 0) // OPT checking 'memory' would suffice
         {
@@ -200,6 +238,9 @@ public:
         ProcessRenames();
 
         wxLogTrace(wxTRACE_FSWATCHER, "We had %d native events", event_count);
+
+        SendBatch();
+
         return event_count;
     }
 
@@ -231,14 +272,14 @@ protected:
         // will be already removed from our list at that time
         if (inevt.mask & IN_IGNORED)
         {
-            // It is now safe to remove it from the stale descriptors too, we
+            // It is now safe to forget about the stale descriptor too, we
             // won't get any more events for it.
             // However if we're here because a dir that we're still watching
-            // has just been deleted, its wd won't be on this list
-            const int pos = m_staleDescriptors.Index(inevt.wd);
-            if ( pos != wxNOT_FOUND )
+            // has just been deleted, its wd won't be stale
+            wxInotifyWatchSlot* const slot = GetSlot(inevt.wd);
+            if ( slot && slot->stale )
             {
-                m_staleDescriptors.RemoveAt(static_cast<size_t>(pos));
+                slot->stale = false;
                 wxLogTrace(wxTRACE_FSWATCHER,
                        "Removed wd %i from the stale-wd cache", inevt.wd);
             }
@@ -246,15 +287,16 @@ protected:
         }
 
         // get watch entry for this event
-        wxFSWatchEntryDescriptors::iterator it = m_watchMap.find(inevt.wd);
+        wxFSWatchEntry* const pwatch = FindWatch(inevt.wd);
 
         // wd will be -1 for IN_Q_OVERFLOW, which would trigger the wxFAIL_MSG
         if (inevt.wd != -1)
         {
-            if (it == m_watchMap.end())
+            if (!pwatch)
             {
-                // It's not in the map; check if was recently removed from it.
-                if (m_staleDescriptors.Index(inevt.wd) != wxNOT_FOUND)
+                // It's not in the table; check if was recently removed from it.
+                const wxInotifyWatchSlot* const slot = GetSlot(inevt.wd);
+                if (slot && slot->stale)
                 {
                     wxLogTrace(wxTRACE_FSWATCHER,
                                "Got an event for stale wd %i", inevt.wd);
@@ -276,7 +318,7 @@ protected:
                              inevt.len ? inevt.name : ""
                             )
                         );
-                    SendEvent(event);
+                    AddToBatch(event);
 
                 }
 
@@ -305,7 +347,7 @@ protected:
             }
 
             wxFileSystemWatcherEvent event(flags, warningType);
-            SendEvent(event);
+            AddToBatch(event);
             return;
         }
 
@@ -324,18 +366,18 @@ protected:
                         inevt.len ? inevt.name : ""
                     )
                 );
-            SendEvent(event);
+            AddToBatch(event);
             return;
         }
 
-        wxFSWatchEntry& watch = *(it->second);
+        wxFSWatchEntry& watch = *pwatch;
 
         // Now IN_UNMOUNT. We must do so here, as it's not in the watch flags
         if (nativeFlags & IN_UNMOUNT)
         {
             wxFileName path = GetEventPath(watch, inevt);
             wxFileSystemWatcherEvent event(wxFSW_EVENT_UNMOUNT, path, path);
-            SendEvent(event);
+            AddToBatch(event);
         }
         // filter out ignored events and those not asked for.
         // we never filter out warnings or exceptions
@@ -364,7 +406,7 @@ protected:
                 if (watch.GetFilespec().empty())
                 {
                     wxFileSystemWatcherEvent event(flags, fn, fn);
-                    SendEvent(event);
+                    AddToBatch(event);
                 }
             }
         }
@@ -387,8 +429,11 @@ protected:
             wxString path(fn.GetPathWithSep());
             const wxString filespec(watch.GetFilespec());
 
-            if (m_watchMap.erase(inevt.wd) == 1)
+            wxInotifyWatchSlot* const slot = GetSlot(inevt.wd);
+            if (slot && slot->watch)
             {
+                slot->watch = NULL;
+
                 // Delete from wxFileSystemWatcher
                 wxDynamicCast(m_watcher, wxInotifyFileSystemWatcher)->
                                             OnDirDeleted(path);
@@ -401,8 +446,8 @@ protected:
                     m_watches.erase(wit);
                 }
 
-                // Cache the wd in case any events arrive late
-                m_staleDescriptors.Add(inevt.wd);
+                // Remember the wd in case any events arrive late
+                slot->stale = true;
             }
 
             // Tell the owner, in case it's interested
@@ -410,7 +455,7 @@ protected:
             if (filespec.empty())
             {
                 wxFileSystemWatcherEvent event(flags, fn, fn);
-                SendEvent(event);
+                AddToBatch(event);
             }
         }
 
@@ -450,17 +495,11 @@ protected:
                     // normally the IN_MOVED_FROM, is to retrieve the watch
                     // corresponding to oldinevt. This is needed for a move
                     // within a watch.
-                    wxFSWatchEntry* oldwatch;
-                    wxFSWatchEntryDescriptors::iterator oldwatch_it =
-                                                m_watchMap.find(oldinevt.wd);
-                    if (oldwatch_it != m_watchMap.end())
-                    {
-                        oldwatch = oldwatch_it->second;
-                    }
-                    else
+                    wxFSWatchEntry* oldwatch = FindWatch(oldinevt.wd);
+                    if (!oldwatch)
                     {
                         wxLogTrace(wxTRACE_FSWATCHER,
-                            "oldinevt's watch descriptor not in the watch map");
+                            "oldinevt's watch descriptor not in the watch table");
                         // For want of a better alternative, use 'watch'. That
                         // will work fine for renames, though not for moves
                         oldwatch = &watch;
@@ -477,7 +516,7 @@ protected:
                         event.SetPath(GetEventPath(*oldwatch, oldinevt));
                         event.SetNewPath(GetEventPath(watch, inevt));
                     }
-                    SendEvent(event);
+                    AddToBatch(event);
                 }
 
                 m_cookies.erase(it2);
@@ -492,7 +531,7 @@ protected:
             if ( MatchesFilespec(path, watch.GetFilespec()) )
             {
                 wxFileSystemWatcherEvent event(flags, path, path);
-                SendEvent(event);
+                AddToBatch(event);
             }
         }
     }
@@ -510,24 +549,24 @@ protected:
             wxLogTrace(wxTRACE_FSWATCHER, InotifyEventToString(inevt));
 
             // get watch entry for this event
-            wxFSWatchEntryDescriptors::iterator wit = m_watchMap.find(inevt.wd);
-            if (wit == m_watchMap.end())
+            wxFSWatchEntry* const pwatch = FindWatch(inevt.wd);
+            if (!pwatch)
             {
                 wxLogTrace(wxTRACE_FSWATCHER,
-                            "Watch descriptor not present in the watch map!");
+                            "Watch descriptor not present in the watch table!");
             }
             else
             {
                 // Tell the owner, in case it's interested
                 // If there's a filespec, assume he's not
-                wxFSWatchEntry& watch = *(wit->second);
+                wxFSWatchEntry& watch = *pwatch;
                 if ( watch.GetFilespec().empty() )
                 {
                     int flags = Native2WatcherFlags(inevt.mask);
                     wxFileName path = GetEventPath(watch, inevt);
                     {
                         wxFileSystemWatcherEvent event(flags, path, path);
-                        SendEvent(event);
+                        AddToBatch(event);
                     }
                 }
             }
@@ -544,12 +583,85 @@ protected:
         m_watcher->GetOwner()->ProcessEvent(evt);
     }
 
+    // Add the event to the batch sent by SendBatch() after processing all
+    // the events read at once, unless it just repeats the last event for the
+    // same path, as it happens when a file is written to, or read from, in
+    // several chunks.
+    void AddToBatch(const wxFileSystemWatcherEvent& evt)
+    {
+        const int changeType = evt.GetChangeType();
+
+        wxString path;
+        if (!evt.IsError())
+        {
+            path = evt.GetPath().GetFullPath();
+
+            if (changeType == wxFSW_EVENT_MODIFY ||
+                    changeType == wxFSW_EVENT_ACCESS)
+            {
+                wxInotifyBatchIndices::const_iterator
+                    it = m_batchIndices.find(path);
+                if (it != m_batchIndices.end() &&
+                        m_batch[it->second]->GetChangeType() == changeType)
+                {
+                    wxLogTrace(wxTRACE_FSWATCHER,
+                               "Coalescing repeated event for \"%s\"", path);
+                    return;
+                }
+            }
+        }
+
+        const size_t index = m_batch.size();
+        m_batch.push_back(new wxFileSystemWatcherEvent(evt));
+
+        if (!path.empty())
+        {
+            m_batchIndices[path] = index;
+
+            const wxString newPath = evt.GetNewPath().GetFullPath();
+            if (newPath != path)
+                m_batchIndices[newPath] = index;
+        }
+    }
+
+    // Send all the events accumulated by AddToBatch() in a single
+    // wxFileSystemWatcherBatchEvent or, if it's not processed, individually.
+    void SendBatch()
+    {
+        if (m_batch.empty())
+            return;
+
+        m_batchIndices.clear();
+
+        // Take the events from m_batch before sending them, the event
+        // handlers could reenter ReadEvents() by running a nested event loop.
+        wxFileSystemWatcherBatchEvent batch;
+        for (size_t n = 0; n < m_batch.size(); n++)
+            batch.AddEvent(m_batch[n]);
+        m_batch.clear();
+
+        wxLogTrace(wxTRACE_FSWATCHER, "Sending a batch of %lu events",
+                   static_cast<unsigned long>(batch.GetEventCount()));
+
+        wxEvtHandler* const owner = m_watcher->GetOwner();
+        if (owner->ProcessEvent(batch))
+            return;
+
+        for (size_t n = 0; n < batch.GetEventCount(); n++)
+        {
+            // The event needs to be copied as ProcessEvent() takes a
+            // non-const reference.
+            wxFileSystemWatcherEvent event(batch.GetEvent(n));
+            wxLogTrace(wxTRACE_FSWATCHER, event.ToString());
+            owner->ProcessEvent(event);
+        }
+    }
+
     int ReadEventsToBuf(char* buf, int size)
     {
         wxCHECK_MSG( IsOk(), false,
                     "Inotify not initialized or invalid inotify descriptor" );
 
-        memset(buf, 0, size);
         ssize_t left = read(m_ifd, buf, size);
         if (left == -1)
         {
@@ -582,10 +694,10 @@ protected:
                                    const inotify_event& inevt)
     {
         // only when dir is watched, we have non-empty e.name
-        wxFileName path = watch.GetPath();
+        wxFileName path = watch.GetFileName();
         if (path.IsDir() && inevt.len)
         {
-            path = wxFileName(path.GetPath(), inevt.name);
+            path.SetFullName(inevt.name);
         }
         return path;
     }
@@ -654,12 +766,47 @@ protected:
         return -1;
     }
 
+    // Return the slot for the given descriptor or NULL if there is none.
+    wxInotifyWatchSlot* GetSlot(int wd)
+    {
+        if (wd < 0 || static_cast<size_t>(wd) >= m_watchTable.size())
+            return NULL;
+
+        return &m_watchTable[wd];
+    }
+
+    wxInotifyWatchSlot& GetOrCreateSlot(int wd)
+    {
+        if (static_cast<size_t>(wd) >= m_watchTable.size())
+            m_watchTable.resize(wd + 1);
+
+        return m_watchTable[wd];
+    }
+
+    wxFSWatchEntry* FindWatch(int wd)
+    {
+        const wxInotifyWatchSlot* const slot = GetSlot(wd);
+        return slot ? slot->watch : NULL;
+    }
+
     wxFSWSourceHandler* m_handler;        // handler for inotify event source
-    wxFSWatchEntryDescriptors m_watchMap; // inotify wd=>wxFSWatchEntry* map
-    wxArrayInt m_staleDescriptors;        // stores recently-removed watches
+
+    // Table indexed by inotify watch descriptors: as they are allocated
+    // sequentially, starting from 1, this is more compact and faster than a
+    // hash map.
+    wxVector<wxInotifyWatchSlot> m_watchTable;
+
     wxInotifyCookies m_cookies;           // map to track renames
     wxEventLoopSource* m_source;          // our event loop source
 
+    // buffer used by ReadEvents(), allocated on first use
+    wxScopedArray<char> m_buffer;
+
+    // events to be sent by SendBatch() and the index of the last event for
+    // each path in it, used for coalescing them
+    wxVector<wxFileSystemWatcherEvent*> m_batch;
+    wxInotifyBatchIndices m_batchIndices;
+
     // file descriptor created by inotify_init()
     int m_ifd;
 };
@@ -687,6 +834,223 @@ void wxFSWSourceHandler::OnExceptionWaiting()
 }
 
 
+// ============================================================================
+// wxInotifyTreeScan: finds the directories for AddTreeAsync()
+// ============================================================================
+
+#ifdef wxHAS_INOTIFY_ASYNC_TREE
+
+// The directories of the tree are found by a pool task, which uses
+// wxDir::TraverseParallel() to read them, and are watched in the main thread,
+// from OnTreeScanProgress() called via CallAfter().
+class wxInotifyTreeScan
+{
+public:
+    // The result of TakeDirs().
+    enum State
+    {
+        State_Pending,  // more directories are available already
+        State_Running,  // OnTreeScanProgress() will be called when they are
+        State_Done      // all directories have been returned
+    };
+
+    wxInotifyTreeScan(wxInotifyFileSystemWatcher* watcher,
+                      const wxFileName& path,
+                      const wxString& root,
+                      int events,
+                      const wxString& filespec)
+        : m_watcher(watcher),
+          m_path(path),
+          m_root(root),
+          m_events(events),
+          m_filespec(filespec)
+    {
+        m_notified = false;
+        m_done = false;
+        m_cancelled = false;
+    }
+
+    void Start()
+    {
+        m_task = wxThreadPool::Get().Run(ScanTask(this));
+    }
+
+    // Stop the scan, must be called before deleting this object.
+    void Cancel()
+    {
+        {
+            wxCriticalSectionLocker lock(m_cs);
+            m_cancelled = true;
+            m_found.clear();
+        }
+
+        m_task->Wait();
+    }
+
+    // Move at most maxCount of the directories found so far to dirs.
+    State TakeDirs(wxArrayString& dirs, size_t maxCount)
+    {
+        {
+            wxCriticalSectionLocker lock(m_cs);
+
+            while ( maxCount && !m_found.empty() )
+            {
+                dirs.push_back(m_found.back());
+                m_found.pop_back();
+                maxCount--;
+            }
+
+            if ( !m_found.empty() )
+            {
+                // Our caller is responsible for calling us again.
+                return State_Pending;
+            }
+
+            if ( !m_done )
+            {
+                m_notified = false;
+                return State_Running;
+            }
+        }
+
+        // The task doesn't use this object any more, but it may still be
+        // running, wait until it returns before allowing to delete us.
+        m_task->Wait();
+        return State_Done;
+    }
+
+    const wxString& GetRoot() const { return m_root; }
+    int GetEvents() const { return m_events; }
+    const wxString& GetFilespec() const { return m_filespec; }
+
+private:
+    class ScanTraverser : public wxDirBatchTraverser
+    {
+    public:
+        explicit ScanTraverser(wxInotifyTreeScan* scan) : m_scan(scan) { }
+
+        virtual wxDirTraverseResult
+        OnFiles(const wxString& WXUNUSED(dirname),
+                const wxArrayString& WXUNUSED(filenames)) wxOVERRIDE
+        {
+            return wxDIR_CONTINUE;
+        }
+
+        virtual wxDirTraverseResult OnDir(const wxString& dirname) wxOVERRIDE
+        {
+            return m_scan->AddDir(dirname) ? wxDIR_CONTINUE : wxDIR_STOP;
+        }
+
+    private:
+        wxInotifyTreeScan* const m_scan;
+    };
+
+    class ScanTask
+    {
+    public:
+        explicit ScanTask(wxInotifyTreeScan* scan) : m_scan(scan) { }
+
+        void operator()() const
+        {
+            m_scan->Scan();
+        }
+
+    private:
+        wxInotifyTreeScan* const m_scan;
+    };
+
+    // Called in a pool thread.
+    void Scan()
+    {
+        wxDir dir;
+        {
+            // Don't log errors from a pool thread: the directory could have
+            // been deleted after AddTreeAsync() was called, which is not an
+            // error.
+            wxLogNull noLog;
+            dir.Open(m_path.GetFullPath());
+        }
+
+        if ( dir.IsOpened() )
+        {
+            // Prevent infinite loops in trees containing symlinks, as in
+            // wxFileSystemWatcherBase::AddTree().
+            int flags = wxDIR_DIRS;
+            if ( !m_path.ShouldFollowLink() )
+                flags |= wxDIR_NO_FOLLOW;
+
+            ScanTraverser traverser(this);
+            dir.TraverseParallel(traverser, m_filespec, flags);
+        }
+
+        bool notify;
+        {
+            wxCriticalSectionLocker lock(m_cs);
+            m_done = true;
+            notify = !m_notified && !m_cancelled;
+            m_notified = true;
+        }
+
+        if ( notify )
+            Notify();
+    }
+
+    // Called in a pool thread for each directory found, returns false if the
+    // scan was cancelled.
+    bool AddDir(const wxString& dirname)
+    {
+        bool notify;
+        {
+            wxCriticalSectionLocker lock(m_cs);
+            if ( m_cancelled )
+                return false;
+
+            m_found.push_back(dirname);
+
+            notify = !m_notified;
+            m_notified = true;
+        }
+
+        if ( notify )
+            Notify();
+
+        return true;
+    }
+
+    void Notify()
+    {
+        m_watcher->CallAfter(&wxInotifyFileSystemWatcher::OnTreeScanProgress);
+    }
+
+
+    wxInotifyFileSystemWatcher* const m_watcher;
+    const wxFileName m_path;
+    const wxString m_root;
+    const int m_events;
+    const wxString m_filespec;
+
+    wxThreadPoolTaskPtr m_task;
+
+    // All the fields below are protected by this critical section.
+    wxCriticalSection m_cs;
+
+    // the directories found but not returned from TakeDirs() yet
+    wxArrayString m_found;
+
+    // true if OnTreeScanProgress() will be called
+    bool m_notified;
+
+    // true once the scan task has finished
+    bool m_done;
+
+    // true if Cancel() was called
+    bool m_cancelled;
+
+    wxDECLARE_NO_COPY_CLASS(wxInotifyTreeScan);
+};
+
+#endif // wxHAS_INOTIFY_ASYNC_TREE
+
 // ============================================================================
 // wxInotifyFileSystemWatcher implementation
 // ============================================================================
@@ -712,6 +1076,12 @@ wxInotifyFileSystemWatcher::wxInotifyFileSystemWatcher(const wxFileName& path,
 
 wxInotifyFileSystemWatcher::~wxInotifyFileSystemWatcher()
 {
+#ifdef wxHAS_INOTIFY_ASYNC_TREE
+    // This must be done before the base class dtor calls RemoveAll() as the
+    // scans can't be allowed to use this object any more.
+    while ( !m_treeScans.empty() )
+        CancelTreeScan(m_treeScans.size() - 1);
+#endif // wxHAS_INOTIFY_ASYNC_TREE
 }
 
 bool wxInotifyFileSystemWatcher::Init()
@@ -720,6 +1090,172 @@ bool wxInotifyFileSystemWatcher::Init()
     return m_service->Init();
 }
 
+bool wxInotifyFileSystemWatcher::RemoveTree(const wxFileName& path)
+{
+    if (!path.DirExists())
+        return false;
+
+    const wxString canonical = GetCanonicalPath(path);
+    wxCHECK_MSG( m_watches.find(canonical) != m_watches.end(), false,
+                 wxString::Format("Path '%s' is not watched", canonical) );
+
+    wxString prefix = canonical;
+    if ( !prefix.EndsWith(wxFILE_SEP_PATH) )
+        prefix += wxFILE_SEP_PATH;
+
+#ifdef wxHAS_INOTIFY_ASYNC_TREE
+    // There is no need to continue scanning the trees being removed.
+    for ( size_t n = 0; n < m_treeScans.size(); )
+    {
+        if ( m_treeScans[n]->GetRoot().StartsWith(prefix) )
+            CancelTreeScan(n);
+        else
+            n++;
+    }
+#endif // wxHAS_INOTIFY_ASYNC_TREE
+
+    // Instead of traversing the tree again, as the base class version does,
+    // find all the directories under it which we watch: this is much faster
+    // for big trees and also takes into account the directories created
+    // after AddTree() was called.
+    wxArrayString dirs;
+    for ( wxFSWatchInfoMap::const_iterator it = m_watches.begin();
+          it != m_watches.end();
+          ++it )
+    {
+        if ( it->second.GetType() != wxFSWPath_File &&
+                (it->first == canonical || it->first.StartsWith(prefix)) )
+        {
+            dirs.push_back(it->first);
+        }
+    }
+
+    for ( size_t n = 0; n < dirs.size(); n++ )
+    {
+        wxFSWatchInfoMap::iterator it = m_watches.find(dirs[n]);
+
+        wxFSWatchInfo& watch = it->second;
+        if ( !watch.DecRef() )
+        {
+            m_service->Remove(watch);
+            m_watches.erase(it);
+        }
+    }
+
+    return true;
+}
+
+#ifdef wxHAS_INOTIFY_ASYNC_TREE
+
+bool wxInotifyFileSystemWatcher::AddTreeAsync(const wxFileName& path,
+                                              int events,
+                                              const wxString& filespec)
+{
+    if (!path.DirExists())
+        return false;
+
+    // Watch the root directory immediately, so that we can report an error if
+    // we can't do it.
+    const wxFileName root(path.GetPathWithSep());
+    if ( !AddAny(root, events, wxFSWPath_Tree, filespec) )
+        return false;
+
+    wxInotifyTreeScan* const scan = new wxInotifyTreeScan
+                                        (
+                                            this,
+                                            path,
+                                            GetCanonicalPath(root),
+                                            events,
+                                            filespec
+                                        );
+    m_treeScans.push_back(scan);
+    scan->Start();
+
+    return true;
+}
+
+bool wxInotifyFileSystemWatcher::IsAddingTrees() const
+{
+    return !m_treeScans.empty();
+}
+
+bool wxInotifyFileSystemWatcher::RemoveAll()
+{
+    while ( !m_treeScans.empty() )
+        CancelTreeScan(m_treeScans.size() - 1);
+
+    return wxFileSystemWatcherBase::RemoveAll();
+}
+
+void wxInotifyFileSystemWatcher::CancelTreeScan(size_t n)
+{
+    wxInotifyTreeScan* const scan = m_treeScans[n];
+    m_treeScans.erase(m_treeScans.begin() + n);
+
+    scan->Cancel();
+    delete scan;
+}
+
+void wxInotifyFileSystemWatcher::OnTreeScanProgress()
+{
+    // Watching the directories is relatively slow, so don't do too much of it
+    // at once to avoid blocking the event loop for too long.
+    size_t budget = 1000;
+
+    bool pending = false;
+    for ( size_t n = 0; n < m_treeScans.size(); )
+    {
+        wxInotifyTreeScan* const scan = m_treeScans[n];
+
+        wxArrayString dirs;
+        const wxInotifyTreeScan::State state = scan->TakeDirs(dirs, budget);
+        budget -= dirs.size();
+
+        for ( size_t i = 0; i < dirs.size(); i++ )
+        {
+            const wxFileName fn = wxFileName::DirName(dirs[i]);
+
+            // Unlike AddTree(), don't increment the refcount of the
+            // directories which are already watched: they could have been
+            // added when we got IN_CREATE for them after the scan started.
+            if ( m_watches.find(GetCanonicalPath(fn)) != m_watches.end() )
+                continue;
+
+            if ( AddAny(fn, scan->GetEvents(), wxFSWPath_Tree,
+                        scan->GetFilespec()) )
+            {
+                wxLogTrace(wxTRACE_FSWATCHER,
+                   "--- AddTreeAsync adding directory '%s' ---", dirs[i]);
+            }
+        }
+
+        switch ( state )
+        {
+            case wxInotifyTreeScan::State_Pending:
+                pending = true;
+                break;
+
+            case wxInotifyTreeScan::State_Running:
+                break;
+
+            case wxInotifyTreeScan::State_Done:
+                wxLogTrace(wxTRACE_FSWATCHER,
+                   "--- AddTreeAsync finished for '%s' ---", scan->GetRoot());
+
+                m_treeScans.erase(m_treeScans.begin() + n);
+                delete scan;
+                continue;
+        }
+
+        n++;
+    }
+
+    if ( pending )
+        CallAfter(&wxInotifyFileSystemWatcher::OnTreeScanProgress);
+}
+
+#endif // wxHAS_INOTIFY_ASYNC_TREE
+
 void wxInotifyFileSystemWatcher::OnDirDeleted(const wxString& path)
 {
     if (!path.empty())
@@ -38,9 +38,6 @@
 
 #include "wx/unix/private/timer.h"
 
-#include "wx/listimpl.cpp"
-WX_DEFINE_LIST(wxTimerList)
-
 // trace mask for the debugging messages used here
 #define wxTrace_Timer wxT("timer")
 
@@ -50,58 +47,109 @@ WX_DEFINE_LIST(wxTimerList)
 
 wxTimerScheduler *wxTimerScheduler::ms_instance = NULL;
 
-wxTimerScheduler::~wxTimerScheduler()
+void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
 {
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
-    {
-        delete *node;
-    }
+    DoAddTimer(timer, expiration);
 }
 
-void wxTimerScheduler::AddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+void wxTimerScheduler::SetAt(size_t n, const wxTimerSchedule& s)
 {
-    DoAddTimer(new wxTimerSchedule(timer, expiration));
+    m_timers[n] = s;
+    s.m_timer->SetScheduleIndex(n);
 }
 
-void wxTimerScheduler::DoAddTimer(wxTimerSchedule *s)
+void wxTimerScheduler::SiftUp(size_t n)
 {
-    // do an insertion sort to keep the list sorted in expiration order
-    wxTimerList::iterator node;
-    for ( node = m_timers.begin(); node != m_timers.end(); ++node )
+    const wxTimerSchedule s = m_timers[n];
+    while ( n > 0 )
     {
-        wxASSERT_MSG( (*node)->m_timer != s->m_timer,
-                      wxT("adding the same timer twice?") );
+        const size_t parent = (n - 1) / 2;
+        if ( !s.IsBefore(m_timers[parent]) )
+            break;
+
+        SetAt(n, m_timers[parent]);
+        n = parent;
+    }
+
+    SetAt(n, s);
+}
 
-        if ( (*node)->m_expiration > s->m_expiration )
+void wxTimerScheduler::SiftDown(size_t n)
+{
+    const size_t count = m_timers.size();
+    const wxTimerSchedule s = m_timers[n];
+    for ( ;; )
+    {
+        size_t child = 2*n + 1;
+        if ( child >= count )
             break;
+
+        if ( child + 1 < count && m_timers[child + 1].IsBefore(m_timers[child]) )
+            child++;
+
+        if ( !m_timers[child].IsBefore(s) )
+            break;
+
+        SetAt(n, m_timers[child]);
+        n = child;
     }
 
-    m_timers.insert(node, s);
+    SetAt(n, s);
+}
 
-    wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
-               s->m_timer->GetId(),
-               s->m_expiration.ToString());
+void wxTimerScheduler::DoAddTimer(wxUnixTimerImpl *timer, wxUsecClock_t expiration)
+{
+    const size_t n = timer->GetScheduleIndex();
+    wxASSERT_MSG( n >= m_timers.size() || m_timers[n].m_timer != timer,
+                  wxT("adding the same timer twice?") );
+
+    m_timers.push_back(wxTimerSchedule(timer, expiration, m_nextOrder++));
+    SiftUp(m_timers.size() - 1);
+
+#if wxUSE_LOG_TRACE
+    // formatting the expiration time is relatively expensive and timers can
+    // be restarted very often, so avoid doing it unless really necessary
+    if ( wxLog::IsAllowedTraceMask(wxTrace_Timer) )
+    {
+        wxLogTrace(wxTrace_Timer, wxT("Inserted timer %d expiring at %s"),
+                   timer->GetId(),
+                   expiration.ToString());
+    }
+#endif // wxUSE_LOG_TRACE
 }
 
-void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
+void wxTimerScheduler::DoRemoveTimer(size_t n)
 {
-    wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
+    // replace the removed element with the last one and put it in its place
+    const size_t last = m_timers.size() - 1;
+    if ( n != last )
+    {
+        SetAt(n, m_timers[last]);
+        m_timers.pop_back();
 
-    for ( wxTimerList::iterator node = m_timers.begin();
-          node != m_timers.end();
-          ++node )
+        if ( n > 0 && m_timers[n].IsBefore(m_timers[(n - 1) / 2]) )
+            SiftUp(n);
+        else
+            SiftDown(n);
+    }
+    else
     {
-        if ( (*node)->m_timer == timer )
-        {
-            delete *node;
-            m_timers.erase(node);
-            return;
-        }
+        m_timers.pop_back();
     }
+}
+
+void wxTimerScheduler::RemoveTimer(wxUnixTimerImpl *timer)
+{
+#if wxUSE_LOG_TRACE
+    if ( wxLog::IsAllowedTraceMask(wxTrace_Timer) )
+        wxLogTrace(wxTrace_Timer, wxT("Removing timer %d"), timer->GetId());
+#endif // wxUSE_LOG_TRACE
 
-    wxFAIL_MSG( wxT("removing inexistent timer?") );
+    const size_t n = timer->GetScheduleIndex();
+    wxCHECK_RET( n < m_timers.size() && m_timers[n].m_timer == timer,
+                 wxT("removing inexistent timer?") );
+
+    DoRemoveTimer(n);
 }
 
 bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
@@ -111,7 +159,7 @@ bool wxTimerScheduler::GetNext(wxUsecClock_t *remaining) const
 
     wxCHECK_MSG( remaining, false, wxT("NULL pointer") );
 
-    *remaining = (*m_timers.begin())->m_expiration - wxGetUTCTimeUSec();
+    *remaining = m_timers[0].m_expiration - wxGetUTCTimeUSec();
     if ( *remaining < 0 )
     {
         // timer already expired, don't wait at all before notifying it
@@ -130,33 +178,35 @@ bool wxTimerScheduler::NotifyExpired()
 
     typedef wxVector<wxUnixTimerImpl *> TimerImpls;
     TimerImpls toNotify;
-    for ( wxTimerList::iterator next,
-            cur = m_timers.begin(); cur != m_timers.end(); cur = next )
+    while ( !m_timers.empty() && m_timers[0].m_expiration <= now )
     {
-        wxTimerSchedule * const s = *cur;
-        if ( s->m_expiration > now )
-        {
-            // as the list is sorted by expiration time, we can skip the rest
-            break;
-        }
+        wxUnixTimerImpl * const timer = m_timers[0].m_timer;
+        DoRemoveTimer(0);
 
-        // remember next as we will delete the node pointed to by cur
-        next = cur;
-        ++next;
+        // we can't notify the timer from this loop as the timer event handler
+        // could modify m_timers (for example, but not only, by stopping this
+        // timer), so do it after the loop end
+        toNotify.push_back(timer);
+    }
 
-        m_timers.erase(cur);
+    if ( toNotify.empty() )
+        return false;
 
-        // check whether we need to keep this timer
-        wxUnixTimerImpl * const timer = s->m_timer;
+    // check whether we need to keep the timers: notice that we do it only now
+    // and not in the loop above as otherwise we could find the same timer
+    // again if its interval were very small
+    for ( TimerImpls::const_iterator i = toNotify.begin(),
+                                     end = toNotify.end();
+          i != end;
+          ++i )
+    {
+        wxUnixTimerImpl * const timer = *i;
         if ( timer->IsOneShot() )
         {
             // the timer needs to be stopped but don't call its Stop() from
-            // here as it would attempt to remove the timer from our list and
+            // here as it would attempt to remove the timer from our heap and
             // we had already done it, so we just need to reset its state
             timer->MarkStopped();
-
-            // don't need it any more
-            delete s;
         }
         else // reschedule the next timer expiration
         {
@@ -164,20 +214,10 @@ bool wxTimerScheduler::NotifyExpired()
             // the current time instead of just offsetting it from the current
             // expiration time because it could happen that we're late and the
             // current expiration time is (far) in the past
-            s->m_expiration = now + timer->GetInterval()*1000;
-            DoAddTimer(s);
+            DoAddTimer(timer, now + timer->GetInterval()*1000);
         }
-
-        // we can't notify the timer from this loop as the timer event handler
-        // could modify m_timers (for example, but not only, by stopping this
-        // timer) which would render our iterators invalid, so do it after the
-        // loop end
-        toNotify.push_back(timer);
     }
 
-    if ( toNotify.empty() )
-        return false;
-
     for ( TimerImpls::const_iterator i = toNotify.begin(),
                                      end = toNotify.end();
           i != end;
@@ -197,6 +237,7 @@ wxUnixTimerImpl::wxUnixTimerImpl(wxTimer* timer)
                : wxTimerImpl(timer)
 {
     m_isRunning = false;
+    m_scheduleIndex = 0;
 }
 
 bool wxUnixTimerImpl::Start(int milliseconds, bool oneShot)
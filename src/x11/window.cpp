@@ -1038,6 +1038,8 @@ void wxWindowX11::DoSetSizeHints(int minW, int minH, int maxW, int maxH, int inc
     m_maxWidth = maxW;
     m_maxHeight = maxH;
 
+    InvalidateBestSize();
+
 #if !wxUSE_NANOX
     XSizeHints sizeHints;
     sizeHints.flags = 0;
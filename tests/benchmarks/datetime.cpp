@@ -17,3 +17,49 @@ BENCHMARK_FUNC(ParseDate)
     return dt.ParseDate("May 23, 2011") && dt.GetMonth() == wxDateTime::May;
 }
 
+
+// The date used by the formatting benchmarks below, don't use a constant one
+// to prevent the compiler from optimizing anything away.
+static wxDateTime GetBenchDate()
+{
+    return wxDateTime(23, wxDateTime::May, 2011, 17, 43, 12, 345);
+}
+
+static const char* const BENCH_FORMAT = "%a, %d %b %Y %H:%M:%S.%l";
+
+BENCHMARK_FUNC(FormatDate)
+{
+    return !GetBenchDate().Format(BENCH_FORMAT).empty();
+}
+
+BENCHMARK_FUNC(FormatDateCompiled)
+{
+    static const wxDateTimeFormatter formatter(BENCH_FORMAT);
+
+    return !formatter.Format(GetBenchDate()).empty();
+}
+
+BENCHMARK_FUNC(FormatDateToBuffer)
+{
+    static const wxDateTimeFormatter formatter(BENCH_FORMAT);
+
+    wxChar buf[64];
+    return formatter.FormatTo(buf, WXSIZEOF(buf), GetBenchDate()) != 0;
+}
+
+BENCHMARK_FUNC(ParseFormat)
+{
+    wxDateTime dt;
+    wxString::const_iterator end;
+    return dt.ParseFormat("2011-05-23 17:43:12", "%Y-%m-%d %H:%M:%S", &end) &&
+                dt.GetMonth() == wxDateTime::May;
+}
+
+BENCHMARK_FUNC(ParseFormatCompiled)
+{
+    static const wxDateTimeFormatter formatter("%Y-%m-%d %H:%M:%S");
+
+    wxDateTime dt;
+    return formatter.Parse("2011-05-23 17:43:12", &dt) &&
+                dt.GetMonth() == wxDateTime::May;
+}
@@ -0,0 +1,141 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/fileconf.cpp
+// Purpose:     wxFileConfig benchmarks
+// Author:      wxWidgets Team
+// Created:     2020-03-02
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/fileconf.h"
+#include "wx/filename.h"
+#include "wx/mstream.h"
+#include "wx/wfstream.h"
+#include "wx/sstream.h"
+
+#include "bench.h"
+
+#if wxUSE_CONFIG
+
+// The number of entries in the config used by the benchmarks below is this
+// number multiplied by the numeric parameter, if specified.
+static const int NUM_ENTRIES = 50000;
+
+// And the number of groups these entries are distributed among.
+static const int NUM_GROUPS = 50;
+
+static int GetNumEntries()
+{
+    long num = Bench::GetNumericParameter();
+    if ( !num )
+        num = 1;
+
+    return NUM_ENTRIES*num;
+}
+
+static wxString GetEntryKey(int n)
+{
+    return wxString::Format("/Group%d/Entry%d", n % NUM_GROUPS, n);
+}
+
+// Contents of the config file with GetNumEntries() entries, in the same format
+// as written by wxFileConfig itself.
+static wxString gs_configText;
+
+static bool FileConfigInit()
+{
+    wxStringOutputStream sos;
+    {
+        wxFileConfig fc(wxString(), wxString(), wxString(), wxString(), 0);
+
+        const int numEntries = GetNumEntries();
+        for ( int n = 0; n < numEntries; n++ )
+            fc.Write(GetEntryKey(n), n);
+
+        if ( !fc.Save(sos) )
+            return false;
+    }
+
+    gs_configText = sos.GetString();
+
+    return true;
+}
+
+static void FileConfigDone()
+{
+    gs_configText.clear();
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigLoad, FileConfigInit, FileConfigDone)
+{
+    const wxScopedCharBuffer buf = gs_configText.utf8_str();
+    wxMemoryInputStream mis(buf.data(), buf.length());
+    wxFileConfig fc(mis);
+
+    return fc.GetNumberOfEntries(true) == size_t(GetNumEntries());
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigRead, FileConfigInit, FileConfigDone)
+{
+    const wxScopedCharBuffer buf = gs_configText.utf8_str();
+    wxMemoryInputStream mis(buf.data(), buf.length());
+    wxFileConfig fc(mis);
+
+    long sum = 0;
+    const int numEntries = GetNumEntries();
+    for ( int n = 0; n < numEntries; n++ )
+        sum += fc.ReadLong(GetEntryKey(n), 0);
+
+    return sum != 0;
+}
+
+BENCHMARK_FUNC(FileConfigWrite)
+{
+    wxFileConfig fc(wxString(), wxString(), wxString(), wxString(), 0);
+
+    const int numEntries = GetNumEntries();
+    for ( int n = 0; n < numEntries; n++ )
+        fc.Write(GetEntryKey(n), n);
+
+    return fc.GetNumberOfEntries(true) == size_t(numEntries);
+}
+
+static wxString gs_configFile;
+
+static bool FileConfigFlushInit()
+{
+    if ( !FileConfigInit() )
+        return false;
+
+    gs_configFile = wxFileName::CreateTempFileName("benchfc");
+
+    return !gs_configFile.empty();
+}
+
+static void FileConfigFlushDone()
+{
+    wxRemoveFile(gs_configFile);
+    gs_configFile.clear();
+
+    FileConfigDone();
+}
+
+BENCHMARK_FUNC_WITH_INIT(FileConfigFlush, FileConfigFlushInit, FileConfigFlushDone)
+{
+    const wxScopedCharBuffer buf = gs_configText.utf8_str();
+    wxMemoryInputStream mis(buf.data(), buf.length());
+    wxFileConfig fc(mis);
+    fc.DisableAutoSave();
+
+    // Writing the values which didn't change shouldn't require saving the
+    // file at all, so modify just one value before flushing.
+    const int numEntries = GetNumEntries();
+    for ( int n = 0; n < numEntries; n += 100 )
+        fc.Write(GetEntryKey(n), n);
+    fc.Write(GetEntryKey(0), -1);
+
+    wxFileOutputStream fos(gs_configFile);
+    return fos.IsOk() && fc.Save(fos);
+}
+
+#endif // wxUSE_CONFIG
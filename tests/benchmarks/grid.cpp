@@ -0,0 +1,104 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/grid.cpp
+// Purpose:     wxGrid benchmarks
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/frame.h"
+#include "wx/grid.h"
+
+#include "bench.h"
+
+#if wxUSE_GRID
+
+// The size of the grid used by the benchmarks below.
+static const int NUM_ROWS = 1000;
+static const int NUM_COLS = 20;
+
+// The benchmarks below simulate one second of updates arriving at this rate,
+// multiplied by the numeric parameter, if specified, and shown at the given
+// number of frames per second.
+static const int UPDATES_PER_SECOND = 10000;
+static const int FRAMES_PER_SECOND = 50;
+
+static wxFrame* gs_frame = NULL;
+static wxGrid* gs_grid = NULL;
+
+static bool GridInit()
+{
+    // Notice that the grid must be shown, as nothing is repainted otherwise.
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxGrid benchmark",
+                           wxDefaultPosition, wxSize(800, 600));
+    gs_grid = new wxGrid(gs_frame, wxID_ANY);
+    gs_grid->CreateGrid(NUM_ROWS, NUM_COLS);
+    gs_frame->Show();
+    gs_grid->Update();
+
+    return true;
+}
+
+static void GridDone()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_grid = NULL;
+}
+
+// Update the values of the cells scattered over the visible part of the grid
+// using the given function and repaint the grid after every frame.
+static bool GridUpdate(void (*updateCell)(int row, int col, const wxString& s))
+{
+    long num = Bench::GetNumericParameter();
+    if ( !num )
+        num = 1;
+
+    const int numVisibleRows = 30;
+
+    unsigned seed = 1;
+    for ( int frame = 0; frame < FRAMES_PER_SECOND; frame++ )
+    {
+        for ( long n = 0; n < UPDATES_PER_SECOND*num/FRAMES_PER_SECOND; n++ )
+        {
+            seed = seed*1103515245 + 12345;
+
+            const int row = (seed >> 8) % numVisibleRows;
+            const int col = (seed >> 16) % NUM_COLS;
+            updateCell(row, col, wxString::Format("%u.%02u",
+                                                  seed % 1000, seed % 100));
+        }
+
+        gs_grid->RefreshChangedCells();
+        gs_grid->Update();
+    }
+
+    return true;
+}
+
+static void SetCellValue(int row, int col, const wxString& s)
+{
+    gs_grid->SetCellValue(row, col, s);
+}
+
+static void MarkCellChanged(int row, int col, const wxString& s)
+{
+    gs_grid->GetTable()->SetValue(row, col, s);
+    gs_grid->MarkCellChanged(row, col);
+}
+
+// Use SetCellValue() which refreshes the row containing the cell immediately.
+BENCHMARK_FUNC_WITH_INIT(GridUpdateSetCellValue, GridInit, GridDone)
+{
+    return GridUpdate(SetCellValue);
+}
+
+// Update the table directly and let the grid refresh all the changed cells at
+// once.
+BENCHMARK_FUNC_WITH_INIT(GridUpdateMarkCellChanged, GridInit, GridDone)
+{
+    return GridUpdate(MarkCellChanged);
+}
+
+#endif // wxUSE_GRID
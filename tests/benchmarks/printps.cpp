@@ -0,0 +1,119 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/printps.cpp
+// Purpose:     wxPostScriptDC benchmarks
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/bitmap.h"
+#include "wx/dcps.h"
+#include "wx/filefn.h"
+#include "wx/filename.h"
+#include "wx/image.h"
+#include "wx/vector.h"
+
+#include "bench.h"
+
+#if wxUSE_POSTSCRIPT
+
+// The number of pages in the report generated by the benchmarks below is this
+// number multiplied by the numeric parameter, if specified.
+static const int NUM_PAGES = 10;
+
+// The number of rows on every page of the report.
+static const int ROWS_PER_PAGE = 50;
+
+static wxString gs_psFile;
+static wxBitmap gs_icon;
+static wxVector<wxBitmap> gs_photos;
+
+// Create a bitmap of the given size filled with a pattern depending on the
+// seed value.
+static wxBitmap CreatePatternBitmap(int width, int height, int seed)
+{
+    wxImage image(width, height);
+    for ( int y = 0; y < height; y++ )
+    {
+        for ( int x = 0; x < width; x++ )
+        {
+            image.SetRGB(x, y,
+                         (x*seed) % 256,
+                         (y*seed) % 256,
+                         ((x + y)/4 + seed) % 256);
+        }
+    }
+
+    return wxBitmap(image);
+}
+
+static bool PostScriptInit()
+{
+    gs_psFile = wxFileName::CreateTempFileName("benchps");
+    if ( gs_psFile.empty() )
+        return false;
+
+    gs_icon = CreatePatternBitmap(32, 32, 1);
+
+    // Use a few different images for the "photos" shown on each page.
+    for ( int n = 0; n < 4; n++ )
+        gs_photos.push_back(CreatePatternBitmap(200, 150, n + 2));
+
+    return true;
+}
+
+static void PostScriptDone()
+{
+    wxRemoveFile(gs_psFile);
+    gs_psFile.clear();
+
+    gs_icon = wxBitmap();
+    gs_photos.clear();
+}
+
+// Generate a multi-page report with some text, lines and images: a small icon
+// repeated in every row and a bigger picture shown on every page.
+BENCHMARK_FUNC_WITH_INIT(PostScriptReport, PostScriptInit, PostScriptDone)
+{
+    long num = Bench::GetNumericParameter();
+    if ( !num )
+        num = 1;
+
+    wxPrintData printData;
+    printData.SetPrintMode(wxPRINT_MODE_FILE);
+    printData.SetFilename(gs_psFile);
+
+    wxPostScriptDC dc(printData);
+
+    // Allow using compressed and shared images data.
+    dc.SetLanguageLevel(3);
+
+    if ( !dc.IsOk() || !dc.StartDoc("Benchmark report") )
+        return false;
+
+    for ( long page = 0; page < NUM_PAGES*num; page++ )
+    {
+        dc.StartPage();
+
+        dc.DrawBitmap(gs_photos[page % gs_photos.size()], 50, 20);
+
+        for ( int row = 0; row < ROWS_PER_PAGE; row++ )
+        {
+            const int y = 200 + 12*row;
+
+            dc.DrawBitmap(gs_icon, 20, y);
+            dc.DrawText(wxString::Format("Item %ld", page*ROWS_PER_PAGE + row),
+                        60, y);
+            dc.DrawLine(20, y + 11, 500, y + 11);
+        }
+
+        dc.EndPage();
+    }
+
+    dc.EndDoc();
+
+    return wxFileName::GetSize(gs_psFile) > 0;
+}
+
+#endif // wxUSE_POSTSCRIPT
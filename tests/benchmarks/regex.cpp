@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/regex.cpp
+// Purpose:     wxRegEx benchmarks
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/regex.h"
+
+#include "bench.h"
+
+#if wxUSE_REGEX
+
+// The number of strings used by the benchmarks below is this number
+// multiplied by the numeric parameter, if specified.
+static const int NUM_STRINGS = 10000;
+
+static wxArrayString gs_strings;
+
+static bool StringsInit()
+{
+    long num = Bench::GetNumericParameter();
+    if ( !num )
+        num = 1;
+
+    for ( long n = 0; n < NUM_STRINGS*num; n++ )
+    {
+        gs_strings.push_back(wxString::Format("row %ld: item-%ld in /usr/lib/%ld",
+                                              n, n*7919 % 100003, n % 97));
+    }
+
+    return true;
+}
+
+static void StringsDone()
+{
+    gs_strings.clear();
+}
+
+// Compile the same expressions repeatedly, as is done by a filter control
+// while the user is typing.
+BENCHMARK_FUNC(RegExCompile)
+{
+    static const char* const patterns[] =
+    {
+        "item-[0-9]+3",
+        "^row [0-9]*7:",
+        "/usr/(lib|bin)/[1-5]+$",
+    };
+
+    bool ok = true;
+    for ( size_t n = 0; n < WXSIZEOF(patterns); n++ )
+    {
+        wxRegEx re(patterns[n]);
+        if ( !re.IsValid() )
+            ok = false;
+    }
+
+    return ok;
+}
+
+// Check all the strings one by one.
+BENCHMARK_FUNC_WITH_INIT(RegExMatches, StringsInit, StringsDone)
+{
+    wxRegEx re("item-[0-9]*42");
+
+    size_t count = 0;
+    for ( size_t n = 0; n < gs_strings.size(); n++ )
+    {
+        if ( re.Matches(gs_strings[n]) )
+            count++;
+    }
+
+    return count != 0;
+}
+
+// Check all the strings at once.
+BENCHMARK_FUNC_WITH_INIT(RegExFilter, StringsInit, StringsDone)
+{
+    wxRegEx re("item-[0-9]*42");
+
+    return re.Filter(gs_strings) != 0;
+}
+
+// Same as above but for an expression without a literal prefix.
+BENCHMARK_FUNC_WITH_INIT(RegExFilterNoPrefix, StringsInit, StringsDone)
+{
+    wxRegEx re("[a-z]+-[0-9]*42");
+
+    return re.Filter(gs_strings) != 0;
+}
+
+#endif // wxUSE_REGEX
@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/sizer.cpp
+// Purpose:     wxSizer layout benchmarks
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/frame.h"
+#include "wx/sizer.h"
+#include "wx/vector.h"
+
+#include "bench.h"
+
+// The number of rows in the form used by the benchmarks below is this number
+// multiplied by the numeric parameter, if specified.
+static const int NUM_ROWS = 1000;
+
+static wxFrame* gs_frame = NULL;
+static wxWindow* gs_panel = NULL;
+static wxVector<wxWindow*> gs_values;
+
+// Create a typical property editor form, with a label and a value with a
+// button in each of its rows.
+static bool SizerInit()
+{
+    long num = Bench::GetNumericParameter();
+    if ( !num )
+        num = 1;
+
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxSizer benchmark");
+    gs_panel = new wxWindow(gs_frame, wxID_ANY);
+
+    wxFlexGridSizer* const grid = new wxFlexGridSizer(2, wxSize(5, 5));
+    grid->AddGrowableCol(1);
+
+    for ( long n = 0; n < NUM_ROWS*num; n++ )
+    {
+        wxWindow* const label = new wxWindow(gs_panel, wxID_ANY);
+        label->SetInitialSize(wxSize(80 + n % 7, 20));
+        grid->Add(label, wxSizerFlags().CentreVertical());
+
+        wxWindow* const value = new wxWindow(gs_panel, wxID_ANY);
+        value->SetInitialSize(wxSize(100, 20));
+        gs_values.push_back(value);
+
+        wxWindow* const button = new wxWindow(gs_panel, wxID_ANY);
+        button->SetInitialSize(wxSize(20, 20));
+
+        wxBoxSizer* const row = new wxBoxSizer(wxHORIZONTAL);
+        row->Add(value, wxSizerFlags(1).Expand());
+        row->Add(button, wxSizerFlags().Border(wxLEFT));
+        grid->Add(row, wxSizerFlags().Expand());
+    }
+
+    wxBoxSizer* const top = new wxBoxSizer(wxVERTICAL);
+    top->Add(grid, wxSizerFlags(1).Expand().Border());
+    gs_panel->SetSizer(top);
+
+    return true;
+}
+
+static void SizerDone()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_panel = NULL;
+
+    gs_values.clear();
+}
+
+// Lay out the form using the given width, as is done when the window is
+// resized.
+static bool LayoutWithWidth(int width)
+{
+    wxSizer* const sizer = gs_panel->GetSizer();
+    sizer->SetDimension(0, 0, width, sizer->GetMinSize().y);
+
+    return gs_values[0]->GetSize().x > 0;
+}
+
+// Repeat the layout without changing anything.
+BENCHMARK_FUNC_WITH_INIT(SizerLayout, SizerInit, SizerDone)
+{
+    return LayoutWithWidth(400);
+}
+
+// Change the width of the form, which changes the size of all its rows.
+BENCHMARK_FUNC_WITH_INIT(SizerResize, SizerInit, SizerDone)
+{
+    static int s_delta = 0;
+    s_delta = (s_delta + 1) % 100;
+
+    return LayoutWithWidth(400 + s_delta);
+}
+
+// Change the minimal size of a single value before relaying out the form.
+BENCHMARK_FUNC_WITH_INIT(SizerChangeOne, SizerInit, SizerDone)
+{
+    static size_t s_n = 0;
+    s_n = (s_n + 1) % gs_values.size();
+
+    gs_values[s_n]->SetMinSize(wxSize(100 + s_n % 2, 20));
+
+    return LayoutWithWidth(400);
+}
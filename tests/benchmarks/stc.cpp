@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/stc.cpp
+// Purpose:     wxStyledTextCtrl benchmarks
+// Author:      wxWidgets Team
+// Created:     2020-03-10
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/frame.h"
+#include "wx/stc/stc.h"
+
+#include "bench.h"
+
+#if wxUSE_STC
+
+// The number of lines in the control is this number multiplied by the numeric
+// parameter, if specified.
+static const int NUM_LINES = 10000;
+
+static wxFrame* gs_frame = NULL;
+static wxStyledTextCtrl* gs_stc = NULL;
+
+// Create a (hidden) control containing syntax highlighted C++ code using the
+// given font.
+static bool STCInit(const wxFont& font)
+{
+    long num = Bench::GetNumericParameter();
+    if ( !num )
+        num = 1;
+
+    gs_frame = new wxFrame(NULL, wxID_ANY, "wxSTC benchmark");
+    gs_stc = new wxStyledTextCtrl(gs_frame, wxID_ANY);
+
+    gs_stc->StyleSetFont(wxSTC_STYLE_DEFAULT, font);
+    gs_stc->StyleClearAll();
+    gs_stc->SetLexer(wxSTC_LEX_CPP);
+    gs_stc->SetKeyWords(0, "const int return static");
+    gs_stc->StyleSetForeground(wxSTC_C_COMMENTLINE, *wxGREEN);
+    gs_stc->StyleSetForeground(wxSTC_C_NUMBER, *wxRED);
+    gs_stc->StyleSetForeground(wxSTC_C_STRING, *wxBLUE);
+    gs_stc->StyleSetBold(wxSTC_C_WORD, true);
+
+    // Make all lines different, to avoid only measuring Scintilla own cache,
+    // and use some non-ASCII characters too.
+    wxString text;
+    const int numLines = NUM_LINES*num;
+    for ( int n = 0; n < numLines; n++ )
+    {
+        if ( n % 8 )
+        {
+            text += wxString::Format
+                    (
+                        "    const int value%d = Compute(%d, \"line %d\"); "
+                        "// see value%d\n",
+                        n, n*7, n, n / 2
+                    );
+        }
+        else
+        {
+            text += wxString::Format
+                    (
+                        wxString::FromUTF8("    // Die Gr\xc3\xb6\xc3\x9f" "e "
+                                           "der Zeile %d ist %d\n"),
+                        n, n*3
+                    );
+        }
+    }
+
+    gs_stc->SetText(text);
+    gs_stc->Colourise(0, -1);
+
+    return gs_stc->GetLineCount() > numLines;
+}
+
+static bool STCInitFixed()
+{
+    return STCInit(wxFont(wxFontInfo(10).Family(wxFONTFAMILY_TELETYPE)));
+}
+
+static bool STCInitProportional()
+{
+    return STCInit(wxFont(wxFontInfo(10).Family(wxFONTFAMILY_SWISS)));
+}
+
+static void STCDone()
+{
+    delete gs_frame;
+    gs_frame = NULL;
+    gs_stc = NULL;
+}
+
+// Lay out all lines of the control: getting the position of the end of the
+// line requires Scintilla to measure all the text in it.
+static bool STCLayoutAllLines()
+{
+    long total = 0;
+
+    const int numLines = gs_stc->GetLineCount();
+    for ( int n = 0; n < numLines; n++ )
+        total += gs_stc->PointFromPosition(gs_stc->GetLineEndPosition(n)).x;
+
+    return total > 0;
+}
+
+BENCHMARK_FUNC_WITH_INIT(STCLayoutFixed, STCInitFixed, STCDone)
+{
+    return STCLayoutAllLines();
+}
+
+BENCHMARK_FUNC_WITH_INIT(STCLayoutProportional, STCInitProportional, STCDone)
+{
+    return STCLayoutAllLines();
+}
+
+#endif // wxUSE_STC
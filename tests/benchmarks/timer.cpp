@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/timer.cpp
+// Purpose:     wxTimer benchmarks
+// Author:      wxWidgets Team
+// Created:     2020-03-11
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/timer.h"
+#include "wx/vector.h"
+
+#include "bench.h"
+
+#if wxUSE_TIMER
+
+// The number of timers used by the benchmarks below is this number multiplied
+// by the numeric parameter, if specified.
+static const int NUM_TIMERS = 10000;
+
+static wxVector<wxTimer*> gs_timers;
+
+static bool TimersInit()
+{
+    long num = Bench::GetNumericParameter();
+    if ( !num )
+        num = 1;
+
+    for ( long n = 0; n < NUM_TIMERS*num; n++ )
+        gs_timers.push_back(new wxTimer);
+
+    return true;
+}
+
+static void TimersDone()
+{
+    for ( size_t n = 0; n < gs_timers.size(); n++ )
+        delete gs_timers[n];
+
+    gs_timers.clear();
+}
+
+// Return an interval long enough for the timers to never expire during the
+// benchmark.
+static int GetInterval(size_t n)
+{
+    return 100000 + (n*7919) % 100000;
+}
+
+// Start all timers, restart them several times, as is typically done with the
+// timers used for timeouts, and stop them all.
+BENCHMARK_FUNC_WITH_INIT(TimerChurn, TimersInit, TimersDone)
+{
+    const size_t count = gs_timers.size();
+    for ( size_t n = 0; n < count; n++ )
+        gs_timers[n]->StartOnce(GetInterval(n));
+
+    for ( size_t i = 1; i <= 5; i++ )
+    {
+        for ( size_t n = 0; n < count; n++ )
+        {
+            // Use different order and intervals on each iteration.
+            const size_t m = (n*i*31) % count;
+            gs_timers[m]->StartOnce(GetInterval(n + i));
+        }
+    }
+
+    bool ok = true;
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( !gs_timers[n]->IsRunning() )
+            ok = false;
+
+        gs_timers[n]->Stop();
+    }
+
+    return ok;
+}
+
+#endif // wxUSE_TIMER
@@ -25,10 +25,65 @@
 #include "wx/panel.h"
 #include "wx/scopedptr.h"
 
+#include "wx/frame.h"
+
 #include "wx/aui/auibook.h"
+#include "wx/aui/framemanager.h"
 
 #include "asserthelper.h"
 
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Manager allowing to change the dock size in the same way as it's done when
+// the dock sash is dragged with the mouse.
+class TestAuiManager : public wxAuiManager
+{
+public:
+    explicit TestAuiManager(wxWindow* managedWnd)
+        : wxAuiManager(managedWnd)
+    {
+    }
+
+    virtual ~TestAuiManager()
+    {
+        UnInit();
+    }
+
+    int GetDockSize(int direction)
+    {
+        wxAuiDockInfo* const dock = FindDock(direction);
+        return dock ? dock->size : -1;
+    }
+
+    void ResizeDock(int direction, int size)
+    {
+        wxAuiDockInfo* const dock = FindDock(direction);
+        REQUIRE( dock );
+
+        dock->size = size;
+        UpdateSizes();
+    }
+
+private:
+    wxAuiDockInfo* FindDock(int direction)
+    {
+        for ( size_t n = 0; n < m_docks.size(); n++ )
+        {
+            if ( m_docks[n].dock_direction == direction )
+                return &m_docks[n];
+        }
+
+        return NULL;
+    }
+};
+
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 // test class
 // ----------------------------------------------------------------------------
@@ -131,4 +186,44 @@ TEST_CASE( "wxAuiNotebook::DoGetBestSize", "[aui]" )
     }
 }
 
+TEST_CASE( "wxAuiManager::ResizeDock", "[aui]" )
+{
+    wxScopedPtr<wxFrame>
+        frame(new wxFrame(wxTheApp->GetTopWindow(), wxID_ANY, "AUI frame",
+                          wxDefaultPosition, wxSize(600, 400)));
+
+    TestAuiManager mgr(frame.get());
+
+    wxPanel* const left = new wxPanel(frame.get());
+    wxPanel* const bottom = new wxPanel(frame.get());
+    wxPanel* const center = new wxPanel(frame.get());
+
+    mgr.AddPane(left, wxAuiPaneInfo().Left().BestSize(100, 100));
+    mgr.AddPane(bottom, wxAuiPaneInfo().Bottom().BestSize(100, 100));
+    mgr.AddPane(center, wxAuiPaneInfo().CenterPane());
+    mgr.Update();
+
+    const wxSize leftSize = left->GetSize();
+    const wxSize bottomSize = bottom->GetSize();
+    const wxSize centerSize = center->GetSize();
+
+    SECTION( "Vertical dock" )
+    {
+        mgr.ResizeDock(wxAUI_DOCK_LEFT, mgr.GetDockSize(wxAUI_DOCK_LEFT) + 50);
+
+        CHECK( left->GetSize() == leftSize + wxSize(50, 0) );
+        CHECK( center->GetSize() == centerSize - wxSize(50, 0) );
+        CHECK( bottom->GetSize() == bottomSize );
+    }
+
+    SECTION( "Horizontal dock" )
+    {
+        mgr.ResizeDock(wxAUI_DOCK_BOTTOM, mgr.GetDockSize(wxAUI_DOCK_BOTTOM) - 30);
+
+        CHECK( bottom->GetSize() == bottomSize - wxSize(0, 30) );
+        CHECK( center->GetSize() == centerSize + wxSize(0, 30) );
+        CHECK( left->GetSize() == leftSize + wxSize(0, 30) );
+    }
+}
+
 #endif
@@ -354,4 +354,92 @@ TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
     CHECK( m_lastColumn->GetWidth() >= lastColumnMinWidth );
 }
 
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+namespace
+{
+
+// List store providing the sort keys and counting how many times they are
+// requested.
+class SortKeysListStore : public wxDataViewListStore
+{
+public:
+    SortKeysListStore() { m_keyCount = 0; }
+
+    virtual bool HasSortKeys(unsigned int WXUNUSED(column)) const wxOVERRIDE
+    {
+        return true;
+    }
+
+    virtual void GetSortKey(wxDataViewSortKey& key,
+                            const wxDataViewItem& item,
+                            unsigned int column) const wxOVERRIDE
+    {
+        m_keyCount++;
+
+        wxDataViewListStore::GetSortKey(key, item, column);
+    }
+
+    mutable int m_keyCount;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxDVC::SortKeys", "[wxDataViewCtrl][sort]")
+{
+    wxDataViewCtrl* const
+        dvc = new wxDataViewCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                                 wxDefaultPosition, wxSize(400, 200));
+
+    SortKeysListStore* const store = new SortKeysListStore();
+    dvc->AssociateModel(store);
+    store->DecRef();
+
+    store->AppendColumn("string");
+    wxDataViewColumn* const
+        col = dvc->AppendTextColumn("Name", 0, wxDATAVIEW_CELL_INERT, -1,
+                                    wxALIGN_NOT, wxDATAVIEW_COL_SORTABLE);
+
+    const char* const names[] = { "delta", "alpha", "echo", "charlie", "bravo" };
+    for ( size_t n = 0; n < WXSIZEOF(names); n++ )
+    {
+        wxVector<wxVariant> values;
+        values.push_back(wxString(names[n]));
+        store->AppendItem(values);
+    }
+
+    dvc->Layout();
+
+    store->m_keyCount = 0;
+    col->SetSortOrder(true);
+    store->Resort();
+
+    // The key of each item is retrieved only once.
+    CHECK( store->m_keyCount == static_cast<int>(WXSIZEOF(names)) );
+
+    // And the items are sorted alphabetically: "alpha" is the second one,
+    // "bravo" the last one and so on.
+    const unsigned rows[] = { 1, 4, 3, 0, 2 };
+    for ( size_t n = 1; n < WXSIZEOF(rows); n++ )
+    {
+        INFO( "Item " << names[rows[n]] );
+        CHECK( dvc->GetItemRect(store->GetItem(rows[n - 1])).y <
+                dvc->GetItemRect(store->GetItem(rows[n])).y );
+    }
+
+    col->SetSortOrder(false);
+    store->Resort();
+
+    for ( size_t n = 1; n < WXSIZEOF(rows); n++ )
+    {
+        INFO( "Item " << names[rows[n]] );
+        CHECK( dvc->GetItemRect(store->GetItem(rows[n - 1])).y >
+                dvc->GetItemRect(store->GetItem(rows[n])).y );
+    }
+
+    delete dvc;
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
 #endif //wxUSE_DATAVIEWCTRL
@@ -19,6 +19,15 @@
     #include "wx/gauge.h"
 #endif // WX_PRECOMP
 
+#include "wx/progsrc.h"
+#include "wx/scopedptr.h"
+#include "wx/timer.h"
+#include "wx/vector.h"
+
+#if wxUSE_PROGRESSDLG
+    #include "wx/progdlg.h"
+#endif // wxUSE_PROGRESSDLG
+
 class GaugeTestCase : public CppUnit::TestCase
 {
 public:
@@ -107,4 +116,210 @@ void GaugeTestCase::Value()
     CPPUNIT_ASSERT_EQUAL(100, m_gauge->GetValue());
 }
 
+#if wxUSE_TIMER
+
+namespace
+{
+
+// Gauge allowing to sample the progress source without waiting for the timer
+// and counting the value changes.
+class ProgressSourceGauge : public wxGauge
+{
+public:
+    ProgressSourceGauge()
+        : wxGauge(wxTheApp->GetTopWindow(), wxID_ANY, 100),
+          m_numSetValue(0)
+    {
+    }
+
+    virtual void SetValue(int pos) wxOVERRIDE
+    {
+        m_numSetValue++;
+
+        wxGauge::SetValue(pos);
+    }
+
+    void TickProgressTimer() { m_progressTimer->Notify(); }
+
+    bool IsSampling() const
+    {
+        return m_progressTimer && m_progressTimer->IsRunning();
+    }
+
+    int m_numSetValue;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxGauge::SetProgressSource", "[gauge][progress]")
+{
+    wxScopedPtr<ProgressSourceGauge> gauge(new ProgressSourceGauge);
+
+    // Use a very long interval to ensure that the timer never fires on its own
+    // and only sample the source explicitly.
+    wxProgressSource source;
+    gauge->SetProgressSource(&source, 1000000);
+    CHECK( gauge->GetProgressSource() == &source );
+    CHECK( gauge->IsSampling() );
+
+    // Nothing changed yet.
+    gauge->TickProgressTimer();
+    CHECK( gauge->m_numSetValue == 0 );
+
+    source.SetValue(10);
+    source.Advance();
+    gauge->TickProgressTimer();
+    CHECK( gauge->m_numSetValue == 1 );
+    CHECK( gauge->GetValue() == 11 );
+
+    // Unchanged values must not result in any updates.
+    gauge->TickProgressTimer();
+    CHECK( gauge->m_numSetValue == 1 );
+
+    // The values beyond the range are clamped to it.
+    source.SetValue(200);
+    gauge->TickProgressTimer();
+    CHECK( gauge->m_numSetValue == 2 );
+    CHECK( gauge->GetValue() == 100 );
+
+    source.SetValue(150);
+    gauge->TickProgressTimer();
+    CHECK( gauge->m_numSetValue == 2 );
+
+    // Resetting the source stops sampling it.
+    gauge->SetProgressSource(NULL);
+    CHECK( !gauge->GetProgressSource() );
+    CHECK( !gauge->IsSampling() );
+
+    source.SetValue(50);
+    gauge->TickProgressTimer();
+    CHECK( gauge->m_numSetValue == 2 );
+    CHECK( gauge->GetValue() == 100 );
+}
+
+#if wxUSE_PROGRESSDLG
+
+namespace
+{
+
+// Progress dialog recording the updates done by sampling the progress source
+// instead of really performing them.
+class ProgressSourceDialog : public wxGenericProgressDialog
+{
+public:
+    ProgressSourceDialog()
+        : wxGenericProgressDialog("Progress", "Testing",
+                                  100,
+                                  wxTheApp->GetTopWindow(),
+                                  wxPD_CAN_ABORT),
+          m_cancelled(false),
+          m_continue(true),
+          m_samplingOnLastUpdate(false)
+    {
+    }
+
+    using wxGenericProgressDialog::Update;
+
+    virtual bool Update(int value,
+                        const wxString& newmsg,
+                        bool* WXUNUSED(skip)) wxOVERRIDE
+    {
+        m_updates.push_back(value);
+        m_lastMessage = newmsg;
+        m_samplingOnLastUpdate = IsSampling();
+
+        return m_continue;
+    }
+
+    virtual bool WasCancelled() const wxOVERRIDE { return m_cancelled; }
+
+    void TickProgressTimer() { m_progressTimer->Notify(); }
+
+    bool IsSampling() const
+    {
+        return m_progressTimer && m_progressTimer->IsRunning();
+    }
+
+    // Simulate pressing the "Cancel" button.
+    bool m_cancelled;
+
+    // The value to return from Update(), false means cancelling too.
+    bool m_continue;
+
+    wxVector<int> m_updates;
+    wxString m_lastMessage;
+    bool m_samplingOnLastUpdate;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxGenericProgressDialog::SetProgressSource", "[progress]")
+{
+    wxScopedPtr<ProgressSourceDialog> dlg(new ProgressSourceDialog);
+
+    wxProgressSource source;
+    dlg->SetProgressSource(&source, 1000000);
+    CHECK( dlg->IsSampling() );
+
+    // The first tick always updates the dialog.
+    dlg->TickProgressTimer();
+    REQUIRE( dlg->m_updates.size() == 1 );
+    CHECK( dlg->m_updates[0] == 0 );
+
+    dlg->TickProgressTimer();
+    CHECK( dlg->m_updates.size() == 1 );
+
+    SECTION("Value and message")
+    {
+        source.SetValue(42);
+        dlg->TickProgressTimer();
+        REQUIRE( dlg->m_updates.size() == 2 );
+        CHECK( dlg->m_updates[1] == 42 );
+
+        // Changing just the message updates the dialog too.
+        source.SetMessage("Almost done");
+        dlg->TickProgressTimer();
+        REQUIRE( dlg->m_updates.size() == 3 );
+        CHECK( dlg->m_updates[2] == 42 );
+        CHECK( dlg->m_lastMessage == "Almost done" );
+        CHECK( dlg->m_samplingOnLastUpdate );
+
+        // The final update can show the dialog modally, so sampling must be
+        // stopped before it.
+        source.SetValue(1000);
+        dlg->TickProgressTimer();
+        REQUIRE( dlg->m_updates.size() == 4 );
+        CHECK( dlg->m_updates[3] == 100 );
+        CHECK( !dlg->m_samplingOnLastUpdate );
+        CHECK( !dlg->GetProgressSource() );
+        CHECK( !source.IsCancelled() );
+    }
+
+    SECTION("Cancel button")
+    {
+        dlg->m_cancelled = true;
+        source.SetValue(10);
+        dlg->TickProgressTimer();
+        CHECK( dlg->m_updates.size() == 1 );
+        CHECK( source.IsCancelled() );
+        CHECK( !dlg->GetProgressSource() );
+        CHECK( !dlg->IsSampling() );
+    }
+
+    SECTION("Cancelled from Update")
+    {
+        dlg->m_continue = false;
+        source.SetValue(10);
+        dlg->TickProgressTimer();
+        CHECK( dlg->m_updates.size() == 2 );
+        CHECK( source.IsCancelled() );
+        CHECK( !dlg->GetProgressSource() );
+        CHECK( !dlg->IsSampling() );
+    }
+}
+
+#endif // wxUSE_PROGRESSDLG
+
+#endif // wxUSE_TIMER
+
 #endif //wxUSE_GAUGE
@@ -21,6 +21,8 @@
 
 #include "wx/grid.h"
 #include "wx/headerctrl.h"
+#include "wx/generic/private/grid.h"
+#include "wx/dcsvg.h"
 #include "testableframe.h"
 #include "asserthelper.h"
 #include "wx/uiaction.h"
@@ -1266,6 +1268,7 @@ TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeColumn", "[grid]")
     SECTION("Default") {}
     SECTION("Native header") { m_grid->UseNativeColHeader(); }
     SECTION("Native labels") { m_grid->SetUseNativeColLabels(); }
+    SECTION("Text extent cache") { m_grid->EnableTextExtentCache(); }
 
     // Hardcoded extra margin for the columns used in grid.cpp.
     const int margin = m_grid->FromDIP(10);
@@ -1533,4 +1536,232 @@ TEST_CASE("GridBlockCoords::SymDifference", "[grid]")
     }
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::CombineChangedCells", "[grid]")
+{
+    m_grid->AppendCols(4);
+    REQUIRE( m_grid->GetNumberCols() == 6 );
+
+    wxVector<wxGridCellCoords> cells;
+    wxVector<wxGridBlockCoords> blocks;
+
+    SECTION("Duplicates")
+    {
+        cells.push_back(wxGridCellCoords(1, 1));
+        cells.push_back(wxGridCellCoords(1, 2));
+        cells.push_back(wxGridCellCoords(1, 1));
+        cells.push_back(wxGridCellCoords(1, 2));
+        cells.push_back(wxGridCellCoords(1, 1));
+
+        blocks = wxGridCombineChangedCells(*m_grid, cells);
+        REQUIRE( blocks.size() == 1 );
+        CHECK( blocks[0] == wxGridBlockCoords(1, 1, 1, 2) );
+    }
+
+    SECTION("Gaps")
+    {
+        // Gap between the columns.
+        cells.push_back(wxGridCellCoords(0, 3));
+        cells.push_back(wxGridCellCoords(0, 0));
+        cells.push_back(wxGridCellCoords(0, 1));
+
+        // Gap between the rows.
+        cells.push_back(wxGridCellCoords(4, 5));
+        cells.push_back(wxGridCellCoords(2, 5));
+
+        // And the cells outside of the grid are ignored.
+        cells.push_back(wxGridCellCoords(-1, 0));
+        cells.push_back(wxGridCellCoords(10, 0));
+        cells.push_back(wxGridCellCoords(0, 6));
+
+        blocks = wxGridCombineChangedCells(*m_grid, cells);
+        REQUIRE( blocks.size() == 4 );
+        CHECK( blocks[0] == wxGridBlockCoords(0, 0, 0, 1) );
+        CHECK( blocks[1] == wxGridBlockCoords(0, 3, 0, 3) );
+        CHECK( blocks[2] == wxGridBlockCoords(2, 5, 2, 5) );
+        CHECK( blocks[3] == wxGridBlockCoords(4, 5, 4, 5) );
+    }
+
+    SECTION("Reordered columns")
+    {
+        wxArrayInt order;
+        order.push_back(0);
+        order.push_back(5);
+        order.push_back(1);
+        order.push_back(2);
+        order.push_back(3);
+        order.push_back(4);
+        m_grid->SetColumnsOrder(order);
+
+        // These cells are adjacent on screen but not in the grid.
+        cells.push_back(wxGridCellCoords(0, 0));
+        cells.push_back(wxGridCellCoords(0, 5));
+
+        // And these ones are adjacent in the grid but not on screen.
+        cells.push_back(wxGridCellCoords(1, 0));
+        cells.push_back(wxGridCellCoords(1, 1));
+
+        blocks = wxGridCombineChangedCells(*m_grid, cells);
+        REQUIRE( blocks.size() == 3 );
+        CHECK( blocks[0] == wxGridBlockCoords(0, 0, 0, 1) );
+        CHECK( blocks[1] == wxGridBlockCoords(1, 0, 1, 0) );
+        CHECK( blocks[2] == wxGridBlockCoords(1, 2, 1, 2) );
+    }
+
+    SECTION("Stacked identical runs")
+    {
+        for ( int row = 3; row >= 1; row-- )
+        {
+            for ( int col = 2; col <= 4; col++ )
+                cells.push_back(wxGridCellCoords(row, col));
+        }
+
+        // This run is different from the ones above, so can't be merged.
+        cells.push_back(wxGridCellCoords(4, 2));
+        cells.push_back(wxGridCellCoords(4, 3));
+
+        // And this one is identical, but not adjacent to them.
+        cells.push_back(wxGridCellCoords(6, 2));
+        cells.push_back(wxGridCellCoords(6, 3));
+        cells.push_back(wxGridCellCoords(6, 4));
+
+        blocks = wxGridCombineChangedCells(*m_grid, cells);
+        REQUIRE( blocks.size() == 3 );
+        CHECK( blocks[0] == wxGridBlockCoords(1, 2, 3, 4) );
+        CHECK( blocks[1] == wxGridBlockCoords(4, 2, 4, 3) );
+        CHECK( blocks[2] == wxGridBlockCoords(6, 2, 6, 4) );
+    }
+}
+
+TEST_CASE_METHOD(GridTestCase, "Grid::TextExtentCache", "[grid]")
+{
+    wxClientDC dc(m_grid->GetGridWindow());
+
+    const wxString text = "Hello";
+    const wxSize size = dc.GetTextExtent(text);
+
+    wxGridTextExtentCache cache;
+
+    SECTION("Repeated measurements")
+    {
+        CHECK( cache.GetTextExtent(dc, text) == size );
+        CHECK( cache.GetNumEntries() == 1 );
+
+        CHECK( cache.GetTextExtent(dc, text) == size );
+        CHECK( cache.GetNumEntries() == 1 );
+
+        CHECK( cache.GetTextExtent(dc, "World") == dc.GetTextExtent("World") );
+        CHECK( cache.GetNumEntries() == 2 );
+
+        cache.Clear();
+        CHECK( cache.GetNumEntries() == 0 );
+    }
+
+    SECTION("Scaled DC")
+    {
+        // The extents measured with a scaled DC are neither cached nor taken
+        // from the cache.
+        dc.SetUserScale(2, 2);
+        CHECK( cache.GetTextExtent(dc, text) == dc.GetTextExtent(text) );
+        CHECK( cache.GetNumEntries() == 0 );
+
+        dc.SetUserScale(1, 1);
+        dc.SetLogicalScale(2, 2);
+        CHECK( cache.GetTextExtent(dc, text) == dc.GetTextExtent(text) );
+        CHECK( cache.GetNumEntries() == 0 );
+
+        dc.SetLogicalScale(1, 1);
+        CHECK( cache.GetTextExtent(dc, text) == size );
+        CHECK( cache.GetNumEntries() == 1 );
+    }
+
+    SECTION("Font change")
+    {
+        CHECK( cache.GetTextExtent(dc, text) == size );
+
+        const wxFont font = dc.GetFont();
+        dc.SetFont(font.Scaled(2));
+        const wxSize sizeBig = dc.GetTextExtent(text);
+        CHECK( sizeBig.x > size.x );
+        CHECK( cache.GetTextExtent(dc, text) == sizeBig );
+        CHECK( cache.GetNumEntries() == 2 );
+
+        // The extents for the original font are still cached.
+        dc.SetFont(font);
+        CHECK( cache.GetTextExtent(dc, text) == size );
+        CHECK( cache.GetNumEntries() == 2 );
+    }
+
+#if wxUSE_SVG
+    SECTION("PPI change")
+    {
+        CHECK( cache.GetTextExtent(dc, text) == size );
+        CHECK( cache.GetTextExtent(dc, "World") == dc.GetTextExtent("World") );
+        CHECK( cache.GetNumEntries() == 2 );
+
+        // Using a DC with a different resolution invalidates all the extents.
+        wxSVGFileDC dcSVG(wxString(), 320, 240, 2*dc.GetPPI().y);
+        REQUIRE( dcSVG.GetPPI() != dc.GetPPI() );
+        dcSVG.SetFont(dc.GetFont());
+
+        CHECK( cache.GetTextExtent(dcSVG, text) == dcSVG.GetTextExtent(text) );
+        CHECK( cache.GetNumEntries() == 1 );
+
+        CHECK( cache.GetTextExtent(dc, text) == size );
+        CHECK( cache.GetNumEntries() == 1 );
+    }
+#endif // wxUSE_SVG
+
+    SECTION("Maximal size")
+    {
+        wxGridTextExtentCache smallCache(3);
+
+        smallCache.GetTextExtent(dc, "a");
+        smallCache.GetTextExtent(dc, "b");
+        smallCache.GetTextExtent(dc, "c");
+        CHECK( smallCache.GetNumEntries() == 3 );
+
+        // The cache is emptied when it becomes full.
+        CHECK( smallCache.GetTextExtent(dc, text) == size );
+        CHECK( smallCache.GetNumEntries() == 1 );
+
+        CHECK( smallCache.GetTextExtent(dc, "a") == dc.GetTextExtent("a") );
+        CHECK( smallCache.GetNumEntries() == 2 );
+    }
+
+    SECTION("Auto wrap renderer")
+    {
+        // Use both short words, wrapped by BreakLine(), and a long one which
+        // has to be broken by BreakWord().
+        m_grid->SetCellValue(0, 0, "Lorem ipsum dolor sit amet, "
+                                   "consecteturadipiscingelitseddoeiusmod "
+                                   "tempor incididunt");
+
+        wxGridCellAttrPtr attr(m_grid->GetOrCreateCellAttr(0, 0));
+        wxGridCellAutoWrapStringRenderer renderer;
+
+        const int widths[] = { 10, 30, 60, 100, 200 };
+        for ( size_t n = 0; n < WXSIZEOF(widths); n++ )
+        {
+            const int width = m_grid->FromDIP(widths[n]);
+            INFO( "Width " << width );
+
+            m_grid->EnableTextExtentCache(false);
+            const int height = renderer.GetBestHeight(*m_grid, *attr, dc,
+                                                      0, 0, width);
+            const int bestWidth = renderer.GetBestWidth(*m_grid, *attr, dc,
+                                                        0, 0, height);
+
+            // Do it twice to check the results with the cache full too.
+            m_grid->EnableTextExtentCache();
+            for ( int i = 0; i < 2; i++ )
+            {
+                CHECK( renderer.GetBestHeight(*m_grid, *attr, dc,
+                                              0, 0, width) == height );
+                CHECK( renderer.GetBestWidth(*m_grid, *attr, dc,
+                                             0, 0, height) == bestWidth );
+            }
+        }
+    }
+}
+
 #endif //wxUSE_GRID
@@ -36,8 +36,11 @@ private:
 
     CPPUNIT_TEST_SUITE( HtmlListBoxTestCase );
         wxITEM_CONTAINER_TESTS();
+        CPPUNIT_TEST( ItemHeight );
     CPPUNIT_TEST_SUITE_END();
 
+    void ItemHeight();
+
     wxSimpleHtmlListBox* m_htmllbox;
 
     wxDECLARE_NO_COPY_CLASS(HtmlListBoxTestCase);
@@ -56,4 +59,32 @@ void HtmlListBoxTestCase::tearDown()
     wxDELETE(m_htmllbox);
 }
 
+void HtmlListBoxTestCase::ItemHeight()
+{
+    // Use a big enough control to show all the items.
+    delete m_htmllbox;
+    m_htmllbox = new wxSimpleHtmlListBox(wxTheApp->GetTopWindow(), wxID_ANY,
+                                         wxDefaultPosition, wxSize(300, 300));
+
+    // Check that the heights of the items are correctly updated even when
+    // only a single item is cached.
+    m_htmllbox->SetCacheSize(1);
+
+    m_htmllbox->Append("small");
+    m_htmllbox->Append("<h1>big</h1>");
+    m_htmllbox->Append("small");
+
+    const int heightSmall = m_htmllbox->GetItemRect(0).height;
+    const int heightBig = m_htmllbox->GetItemRect(1).height;
+    CHECK( heightSmall > 0 );
+    CHECK( heightBig > heightSmall );
+    CHECK( m_htmllbox->GetItemRect(2).height == heightSmall );
+
+    m_htmllbox->SetString(2, "<h1>big</h1><p>and more</p>");
+    CHECK( m_htmllbox->GetItemRect(2).height > heightBig );
+
+    m_htmllbox->SetString(1, "small");
+    CHECK( m_htmllbox->GetItemRect(1).height == heightSmall );
+}
+
 #endif //wxUSE_HTML
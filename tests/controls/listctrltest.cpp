@@ -30,6 +30,11 @@
 #include "testableframe.h"
 #include "wx/uiaction.h"
 
+// Sorting by columns is only implemented in the generic version.
+#if (!defined(__WXMSW__) && !defined(__WXQT__)) || defined(__WXUNIVERSAL__)
+    #define wxHAS_LISTCTRL_SORT_BY_COLUMNS
+#endif
+
 // ----------------------------------------------------------------------------
 // test class
 // ----------------------------------------------------------------------------
@@ -51,10 +56,16 @@ private:
         WXUISIM_TEST( ColumnClick );
         WXUISIM_TEST( ColumnDrag );
         CPPUNIT_TEST( SubitemRect );
+#ifdef wxHAS_LISTCTRL_SORT_BY_COLUMNS
+        CPPUNIT_TEST( SortByColumns );
+#endif // wxHAS_LISTCTRL_SORT_BY_COLUMNS
     CPPUNIT_TEST_SUITE_END();
 
     void EditLabel();
     void SubitemRect();
+#ifdef wxHAS_LISTCTRL_SORT_BY_COLUMNS
+    void SortByColumns();
+#endif // wxHAS_LISTCTRL_SORT_BY_COLUMNS
 #if wxUSE_UIACTIONSIMULATOR
     // Column events are only supported in wxListCtrl currently so we test them
     // here rather than in ListBaseTest
@@ -142,6 +153,55 @@ void ListCtrlTestCase::SubitemRect()
     CHECK(rectLabel.GetRight() == rectItem.GetRight());
 }
 
+#ifdef wxHAS_LISTCTRL_SORT_BY_COLUMNS
+void ListCtrlTestCase::SortByColumns()
+{
+    m_list->InsertColumn(0, "Name");
+    m_list->InsertColumn(1, "Size");
+
+    static const char* const names[] = { "b10", "a", "B9", "b9", "A" };
+    static const char* const sizes[] = { "3",   "20", "x", "1.5", "20" };
+    for ( int i = 0; i < (int)WXSIZEOF(names); i++ )
+    {
+        m_list->InsertItem(i, names[i]);
+        m_list->SetItem(i, 1, sizes[i]);
+    }
+
+    m_list->SetItemState(0, wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED,
+                            wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+
+    // The sort is stable, so "b9" remains after "B9" and "A" after "a".
+    CPPUNIT_ASSERT( m_list->SortItemsByColumn(0, wxLIST_SORT_NOCASE |
+                                                 wxLIST_SORT_NATURAL) );
+    CPPUNIT_ASSERT_EQUAL( "a", m_list->GetItemText(0) );
+    CPPUNIT_ASSERT_EQUAL( "A", m_list->GetItemText(1) );
+    CPPUNIT_ASSERT_EQUAL( "B9", m_list->GetItemText(2) );
+    CPPUNIT_ASSERT_EQUAL( "b9", m_list->GetItemText(3) );
+    CPPUNIT_ASSERT_EQUAL( "b10", m_list->GetItemText(4) );
+
+    // The selection and the focus follow the item.
+    CPPUNIT_ASSERT_EQUAL( 1, m_list->GetSelectedItemCount() );
+    CPPUNIT_ASSERT_EQUAL( 4, m_list->GetNextItem(-1, wxLIST_NEXT_ALL,
+                                                 wxLIST_STATE_SELECTED) );
+    CPPUNIT_ASSERT_EQUAL( 4, m_list->GetNextItem(-1, wxLIST_NEXT_ALL,
+                                                 wxLIST_STATE_FOCUSED) );
+
+    wxVector<wxListSortKey> keys;
+    keys.push_back(wxListSortKey(1, wxLIST_SORT_NUMERIC |
+                                    wxLIST_SORT_DESCENDING));
+    keys.push_back(wxListSortKey(0));
+    CPPUNIT_ASSERT( m_list->SortItemsByColumns(keys) );
+    CPPUNIT_ASSERT_EQUAL( "A", m_list->GetItemText(0) );
+    CPPUNIT_ASSERT_EQUAL( "a", m_list->GetItemText(1) );
+    CPPUNIT_ASSERT_EQUAL( "b10", m_list->GetItemText(2) );
+    CPPUNIT_ASSERT_EQUAL( "b9", m_list->GetItemText(3) );
+    CPPUNIT_ASSERT_EQUAL( "B9", m_list->GetItemText(4) );
+
+    // Invalid columns are rejected.
+    WX_ASSERT_FAILS_WITH_ASSERT( m_list->SortItemsByColumn(2) );
+}
+#endif // wxHAS_LISTCTRL_SORT_BY_COLUMNS
+
 #if wxUSE_UIACTIONSIMULATOR
 void ListCtrlTestCase::ColumnDrag()
 {
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/controls/propgridtest.cpp
+// Purpose:     wxPropertyGrid unit tests
+// Author:      wxWidgets Team
+// Created:     2020-03-14
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#if wxUSE_PROPGRID
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif // WX_PRECOMP
+
+#include "wx/scopedptr.h"
+
+#include "wx/propgrid/propgrid.h"
+#include "wx/propgrid/props.h"
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Check that exactly the given properties are shown in the grid, in this
+// order, both when looking up the property at the given position and the
+// position of the given property.
+template <size_t N>
+void CheckRows(wxPropertyGrid* pg, wxPGProperty* const (&rows)[N])
+{
+    const int lh = pg->GetRowHeight();
+
+    CHECK( pg->GetState()->GetVisibleRowCount() == N );
+
+    for ( size_t n = 0; n < N; n++ )
+    {
+        INFO( "Row " << n << " (\"" << rows[n]->GetLabel() << "\")" );
+
+        const int y = static_cast<int>(n)*lh;
+        CHECK( rows[n]->GetY() == y );
+        CHECK( pg->GetItemAtY(y) == rows[n] );
+        CHECK( pg->GetItemAtY(y + lh - 1) == rows[n] );
+        CHECK( pg->HitTest(wxPoint(1, y + lh/2)).GetProperty() == rows[n] );
+    }
+
+    CHECK( !pg->GetItemAtY(static_cast<int>(N)*lh) );
+    CHECK( !pg->GetItemAtY(-1) );
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests themselves
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxPropertyGrid::VisibleRows", "[propgrid]")
+{
+    wxPropertyGrid* const
+        pg = new wxPropertyGrid(wxTheApp->GetTopWindow(), wxID_ANY,
+                                wxDefaultPosition, wxSize(400, 400));
+    wxScopedPtr<wxPropertyGrid> cleanUp(pg);
+
+    wxPGProperty* const cat = pg->Append(new wxPropertyCategory("Category"));
+    wxPGProperty* const a = pg->Append(new wxStringProperty("A"));
+    wxPGProperty* const
+        parent = pg->Append(new wxStringProperty("Parent",
+                                                 wxPG_LABEL,
+                                                 "<composed>"));
+    wxPGProperty* const child1 = pg->AppendIn(parent, new wxIntProperty("C1"));
+    wxPGProperty* const child2 = pg->AppendIn(parent, new wxIntProperty("C2"));
+    wxPGProperty* const b = pg->Append(new wxStringProperty("B"));
+
+    pg->Expand(parent);
+
+    wxPGProperty* const all[] = { cat, a, parent, child1, child2, b };
+    CheckRows(pg, all);
+
+    SECTION("Hide and collapse")
+    {
+        pg->HideProperty(a);
+        wxPGProperty* const hiddenA[] = { cat, parent, child1, child2, b };
+        CheckRows(pg, hiddenA);
+
+        pg->Collapse(parent);
+        wxPGProperty* const collapsed[] = { cat, parent, b };
+        CheckRows(pg, collapsed);
+
+        pg->Expand(parent);
+        CheckRows(pg, hiddenA);
+
+        pg->HideProperty(a, false);
+        CheckRows(pg, all);
+
+        pg->Collapse(cat);
+        wxPGProperty* const onlyCat[] = { cat };
+        CheckRows(pg, onlyCat);
+
+        pg->Expand(cat);
+        CheckRows(pg, all);
+    }
+
+    SECTION("Flags from string")
+    {
+        child1->SetFlagsFromString("HIDDEN");
+        wxPGProperty* const hiddenChild[] = { cat, a, parent, child2, b };
+        CheckRows(pg, hiddenChild);
+
+        parent->SetFlagsFromString("COLLAPSED");
+        wxPGProperty* const collapsed[] = { cat, a, parent, b };
+        CheckRows(pg, collapsed);
+
+        parent->SetFlagsFromString("");
+        CheckRows(pg, hiddenChild);
+
+        child1->SetFlagsFromString("DISABLED");
+        CheckRows(pg, all);
+    }
+}
+
+#endif // wxUSE_PROPGRID
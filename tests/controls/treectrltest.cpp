@@ -25,7 +25,9 @@
 
 #include "wx/artprov.h"
 #include "wx/imaglist.h"
+#include "wx/scopedptr.h"
 #include "wx/treectrl.h"
+#include "wx/generic/treectlg.h"
 #include "wx/uiaction.h"
 #include "testableframe.h"
 
@@ -648,4 +650,132 @@ void TreeCtrlTestCase::KeyNavigation()
 #endif
 }
 
+// ----------------------------------------------------------------------------
+// virtual tree control test
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// A virtual tree in which all items at the first two levels have many
+// children and the label of each item is its path from the root.
+class VirtualTreeCtrl : public wxGenericTreeCtrl
+{
+public:
+    enum { NUM_CHILDREN = 100000 };
+
+    VirtualTreeCtrl()
+        : wxGenericTreeCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                            wxDefaultPosition, wxSize(400, 200),
+                            wxTR_DEFAULT_STYLE | wxTR_HIDE_ROOT | wxTR_VIRTUAL)
+    {
+        m_textCount = 0;
+    }
+
+    int GetTextCount() const { return m_textCount; }
+
+protected:
+    virtual size_t OnGetChildrenCount(const wxTreeItemId& item) const wxOVERRIDE
+    {
+        int depth = 0;
+        for ( wxTreeItemId parent = GetItemParent(item);
+              parent.IsOk();
+              parent = GetItemParent(parent) )
+        {
+            depth++;
+        }
+
+        return depth < 2 ? NUM_CHILDREN : 0;
+    }
+
+    virtual wxString OnGetItemText(const wxTreeItemId& parent,
+                                   size_t n) const wxOVERRIDE
+    {
+        m_textCount++;
+
+        return wxString::Format("%s/%d", GetItemText(parent), (int)n);
+    }
+
+private:
+    mutable int m_textCount;
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxGenericTreeCtrl::Virtual", "[treectrl][virtual]")
+{
+    wxScopedPtr<VirtualTreeCtrl> tree(new VirtualTreeCtrl());
+
+    const wxTreeItemId root = tree->AddRoot("r");
+    CHECK( tree->GetChildrenCount(root, false) == VirtualTreeCtrl::NUM_CHILDREN );
+
+    wxTreeItemIdValue cookie;
+    const wxTreeItemId first = tree->GetFirstChild(root, cookie);
+    const wxTreeItemId last = tree->GetLastChild(root);
+    CHECK( tree->GetItemText(first) == "r/0" );
+    CHECK( tree->GetItemText(last) == "r/99999" );
+    CHECK( tree->GetItemText(tree->GetNextSibling(first)) == "r/1" );
+    CHECK( tree->ItemHasChildren(first) );
+
+    wxRect rectFirst, rectLast;
+    REQUIRE( tree->GetBoundingRect(first, rectFirst) );
+    REQUIRE( tree->GetBoundingRect(last, rectLast) );
+    CHECK( rectLast.y - rectFirst.y ==
+            (VirtualTreeCtrl::NUM_CHILDREN - 1)*rectFirst.height );
+
+    // Expanding an item moves all the items below it down.
+    tree->Expand(first);
+    const wxTreeItemId grandchild = tree->GetLastChild(first);
+    CHECK( tree->GetItemText(grandchild) == "r/0/99999" );
+    CHECK( !tree->ItemHasChildren(grandchild) );
+
+    REQUIRE( tree->GetBoundingRect(last, rectLast) );
+    CHECK( rectLast.y - rectFirst.y ==
+            (2*VirtualTreeCtrl::NUM_CHILDREN - 1)*rectFirst.height );
+
+    tree->Collapse(first);
+    REQUIRE( tree->GetBoundingRect(last, rectLast) );
+    CHECK( rectLast.y - rectFirst.y ==
+            (VirtualTreeCtrl::NUM_CHILDREN - 1)*rectFirst.height );
+
+    // Only the items which were really used must have been created.
+    CHECK( tree->GetTextCount() < 10 );
+
+    // Expanding several items at once shifts the items below all of them.
+    const wxTreeItemId prev = tree->GetPrevSibling(last);
+    tree->Expand(prev);
+    REQUIRE( tree->GetBoundingRect(last, rectLast) );
+    CHECK( rectLast.y - rectFirst.y ==
+            (2*VirtualTreeCtrl::NUM_CHILDREN - 1)*rectFirst.height );
+
+    tree->Expand(first);
+    REQUIRE( tree->GetBoundingRect(last, rectLast) );
+    CHECK( rectLast.y - rectFirst.y ==
+            (3*VirtualTreeCtrl::NUM_CHILDREN - 1)*rectFirst.height );
+
+    // And hit testing finds the items at their new positions.
+    const wxTreeItemId deep = tree->GetLastChild(prev);
+    CHECK( tree->GetItemText(deep) == "r/99998/99999" );
+    tree->EnsureVisible(deep);
+
+    wxRect rectDeep;
+    REQUIRE( tree->GetBoundingRect(deep, rectDeep) );
+
+    int flags = 0;
+    CHECK( tree->HitTest(wxPoint(rectDeep.x + 1,
+                                 rectDeep.y + rectDeep.height/2),
+                         flags) == deep );
+
+    tree->Collapse(prev);
+    tree->Collapse(first);
+    REQUIRE( tree->GetBoundingRect(last, rectLast) );
+    CHECK( rectLast.y - rectFirst.y ==
+            (VirtualTreeCtrl::NUM_CHILDREN - 1)*rectFirst.height );
+
+    // Deleting the children reloads them.
+    tree->DeleteChildren(root);
+    CHECK( tree->GetChildrenCount(root, false) == VirtualTreeCtrl::NUM_CHILDREN );
+    CHECK( tree->GetItemText(tree->GetLastChild(root)) == "r/99999" );
+}
+
 #endif //wxUSE_TREECTRL
@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/controls/vscrolltest.cpp
+// Purpose:     wxVScrolledWindow unit test
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif // WX_PRECOMP
+
+#include "wx/scopedptr.h"
+#include "wx/vscroll.h"
+
+// ----------------------------------------------------------------------------
+// test window
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+class VarHeightWindow : public wxVScrolledWindow
+{
+public:
+    enum { NUM_ROWS = 100000 };
+
+    VarHeightWindow()
+        : wxVScrolledWindow(wxTheApp->GetTopWindow(), wxID_ANY,
+                            wxDefaultPosition, wxSize(200, 100))
+    {
+        m_heightCalls = 0;
+        m_extra = 0;
+
+        SetRowCount(NUM_ROWS);
+    }
+
+    wxCoord GetRowPosition(size_t row) const { return GetRowsHeight(0, row); }
+
+    size_t FindFirstVisible(size_t last, bool full) const
+        { return FindFirstVisibleFromLast(last, full); }
+
+    // make the given row higher
+    void EnlargeRow(size_t row)
+    {
+        m_extraRow = row;
+        m_extra = 1000;
+
+        RefreshRow(row);
+    }
+
+    int GetHeightCalls() const { return m_heightCalls; }
+    void ResetHeightCalls() { m_heightCalls = 0; }
+
+protected:
+    virtual wxCoord OnGetRowHeight(size_t row) const wxOVERRIDE
+    {
+        m_heightCalls++;
+
+        wxCoord height = 5 + row % 17;
+        if ( m_extra && row == m_extraRow )
+            height += m_extra;
+
+        return height;
+    }
+
+private:
+    mutable int m_heightCalls;
+
+    size_t m_extraRow;
+    wxCoord m_extra;
+
+    wxDECLARE_NO_COPY_CLASS(VarHeightWindow);
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxVScrolledWindow::UnitSizeCache", "[vscroll]")
+{
+    wxScopedPtr<VarHeightWindow> plain(new VarHeightWindow());
+    wxScopedPtr<VarHeightWindow> cached(new VarHeightWindow());
+
+    cached->EnableUnitSizeCache();
+    CHECK( cached->IsUnitSizeCacheEnabled() );
+
+    const size_t rows[] = { 0, 1, 16, 17, 1000, 54321, 99999 };
+    for ( size_t n = 0; n < WXSIZEOF(rows); n++ )
+    {
+        const size_t row = rows[n];
+        INFO( "Row " << row );
+
+        CHECK( cached->GetRowPosition(row) == plain->GetRowPosition(row) );
+        CHECK( cached->FindFirstVisible(row, false) ==
+                plain->FindFirstVisible(row, false) );
+        CHECK( cached->FindFirstVisible(row, true) ==
+                plain->FindFirstVisible(row, true) );
+
+        plain->ScrollToRow(row);
+        cached->ScrollToRow(row);
+        CHECK( cached->GetVisibleRowsBegin() == plain->GetVisibleRowsBegin() );
+
+        for ( wxCoord y = 0; y < 100; y += 7 )
+        {
+            CHECK( cached->VirtualHitTest(y) == plain->VirtualHitTest(y) );
+        }
+    }
+
+    // The heights are not queried again once the cache is built.
+    cached->ScrollToRow(0);
+    cached->ResetHeightCalls();
+    cached->ScrollToRow(80000);
+    CHECK( cached->GetRowPosition(VarHeightWindow::NUM_ROWS) ==
+            plain->GetRowPosition(VarHeightWindow::NUM_ROWS) );
+    CHECK( cached->GetHeightCalls() < 100 );
+
+    // But refreshing a row updates its height.
+    plain->EnlargeRow(500);
+    cached->EnlargeRow(500);
+    CHECK( cached->GetRowPosition(501) == plain->GetRowPosition(501) );
+    CHECK( cached->GetRowPosition(70000) == plain->GetRowPosition(70000) );
+
+    cached->EnableUnitSizeCache(false);
+    CHECK( !cached->IsUnitSizeCacheEnabled() );
+    CHECK( cached->GetRowPosition(70000) == plain->GetRowPosition(70000) );
+}
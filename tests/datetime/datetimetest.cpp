@@ -1756,4 +1756,131 @@ TEST_CASE("wxDateTime::UNow", "[datetime][now][unow]")
     CHECK( gotMS );
 }
 
+TEST_CASE("wxDateTimeFormatter", "[datetime][format]")
+{
+    static const char* const formats[] =
+    {
+        "%Y-%m-%d %H:%M:%S",
+        "%Y-%m-%dT%H:%M:%S%z",
+        "%a, %d %b %Y %I:%M:%S %p",
+        "%A %B %j %w %y %l",
+        "100%% %3d %-4m literal",
+        "%c | %x | %X | %U",
+    };
+
+    const wxDateTime dates[] =
+    {
+        wxDateTime(1, wxDateTime::Jan, 2000),
+        wxDateTime(29, wxDateTime::Feb, 2004, 12, 0, 1, 2),
+        wxDateTime(31, wxDateTime::Dec, 2020, 23, 59, 59, 999),
+        wxDateTime(15, wxDateTime::Jul, 1812, 7, 5, 3, 42),
+        wxDateTime(4, wxDateTime::Mar, 2100, 0, 30),
+    };
+
+    for ( size_t n = 0; n < WXSIZEOF(formats); n++ )
+    {
+        const wxDateTimeFormatter formatter(formats[n]);
+        CHECK( formatter.GetFormat() == formats[n] );
+
+        for ( size_t m = 0; m < WXSIZEOF(dates); m++ )
+        {
+            const wxDateTime& dt = dates[m];
+            INFO("Format \"" << formats[n] << "\", date " << dt.FormatISOCombined());
+
+            CHECK( formatter.Format(dt) == dt.Format(formats[n]) );
+            CHECK( formatter.Format(dt, wxDateTime::UTC) ==
+                        dt.Format(formats[n], wxDateTime::UTC) );
+        }
+    }
+
+    // Check that formatting to a buffer works and truncates the output.
+    wxDateTimeFormatter formatter("%Y-%m-%d");
+    const wxDateTime dt(7, wxDateTime::Aug, 2019);
+
+    wxChar buf[16];
+    CHECK( formatter.FormatTo(buf, WXSIZEOF(buf), dt) == 10 );
+    CHECK( wxString(buf) == "2019-08-07" );
+
+    CHECK( formatter.FormatTo(buf, 5, dt) == 10 );
+    CHECK( wxString(buf) == "2019" );
+
+    CHECK( formatter.FormatTo(NULL, 0, dt) == 10 );
+
+    // Check parsing, both using the optimized code and falling back on
+    // ParseFormat().
+    wxDateTime parsed;
+    CHECK( formatter.Parse("2019-08-07", &parsed) );
+    CHECK( parsed == dt );
+
+    wxString::const_iterator end;
+    const wxString date("2019-08-07 and more");
+    CHECK( formatter.Parse(date, &parsed, wxDefaultDateTime, &end) );
+    CHECK( wxString(end, date.end()) == " and more" );
+
+    // Without the end iterator, the entire string must match.
+    CHECK( !formatter.Parse(date, &parsed) );
+    CHECK( !formatter.Parse("2019-13-07", &parsed) );
+    CHECK( parsed == dt );
+
+    for ( size_t n = 0; n < WXSIZEOF(formats) - 1; n++ )
+    {
+        formatter.SetFormat(formats[n]);
+
+        for ( size_t m = 0; m < WXSIZEOF(dates); m++ )
+        {
+            const wxDateTime& date = dates[m];
+            const wxString str = formatter.Format(date);
+            INFO("Format \"" << formats[n] << "\", string \"" << str << "\"");
+
+            wxDateTime expected;
+            const bool ok = expected.ParseFormat(str, formats[n], &end) &&
+                                end == str.end();
+
+            wxDateTime result;
+            CHECK( formatter.Parse(str, &result) == ok );
+            if ( ok )
+                CHECK( result == expected );
+        }
+    }
+
+    // The date must not be modified if parsing fails when falling back on
+    // ParseFormat() neither.
+    formatter.SetFormat("%e.%m.%Y");
+    CHECK( formatter.Parse("7.08.2019", &parsed) );
+    CHECK( parsed.IsSameDate(dt) );
+
+    const wxDateTime before = parsed;
+    CHECK( !formatter.Parse("19.03.2020 and more", &parsed) );
+    CHECK( parsed == before );
+
+    // The explicit width of "%e" must be used when parsing, as ParseFormat()
+    // does, and not the default one. Notice that "%e" can only be formatted
+    // for the dates in the standard range.
+    const wxDateTime datesE[] =
+    {
+        wxDateTime(1, wxDateTime::Jan, 2000),
+        wxDateTime(29, wxDateTime::Feb, 2004, 12, 0, 1, 2),
+        wxDateTime(31, wxDateTime::Dec, 2020, 23, 59, 59, 999),
+    };
+
+    formatter.SetFormat("%3e%m%Y");
+    for ( size_t m = 0; m < WXSIZEOF(datesE); m++ )
+    {
+        const wxDateTime& date = datesE[m];
+        CHECK( formatter.Format(date) == date.Format("%3e%m%Y") );
+
+        const wxString str = date.Format("%03d%m%Y");
+        INFO("String \"" << str << "\"");
+
+        wxDateTime expected;
+        REQUIRE( expected.ParseFormat(str, "%3e%m%Y", &end) );
+        CHECK( end == str.end() );
+        CHECK( expected.IsSameDate(date) );
+
+        wxDateTime result;
+        CHECK( formatter.Parse(str, &result) );
+        CHECK( result == expected );
+    }
+}
+
 #endif // wxUSE_DATETIME
@@ -39,12 +39,14 @@ private:
     CPPUNIT_TEST_SUITE( DirTestCase );
         CPPUNIT_TEST( DirExists );
         CPPUNIT_TEST( Traverse );
+        CPPUNIT_TEST( TraverseParallel );
         CPPUNIT_TEST( Enum );
         CPPUNIT_TEST( GetName );
     CPPUNIT_TEST_SUITE_END();
 
     void DirExists();
     void Traverse();
+    void TraverseParallel();
     void Enum();
     void GetName();
 
@@ -175,6 +177,76 @@ void DirTestCase::Traverse()
     CPPUNIT_ASSERT_EQUAL(6, traverser.dirs.size());
 }
 
+class TestDirBatchTraverser : public wxDirBatchTraverser
+{
+public:
+    wxArrayString dirs;
+    wxArrayString files;
+
+    virtual wxDirTraverseResult OnFiles(const wxString& dirname,
+                                        const wxArrayString& filenames) wxOVERRIDE
+    {
+        // the directory must have been already reported
+        if ( dirname != DIRTEST_FOLDER + SEP )
+            CPPUNIT_ASSERT( dirs.Index(dirname.substr(0, dirname.length() - 1)) != wxNOT_FOUND );
+
+        for ( size_t n = 0; n < filenames.size(); n++ )
+            files.push_back(dirname + filenames[n]);
+
+        return wxDIR_CONTINUE;
+    }
+
+    virtual wxDirTraverseResult OnDir(const wxString& dirname) wxOVERRIDE
+    {
+        dirs.push_back(dirname);
+
+        // check that ignoring a directory works
+        return dirname.EndsWith("folder3") ? wxDIR_IGNORE : wxDIR_CONTINUE;
+    }
+};
+
+void DirTestCase::TraverseParallel()
+{
+    wxDir dir(DIRTEST_FOLDER);
+    TestDirBatchTraverser traverser;
+    CPPUNIT_ASSERT_EQUAL( 2, dir.TraverseParallel(traverser) );
+    CPPUNIT_ASSERT_EQUAL( 5, traverser.dirs.size() );
+
+    traverser.files.Sort();
+    CPPUNIT_ASSERT_EQUAL( DIRTEST_FOLDER + SEP + "dummy", traverser.files[0] );
+    CPPUNIT_ASSERT_EQUAL( DIRTEST_FOLDER + SEP + "folder1" + SEP + "subfolder2" +
+                          SEP + "dummy", traverser.files[1] );
+
+    // the files must be returned in the same order by GetAllFiles() as by
+    // Traverse() which enumerates them in depth first order
+    wxArrayString files;
+    wxDir::GetAllFiles(DIRTEST_FOLDER, &files);
+
+    wxArrayString filesTraverse;
+    class SimpleTraverser : public wxDirTraverser
+    {
+    public:
+        explicit SimpleTraverser(wxArrayString& files) : m_files(files) { }
+
+        virtual wxDirTraverseResult OnFile(const wxString& filename) wxOVERRIDE
+        {
+            m_files.push_back(filename);
+            return wxDIR_CONTINUE;
+        }
+
+        virtual wxDirTraverseResult OnDir(const wxString& WXUNUSED(dirname)) wxOVERRIDE
+        {
+            return wxDIR_CONTINUE;
+        }
+
+    private:
+        wxArrayString& m_files;
+    } simpleTraverser(filesTraverse);
+    dir.Traverse(simpleTraverser);
+
+    CPPUNIT_ASSERT( files == filesTraverse );
+}
+
 void DirTestCase::DirExists()
 {
     struct
@@ -608,6 +608,104 @@ TEST_CASE_METHOD(FileSystemWatcherTestCase,
     EventTester tester;
     tester.Run();
 }
+
+// ----------------------------------------------------------------------------
+// TestBatchEvent: check that the events read at once are sent in a single
+// batch with the repeated modifications of the same file coalesced
+// ----------------------------------------------------------------------------
+
+TEST_CASE_METHOD(FileSystemWatcherTestCase,
+                 "wxFileSystemWatcher::BatchEvent", "[fsw]")
+{
+    class EventTester : public FSWTesterBase
+    {
+    public:
+        EventTester()
+            : m_other(eg.RandomName()),
+              m_created(eg.RandomName())
+        {
+            Bind(wxEVT_FSWATCHER_BATCH, &EventTester::OnBatch, this);
+
+            // Create both files to be modified before starting watching.
+            CHECK(eg.CreateFile());
+            CHECK(wxFile().Create(m_other.GetFullPath()));
+        }
+
+        virtual ~EventTester()
+        {
+            for (size_t n = 0; n < m_batches.size(); n++)
+                delete m_batches[n];
+        }
+
+        virtual void GenerateEvent() wxOVERRIDE
+        {
+            // All these changes happen before the events are read, so they
+            // must be delivered together and the second and third
+            // modifications of m_file must be folded into the first one,
+            // even though a change to another file happens in between.
+            CHECK(eg.ModifyFile());
+            CHECK(Append(m_other));
+            CHECK(eg.ModifyFile());
+            CHECK(eg.ModifyFile());
+            CHECK(wxFile().Create(m_created.GetFullPath()));
+        }
+
+        virtual wxFileSystemWatcherEvent ExpectedEvent() wxOVERRIDE
+        {
+            wxFileSystemWatcherEvent event(wxFSW_EVENT_MODIFY);
+            event.SetPath(eg.m_file);
+            event.SetNewPath(eg.m_file);
+            return event;
+        }
+
+        virtual void CheckResult() wxOVERRIDE
+        {
+            // Individual events are not sent when the batch is processed.
+            CHECK( m_events.empty() );
+
+            REQUIRE( m_batches.size() == 1 );
+
+            const wxFileSystemWatcherBatchEvent& batch = *m_batches[0];
+            CHECK( batch.GetEventType() == wxEVT_FSWATCHER_BATCH );
+
+            REQUIRE( batch.GetEventCount() == 3 );
+
+            const wxFileSystemWatcherEvent expected = ExpectedEvent();
+            CHECK( batch.GetEvent(0).GetChangeType() == wxFSW_EVENT_MODIFY );
+            CHECK( batch.GetEvent(0).GetPath() == expected.GetPath() );
+
+            CHECK( batch.GetEvent(1).GetChangeType() == wxFSW_EVENT_MODIFY );
+            CHECK( batch.GetEvent(1).GetPath() == m_other );
+
+            CHECK( batch.GetEvent(2).GetChangeType() == wxFSW_EVENT_CREATE );
+            CHECK( batch.GetEvent(2).GetPath() == m_created );
+        }
+
+    private:
+        static bool Append(const wxFileName& fn)
+        {
+            wxFile file(fn.GetFullPath(), wxFile::write_append);
+            return file.IsOpened() && file.Write("More words\n") &&
+                    file.Close();
+        }
+
+        void OnBatch(wxFileSystemWatcherBatchEvent& event)
+        {
+            m_batches.push_back(
+                wxDynamicCast(event.Clone(), wxFileSystemWatcherBatchEvent));
+
+            SendIdle();
+        }
+
+        const wxFileName m_other;
+        const wxFileName m_created;
+
+        wxVector<wxFileSystemWatcherBatchEvent*> m_batches;
+    };
+
+    EventTester tester;
+    tester.Run();
+}
 #endif // wxHAS_INOTIFY
 
 // ----------------------------------------------------------------------------
@@ -854,6 +952,88 @@ TEST_CASE_METHOD(FileSystemWatcherTestCase,
     tester.Run();
 }
 
+// ----------------------------------------------------------------------------
+// TestTreeAsync
+// ----------------------------------------------------------------------------
+
+TEST_CASE_METHOD(FileSystemWatcherTestCase,
+                 "wxFileSystemWatcher::TreeAsync", "[fsw]")
+{
+    class TreeAsyncTester : public FSWTesterBase
+    {
+    public:
+        TreeAsyncTester() : m_initial(0), m_expected(0) { }
+
+        virtual void GenerateEvent() wxOVERRIDE
+        {
+            m_dir = EventGenerator::GetWatchDir();
+            m_dir.AppendDir("asynctree");
+
+            for ( unsigned d = 0; d < 3; ++d )
+            {
+                wxFileName subdir(m_dir);
+                subdir.AppendDir(wxString::Format("subdir%u", d+1));
+                subdir.AppendDir("child");
+                REQUIRE(subdir.Mkdir(wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL));
+            }
+
+            m_initial = m_watcher->GetWatchedPathsCount();
+
+            // Find the number of watches used by the synchronous version,
+            // which depends on the platform.
+            REQUIRE(m_watcher->AddTree(m_dir));
+            m_expected = m_watcher->GetWatchedPathsCount();
+            REQUIRE(m_watcher->RemoveTree(m_dir));
+
+            REQUIRE(m_watcher->AddTreeAsync(m_dir));
+            CHECK( m_watcher->GetWatchedPathsCount() > m_initial );
+
+            WaitUntilAdded();
+        }
+
+        // Keep the event loop busy, so that OnIdleCheckResult() is not called,
+        // until all the directories are watched.
+        void WaitUntilAdded()
+        {
+            if ( m_watcher->IsAddingTrees() )
+                CallAfter(&TreeAsyncTester::WaitUntilAdded);
+        }
+
+        virtual wxFileSystemWatcherEvent ExpectedEvent() wxOVERRIDE
+        {
+            FAIL("Shouldn't be called");
+
+            return wxFileSystemWatcherEvent(wxFSW_EVENT_ERROR);
+        }
+
+        virtual void CheckResult() wxOVERRIDE
+        {
+            CHECK( !m_watcher->IsAddingTrees() );
+            CHECK( m_watcher->GetWatchedPathsCount() == m_expected );
+
+            m_watcher->RemoveTree(m_dir);
+            CHECK( m_watcher->GetWatchedPathsCount() == m_initial );
+
+            // Check that removing a tree while it's being added works too.
+            m_watcher->AddTreeAsync(m_dir);
+            m_watcher->RemoveTree(m_dir);
+            CHECK( !m_watcher->IsAddingTrees() );
+            CHECK( m_watcher->GetWatchedPathsCount() == m_initial );
+
+            CHECK(m_dir.Rmdir(wxPATH_RMDIR_RECURSIVE));
+        }
+
+    private:
+        wxFileName m_dir;
+        int m_initial,
+            m_expected;
+    };
+
+    TreeAsyncTester tester;
+
+    tester.Run();
+}
+
 
 namespace
 {
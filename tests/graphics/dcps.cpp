@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/dcps.cpp
+// Purpose:     wxPostScriptDC unit tests
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#if wxUSE_PRINTING_ARCHITECTURE && wxUSE_POSTSCRIPT
+
+#ifndef WX_PRECOMP
+    #include "wx/bitmap.h"
+    #include "wx/image.h"
+#endif // WX_PRECOMP
+
+#include "wx/dcps.h"
+#include "wx/ffile.h"
+#include "wx/filename.h"
+
+#include "wx/generic/private/dcpsg.h"
+
+#include <string>
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return the data as a string of hexadecimal bytes.
+wxString DataAsHex(const wxMemoryBuffer& buf)
+{
+    const unsigned char* const data =
+        static_cast<const unsigned char*>(buf.GetData());
+
+    wxString hex;
+    for ( size_t n = 0; n < buf.GetDataLen(); n++ )
+    {
+        if ( n )
+            hex += ' ';
+        hex += wxString::Format("%02X", data[n]);
+    }
+
+    return hex;
+}
+
+wxString RunLength(const unsigned char* data, size_t len)
+{
+    wxMemoryBuffer buf;
+    wxPostScriptEncodeRunLength(data, len, buf);
+    return DataAsHex(buf);
+}
+
+wxString ASCII85(const char* data, size_t len)
+{
+    wxMemoryBuffer buf;
+    wxPostScriptEncodeASCII85(reinterpret_cast<const unsigned char*>(data),
+                              len, buf);
+    return wxString(static_cast<const char*>(buf.GetData()),
+                    buf.GetDataLen());
+}
+
+// Draw the same bitmap twice using the given language level and return the
+// generated PostScript.
+wxString DrawBitmapTwice(int level)
+{
+    const wxString filename = wxFileName::CreateTempFileName("dcps");
+
+    {
+        wxPrintData printData;
+        printData.SetPrintMode(wxPRINT_MODE_FILE);
+        printData.SetFilename(filename);
+
+        wxPostScriptDC dc(printData);
+        dc.SetLanguageLevel(level);
+        CHECK( dc.GetLanguageLevel() == level );
+
+        REQUIRE( dc.StartDoc("Test") );
+        dc.StartPage();
+
+        wxImage image(16, 16);
+        image.SetRGB(wxRect(0, 0, 8, 16), 255, 0, 0);
+        const wxBitmap bitmap(image);
+        dc.DrawBitmap(bitmap, 10, 10);
+        dc.DrawBitmap(bitmap, 50, 10);
+
+        dc.EndPage();
+        dc.EndDoc();
+    }
+
+    wxString ps;
+    {
+        wxFFile file(filename);
+        CHECK( file.ReadAll(&ps) );
+    }
+
+    wxRemoveFile(filename);
+
+    return ps;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests themselves
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxPostScriptDC::RunLength", "[dc][ps]")
+{
+    CHECK( RunLength(NULL, 0) == "80" );
+
+    const unsigned char data[] = { 1, 1, 1, 1, 2, 3, 4 };
+    CHECK( RunLength(data, WXSIZEOF(data)) == "FD 01 02 02 03 04 80" );
+
+    const unsigned char literal[] = { 5, 6, 7, 7, 8 };
+    CHECK( RunLength(literal, WXSIZEOF(literal)) == "01 05 06 FF 07 00 08 80" );
+
+    // Runs are limited to 128 bytes.
+    unsigned char zeros[130] = { 0 };
+    CHECK( RunLength(zeros, WXSIZEOF(zeros)) == "81 00 FF 00 80" );
+}
+
+TEST_CASE("wxPostScriptDC::ASCII85", "[dc][ps]")
+{
+    CHECK( ASCII85("", 0) == "~>\n" );
+    CHECK( ASCII85("Man sure.", 9) == "9jqo^F*2M7/c~>\n" );
+
+    // Groups of 4 zero bytes are abbreviated, but not partial ones.
+    CHECK( ASCII85("\0\0\0\0\0\0", 6) == "z!!!~>\n" );
+
+    // Long output is split in lines.
+    const std::string x(80, 'x');
+    const wxString encoded = ASCII85(x.c_str(), x.length());
+    CHECK( encoded.length() == 100 + 1 + 3 );
+    CHECK( encoded.Find('\n') == 80 );
+}
+
+TEST_CASE("wxPostScriptDC::LanguageLevel", "[dc][ps]")
+{
+    wxString ps = DrawBitmapTwice(1);
+    CHECK( ps.StartsWith("%!PS-Adobe-2.0\n") );
+    CHECK( !ps.Contains("%%LanguageLevel") );
+    CHECK( ps.Contains("colorimage") );
+    CHECK( !ps.Contains("/ASCII85Decode filter") );
+
+    // Level 2 output uses run-length encoding but no reusable streams.
+    ps = DrawBitmapTwice(2);
+    CHECK( ps.Contains("%%LanguageLevel: 2\n") );
+    CHECK( ps.Contains("/RunLengthDecode filter") );
+    CHECK( !ps.Contains("FlateDecode") );
+    CHECK( !ps.Contains("ReusableStreamDecode") );
+
+    // Level 3 output defines the image data only once.
+    ps = DrawBitmapTwice(3);
+    CHECK( ps.Contains("%%LanguageLevel: 3\n") );
+
+    const wxString reusable("/ReusableStreamDecode filter");
+    const int pos = ps.Find(reusable);
+    CHECK( pos != wxNOT_FOUND );
+    CHECK( ps.Mid(pos + reusable.length()).Find(reusable) == wxNOT_FOUND );
+    CHECK( ps.Contains("wxImageData0 dup 0 setfileposition") );
+}
+
+#endif // wxUSE_PRINTING_ARCHITECTURE && wxUSE_POSTSCRIPT
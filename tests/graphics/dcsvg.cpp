@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/graphics/dcsvg.cpp
+// Purpose:     wxSVGFileDC unit tests
+// Author:      wxWidgets Team
+// Created:     2020-03-16
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#if wxUSE_SVG
+
+#ifndef WX_PRECOMP
+    #include "wx/bitmap.h"
+    #include "wx/image.h"
+#endif // WX_PRECOMP
+
+#include "wx/dcsvg.h"
+#include "wx/ffile.h"
+
+#include "testfile.h"
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const wxSize s_dcSize(100, 120);
+
+// Return the number of occurrences of the given substring in the string.
+size_t CountOccurrences(const wxString& s, const wxString& sub)
+{
+    size_t count = 0;
+    for ( size_t pos = s.find(sub); pos != wxString::npos; pos = s.find(sub, pos + 1) )
+        count++;
+
+    return count;
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests themselves
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxSVGFileDC::Output", "[dc][svgdc]")
+{
+    TestFile tf;
+
+    SECTION("Identical bitmaps are only written once")
+    {
+        {
+            wxSVGFileDC dc(tf.GetName(), s_dcSize.x, s_dcSize.y);
+            dc.SetBitmapHandler(new wxSVGBitmapEmbedHandler());
+
+            wxImage image(8, 8);
+            image.SetRGB(wxRect(0, 0, 4, 8), 0, 0, 255);
+            const wxBitmap bmp(image);
+            dc.DrawBitmap(bmp, 10, 10);
+            dc.DrawBitmap(wxBitmap(image), 30, 40);
+        }
+
+        wxString svg;
+        REQUIRE( wxFFile(tf.GetName()).ReadAll(&svg) );
+
+        CHECK( CountOccurrences(svg, "<image ") == 1 );
+        CHECK( CountOccurrences(svg, "<use ") == 2 );
+        CHECK( svg.Contains("<use xlink:href=\"#bitmap0\" x=\"10\" y=\"10\"/>") );
+        CHECK( svg.Contains("<use xlink:href=\"#bitmap0\" x=\"30\" y=\"40\"/>") );
+    }
+
+    SECTION("Consecutive lines are merged into a single path")
+    {
+        {
+            wxSVGFileDC dc(tf.GetName(), s_dcSize.x, s_dcSize.y);
+            dc.SetPen(*wxBLACK_PEN);
+            dc.DrawLine(0, 0, 10, 10);
+            dc.DrawLine(10, 10, 20, 5);
+
+            const wxPoint points[] = { wxPoint(1, 2), wxPoint(3, 4), wxPoint(5, 6) };
+            dc.DrawLines(WXSIZEOF(points), points);
+        }
+
+        wxString svg;
+        REQUIRE( wxFFile(tf.GetName()).ReadAll(&svg) );
+
+        CHECK( CountOccurrences(svg, "<path ") == 1 );
+        CHECK( svg.Contains("<path d=\"M0 0 L10 10 M10 10 L20 5 M1 2 L3 4 L5 6\" ") );
+    }
+}
+
+#endif // wxUSE_SVG
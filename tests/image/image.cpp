@@ -23,6 +23,7 @@
 #endif // WX_PRECOMP
 
 #include "wx/anidecod.h" // wxImageArray
+#include "wx/gifdecod.h"
 #include "wx/palette.h"
 #include "wx/url.h"
 #include "wx/log.h"
@@ -78,11 +79,13 @@ private:
         CPPUNIT_TEST( ReadCorruptedTGA );
 #if wxUSE_GIF
         CPPUNIT_TEST( SaveAnimatedGIF );
+        CPPUNIT_TEST( LoadAnimatedGIFFrames );
         CPPUNIT_TEST( GIFComment );
 #endif // wxUSE_GIF
         CPPUNIT_TEST( DibPadding );
         CPPUNIT_TEST( BMPFlippingAndRLECompression );
         CPPUNIT_TEST( ScaleCompare );
+        CPPUNIT_TEST( LoadScaled );
     CPPUNIT_TEST_SUITE_END();
 
     void LoadFromSocketStream();
@@ -98,11 +101,13 @@ private:
     void ReadCorruptedTGA();
 #if wxUSE_GIF
     void SaveAnimatedGIF();
+    void LoadAnimatedGIFFrames();
     void GIFComment();
 #endif // wxUSE_GIF
     void DibPadding();
     void BMPFlippingAndRLECompression();
     void ScaleCompare();
+    void LoadScaled();
 
     wxDECLARE_NO_COPY_CLASS(ImageTestCase);
 };
@@ -1222,6 +1227,43 @@ void ImageTestCase::SaveAnimatedGIF()
 #endif // #if wxUSE_PALETTE
 }
 
+void ImageTestCase::LoadAnimatedGIFFrames()
+{
+#if wxUSE_PALETTE
+    wxImage image("horse.gif");
+    CPPUNIT_ASSERT( image.IsOk() );
+
+    // Use more frames than the decoder keeps decoded simultaneously.
+    wxImageArray images;
+    images.Add(image);
+    for (int i = 0; i < 8-1; ++i)
+    {
+        images.Add( i % 2 ? images[i].Mirror() : images[i].Rotate180() );
+
+        images[i+1].SetPalette(images[0].GetPalette());
+    }
+
+    wxMemoryOutputStream memOut;
+    CPPUNIT_ASSERT( wxGIFHandler().SaveAnimation(images, &memOut) );
+
+    wxGIFDecoder decod;
+    wxMemoryInputStream memIn(memOut);
+    CPPUNIT_ASSERT_EQUAL( wxGIF_OK, decod.LoadGIF(memIn) );
+    CPPUNIT_ASSERT_EQUAL( 8, decod.GetFrameCount() );
+
+    // Access the frames in an order which forces them to be decoded again.
+    static const unsigned int frames[] = { 0, 7, 3, 1, 5, 2, 6, 4, 0, 7, 1 };
+    for (size_t n = 0; n < WXSIZEOF(frames); ++n)
+    {
+        const unsigned int i = frames[n];
+        CPPUNIT_ASSERT( decod.ConvertToImage(i, &image) );
+
+        wxINFO_FMT("Compare test for GIF frame number %u failed", i);
+        CHECK_THAT(image, RGBSameAs(images[i]));
+    }
+#endif // #if wxUSE_PALETTE
+}
+
 static void TestGIFComment(const wxString& comment)
 {
     wxImage image("horse.gif");
@@ -1452,6 +1494,160 @@ void ImageTestCase::ScaleCompare()
                                "image/cross_nearest_neighb_256x256.png");
 }
 
+static void TestLoadScaledFrom(wxMemoryOutputStream& memOut, wxBitmapType type)
+{
+    wxImage full;
+    {
+        wxMemoryInputStream memIn(memOut);
+        CPPUNIT_ASSERT( full.LoadFile(memIn, type) );
+    }
+
+    // Use both a size which requires halving the image once and twice.
+    static const int maxSizes[] = { 150, 60 };
+    for ( size_t n = 0; n < WXSIZEOF(maxSizes); n++ )
+    {
+        wxImage scaled;
+        scaled.SetOption(wxIMAGE_OPTION_MAX_WIDTH, maxSizes[n]);
+        scaled.SetOption(wxIMAGE_OPTION_MAX_HEIGHT, maxSizes[n]);
+
+        wxMemoryInputStream memIn(memOut);
+        CPPUNIT_ASSERT( scaled.LoadFile(memIn, type) );
+
+        const int width = full.GetWidth() >> (n + 1),
+                  height = full.GetHeight() >> (n + 1);
+        CPPUNIT_ASSERT_EQUAL( width, scaled.GetWidth() );
+        CPPUNIT_ASSERT_EQUAL( height, scaled.GetHeight() );
+        CPPUNIT_ASSERT_EQUAL( full.GetWidth(),
+                              scaled.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_WIDTH) );
+        CPPUNIT_ASSERT_EQUAL( full.GetHeight(),
+                              scaled.GetOptionInt(wxIMAGE_OPTION_ORIGINAL_HEIGHT) );
+
+        // The result must be the same as when scaling the image after loading
+        // it, whether or not the handler scales it during loading.
+        const wxImage
+            expected = full.Scale(width, height, wxIMAGE_QUALITY_BOX_AVERAGE);
+
+        wxINFO_FMT("Scaling to %d*%d", width, height);
+        CHECK_THAT( scaled, RGBSameAs(expected) );
+
+        CPPUNIT_ASSERT_EQUAL( expected.HasAlpha(), scaled.HasAlpha() );
+        if ( expected.HasAlpha() )
+        {
+            CPPUNIT_ASSERT( memcmp(expected.GetAlpha(), scaled.GetAlpha(),
+                                   width*height) == 0 );
+        }
+    }
+}
+
+static void TestLoadScaled(const wxImage& image, wxBitmapType type)
+{
+    wxMemoryOutputStream memOut;
+    CPPUNIT_ASSERT( image.SaveFile(memOut, type) );
+
+    TestLoadScaledFrom(memOut, type);
+}
+
+static void WriteLE(wxOutputStream& out, wxUint32 value, int size)
+{
+    for ( int n = 0; n < size; n++, value >>= 8 )
+        out.PutC(static_cast<char>(value & 0xff));
+}
+
+// wxBMPHandler never saves alpha, so write 32bpp BMP with the image alpha, or
+// zero alpha if it has none, manually.
+static void TestLoadScaled32bppBMP(const wxImage& image)
+{
+    const int width = image.GetWidth(),
+              height = image.GetHeight();
+    const wxUint32 dataSize = 4*width*height;
+
+    wxMemoryOutputStream memOut;
+
+    // BITMAPFILEHEADER
+    memOut.Write("BM", 2);
+    WriteLE(memOut, 14 + 40 + dataSize, 4);
+    WriteLE(memOut, 0, 4);
+    WriteLE(memOut, 14 + 40, 4);
+
+    // BITMAPINFOHEADER
+    WriteLE(memOut, 40, 4);
+    WriteLE(memOut, width, 4);
+    WriteLE(memOut, height, 4);
+    WriteLE(memOut, 1, 2);          // planes
+    WriteLE(memOut, 32, 2);         // bpp
+    WriteLE(memOut, 0, 4);          // BI_RGB
+    WriteLE(memOut, dataSize, 4);
+    WriteLE(memOut, 2835, 4);       // 72 DPI
+    WriteLE(memOut, 2835, 4);
+    WriteLE(memOut, 0, 4);          // colours used
+    WriteLE(memOut, 0, 4);          // important colours
+
+    // The rows are stored bottom up, the pixels as BGRA.
+    for ( int y = height - 1; y >= 0; y-- )
+    {
+        for ( int x = 0; x < width; x++ )
+        {
+            memOut.PutC(image.GetBlue(x, y));
+            memOut.PutC(image.GetGreen(x, y));
+            memOut.PutC(image.GetRed(x, y));
+            memOut.PutC(image.HasAlpha() ? image.GetAlpha(x, y) : 0);
+        }
+    }
+
+    TestLoadScaledFrom(memOut, wxBITMAP_TYPE_BMP);
+}
+
+void ImageTestCase::LoadScaled()
+{
+    // Use an image with odd size and different width and height to check that
+    // the rows and columns are averaged correctly.
+    const wxImage
+        original = wxImage("horse.png").GetSubImage(wxRect(0, 0, 199, 181));
+    CPPUNIT_ASSERT( original.IsOk() );
+
+    wxImage withAlpha = original.Copy();
+    withAlpha.InitAlpha();
+    unsigned char* alpha = withAlpha.GetAlpha();
+    for ( int n = 0; n < withAlpha.GetWidth()*withAlpha.GetHeight(); n++ )
+        alpha[n] = static_cast<unsigned char>(n % 253);
+
+    // Also check that the colour of the fully transparent regions is the
+    // same as with ResampleBox().
+    wxImage withHoles = withAlpha.Copy();
+    alpha = withHoles.GetAlpha();
+    for ( int y = 0; y < withHoles.GetHeight(); y++ )
+    {
+        for ( int x = 0; x < withHoles.GetWidth(); x++ )
+        {
+            if ( (y >= 20 && y < 70) || x < 33 )
+                alpha[y*withHoles.GetWidth() + x] = 0;
+        }
+    }
+
+    TestLoadScaled(original, wxBITMAP_TYPE_PNG);
+    TestLoadScaled(withAlpha, wxBITMAP_TYPE_PNG);
+    TestLoadScaled(withHoles, wxBITMAP_TYPE_PNG);
+
+    TestLoadScaled(original, wxBITMAP_TYPE_BMP);
+    TestLoadScaled(withAlpha, wxBITMAP_TYPE_BMP);
+    TestLoadScaled(withHoles, wxBITMAP_TYPE_BMP);
+
+    // 32bpp BMPs with only zero alpha values are loaded without alpha, check
+    // that they are not scaled as if they were fully transparent.
+    TestLoadScaled32bppBMP(original);
+    TestLoadScaled32bppBMP(withHoles);
+
+    wxImage imageGrey = original.Copy();
+    imageGrey.SetOption(wxIMAGE_OPTION_BMP_FORMAT, wxBMP_8BPP_GREY);
+    TestLoadScaled(imageGrey, wxBITMAP_TYPE_BMP);
+
+#if wxUSE_LIBTIFF
+    TestLoadScaled(original, wxBITMAP_TYPE_TIFF);
+    TestLoadScaled(withAlpha, wxBITMAP_TYPE_TIFF);
+    TestLoadScaled(withHoles, wxBITMAP_TYPE_TIFF);
+#endif // wxUSE_LIBTIFF
+}
+
 #endif //wxUSE_IMAGE
 
 
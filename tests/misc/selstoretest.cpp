@@ -47,6 +47,7 @@ private:
         CPPUNIT_TEST( Clear );
         CPPUNIT_TEST( Iterate );
         CPPUNIT_TEST( ItemsAddDelete );
+        CPPUNIT_TEST( HugeRanges );
     CPPUNIT_TEST_SUITE_END();
 
     void SelectItem();
@@ -55,6 +56,7 @@ private:
     void Clear();
     void Iterate();
     void ItemsAddDelete();
+    void HugeRanges();
 
     // NB: must be even
     static const unsigned NUM_ITEMS;
@@ -187,3 +189,49 @@ void SelStoreTestCase::ItemsAddDelete()
     CPPUNIT_ASSERT(m_store->IsSelected(0));
     CPPUNIT_ASSERT(m_store->IsSelected(NUM_ITEMS/2));
 }
+
+void SelStoreTestCase::HugeRanges()
+{
+    // Selecting many items in a huge store must not take forever.
+    const unsigned numItems = 100000000;
+    m_store->SetItemCount(numItems);
+
+    m_store->SelectRange(1000, numItems/4);
+    m_store->SelectRange(numItems/2, numItems/2 + 9);
+    CPPUNIT_ASSERT_EQUAL( numItems/4 - 1000 + 1 + 10, m_store->GetSelectedCount() );
+    CPPUNIT_ASSERT( !m_store->IsSelected(999) );
+    CPPUNIT_ASSERT( m_store->IsSelected(1000) );
+    CPPUNIT_ASSERT( m_store->IsSelected(numItems/4) );
+    CPPUNIT_ASSERT( !m_store->IsSelected(numItems/4 + 1) );
+
+    // Inserting items in the middle of a selected range doesn't select them.
+    m_store->OnItemsInserted(2000, 1000);
+    CPPUNIT_ASSERT( m_store->IsSelected(1999) );
+    CPPUNIT_ASSERT( !m_store->IsSelected(2000) );
+    CPPUNIT_ASSERT( !m_store->IsSelected(2999) );
+    CPPUNIT_ASSERT( m_store->IsSelected(3000) );
+    CPPUNIT_ASSERT( m_store->IsSelected(numItems/2 + 1000) );
+
+    // And deleting them restores the original selection.
+    CPPUNIT_ASSERT( !m_store->OnItemsDeleted(2000, 1000) );
+    CPPUNIT_ASSERT_EQUAL( numItems/4 - 1000 + 1 + 10, m_store->GetSelectedCount() );
+
+    wxSelectionStore::IterationState cookie;
+    CPPUNIT_ASSERT_EQUAL( 1000, m_store->GetFirstSelectedItem(cookie) );
+    CPPUNIT_ASSERT_EQUAL( 1001, m_store->GetNextSelectedItem(cookie) );
+
+    // Inserting no items at all doesn't change anything.
+    m_store->OnItemsInserted(2000, 0);
+    CPPUNIT_ASSERT_EQUAL( numItems/4 - 1000 + 1 + 10, m_store->GetSelectedCount() );
+    CPPUNIT_ASSERT( m_store->IsSelected(1999) );
+    CPPUNIT_ASSERT( m_store->IsSelected(2000) );
+    CPPUNIT_ASSERT( !m_store->IsSelected(numItems/4 + 1) );
+
+    wxArrayInt itemsChanged;
+    CPPUNIT_ASSERT( m_store->SelectRange(numItems/2 + 5, numItems/2 + 14,
+                                         false, &itemsChanged) );
+    CPPUNIT_ASSERT_EQUAL( 5, itemsChanged.size() );
+    CPPUNIT_ASSERT_EQUAL( numItems/2 + 5, itemsChanged[0] );
+    CPPUNIT_ASSERT( !m_store->SelectRange(0, numItems/4, false, &itemsChanged) );
+    CPPUNIT_ASSERT_EQUAL( 5, m_store->GetSelectedCount() );
+}
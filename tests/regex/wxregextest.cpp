@@ -22,6 +22,10 @@
 #include "wx/tokenzr.h"
 #include <string>
 
+#if wxUSE_THREADS
+    #include "wx/threadpool.h"
+#endif // wxUSE_THREADS
+
 using CppUnit::Test;
 using CppUnit::TestCase;
 using CppUnit::TestSuite;
@@ -344,4 +348,164 @@ TEST_CASE("wxRegEx::QuoteMeta", "[regex][meta]")
     CHECK( wxRegEx::QuoteMeta(":foo.*bar") == ":foo\\.\\*bar" );
 }
 
+TEST_CASE("wxRegEx::Filter", "[regex][filter]")
+{
+    static const char* const patterns[] =
+    {
+        "foo",
+        "^foo",
+        "foo$",
+        "fo+bar",
+        "fooo?",
+        "foo*",
+        "ba[rz]",
+        "foo|baz",
+        "(foo)+x",
+        "o\\.b",
+    };
+
+    wxArrayString strings;
+    strings.push_back("foo");
+    strings.push_back("foobar");
+    strings.push_back("fobar");
+    strings.push_back("fo");
+    strings.push_back("xfoo");
+    strings.push_back("baz");
+    strings.push_back("foofoox");
+    strings.push_back("o.b");
+    strings.push_back("FOO");
+    strings.push_back("");
+
+    for ( int icase = 0; icase < 2; icase++ )
+    {
+        for ( size_t n = 0; n < WXSIZEOF(patterns); n++ )
+        {
+            INFO("Pattern \"" << patterns[n] << "\"");
+
+            wxRegEx re(patterns[n], icase ? wxRE_ICASE : wxRE_DEFAULT);
+            REQUIRE( re.IsValid() );
+
+            wxArrayInt expected;
+            for ( size_t m = 0; m < strings.size(); m++ )
+            {
+                if ( re.Matches(strings[m]) )
+                    expected.push_back(m);
+            }
+
+            wxArrayInt indices;
+            CHECK( re.Filter(strings, &indices) == expected.size() );
+            CHECK( indices == expected );
+
+            CHECK( re.Filter(&strings[0], strings.size()) == expected.size() );
+        }
+    }
+}
+
+TEST_CASE("wxRegEx::Cache", "[regex][cache]")
+{
+    const size_t cacheSize = wxRegEx::GetCacheSize();
+    CHECK( cacheSize > 0 );
+
+    // The objects using the same expression must still be independent.
+    wxRegEx re1("b+"),
+            re2("b+");
+    REQUIRE( re1.Matches("abbc") );
+    REQUIRE( re2.Matches("bbbb") );
+
+    size_t start, len;
+    CHECK( re1.GetMatch(&start, &len) );
+    CHECK( start == 1 );
+    CHECK( len == 2 );
+
+    CHECK( re2.GetMatch(&start, &len) );
+    CHECK( start == 0 );
+    CHECK( len == 4 );
+
+    // Check that the matches of literal expressions are found correctly.
+    wxRegEx re("lit");
+    REQUIRE( re.Matches("a literal") );
+    CHECK( re.GetMatch("a literal") == "lit" );
+    CHECK( !re.Matches("a lid") );
+
+    wxString text("literally lit");
+    CHECK( re.ReplaceAll(&text, "LIT") == 2 );
+    CHECK( text == "LITerally LIT" );
+
+    // Check that everything works with the cache disabled too.
+    wxRegEx::SetCacheSize(0);
+    CHECK( wxRegEx::GetCacheSize() == 0 );
+
+    REQUIRE( re.Compile("(a+)b") );
+    REQUIRE( re.Matches("xaab") );
+    CHECK( re.GetMatch("xaab", 1) == "aa" );
+
+    wxRegEx::SetCacheSize(cacheSize);
+}
+
+#if wxUSE_THREADS
+
+namespace
+{
+
+wxAtomicInt gs_regexFailures;
+
+// Compiles the same expressions as the other threads and checks the matches.
+struct RegExWorker
+{
+    void operator()() const
+    {
+        static const struct
+        {
+            const char* expr;
+            const char* text;
+            const char* match;
+        } data[] =
+        {
+            { "(a+)b",  "xaab",     "aa"  },
+            { "c(d+)",  "ccddd",    "ddd" },
+            { "(e+)f",  "efeef",    "e"   },
+            { "lit",    "a literal", "lit" },
+        };
+
+        for ( int n = 0; n < 1000; n++ )
+        {
+            const size_t i = n % WXSIZEOF(data);
+            const int index = i == WXSIZEOF(data) - 1 ? 0 : 1;
+
+            wxRegEx re(data[i].expr);
+            if ( !re.IsValid() ||
+                    !re.Matches(data[i].text) ||
+                        re.GetMatch(data[i].text, index) != data[i].match )
+            {
+                wxAtomicInc(gs_regexFailures);
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+TEST_CASE("wxRegEx::CacheThreads", "[regex][cache]")
+{
+    const size_t cacheSize = wxRegEx::GetCacheSize();
+
+    // Use a cache smaller than the number of expressions to also evict the
+    // entries while they are used by the other threads.
+    wxRegEx::SetCacheSize(2);
+
+    gs_regexFailures = 0;
+    {
+        wxThreadPool pool(4);
+        wxTaskGroup group(pool);
+        for ( int n = 0; n < 8; n++ )
+            group.Run(RegExWorker());
+    }
+
+    CHECK( gs_regexFailures == 0 );
+
+    wxRegEx::SetCacheSize(cacheSize);
+}
+
+#endif // wxUSE_THREADS
+
 #endif // wxUSE_REGEX
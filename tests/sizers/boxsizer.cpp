@@ -287,6 +287,65 @@ TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::SetMinSize", "[sizer]")
     CHECK(m_sizer->GetMinSize().x == 100);
 }
 
+TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::NestedChanges", "[sizer]")
+{
+    wxWindow* const child1 = new wxWindow(m_win, wxID_ANY);
+    child1->SetInitialSize(wxSize(10, 10));
+    wxWindow* const child2 = new wxWindow(m_win, wxID_ANY);
+    child2->SetInitialSize(wxSize(20, 20));
+
+    // The nested sizer takes all the available space, so its size doesn't
+    // change when its contents does below.
+    wxSizer* const sizer = new wxBoxSizer(wxVERTICAL);
+    sizer->Add(child1);
+    sizer->Add(child2);
+    m_sizer->Add(sizer, wxSizerFlags(1).Expand());
+    CHECK( sizer->GetContainingSizer() == m_sizer );
+
+    m_win->Layout();
+    CHECK( m_sizer->GetMinSize() == wxSize(20, 30) );
+    CHECK( child2->GetPosition() == wxPoint(0, 10) );
+
+    // Changes to the minimal size of the windows must be taken into account.
+    child1->SetMinSize(wxSize(30, 15));
+    CHECK( m_sizer->GetMinSize() == wxSize(30, 35) );
+    m_win->Layout();
+    CHECK( child2->GetPosition() == wxPoint(0, 15) );
+
+    // Including the ones done by setting the size hints directly.
+    child1->SetSizeHints(wxSize(40, 25));
+    CHECK( m_sizer->GetMinSize() == wxSize(40, 45) );
+    m_win->Layout();
+    CHECK( child2->GetPosition() == wxPoint(0, 25) );
+
+    // As well as hiding them.
+    child1->Hide();
+    CHECK( m_sizer->GetMinSize() == wxSize(20, 20) );
+    m_win->Layout();
+    CHECK( child2->GetPosition() == wxPoint(0, 0) );
+
+    // Windows moved by the program must be repositioned by the next layout
+    // even if nothing changed in the sizers themselves.
+    child2->Move(50, 50);
+    m_win->Layout();
+    CHECK( child2->GetPosition() == wxPoint(0, 0) );
+
+    // And changes to the sizer items.
+    sizer->GetItem(child2)->SetFlag(wxEXPAND);
+    m_win->Layout();
+    CHECK( child2->GetSize() == wxSize(m_win->GetClientSize().x, 20) );
+
+    sizer->Insert(0, 5, 5);
+    CHECK( m_sizer->GetMinSize() == wxSize(20, 25) );
+    m_win->Layout();
+    CHECK( child2->GetPosition() == wxPoint(0, 5) );
+
+    CHECK( m_sizer->Detach(sizer) );
+    CHECK( sizer->GetContainingSizer() == NULL );
+    CHECK( m_sizer->GetMinSize() == wxSize(0, 0) );
+    delete sizer;
+}
+
 #if wxUSE_LISTBOX
 TEST_CASE_METHOD(BoxSizerTestCase, "BoxSizer::BestSizeRespectsMaxSize", "[sizer]")
 {
@@ -19,6 +19,7 @@
 #if wxUSE_TEXTFILE
 
 #ifndef WX_PRECOMP
+    #include "wx/log.h"
 #endif // WX_PRECOMP
 
 #include "wx/ffile.h"
@@ -59,6 +60,9 @@ private:
         CPPUNIT_TEST( ReadUTF16 );
 #endif // wxUSE_UNICODE
         CPPUNIT_TEST( ReadBig );
+        CPPUNIT_TEST( ReadIndexed );
+        CPPUNIT_TEST( ReadIndexedWithFuzzing );
+        CPPUNIT_TEST( ReadIndexedBig );
     CPPUNIT_TEST_SUITE_END();
 
     void ReadEmpty();
@@ -76,6 +80,9 @@ private:
     void ReadUTF16();
 #endif // wxUSE_UNICODE
     void ReadBig();
+    void ReadIndexed();
+    void ReadIndexedWithFuzzing();
+    void ReadIndexedBig();
 
     // return the name of the test file we use
     static const char *GetTestFileName() { return "textfiletest.txt"; }
@@ -338,6 +345,94 @@ void TextFileTestCase::ReadBig()
                           f[NUM_LINES - 1] );
 }
 
+void TextFileTestCase::ReadIndexed()
+{
+    CreateTestFile("\xef\xbb\xbf" "foo\rbar\r\n\nbaz");
+
+    wxIndexedTextFile f;
+    CPPUNIT_ASSERT( f.Open(GetTestFileName()) );
+
+    CPPUNIT_ASSERT_EQUAL( 4, f.GetLineCount() );
+    CPPUNIT_ASSERT_EQUAL( wxTextFileType_Mac, f.GetLineType(0) );
+    CPPUNIT_ASSERT_EQUAL( wxTextFileType_Dos, f.GetLineType(1) );
+    CPPUNIT_ASSERT_EQUAL( wxTextFileType_Unix, f.GetLineType(2) );
+    CPPUNIT_ASSERT_EQUAL( wxTextFileType_None, f.GetLineType(3) );
+    CPPUNIT_ASSERT_EQUAL( "foo", f.GetLine(0) );
+    CPPUNIT_ASSERT_EQUAL( "bar", f.GetLine(1) );
+    CPPUNIT_ASSERT_EQUAL( "", f.GetLine(2) );
+    CPPUNIT_ASSERT_EQUAL( "baz", f[3] );
+    CPPUNIT_ASSERT_EQUAL( 3, f.GetLineOffset(0) );
+    CPPUNIT_ASSERT_EQUAL( 13, f.GetLineOffset(3) );
+
+    CreateTestFile("");
+    CPPUNIT_ASSERT( f.Open(GetTestFileName()) );
+    CPPUNIT_ASSERT_EQUAL( 0, f.GetLineCount() );
+
+    // UTF-16 files can't be indexed.
+    CreateTestFile(4, "\xff\xfe" "a\0");
+    wxLogNull noLog;
+    CPPUNIT_ASSERT( !f.Open(GetTestFileName()) );
+}
+
+void TextFileTestCase::ReadIndexedWithFuzzing()
+{
+    // Check that wxIndexedTextFile splits the file in lines in exactly the
+    // same way as wxTextFile does.
+    for ( int iteration = 0; iteration < 100; iteration++ )
+    {
+        static const char CHOICES[] = {'\r', '\n', 'X'};
+
+        const size_t BUF_LEN = 100;
+        char data[BUF_LEN + 1];
+        for ( size_t i = 0; i < BUF_LEN; i++ )
+            data[i] = CHOICES[rand() % WXSIZEOF(CHOICES)];
+        data[BUF_LEN] = '\0';
+
+        CreateTestFile(data);
+
+        wxTextFile tf;
+        CPPUNIT_ASSERT( tf.Open(GetTestFileName()) );
+
+        wxIndexedTextFile itf;
+        CPPUNIT_ASSERT( itf.Open(GetTestFileName()) );
+
+        CPPUNIT_ASSERT_EQUAL( tf.GetLineCount(), itf.GetLineCount() );
+        for ( size_t n = 0; n < tf.GetLineCount(); n++ )
+        {
+            CPPUNIT_ASSERT_EQUAL( tf.GetLineType(n), itf.GetLineType(n) );
+            CPPUNIT_ASSERT_EQUAL( tf.GetLine(n), itf.GetLine(n) );
+        }
+    }
+}
+
+void TextFileTestCase::ReadIndexedBig()
+{
+    static const size_t NUM_LINES = 100000;
+
+    {
+        wxFFile f(GetTestFileName(), "w");
+        for ( size_t n = 0; n < NUM_LINES; n++ )
+        {
+            fprintf(f.fp(), "Line %lu\n", (unsigned long)n + 1);
+        }
+    }
+
+    wxIndexedTextFile f(GetTestFileName());
+    CPPUNIT_ASSERT( f.IsOpened() );
+
+    CPPUNIT_ASSERT_EQUAL( NUM_LINES, f.GetLineCount() );
+    CPPUNIT_ASSERT_EQUAL( wxString::Format("Line %lu", (unsigned long)NUM_LINES),
+                          f[NUM_LINES - 1] );
+    CPPUNIT_ASSERT_EQUAL( wxString("Line 1"), f[0] );
+    CPPUNIT_ASSERT_EQUAL( wxString("Line 54321"), f[54320] );
+
+    for ( size_t n = 0; n < NUM_LINES; n++ )
+    {
+        CPPUNIT_ASSERT_EQUAL( wxString::Format("Line %lu", (unsigned long)n + 1),
+                              f[n] );
+    }
+}
+
 #ifdef __LINUX__
 
 // Check if using wxTextFile with special files, whose reported size doesn't
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/thread/progsrc.cpp
+// Purpose:     wxProgressSource unit test
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#include "wx/progsrc.h"
+
+#if wxUSE_THREADS
+    #include "wx/threadpool.h"
+#endif // wxUSE_THREADS
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+const int NUM_STEPS = 10000;
+
+struct Worker
+{
+    explicit Worker(wxProgressSource& source) : m_source(source) { }
+
+    void operator()() const
+    {
+        for ( int n = 0; n < NUM_STEPS && !m_source.IsCancelled(); n++ )
+            m_source.Advance();
+
+        m_source.SetMessage("Done");
+    }
+
+    wxProgressSource& m_source;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests themselves
+// ----------------------------------------------------------------------------
+
+TEST_CASE("ProgressSource::Basic", "[progresssource]")
+{
+    wxProgressSource source;
+    CHECK( source.GetValue() == 0 );
+    CHECK( !source.IsCancelled() );
+
+    wxString message;
+    CHECK( !source.GetNewMessage(message) );
+
+    source.SetValue(17);
+    source.Advance();
+    CHECK( source.GetValue() == 18 );
+
+    // Only the last message is returned and only once.
+    source.SetMessage("First");
+    source.SetMessage("Second");
+    CHECK( source.GetNewMessage(message) );
+    CHECK( message == "Second" );
+    CHECK( !source.GetNewMessage(message) );
+
+    source.Cancel();
+    CHECK( source.IsCancelled() );
+
+    source.Reset();
+    CHECK( source.GetValue() == 0 );
+    CHECK( !source.IsCancelled() );
+}
+
+#if wxUSE_THREADS
+
+TEST_CASE("ProgressSource::Threads", "[progresssource]")
+{
+    wxThreadPool pool(4);
+    wxProgressSource source;
+
+    {
+        wxTaskGroup group(pool);
+        for ( int n = 0; n < 4; n++ )
+            group.Run(Worker(source));
+    }
+
+    CHECK( source.GetValue() == 4*NUM_STEPS );
+
+    wxString message;
+    CHECK( source.GetNewMessage(message) );
+    CHECK( message == "Done" );
+
+    // The workers stop as soon as they notice the cancellation request.
+    source.Reset();
+    source.Cancel();
+    pool.Run(Worker(source))->Wait();
+    CHECK( source.GetValue() == 0 );
+}
+
+#endif // wxUSE_THREADS
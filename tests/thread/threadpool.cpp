@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/thread/threadpool.cpp
+// Purpose:     wxThreadPool unit test
+// Author:      wxWidgets Team
+// Created:     2020-03-12
+// Copyright:   (c) 2020 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+#ifdef __BORLANDC__
+    #pragma hdrstop
+#endif
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+#endif // WX_PRECOMP
+
+#include "wx/threadpool.h"
+
+// ----------------------------------------------------------------------------
+// helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+wxAtomicInt gs_counter;
+
+struct IncrementCounter
+{
+    void operator()() const { wxAtomicInc(gs_counter); }
+};
+
+// Recursively computes Fibonacci numbers using nested task groups, to check
+// that waiting from inside the tasks works.
+struct Fibonacci
+{
+    Fibonacci(wxThreadPool& pool, int n, long* result)
+        : m_pool(pool), m_n(n), m_result(result)
+    {
+    }
+
+    void operator()() const
+    {
+        if ( m_n < 2 )
+        {
+            *m_result = m_n;
+            return;
+        }
+
+        long a, b;
+        {
+            wxTaskGroup group(m_pool);
+            group.Run(Fibonacci(m_pool, m_n - 1, &a));
+            group.Run(Fibonacci(m_pool, m_n - 2, &b));
+        }
+
+        *m_result = a + b;
+    }
+
+    wxThreadPool& m_pool;
+    const int m_n;
+    long* const m_result;
+};
+
+struct Square
+{
+    explicit Square(int n) : m_n(n) { }
+
+    int operator()() const { return m_n*m_n; }
+
+    const int m_n;
+};
+
+int gs_sumOfCompleted;
+
+struct AddCompleted
+{
+    void operator()(int n) const { gs_sumOfCompleted += n; }
+};
+
+class CountingTask : public wxThreadPoolTask
+{
+public:
+    CountingTask() : m_completed(false) { }
+
+    virtual void Run() wxOVERRIDE { wxAtomicInc(gs_counter); }
+    virtual void OnCompleted() wxOVERRIDE { m_completed = true; }
+
+    bool m_completed;
+};
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// tests themselves
+// ----------------------------------------------------------------------------
+
+TEST_CASE("ThreadPool::Group", "[threadpool]")
+{
+    // Use more threads than CPUs to test concurrency even on single CPU.
+    wxThreadPool pool(4);
+    CHECK( pool.GetThreadCount() == 4 );
+
+    gs_counter = 0;
+    {
+        wxTaskGroup group(pool);
+        for ( int n = 0; n < 10000; n++ )
+            group.Run(IncrementCounter());
+
+        group.Wait();
+        CHECK( group.IsDone() );
+        CHECK( gs_counter == 10000 );
+
+        // Check that the group can be reused after waiting.
+        for ( int n = 0; n < 100; n++ )
+            group.Run(IncrementCounter());
+    }
+
+    CHECK( gs_counter == 10100 );
+}
+
+TEST_CASE("ThreadPool::Nested", "[threadpool]")
+{
+    wxThreadPool pool(4);
+
+    long result = 0;
+    pool.Run(Fibonacci(pool, 16, &result))->Wait();
+    CHECK( result == 987 );
+
+    // This must work even with a single thread, as the waiting task executes
+    // the sub-tasks itself.
+    wxThreadPool poolSingle(1);
+    poolSingle.Run(Fibonacci(poolSingle, 12, &result))->Wait();
+    CHECK( result == 144 );
+}
+
+TEST_CASE("ThreadPool::Future", "[threadpool]")
+{
+    wxThreadPool& pool = wxThreadPool::Get();
+    CHECK( pool.GetThreadCount() >= 1 );
+
+    wxVector< wxThreadPoolFuture<int> > futures;
+    for ( int n = 0; n < 100; n++ )
+        futures.push_back(pool.Async<int>(Square(n)));
+
+    int sum = 0;
+    for ( size_t n = 0; n < futures.size(); n++ )
+    {
+        REQUIRE( futures[n].IsValid() );
+        sum += futures[n].Get();
+        CHECK( futures[n].IsReady() );
+    }
+
+    CHECK( sum == 328350 );
+
+    CHECK( !wxThreadPoolFuture<int>().IsValid() );
+}
+
+#ifdef wxHAS_CALL_AFTER
+
+TEST_CASE("ThreadPool::Completion", "[threadpool]")
+{
+    wxThreadPool pool(2);
+
+    gs_counter = 0;
+    CountingTask* const task = new CountingTask;
+    wxThreadPoolTaskPtr taskPtr = pool.Queue(task, wxTheApp);
+
+    gs_sumOfCompleted = 0;
+    wxThreadPoolFuture<int>
+        future = pool.Async<int>(Square(7), wxTheApp, AddCompleted());
+
+    taskPtr->Wait();
+    future.Wait();
+
+    // The completion functions are only called from the event loop.
+    CHECK( !task->m_completed );
+    CHECK( gs_sumOfCompleted == 0 );
+
+    wxTheApp->ProcessPendingEvents();
+
+    CHECK( gs_counter == 1 );
+    CHECK( task->m_completed );
+    CHECK( gs_sumOfCompleted == 49 );
+}
+
+#endif // wxHAS_CALL_AFTER